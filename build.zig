@@ -19,6 +19,21 @@ pub fn build(b: *std.Build) void {
     // Add build_options to main module
     main_mod.addOptions("build_options", build_options);
 
+    // 🆕 v0.2.0: 构建期解析 prelude，生成 AST 快照嵌入 pawc（src/prelude.zig 只解码，不再词法/语法分析）
+    // 生成器运行在构建主机上；快照是小端、定宽编码，交叉编译时同样有效
+    const prelude_gen = b.addExecutable(.{
+        .name = "prelude_gen",
+        .root_module = b.createModule(.{
+            .root_source_file = .{ .cwd_relative = "src/prelude_gen.zig" },
+            .target = b.graph.host,
+            .optimize = .ReleaseSafe,
+        }),
+    });
+    const gen_prelude = b.addRunArtifact(prelude_gen);
+    gen_prelude.addFileArg(.{ .cwd_relative = "src/prelude/prelude.paw" });
+    const prelude_ast = gen_prelude.addOutputFileArg("prelude.ast");
+    main_mod.addAnonymousImport("prelude_ast", .{ .root_source_file = prelude_ast });
+
     const exe = b.addExecutable(.{
         .name = "pawc",
         .root_module = main_mod,
@@ -221,6 +236,28 @@ pub fn build(b: *std.Build) void {
     // 链接标准库
     exe.linkLibC();
 
+    // 🆕 v0.2.0: pawrt 运行时库（src/builtin：paw_malloc、arena、内存池、文件 I/O）
+    // 安装为 zig-out/lib/libpawrt.a，C / LLVM 后端生成的程序链接时自动带上；
+    // pawc 自身也导出这些符号（rdynamic），JIT 执行的代码从进程中解析它们
+    const runtime_lib = b.addLibrary(.{
+        .name = "pawrt",
+        .linkage = .static,
+        .root_module = b.createModule(.{
+            .root_source_file = .{ .cwd_relative = "src/builtin/mod.zig" },
+            .target = target,
+            .optimize = optimize,
+            .link_libc = true,
+        }),
+    });
+    runtime_lib.bundle_compiler_rt = true;
+    b.installArtifact(runtime_lib);
+    exe.rdynamic = true;
+
+    // 🆕 v0.2.0: `zig build test` 运行运行时库的单元测试
+    const runtime_tests = b.addTest(.{ .root_module = runtime_lib.root_module });
+    const test_step = b.step("test", "Run runtime library unit tests");
+    test_step.dependOn(&b.addRunArtifact(runtime_tests).step);
+
     const install_artifact = b.addInstallArtifact(exe, .{});
     
     // 🆕 Cross-platform: Auto-copy LLVM libraries to output directory (for distribution)
@@ -0,0 +1,31 @@
+// 🐾 PawLang VSCode extension: starts `pawc lsp` for `.paw` files
+const vscode = require('vscode');
+const { LanguageClient } = require('vscode-languageclient/node');
+
+let client;
+
+function activate(context) {
+    const config = vscode.workspace.getConfiguration('paw');
+    const command = config.get('serverPath') || 'pawc';
+    const folder = vscode.workspace.workspaceFolders && vscode.workspace.workspaceFolders[0];
+
+    // Imports are resolved relative to the server's working directory
+    const serverOptions = {
+        command,
+        args: ['lsp'],
+        options: folder ? { cwd: folder.uri.fsPath } : {},
+    };
+    const clientOptions = {
+        documentSelector: [{ scheme: 'file', language: 'paw' }],
+    };
+
+    client = new LanguageClient('paw', 'Paw Language Server', serverOptions, clientOptions);
+    context.subscriptions.push(client);
+    client.start();
+}
+
+function deactivate() {
+    return client ? client.stop() : undefined;
+}
+
+module.exports = { activate, deactivate };
@@ -487,6 +487,11 @@ pub const FunctionDecl = struct {
     body: []Stmt,
     is_public: bool,
     is_async: bool,  // 新增：是否异步
+    // 🆕 v0.2.0: 没有函数体的声明 `fn name(...) -> T;`，由运行时库（pawrt）提供实现
+    is_extern: bool = false,
+    // 🆕 v0.2.0: 声明位置（-g 调试信息、#line），0 = 未知
+    line: usize = 0,
+    source_file: []const u8 = "",
     
     pub fn deinit(self: FunctionDecl, allocator: std.mem.Allocator) void {
         allocator.free(self.type_params);
@@ -0,0 +1,500 @@
+//! 🆕 v0.2.0: Benchmark Runner - `pawc bench`
+//!
+//! 用法：
+//!   pawc bench [path...] [options]
+//!
+//! 发现基准：
+//!   - 每个 .paw 文件中无参数的 `bench_*` 函数各是一个基准
+//!   - 没有 `bench_*` 函数的文件把整个程序（main）作为一个基准
+//!
+//! 对每个基准，pawc 生成一个只调用该函数的 harness 程序，
+//! 然后用当前 pawc 可执行文件在每个配置下编译：
+//!   c          : C 后端（-O 级别只对 LLVM 后端生效）
+//!   llvm-O0..3 : LLVM 后端的四个优化级别
+//! 每个配置先预热 warmup 次，再计时运行 iterations 次，报告 median / p99 / min。
+//!
+//! 基线：
+//!   --save-baseline=FILE 保存本次结果（JSON）
+//!   --baseline=FILE      与保存的结果比较，median 变慢超过 --threshold（默认 5%）
+//!                        时以非零状态退出，便于在发布前拦截代码生成的性能回退
+
+const std = @import("std");
+const ast = @import("ast.zig");
+const Lexer = @import("lexer.zig").Lexer;
+const Parser = @import("parser.zig").Parser;
+const Token = @import("token.zig").Token;
+const Prelude = @import("prelude.zig").Prelude;
+const prof = @import("profiler.zig");
+
+/// 默认的基准目录
+pub const default_dir = "tests/benchmarks";
+
+/// harness 源码和可执行文件的存放目录
+const work_dir = ".paw-bench";
+
+const baseline_version = 1;
+
+const Config = struct {
+    label: []const u8,
+    backend_flag: []const u8,
+    opt_flag: ?[]const u8,
+};
+
+const all_configs = [_]Config{
+    .{ .label = "c", .backend_flag = "--backend=c", .opt_flag = null },
+    .{ .label = "llvm-O0", .backend_flag = "--backend=llvm", .opt_flag = "-O0" },
+    .{ .label = "llvm-O1", .backend_flag = "--backend=llvm", .opt_flag = "-O1" },
+    .{ .label = "llvm-O2", .backend_flag = "--backend=llvm", .opt_flag = "-O2" },
+    .{ .label = "llvm-O3", .backend_flag = "--backend=llvm", .opt_flag = "-O3" },
+};
+
+const Options = struct {
+    paths: std.ArrayList([]const u8) = .{},
+    use_c: bool = true,
+    use_llvm: bool = true,
+    opt_levels: [4]bool = .{ false, false, false, false },  // 未指定时四个级别全跑
+    iterations: usize = 10,
+    warmup: usize = 2,
+    baseline: ?[]const u8 = null,
+    save_baseline: ?[]const u8 = null,
+    threshold_pct: f64 = 5.0,
+
+    fn wants(self: Options, config: Config) bool {
+        const opt = config.opt_flag orelse return self.use_c;
+        if (!self.use_llvm) return false;
+        const level = opt[2] - '0';
+        const any_selected = for (self.opt_levels) |selected| {
+            if (selected) break true;
+        } else false;
+        return !any_selected or self.opt_levels[level];
+    }
+};
+
+/// 一个待测的基准
+const Benchmark = struct {
+    name: []const u8,  // file.paw::bench_fn
+    harness_path: []const u8,
+};
+
+pub const Result = struct {
+    name: []const u8,
+    config: []const u8,
+    median_ns: u64,
+    p99_ns: u64,
+    min_ns: u64,
+};
+
+const Baseline = struct {
+    version: u32,
+    results: []Result,
+};
+
+/// `pawc bench` 入口（args 为 "bench" 之后的参数）
+pub fn run(allocator: std.mem.Allocator, args: []const [:0]u8, llvm_available: bool) !void {
+    var arena_state = std.heap.ArenaAllocator.init(allocator);
+    defer arena_state.deinit();
+    const arena = arena_state.allocator();
+
+    var options = Options{ .use_llvm = llvm_available };
+    if (!try parseOptions(arena, args, &options, llvm_available)) return;
+    if (options.paths.items.len == 0) {
+        try options.paths.append(arena, default_dir);
+    }
+
+    const self_exe = try std.fs.selfExePathAlloc(arena);
+    try std.fs.cwd().makePath(work_dir);
+
+    // 1. 发现基准并生成 harness
+    const prelude = try Prelude.load(allocator);
+    defer prelude.deinit();
+
+    var benchmarks = std.ArrayList(Benchmark){};
+    for (options.paths.items) |path| {
+        try discoverPath(arena, prelude, path, &benchmarks);
+    }
+    if (benchmarks.items.len == 0) {
+        std.debug.print("❌ No benchmarks found\n", .{});
+        return;
+    }
+
+    // 2. 按配置矩阵编译、运行
+    std.debug.print("🏁 Running {d} benchmark(s), {d} warmup + {d} timed iteration(s)\n\n", .{
+        benchmarks.items.len, options.warmup, options.iterations,
+    });
+
+    var results = std.ArrayList(Result){};
+    for (benchmarks.items, 0..) |bench, bench_idx| {
+        for (all_configs) |config| {
+            if (!options.wants(config)) continue;
+            const result = runOne(arena, self_exe, bench, bench_idx, config, options) catch |err| {
+                std.debug.print("  {s:<40} {s:<8} ❌ {s}\n", .{ bench.name, config.label, @errorName(err) });
+                continue;
+            };
+            try results.append(arena, result);
+        }
+    }
+
+    // 3. 报告（与基线比较）
+    var baseline: ?std.json.Parsed(Baseline) = null;
+    defer if (baseline) |*b| b.deinit();
+    if (options.baseline) |path| {
+        baseline = loadBaseline(allocator, path) catch |err| blk: {
+            std.debug.print("⚠️  Warning: cannot read baseline {s}: {s}\n", .{ path, @errorName(err) });
+            break :blk null;
+        };
+    }
+
+    const regressions = printReport(results.items, if (baseline) |b| b.value.results else null, options.threshold_pct);
+
+    if (options.save_baseline) |path| {
+        try saveBaseline(allocator, path, results.items);
+        std.debug.print("💾 Baseline saved: {s}\n", .{path});
+    }
+
+    if (regressions > 0) {
+        std.debug.print("❌ {d} regression(s) above {d:.1}%\n", .{ regressions, options.threshold_pct });
+        std.process.exit(1);
+    }
+}
+
+fn parseOptions(arena: std.mem.Allocator, args: []const [:0]u8, options: *Options, llvm_available: bool) !bool {
+    for (args) |arg| {
+        if (std.mem.eql(u8, arg, "--help") or std.mem.eql(u8, arg, "-h")) {
+            printUsage();
+            return false;
+        } else if (std.mem.eql(u8, arg, "--backend=c")) {
+            options.use_c = true;
+            options.use_llvm = false;
+        } else if (std.mem.eql(u8, arg, "--backend=llvm")) {
+            if (!llvm_available) {
+                std.debug.print("❌ Error: LLVM backend not available in this build\n", .{});
+                return false;
+            }
+            options.use_c = false;
+            options.use_llvm = true;
+        } else if (std.mem.eql(u8, arg, "--backend=all")) {
+            options.use_c = true;
+            options.use_llvm = llvm_available;
+        } else if (arg.len == 3 and std.mem.startsWith(u8, arg, "-O") and arg[2] >= '0' and arg[2] <= '3') {
+            options.opt_levels[arg[2] - '0'] = true;
+        } else if (std.mem.startsWith(u8, arg, "--iterations=")) {
+            options.iterations = std.fmt.parseInt(usize, arg["--iterations=".len..], 10) catch return invalid(arg);
+            if (options.iterations == 0) return invalid(arg);
+        } else if (std.mem.startsWith(u8, arg, "--warmup=")) {
+            options.warmup = std.fmt.parseInt(usize, arg["--warmup=".len..], 10) catch return invalid(arg);
+        } else if (std.mem.startsWith(u8, arg, "--baseline=")) {
+            options.baseline = arg["--baseline=".len..];
+        } else if (std.mem.startsWith(u8, arg, "--save-baseline=")) {
+            options.save_baseline = arg["--save-baseline=".len..];
+        } else if (std.mem.startsWith(u8, arg, "--threshold=")) {
+            options.threshold_pct = std.fmt.parseFloat(f64, arg["--threshold=".len..]) catch return invalid(arg);
+        } else if (std.mem.startsWith(u8, arg, "-")) {
+            return invalid(arg);
+        } else {
+            try options.paths.append(arena, arg);
+        }
+    }
+    return true;
+}
+
+fn invalid(arg: []const u8) bool {
+    std.debug.print("❌ Error: invalid bench option: {s}\n", .{arg});
+    printUsage();
+    return false;
+}
+
+pub fn printUsage() void {
+    std.debug.print("Usage: pawc bench [path...] [options]\n", .{});
+    std.debug.print("  path                     .paw file or directory (default: {s})\n", .{default_dir});
+    std.debug.print("  --backend=c|llvm|all     Backends to benchmark (default: all)\n", .{});
+    std.debug.print("  -O0 -O1 -O2 -O3          LLVM optimization levels (default: all)\n", .{});
+    std.debug.print("  --iterations=N           Timed runs per configuration (default: 10)\n", .{});
+    std.debug.print("  --warmup=N               Untimed warmup runs (default: 2)\n", .{});
+    std.debug.print("  --baseline=FILE          Compare against a saved baseline\n", .{});
+    std.debug.print("  --save-baseline=FILE     Save results as a baseline\n", .{});
+    std.debug.print("  --threshold=PCT          Regression threshold in percent (default: 5)\n", .{});
+}
+
+// ============================================================================
+// 基准发现与 harness 生成
+// ============================================================================
+
+fn discoverPath(arena: std.mem.Allocator, prelude: *Prelude, path: []const u8, out: *std.ArrayList(Benchmark)) !void {
+    if (std.mem.endsWith(u8, path, ".paw")) {
+        return discoverFile(arena, prelude, path, out);
+    }
+
+    var dir = try std.fs.cwd().openDir(path, .{ .iterate = true });
+    defer dir.close();
+
+    // 按文件名排序，保证报告顺序稳定
+    var names = std.ArrayList([]const u8){};
+    var it = dir.iterate();
+    while (try it.next()) |entry| {
+        if (entry.kind == .file and std.mem.endsWith(u8, entry.name, ".paw")) {
+            try names.append(arena, try arena.dupe(u8, entry.name));
+        }
+    }
+    std.mem.sort([]const u8, names.items, {}, lessThan);
+
+    for (names.items) |name| {
+        const file_path = try std.fs.path.join(arena, &.{ path, name });
+        try discoverFile(arena, prelude, file_path, out);
+    }
+}
+
+fn lessThan(_: void, a: []const u8, b: []const u8) bool {
+    return std.mem.lessThan(u8, a, b);
+}
+
+fn discoverFile(arena: std.mem.Allocator, prelude: *Prelude, path: []const u8, out: *std.ArrayList(Benchmark)) !void {
+    const source = try std.fs.cwd().readFileAlloc(arena, path, std.math.maxInt(usize));
+
+    var lexer = Lexer.init(arena, source, path);
+    const tokens = try lexer.tokenize();
+    var parser = Parser.init(arena, tokens);
+    try parser.addKnownTypes(prelude.type_names.items);
+    const program = parser.parse() catch |err| {
+        std.debug.print("⚠️  Skipping {s}: parse error {s}\n", .{ path, @errorName(err) });
+        return;
+    };
+
+    const stem = std.fs.path.stem(path);
+    var found = false;
+    for (program.declarations) |decl| {
+        if (decl != .function) continue;
+        const func = decl.function;
+        if (!std.mem.startsWith(u8, func.name, "bench_")) continue;
+        if (func.params.len > 0 or func.type_params.len > 0) {
+            std.debug.print("⚠️  Skipping {s}::{s}: bench functions take no parameters\n", .{ path, func.name });
+            continue;
+        }
+        found = true;
+
+        const harness = try makeHarness(arena, source, tokens, func);
+        const harness_path = try std.fmt.allocPrint(arena, "{s}/{s}__{s}.paw", .{ work_dir, stem, func.name });
+        try std.fs.cwd().writeFile(.{ .sub_path = harness_path, .data = harness });
+        try out.append(arena, Benchmark{
+            .name = try std.fmt.allocPrint(arena, "{s}::{s}", .{ std.fs.path.basename(path), func.name }),
+            .harness_path = harness_path,
+        });
+    }
+
+    // 没有 bench_* 函数：整个程序就是基准
+    if (!found) {
+        try out.append(arena, Benchmark{
+            .name = try std.fmt.allocPrint(arena, "{s}::main", .{std.fs.path.basename(path)}),
+            .harness_path = path,
+        });
+    }
+}
+
+/// 删除原来的 main，追加一个只调用基准函数的 main
+fn makeHarness(arena: std.mem.Allocator, source: []const u8, tokens: []const Token, func: ast.FunctionDecl) ![]const u8 {
+    var harness = std.ArrayList(u8){};
+    if (findMainRange(source, tokens)) |range| {
+        try harness.appendSlice(arena, source[0..range[0]]);
+        try harness.appendSlice(arena, source[range[1]..]);
+    } else {
+        try harness.appendSlice(arena, source);
+    }
+
+    try harness.appendSlice(arena, "\n// pawc bench harness\nfn main() -> i32 {\n");
+    switch (func.return_type) {
+        .i32 => try harness.print(arena, "    return {s}();\n", .{func.name}),
+        .void => try harness.print(arena, "    {s}();\n    return 0;\n", .{func.name}),
+        else => try harness.print(arena, "    let result = {s}();\n    return 0;\n", .{func.name}),
+    }
+    try harness.appendSlice(arena, "}\n");
+    return harness.items;
+}
+
+/// 顶层 `fn main` 声明在源码中的字节范围 [start, end)
+fn findMainRange(source: []const u8, tokens: []const Token) ?[2]usize {
+    var depth: usize = 0;
+    var i: usize = 0;
+    while (i + 1 < tokens.len) : (i += 1) {
+        switch (tokens[i].type) {
+            .lbrace => depth += 1,
+            .rbrace => depth -|= 1,
+            .keyword_fn => {
+                if (depth != 0) continue;
+                const name = tokens[i + 1];
+                if (name.type != .identifier or !std.mem.eql(u8, name.lexeme, "main")) continue;
+
+                const start = offsetOf(source, tokens[i]);
+                // 找到函数体的 { 并匹配对应的 }
+                var j = i + 2;
+                while (j < tokens.len and tokens[j].type != .lbrace) : (j += 1) {}
+                var body_depth: usize = 0;
+                while (j < tokens.len) : (j += 1) {
+                    switch (tokens[j].type) {
+                        .lbrace => body_depth += 1,
+                        .rbrace => {
+                            body_depth -= 1;
+                            if (body_depth == 0) {
+                                return .{ start, offsetOf(source, tokens[j]) + tokens[j].lexeme.len };
+                            }
+                        },
+                        else => {},
+                    }
+                }
+                return null;
+            },
+            else => {},
+        }
+    }
+    return null;
+}
+
+fn offsetOf(source: []const u8, token: Token) usize {
+    return @intFromPtr(token.lexeme.ptr) - @intFromPtr(source.ptr);
+}
+
+// ============================================================================
+// 编译与计时
+// ============================================================================
+
+fn runOne(
+    arena: std.mem.Allocator,
+    self_exe: []const u8,
+    bench: Benchmark,
+    bench_idx: usize,
+    config: Config,
+    options: Options,
+) !Result {
+    const exe_path = try std.fmt.allocPrint(arena, "{s}/bench{d}_{s}", .{ work_dir, bench_idx, config.label });
+
+    // 编译
+    var argv = std.ArrayList([]const u8){};
+    try argv.appendSlice(arena, &.{ self_exe, bench.harness_path, config.backend_flag, "--compile", "-o", exe_path });
+    if (config.opt_flag) |opt| try argv.append(arena, opt);
+
+    const compile = try std.process.Child.run(.{ .allocator = arena, .argv = argv.items });
+    if (compile.term != .Exited or compile.term.Exited != 0) {
+        std.debug.print("{s}", .{compile.stderr});
+        return error.CompileFailed;
+    }
+    defer std.fs.cwd().deleteFile(exe_path) catch {};
+
+    const run_path = try std.fmt.allocPrint(arena, "./{s}", .{exe_path});
+
+    var i: usize = 0;
+    while (i < options.warmup) : (i += 1) {
+        _ = try runBinary(arena, run_path);
+    }
+
+    const samples = try arena.alloc(u64, options.iterations);
+    for (samples) |*sample| {
+        sample.* = try runBinary(arena, run_path);
+    }
+    std.mem.sort(u64, samples, {}, std.sort.asc(u64));
+
+    return Result{
+        .name = bench.name,
+        .config = config.label,
+        .median_ns = percentile(samples, 50),
+        .p99_ns = percentile(samples, 99),
+        .min_ns = samples[0],
+    };
+}
+
+/// 运行一次并返回墙钟时间；程序崩溃视为失败
+fn runBinary(arena: std.mem.Allocator, path: []const u8) !u64 {
+    var child = std.process.Child.init(&.{path}, arena);
+    child.stdin_behavior = .Ignore;
+    child.stdout_behavior = .Ignore;
+    child.stderr_behavior = .Ignore;
+
+    var timer = try std.time.Timer.start();
+    const term = try child.spawnAndWait();
+    const elapsed = timer.read();
+
+    if (term != .Exited) return error.BenchmarkCrashed;
+    return elapsed;
+}
+
+/// nearest-rank 百分位（samples 已排序）
+fn percentile(samples: []const u64, pct: usize) u64 {
+    const rank = (pct * samples.len + 99) / 100;
+    return samples[@max(rank, 1) - 1];
+}
+
+// ============================================================================
+// 报告与基线
+// ============================================================================
+
+fn printReport(results: []const Result, baseline: ?[]const Result, threshold_pct: f64) usize {
+    var regressions: usize = 0;
+
+    std.debug.print("{s:<40} {s:<8} {s:>12} {s:>12} {s:>12} {s:>10}\n", .{
+        "benchmark", "config", "median", "p99", "min", "Δ median",
+    });
+    for (results) |result| {
+        std.debug.print("{s:<40} {s:<8} {d:>10.3}ms {d:>10.3}ms {d:>10.3}ms", .{
+            result.name,
+            result.config,
+            toMs(result.median_ns),
+            toMs(result.p99_ns),
+            toMs(result.min_ns),
+        });
+
+        const previous = if (baseline) |items| findResult(items, result.name, result.config) else null;
+        if (previous) |prev| {
+            const delta = (@as(f64, @floatFromInt(result.median_ns)) / @as(f64, @floatFromInt(@max(prev.median_ns, 1))) - 1.0) * 100.0;
+            const marker = if (delta > threshold_pct) " ⚠️" else "";
+            if (delta > threshold_pct) regressions += 1;
+            std.debug.print(" {d:>9.1}%{s}\n", .{ delta, marker });
+        } else {
+            std.debug.print(" {s:>10}\n", .{"-"});
+        }
+    }
+    std.debug.print("\n", .{});
+    return regressions;
+}
+
+fn toMs(ns: u64) f64 {
+    return @as(f64, @floatFromInt(ns)) / 1_000_000.0;
+}
+
+fn findResult(items: []const Result, name: []const u8, config: []const u8) ?Result {
+    for (items) |item| {
+        if (std.mem.eql(u8, item.name, name) and std.mem.eql(u8, item.config, config)) return item;
+    }
+    return null;
+}
+
+fn loadBaseline(allocator: std.mem.Allocator, path: []const u8) !std.json.Parsed(Baseline) {
+    const bytes = try std.fs.cwd().readFileAlloc(allocator, path, 16 * 1024 * 1024);
+    defer allocator.free(bytes);
+
+    const parsed = try std.json.parseFromSlice(Baseline, allocator, bytes, .{
+        .ignore_unknown_fields = true,
+        .allocate = .alloc_always,
+    });
+    if (parsed.value.version != baseline_version) {
+        parsed.deinit();
+        return error.UnsupportedBaselineVersion;
+    }
+    return parsed;
+}
+
+fn saveBaseline(allocator: std.mem.Allocator, path: []const u8, results: []const Result) !void {
+    var buf = std.ArrayList(u8){};
+    defer buf.deinit(allocator);
+
+    try buf.print(allocator, "{{\n  \"version\": {d},\n  \"results\": [", .{baseline_version});
+    for (results, 0..) |result, idx| {
+        try buf.appendSlice(allocator, if (idx == 0) "\n    " else ",\n    ");
+        try buf.appendSlice(allocator, "{ \"name\": ");
+        try prof.writeJsonString(&buf, allocator, result.name);
+        try buf.appendSlice(allocator, ", \"config\": ");
+        try prof.writeJsonString(&buf, allocator, result.config);
+        try buf.print(allocator, ", \"median_ns\": {d}, \"p99_ns\": {d}, \"min_ns\": {d} }}", .{
+            result.median_ns, result.p99_ns, result.min_ns,
+        });
+    }
+    try buf.appendSlice(allocator, "\n  ]\n}\n");
+
+    try std.fs.cwd().writeFile(.{ .sub_path = path, .data = buf.items });
+}
@@ -1,12 +1,16 @@
 // 文件系统内置函数
 // PawLang v0.2.0
 // 提供跨平台的文件 I/O 操作
+//
+// 🆕 v0.2.0: 除了整文件读写，还提供
+//   - 文件句柄：带 64 KiB 缓冲区的 read_chunk / read_line / write，以及 writev 向量写
+//   - 只读内存映射：大文件不必读入内存，直接按指针访问（Windows 上退化为整文件读取）
 
 const std = @import("std");
+const builtin = @import("builtin");
 
-// 全局分配器（用于文件内容缓冲区）
-var gpa = std.heap.GeneralPurposeAllocator(.{}){};
-const allocator = gpa.allocator();
+// 文件内容缓冲区和句柄使用 libc 分配器（pawrt 链接 libc，和 paw_malloc 同一个堆）
+const allocator = std.heap.c_allocator;
 
 // ============================================================================
 // 文件读取
@@ -15,29 +19,26 @@ const allocator = gpa.allocator();
 /// 读取文件内容
 /// @param path_ptr 文件路径的指针
 /// @param path_len 路径长度
-/// @return 文件内容的指针（i64 编码），失败返回 0
+/// @return 文件内容的指针（i64 编码，以 '\0' 结尾，可以直接作为 string 使用），失败返回 0
+/// 🆕 v0.2.0: 只打开一次文件，按 fstat 得到的大小一次分配
 export fn paw_read_file(path_ptr: [*]const u8, path_len: usize) i64 {
-    // 转换路径为 slice
     const path_slice = path_ptr[0..path_len];
     
-    // 打开文件
     const file = std.fs.cwd().openFile(path_slice, .{}) catch {
         return 0; // 文件不存在或无法打开
     };
     defer file.close();
     
-    // 读取文件大小
     const file_size = file.getEndPos() catch {
         return 0;
     };
     
-    // 分配缓冲区
-    const buffer = allocator.alloc(u8, file_size) catch {
+    // 多分配 1 字节放结尾的 '\0'（paw_free_file_content 按 len + 1 释放）
+    const buffer = allocator.alloc(u8, file_size + 1) catch {
         return 0;
     };
     
-    // 读取内容
-    const bytes_read = file.readAll(buffer) catch {
+    const bytes_read = file.readAll(buffer[0..file_size]) catch {
         allocator.free(buffer);
         return 0;
     };
@@ -46,27 +47,25 @@ export fn paw_read_file(path_ptr: [*]const u8, path_len: usize) i64 {
         allocator.free(buffer);
         return 0;
     }
+    buffer[file_size] = 0;
     
     // 返回缓冲区指针（编码为 i64）
     return @intCast(@intFromPtr(buffer.ptr));
 }
 
-/// 获取读取的文件大小
-/// @param content_ptr 文件内容指针（来自 paw_read_file）
-/// @return 文件大小
+/// 获取文件大小
+/// @param path_ptr 文件路径指针
+/// @param path_len 路径长度
+/// @return 文件大小，失败返回 -1
+/// 🆕 v0.2.0: 只做一次 stat，不打开文件；已打开的文件用 paw_file_length
 export fn paw_file_size(path_ptr: [*]const u8, path_len: usize) i64 {
     const path_slice = path_ptr[0..path_len];
     
-    const file = std.fs.cwd().openFile(path_slice, .{}) catch {
-        return -1;
-    };
-    defer file.close();
-    
-    const size = file.getEndPos() catch {
+    const stat = std.fs.cwd().statFile(path_slice) catch {
         return -1;
     };
     
-    return @intCast(size);
+    return @intCast(stat.size);
 }
 
 // ============================================================================
@@ -283,12 +282,410 @@ export fn paw_delete_dir_all(path_ptr: [*]const u8, path_len: usize) i32 {
 
 /// 释放由 paw_read_file 分配的内存
 /// @param ptr 指针
-/// @param len 长度
+/// @param len 长度（文件大小，不含结尾的 '\0'）
 export fn paw_free_file_content(ptr: i64, len: usize) void {
     if (ptr == 0) return;
     
     const buf_ptr: [*]u8 = @ptrFromInt(@as(usize, @intCast(ptr)));
-    const buffer = buf_ptr[0..len];
+    const buffer = buf_ptr[0 .. len + 1];
     allocator.free(buffer);
 }
 
+
+// ============================================================================
+// 🆕 v0.2.0: 文件句柄 - 缓冲读写
+// ============================================================================
+
+const buffer_size = 64 * 1024;
+
+/// paw_file_open 的 mode 参数
+const OpenMode = enum(i32) {
+    read = 0,        // 只读
+    write = 1,       // 创建或截断后写入
+    append = 2,      // 创建或追加到末尾
+    read_write = 3,  // 读写已存在的文件
+};
+
+const FileHandle = struct {
+    file: std.fs.File,
+    // 读缓冲区：有效数据是 rbuf[start..end]
+    rbuf: []u8 = &.{},
+    start: usize = 0,
+    end: usize = 0,
+    // 写缓冲区：待写入的数据是 wbuf[0..wlen]
+    wbuf: []u8 = &.{},
+    wlen: usize = 0,
+    // 跨越读缓冲区边界的行在这里拼接
+    line_buf: std.ArrayListUnmanaged(u8) = .{},
+    line: []const u8 = &.{},
+    failed: bool = false,
+
+    /// 把写缓冲区交给系统
+    fn flush(self: *FileHandle) bool {
+        if (self.wlen == 0) return true;
+        self.file.writeAll(self.wbuf[0..self.wlen]) catch {
+            self.failed = true;
+            return false;
+        };
+        self.wlen = 0;
+        return true;
+    }
+
+    /// 从读切换到写之前丢弃读缓冲区
+    /// 文件位置在预读数据的末尾，回退尚未交给调用方的 end - start 字节，
+    /// 写入才会落在调用方读到的位置之后
+    fn discardReadAhead(self: *FileHandle) bool {
+        const unread = self.end - self.start;
+        self.start = 0;
+        self.end = 0;
+        if (unread == 0) return true;
+        self.file.seekBy(-@as(i64, @intCast(unread))) catch {
+            self.failed = true;
+            return false;
+        };
+        return true;
+    }
+
+    /// 读缓冲区为空时从文件读入下一块；到达文件末尾返回 false
+    fn fill(self: *FileHandle) bool {
+        if (self.rbuf.len == 0) {
+            self.rbuf = allocator.alloc(u8, buffer_size) catch return false;
+        }
+        // 读写同一个文件时，先让之前的写入生效
+        if (!self.flush()) return false;
+        const n = self.file.read(self.rbuf) catch {
+            self.failed = true;
+            return false;
+        };
+        self.start = 0;
+        self.end = n;
+        return n > 0;
+    }
+
+    /// 读取下一行（不含 '\n' 和 '\r'，以 '\0' 结尾）
+    /// 整行都在读缓冲区中时直接借用缓冲区，不复制
+    fn readLine(self: *FileHandle) bool {
+        self.line_buf.clearRetainingCapacity();
+        while (true) {
+            const available = self.rbuf[self.start..self.end];
+            if (std.mem.indexOfScalar(u8, available, '\n')) |newline| {
+                const content = available[0..newline];
+                self.start += newline + 1;
+                if (self.line_buf.items.len == 0) {
+                    // 把 '\n' 换成 '\0'，行直接指向缓冲区
+                    self.rbuf[self.start - 1] = 0;
+                    self.line = trimCarriageReturn(self.rbuf[self.start - 1 - content.len .. self.start - 1]);
+                    return true;
+                }
+                self.line_buf.appendSlice(allocator, content) catch return false;
+                return self.finishBufferedLine();
+            }
+            self.line_buf.appendSlice(allocator, available) catch return false;
+            self.start = self.end;
+            if (!self.fill()) {
+                // 文件末尾：最后一行可以没有换行符
+                if (self.line_buf.items.len == 0) return false;
+                return self.finishBufferedLine();
+            }
+        }
+    }
+
+    fn finishBufferedLine(self: *FileHandle) bool {
+        self.line_buf.append(allocator, 0) catch return false;
+        const items = self.line_buf.items;
+        self.line = trimCarriageReturn(items[0 .. items.len - 1]);
+        return true;
+    }
+};
+
+/// Windows 换行 "\r\n"：去掉行尾的 '\r'（改为 '\0'，保持以 '\0' 结尾）
+fn trimCarriageReturn(line: []u8) []const u8 {
+    if (line.len > 0 and line[line.len - 1] == '\r') {
+        line[line.len - 1] = 0;
+        return line[0 .. line.len - 1];
+    }
+    return line;
+}
+
+fn toHandle(ptr: *anyopaque) i64 {
+    return @bitCast(@intFromPtr(ptr));
+}
+
+fn fromHandle(comptime T: type, handle: i64) ?*T {
+    if (handle == 0) return null;
+    const ptr_val: usize = @bitCast(handle);
+    return @ptrFromInt(ptr_val);
+}
+
+fn bytesAt(ptr: i64, len: i64) []const u8 {
+    if (ptr == 0 or len <= 0) return &.{};
+    const base: [*]const u8 = @ptrFromInt(@as(usize, @bitCast(ptr)));
+    return base[0..@intCast(len)];
+}
+
+/// 打开文件
+/// @param path 文件路径（'\0' 结尾）
+/// @param mode 0 只读，1 创建/截断写入，2 追加，3 读写
+/// @return 句柄，失败返回 0
+export fn paw_file_open(path: [*:0]const u8, mode: i32) i64 {
+    const path_slice = std.mem.span(path);
+    const open_mode = std.meta.intToEnum(OpenMode, mode) catch return 0;
+    const file = switch (open_mode) {
+        .read => std.fs.cwd().openFile(path_slice, .{}),
+        .write => std.fs.cwd().createFile(path_slice, .{}),
+        .append => std.fs.cwd().createFile(path_slice, .{ .truncate = false }),
+        .read_write => std.fs.cwd().openFile(path_slice, .{ .mode = .read_write }),
+    } catch return 0;
+    if (open_mode == .append) file.seekFromEnd(0) catch {
+        file.close();
+        return 0;
+    };
+
+    const handle = allocator.create(FileHandle) catch {
+        file.close();
+        return 0;
+    };
+    handle.* = .{ .file = file };
+    return toHandle(handle);
+}
+
+/// 关闭文件（先写出缓冲区中的数据）
+/// @return 缓冲区全部写出返回 1，否则返回 0
+export fn paw_file_close(handle: i64) i32 {
+    const f = fromHandle(FileHandle, handle) orelse return 0;
+    const ok = f.flush();
+    f.file.close();
+    allocator.free(f.rbuf);
+    allocator.free(f.wbuf);
+    f.line_buf.deinit(allocator);
+    allocator.destroy(f);
+    return if (ok) 1 else 0;
+}
+
+/// 读取最多 capacity 字节到 dest
+/// @return 读到的字节数，文件末尾返回 0，出错返回 -1
+export fn paw_file_read_chunk(handle: i64, dest: i64, capacity: i64) i64 {
+    const f = fromHandle(FileHandle, handle) orelse return -1;
+    if (dest == 0 or capacity <= 0) return 0;
+    const out: [*]u8 = @ptrFromInt(@as(usize, @bitCast(dest)));
+    const want: usize = @intCast(capacity);
+
+    // 先交出缓冲区中剩下的数据
+    if (f.start < f.end) {
+        const n = @min(want, f.end - f.start);
+        @memcpy(out[0..n], f.rbuf[f.start..][0..n]);
+        f.start += n;
+        return @intCast(n);
+    }
+    // 大块读取直接读入调用方的内存，不经过缓冲区
+    if (want >= buffer_size) {
+        if (!f.flush()) return -1;
+        const n = f.file.read(out[0..want]) catch return -1;
+        return @intCast(n);
+    }
+    if (!f.fill()) return if (f.failed) -1 else 0;
+    const n = @min(want, f.end - f.start);
+    @memcpy(out[0..n], f.rbuf[f.start..][0..n]);
+    f.start += n;
+    return @intCast(n);
+}
+
+/// 读取下一行，通过 paw_file_line / paw_file_line_len 获取内容
+/// @return 读到一行返回 1，文件末尾返回 0
+export fn paw_file_read_line(handle: i64) i32 {
+    const f = fromHandle(FileHandle, handle) orelse return 0;
+    return if (f.readLine()) 1 else 0;
+}
+
+/// 最近一次 paw_file_read_line 读到的行（不含换行符，'\0' 结尾）
+/// 借用句柄的缓冲区，下一次读取后失效
+export fn paw_file_line(handle: i64) [*:0]const u8 {
+    const f = fromHandle(FileHandle, handle) orelse return "";
+    if (f.line.len == 0) return "";
+    return @ptrCast(f.line.ptr);
+}
+
+export fn paw_file_line_len(handle: i64) i64 {
+    const f = fromHandle(FileHandle, handle) orelse return 0;
+    return @intCast(f.line.len);
+}
+
+/// 缓冲写入 len 字节
+/// @return 成功返回 1，失败返回 0
+export fn paw_file_write_bytes(handle: i64, ptr: i64, len: i64) i32 {
+    const f = fromHandle(FileHandle, handle) orelse return 0;
+    return if (writeBuffered(f, bytesAt(ptr, len))) 1 else 0;
+}
+
+/// 缓冲写入以 '\0' 结尾的字符串
+export fn paw_file_write(handle: i64, s: [*:0]const u8) i32 {
+    const f = fromHandle(FileHandle, handle) orelse return 0;
+    return if (writeBuffered(f, std.mem.span(s))) 1 else 0;
+}
+
+fn writeBuffered(f: *FileHandle, bytes: []const u8) bool {
+    if (!f.discardReadAhead()) return false;
+    if (f.wbuf.len == 0) {
+        f.wbuf = allocator.alloc(u8, buffer_size) catch return false;
+    }
+    if (f.wlen + bytes.len > f.wbuf.len) {
+        if (!f.flush()) return false;
+    }
+    // 比缓冲区还大的写入直接交给系统
+    if (bytes.len >= f.wbuf.len) {
+        f.file.writeAll(bytes) catch {
+            f.failed = true;
+            return false;
+        };
+        return true;
+    }
+    @memcpy(f.wbuf[f.wlen..][0..bytes.len], bytes);
+    f.wlen += bytes.len;
+    return true;
+}
+
+/// 向量写入：parts 指向 count 对 i64（指针，长度），一次 writev 系统调用写出
+/// 写缓冲区中已有的数据作为第一段一起写出，保持写入顺序
+/// @return 成功返回 1，失败返回 0
+export fn paw_file_writev(handle: i64, parts: i64, count: i64) i32 {
+    const f = fromHandle(FileHandle, handle) orelse return 0;
+    if (count <= 0) return 1;
+    const pairs: [*]const i64 = @ptrFromInt(@as(usize, @bitCast(parts)));
+    const n: usize = @intCast(count);
+    if (!f.discardReadAhead()) return 0;
+
+    const iovecs = allocator.alloc(std.posix.iovec_const, n + 1) catch return 0;
+    defer allocator.free(iovecs);
+    var used: usize = 0;
+    if (f.wlen > 0) {
+        iovecs[used] = .{ .base = f.wbuf.ptr, .len = f.wlen };
+        used += 1;
+    }
+    for (0..n) |i| {
+        const bytes = bytesAt(pairs[2 * i], pairs[2 * i + 1]);
+        if (bytes.len == 0) continue;
+        iovecs[used] = .{ .base = bytes.ptr, .len = bytes.len };
+        used += 1;
+    }
+    f.file.writevAll(iovecs[0..used]) catch {
+        f.failed = true;
+        return 0;
+    };
+    f.wlen = 0;
+    return 1;
+}
+
+/// 把缓冲区中的数据写入文件
+export fn paw_file_flush(handle: i64) i32 {
+    const f = fromHandle(FileHandle, handle) orelse return 0;
+    return if (f.flush()) 1 else 0;
+}
+
+/// 移动到文件中的 offset 字节处（丢弃读缓冲区，写出写缓冲区）
+export fn paw_file_seek(handle: i64, offset: i64) i32 {
+    const f = fromHandle(FileHandle, handle) orelse return 0;
+    if (offset < 0 or !f.flush()) return 0;
+    f.file.seekTo(@intCast(offset)) catch return 0;
+    f.start = 0;
+    f.end = 0;
+    return 1;
+}
+
+/// 已打开文件的大小（fstat，不再按路径打开文件）
+export fn paw_file_length(handle: i64) i64 {
+    const f = fromHandle(FileHandle, handle) orelse return -1;
+    if (!f.flush()) return -1;
+    const size = f.file.getEndPos() catch return -1;
+    return @intCast(size);
+}
+
+// ============================================================================
+// 🆕 v0.2.0: 只读内存映射
+// ============================================================================
+
+const Mapping = struct {
+    bytes: []const u8,
+    mapped: bool,   // false：整文件读入的堆内存（Windows 或空文件）
+};
+
+/// 以只读方式映射整个文件；按页按需读入，适合顺序扫描大文件
+/// @param path 文件路径（'\0' 结尾）
+/// @return 句柄，失败返回 0
+export fn paw_mmap_open(path: [*:0]const u8) i64 {
+    const file = std.fs.cwd().openFile(std.mem.span(path), .{}) catch return 0;
+    defer file.close();
+    const size = file.getEndPos() catch return 0;
+
+    const mapping = allocator.create(Mapping) catch return 0;
+    mapping.* = .{ .bytes = &.{}, .mapped = false };
+    if (size == 0) return toHandle(mapping);
+
+    if (builtin.os.tag != .windows) {
+        if (std.posix.mmap(null, size, std.posix.PROT.READ, .{ .TYPE = .PRIVATE }, file.handle, 0)) |memory| {
+            // 顺序访问提示：内核加大预读，扫描过的页尽早回收
+            std.posix.madvise(memory.ptr, memory.len, std.posix.MADV.SEQUENTIAL) catch {};
+            mapping.* = .{ .bytes = memory, .mapped = true };
+            return toHandle(mapping);
+        } else |_| {}
+    }
+
+    // 无法映射时退化为整文件读取
+    const buffer = allocator.alloc(u8, size) catch {
+        allocator.destroy(mapping);
+        return 0;
+    };
+    const n = file.readAll(buffer) catch 0;
+    if (n != size) {
+        allocator.free(buffer);
+        allocator.destroy(mapping);
+        return 0;
+    }
+    mapping.* = .{ .bytes = buffer, .mapped = false };
+    return toHandle(mapping);
+}
+
+/// 映射内容的起始指针（空文件为 0）
+export fn paw_mmap_ptr(handle: i64) i64 {
+    const mapping = fromHandle(Mapping, handle) orelse return 0;
+    if (mapping.bytes.len == 0) return 0;
+    return @bitCast(@intFromPtr(mapping.bytes.ptr));
+}
+
+export fn paw_mmap_len(handle: i64) i64 {
+    const mapping = fromHandle(Mapping, handle) orelse return 0;
+    return @intCast(mapping.bytes.len);
+}
+
+/// 解除映射；之后不能再访问 paw_mmap_ptr 返回的内存
+export fn paw_mmap_close(handle: i64) void {
+    const mapping = fromHandle(Mapping, handle) orelse return;
+    if (builtin.os.tag != .windows and mapping.mapped) {
+        const memory: []align(std.heap.page_size_min) const u8 = @alignCast(mapping.bytes);
+        std.posix.munmap(memory);
+    } else {
+        allocator.free(mapping.bytes);
+    }
+    allocator.destroy(mapping);
+}
+
+test "Write after buffered reads lands after the consumed bytes" {
+    var tmp = std.testing.tmpDir(.{});
+    defer tmp.cleanup();
+    try tmp.dir.writeFile(.{ .sub_path = "rw.txt", .data = "first\nsecond\nthird\n" });
+    const dir_path = try tmp.dir.realpathAlloc(std.testing.allocator, ".");
+    defer std.testing.allocator.free(dir_path);
+    const path = try std.fs.path.joinZ(std.testing.allocator, &.{ dir_path, "rw.txt" });
+    defer std.testing.allocator.free(path);
+
+    const h = paw_file_open(path, @intFromEnum(OpenMode.read_write));
+    try std.testing.expect(h != 0);
+    // 第一次读取把整个文件读入缓冲区，但调用方只消费了第一行
+    try std.testing.expectEqual(@as(i32, 1), paw_file_read_line(h));
+    try std.testing.expectEqualStrings("first", std.mem.span(paw_file_line(h)));
+    try std.testing.expectEqual(@as(i32, 1), paw_file_write(h, "SECOND"));
+    try std.testing.expectEqual(@as(i32, 1), paw_file_close(h));
+
+    const contents = try tmp.dir.readFileAlloc(std.testing.allocator, "rw.txt", 1024);
+    defer std.testing.allocator.free(contents);
+    try std.testing.expectEqualStrings("first\nSECOND\nthird\n", contents);
+}
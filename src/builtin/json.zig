@@ -0,0 +1,683 @@
+//! 🆕 v0.2.0: Built-in Streaming JSON Reader for PawLang
+//!
+//! 拉取式（pull / SAX 风格）JSON 解析器，stdlib/json 的 JsonReader 是它的句柄：
+//!   - 输入可以分块 feed（文件、socket 缓冲区），不需要整个文档在内存中
+//!   - paw_json_next 每次返回一个事件（对象/数组开始结束、键、标量值），不构建树
+//!   - 键和字符串值是指向输入的借用切片（不含引号、不解码转义），需要保存时再复制
+//!   - 空白和字符串内容按 16 字节向量扫描
+//!
+//! 只有跨越两个输入块的那一个 token 会被复制到内部的 carry 缓冲区中拼接完整。
+//! 文档顶层可以是连续多个值（NDJSON 日志），全部输入结束后调用 paw_json_reader_finish。
+
+const std = @import("std");
+const memory = @import("memory.zig");
+
+/// paw_json_next 返回的事件（数值与 stdlib/json 中 JsonReader 的说明一致）
+pub const Event = enum(i32) {
+    need_more = 0,      // 当前输入已用完，feed 更多数据后再调用
+    object_start = 1,
+    object_end = 2,
+    array_start = 3,
+    array_end = 4,
+    key = 5,
+    string = 6,
+    number = 7,
+    true_value = 8,
+    false_value = 9,
+    null_value = 10,
+    end = 11,           // finish 之后所有输入都已解析完
+    syntax_error = -1,
+};
+
+const max_depth = 512;
+
+/// 下一个 token 应该是什么
+const Expect = enum(u8) {
+    value,          // 任意值（顶层、冒号之后、数组中逗号之后）
+    first_value,    // '[' 之后：值或 ']'
+    first_key,      // '{' 之后：键或 '}'
+    key,            // 对象中逗号之后
+    colon,
+    comma_or_end,
+};
+
+const Reader = struct {
+    window: []const u8 = &.{},      // 正在解析的字节（调用方的输入块或 carry）
+    pos: usize = 0,
+    window_base: u64 = 0,           // window[0] 在整个输入流中的偏移
+    rest: []const u8 = &.{},        // window 是 carry 时，输入块中 carry 之后的部分
+    rest_base: u64 = 0,
+    in_carry: bool = false,
+    carry: std.ArrayListUnmanaged(u8) = .{},
+    carry_pending: bool = false,    // carry 中是一个还没结束的 token
+    fed: u64 = 0,                   // 已 feed 的总字节数
+    final: bool = false,
+
+    depth: usize = 0,
+    stack: [max_depth]u8 = undefined,   // '{' 或 '['
+    expect: Expect = .value,
+    skip_target: ?usize = null,
+    failed: bool = false,
+    error_offset: u64 = 0,
+
+    // 当前事件的值
+    value: []const u8 = &.{},
+    number: f64 = 0,
+    escaped: bool = false,
+};
+
+const allocator = std.heap.c_allocator;
+
+fn toHandle(ptr: *anyopaque) i64 {
+    return @bitCast(@intFromPtr(ptr));
+}
+
+fn fromHandle(handle: i64) ?*Reader {
+    if (handle == 0) return null;
+    const ptr_val: usize = @bitCast(handle);
+    return @ptrFromInt(ptr_val);
+}
+
+// ============================================================================
+// 扫描函数 - 16 字节一组的快速路径
+// ============================================================================
+
+const vec_len = 16;
+const Bytes = @Vector(vec_len, u8);
+const Mask = @Vector(vec_len, bool);
+const all_true: Mask = @splat(true);
+const all_false: Mask = @splat(false);
+
+fn isSpace(c: u8) bool {
+    return c == ' ' or c == '\n' or c == '\r' or c == '\t';
+}
+
+/// 返回 start 之后第一个非空白字符的位置
+fn skipWhitespace(bytes: []const u8, start: usize) usize {
+    var i = start;
+    // 紧凑的 JSON 中空白很短：先看一个字节，只有长串缩进才走向量路径
+    if (i < bytes.len and !isSpace(bytes[i])) return i;
+    while (i + vec_len <= bytes.len) : (i += vec_len) {
+        const chunk: Bytes = bytes[i..][0..vec_len].*;
+        const space = @select(bool, chunk == @as(Bytes, @splat(' ')), all_true, chunk == @as(Bytes, @splat('\n')));
+        const blank = @select(bool, space, all_true, @select(bool, chunk == @as(Bytes, @splat('\r')), all_true, chunk == @as(Bytes, @splat('\t'))));
+        if (std.simd.firstTrue(@select(bool, blank, all_false, all_true))) |offset| return i + offset;
+    }
+    while (i < bytes.len and isSpace(bytes[i])) i += 1;
+    return i;
+}
+
+/// 在字符串内容中查找结束引号，返回它的位置；bytes 中没有结束引号时返回 null
+/// start_escaped: 第一个字节前面是一个未配对的反斜杠（上一个输入块以 '\' 结尾）
+fn findStringEnd(bytes: []const u8, start_escaped: bool, saw_escape: *bool) ?usize {
+    var i: usize = 0;
+    if (start_escaped) {
+        saw_escape.* = true;
+        i = 1;
+    }
+    while (i < bytes.len) {
+        while (i + vec_len <= bytes.len) {
+            const chunk: Bytes = bytes[i..][0..vec_len].*;
+            const special = @select(bool, chunk == @as(Bytes, @splat('"')), all_true, chunk == @as(Bytes, @splat('\\')));
+            if (std.simd.firstTrue(special)) |offset| {
+                i += offset;
+                break;
+            }
+            i += vec_len;
+        }
+        if (i >= bytes.len) return null;
+        switch (bytes[i]) {
+            '"' => return i,
+            '\\' => {
+                saw_escape.* = true;
+                i += 2;
+            },
+            else => i += 1,
+        }
+    }
+    return null;
+}
+
+/// 数字和 true / false / null 可能包含的字符
+fn isAtomChar(c: u8) bool {
+    return std.ascii.isAlphanumeric(c) or c == '-' or c == '+' or c == '.';
+}
+
+fn findAtomEnd(bytes: []const u8, start: usize) ?usize {
+    var i = start;
+    while (i < bytes.len) : (i += 1) {
+        if (!isAtomChar(bytes[i])) return i;
+    }
+    return null;
+}
+
+/// -?(0|[1-9][0-9]*)(\.[0-9]+)?([eE][+-]?[0-9]+)?
+fn isJsonNumber(text: []const u8) bool {
+    var i: usize = 0;
+    if (i < text.len and text[i] == '-') i += 1;
+    if (i >= text.len) return false;
+    if (text[i] == '0') {
+        i += 1;
+    } else {
+        if (!std.ascii.isDigit(text[i])) return false;
+        while (i < text.len and std.ascii.isDigit(text[i])) i += 1;
+    }
+    if (i < text.len and text[i] == '.') {
+        i += 1;
+        const digits = i;
+        while (i < text.len and std.ascii.isDigit(text[i])) i += 1;
+        if (i == digits) return false;
+    }
+    if (i < text.len and (text[i] == 'e' or text[i] == 'E')) {
+        i += 1;
+        if (i < text.len and (text[i] == '+' or text[i] == '-')) i += 1;
+        const digits = i;
+        while (i < text.len and std.ascii.isDigit(text[i])) i += 1;
+        if (i == digits) return false;
+    }
+    return i == text.len;
+}
+
+// ============================================================================
+// 解析
+// ============================================================================
+
+fn fail(r: *Reader) Event {
+    r.failed = true;
+    r.error_offset = r.window_base + r.pos;
+    return .syntax_error;
+}
+
+fn afterValue(r: *Reader) void {
+    r.expect = if (r.depth == 0) .value else .comma_or_end;
+}
+
+fn open(r: *Reader, kind: u8) Event {
+    if (r.depth == max_depth) return fail(r);
+    r.stack[r.depth] = kind;
+    r.depth += 1;
+    r.pos += 1;
+    r.expect = if (kind == '{') .first_key else .first_value;
+    return if (kind == '{') .object_start else .array_start;
+}
+
+fn close(r: *Reader, kind: u8) Event {
+    if (r.depth == 0 or r.stack[r.depth - 1] != kind) return fail(r);
+    r.depth -= 1;
+    r.pos += 1;
+    afterValue(r);
+    return if (kind == '{') .object_end else .array_end;
+}
+
+/// 输入在 token 中间结束：把 token 的已有部分移到 carry，等待下一块输入
+fn suspendToken(r: *Reader, start: usize) Event {
+    const partial = r.window[start..];
+    if (r.in_carry) {
+        // window 就是 carry：去掉前面已经解析过的部分
+        std.mem.copyForwards(u8, r.carry.items[0..partial.len], partial);
+        r.carry.shrinkRetainingCapacity(partial.len);
+    } else {
+        r.carry.clearRetainingCapacity();
+        r.carry.appendSlice(allocator, partial) catch return fail(r);
+    }
+    r.window_base += start;
+    r.window = &.{};
+    r.pos = 0;
+    r.in_carry = false;
+    r.carry_pending = true;
+    return .need_more;
+}
+
+/// 当前 window 之后没有更多输入
+fn atEndOfInput(r: *const Reader) bool {
+    return r.final and (!r.in_carry or r.rest.len == 0);
+}
+
+fn step(r: *Reader) Event {
+    while (true) {
+        r.pos = skipWhitespace(r.window, r.pos);
+        if (r.pos < r.window.len) {
+            const c = r.window[r.pos];
+            switch (r.expect) {
+                .colon => {
+                    if (c != ':') return fail(r);
+                    r.pos += 1;
+                    r.expect = .value;
+                    continue;
+                },
+                .comma_or_end => {
+                    const top = r.stack[r.depth - 1];
+                    if (c == ',') {
+                        r.pos += 1;
+                        r.expect = if (top == '{') .key else .value;
+                        continue;
+                    }
+                    if (c == '}' or c == ']') return close(r, if (c == '}') '{' else '[');
+                    return fail(r);
+                },
+                .first_key, .key => {
+                    if (c == '}' and r.expect == .first_key) return close(r, '{');
+                    if (c != '"') return fail(r);
+                    return scanString(r, .key);
+                },
+                .first_value, .value => {
+                    if (c == ']' and r.expect == .first_value) return close(r, '[');
+                    return switch (c) {
+                        '{' => open(r, '{'),
+                        '[' => open(r, '['),
+                        '"' => scanString(r, .string),
+                        '-', '0'...'9', 't', 'f', 'n' => scanAtom(r),
+                        else => fail(r),
+                    };
+                },
+            }
+        }
+
+        // window 用完了
+        if (r.in_carry) {
+            // carry 中的 token 已在上一次调用中返回，接着解析输入块的剩余部分
+            r.carry.clearRetainingCapacity();
+            r.in_carry = false;
+            r.window = r.rest;
+            r.window_base = r.rest_base;
+            r.rest = &.{};
+            r.pos = 0;
+            continue;
+        }
+        if (!r.final) return .need_more;
+        if (r.carry_pending) return fail(r);
+        if (r.depth == 0 and r.expect == .value) return .end;
+        return fail(r);
+    }
+}
+
+fn scanString(r: *Reader, event: Event) Event {
+    const start = r.pos;
+    var saw_escape = false;
+    const content = r.window[start + 1 ..];
+    const end = findStringEnd(content, false, &saw_escape) orelse {
+        if (atEndOfInput(r)) return fail(r);
+        return suspendToken(r, start);
+    };
+    r.value = content[0..end];
+    r.escaped = saw_escape;
+    r.pos = start + 1 + end + 1;
+    if (event == .key) {
+        r.expect = .colon;
+    } else {
+        afterValue(r);
+    }
+    return event;
+}
+
+fn scanAtom(r: *Reader) Event {
+    const start = r.pos;
+    const end = findAtomEnd(r.window, start) orelse blk: {
+        if (!atEndOfInput(r)) return suspendToken(r, start);
+        break :blk r.window.len;
+    };
+    const text = r.window[start..end];
+    r.value = text;
+    r.escaped = false;
+    r.pos = end;
+
+    const event: Event = if (std.mem.eql(u8, text, "true"))
+        .true_value
+    else if (std.mem.eql(u8, text, "false"))
+        .false_value
+    else if (std.mem.eql(u8, text, "null"))
+        .null_value
+    else if (isJsonNumber(text)) blk: {
+        r.number = std.fmt.parseFloat(f64, text) catch {
+            r.pos = start;
+            return fail(r);
+        };
+        break :blk .number;
+    } else {
+        r.pos = start;
+        return fail(r);
+    };
+    afterValue(r);
+    return event;
+}
+
+// ============================================================================
+// C ABI 导出
+// ============================================================================
+
+/// 创建读取器
+/// 返回: 句柄，内存不足时返回 0
+export fn paw_json_reader_new() i64 {
+    const reader = allocator.create(Reader) catch return 0;
+    reader.* = .{};
+    return toHandle(reader);
+}
+
+/// 提供下一块输入（应在 paw_json_next 返回 0 之后调用，或在第一次调用之前）
+/// 数据不会被复制（跨块的那个 token 除外），在下一次返回 0 之前调用方必须保持它有效
+export fn paw_json_reader_feed(handle: i64, data: i64, len: i64) void {
+    const r = fromHandle(handle) orelse return;
+    if (data == 0 or len <= 0) return;
+    const ptr: [*]const u8 = @ptrFromInt(@as(usize, @bitCast(data)));
+    feed(r, ptr[0..@intCast(len)]);
+}
+
+/// 以 '\0' 结尾的字符串作为下一块输入
+export fn paw_json_reader_feed_string(handle: i64, s: ?[*:0]const u8) void {
+    const r = fromHandle(handle) orelse return;
+    const str = s orelse return;
+    feed(r, std.mem.span(str));
+}
+
+fn feed(r: *Reader, chunk: []const u8) void {
+    const chunk_base = r.fed;
+    r.fed += chunk.len;
+
+    // 还有没解析的字节（调用方没有等到 0 就 feed）：全部拼到 carry 中
+    if (r.pos < r.window.len or r.rest.len > 0) {
+        const unread = r.window[r.pos..];
+        const rest = r.rest;
+        var joined = std.ArrayListUnmanaged(u8){};
+        joined.ensureTotalCapacity(allocator, unread.len + rest.len + chunk.len) catch {
+            r.failed = true;
+            return;
+        };
+        joined.appendSliceAssumeCapacity(unread);
+        joined.appendSliceAssumeCapacity(rest);
+        joined.appendSliceAssumeCapacity(chunk);
+        r.carry.deinit(allocator);
+        r.carry = joined;
+        r.window_base += r.pos;
+        r.window = r.carry.items;
+        r.pos = 0;
+        r.rest = &.{};
+        r.in_carry = true;
+        return;
+    }
+
+    if (!r.carry_pending) {
+        r.window = chunk;
+        r.window_base = chunk_base;
+        r.pos = 0;
+        return;
+    }
+
+    // carry 中有未结束的 token：只把能让它结束的那一段接上，其余部分直接在输入块中解析
+    const partial = r.carry.items;
+    const end: ?usize = if (partial[0] == '"') blk: {
+        var trailing: usize = 0;
+        while (trailing + 1 < partial.len and partial[partial.len - 1 - trailing] == '\\') trailing += 1;
+        var saw_escape = false;
+        const quote = findStringEnd(chunk, trailing % 2 == 1, &saw_escape) orelse break :blk null;
+        break :blk quote + 1;
+    } else findAtomEnd(chunk, 0);
+
+    const take = end orelse chunk.len;
+    r.carry.appendSlice(allocator, chunk[0..take]) catch {
+        r.failed = true;
+        return;
+    };
+    if (end == null and !r.final) return;  // 仍未结束，等待下一块
+
+    r.carry_pending = false;
+    r.window = r.carry.items;
+    r.pos = 0;
+    r.rest = chunk[take..];
+    r.rest_base = chunk_base + take;
+    r.in_carry = true;
+}
+
+/// 不再有输入：末尾的数字 / 字面量按结束处理，未闭合的容器报错
+export fn paw_json_reader_finish(handle: i64) void {
+    const r = fromHandle(handle) orelse return;
+    r.final = true;
+    if (r.carry_pending) {
+        // carry 中的 token 就是输入的最后一个 token
+        r.carry_pending = r.carry.items.len > 0 and r.carry.items[0] == '"';
+        if (!r.carry_pending) {
+            r.window = r.carry.items;
+            r.pos = 0;
+            r.rest = &.{};
+            r.in_carry = true;
+        }
+    }
+}
+
+/// 解析下一个事件（见 Event）
+export fn paw_json_next(handle: i64) i32 {
+    const r = fromHandle(handle) orelse return @intFromEnum(Event.syntax_error);
+    return @intFromEnum(next(r));
+}
+
+fn next(r: *Reader) Event {
+    if (r.failed) return .syntax_error;
+    while (true) {
+        const event = step(r);
+        const target = r.skip_target orelse return event;
+        switch (event) {
+            .need_more, .end, .syntax_error => return event,
+            else => {},
+        }
+        // 跳过的值结束时深度回到 target
+        if (r.depth == target) r.skip_target = null;
+    }
+}
+
+/// 跳过刚开始的对象 / 数组（或刚读到的键所对应的值），下一次 paw_json_next 返回它之后的事件
+export fn paw_json_skip(handle: i64, event: i32) void {
+    const r = fromHandle(handle) orelse return;
+    if (r.depth == 0) return;
+    r.skip_target = switch (event) {
+        @intFromEnum(Event.object_start), @intFromEnum(Event.array_start) => r.depth - 1,
+        @intFromEnum(Event.key) => r.depth,
+        else => return,
+    };
+}
+
+/// 当前的嵌套深度（对象 / 数组开始之后加 1）
+export fn paw_json_depth(handle: i64) i32 {
+    const r = fromHandle(handle) orelse return 0;
+    return @intCast(r.depth);
+}
+
+/// 当前键 / 字符串 / 数字的原始文本（借用，下一次 paw_json_next 或 feed 后失效）
+export fn paw_json_value_ptr(handle: i64) i64 {
+    const r = fromHandle(handle) orelse return 0;
+    return @bitCast(@intFromPtr(r.value.ptr));
+}
+
+export fn paw_json_value_len(handle: i64) i64 {
+    const r = fromHandle(handle) orelse return 0;
+    return @intCast(r.value.len);
+}
+
+/// 当前数字事件的值
+export fn paw_json_value_number(handle: i64) f64 {
+    const r = fromHandle(handle) orelse return 0;
+    return r.number;
+}
+
+/// 当前键 / 字符串是否等于 s（比较原始文本，不复制；含转义的值按转义前的文本比较）
+export fn paw_json_value_equals(handle: i64, s: ?[*:0]const u8) bool {
+    const r = fromHandle(handle) orelse return false;
+    const str = s orelse return false;
+    return std.mem.eql(u8, r.value, std.mem.span(str));
+}
+
+/// 把当前键 / 字符串复制出来并解码转义，分配在 arena 中（0 = 堆，用 paw_free 释放）
+/// 返回: '\0' 结尾的字符串，内存不足时返回 null
+export fn paw_json_value_string(handle: i64, arena: i64) ?[*:0]u8 {
+    const r = fromHandle(handle) orelse return null;
+    const raw = memory.paw_arena_alloc(arena, @intCast(r.value.len + 1));
+    if (raw == 0) return null;
+    const dest: [*]u8 = @ptrFromInt(@as(usize, @bitCast(raw)));
+    const len = if (r.escaped) unescape(r.value, dest) else blk: {
+        @memcpy(dest[0..r.value.len], r.value);
+        break :blk r.value.len;
+    };
+    dest[len] = 0;
+    return @ptrCast(dest);
+}
+
+/// 解码 JSON 转义（输出不会比输入长）；无效的转义原样保留
+fn unescape(src: []const u8, dest: [*]u8) usize {
+    var i: usize = 0;
+    var out: usize = 0;
+    while (i < src.len) {
+        if (src[i] != '\\' or i + 1 >= src.len) {
+            dest[out] = src[i];
+            out += 1;
+            i += 1;
+            continue;
+        }
+        const simple: ?u8 = switch (src[i + 1]) {
+            '"' => '"',
+            '\\' => '\\',
+            '/' => '/',
+            'b' => 0x08,
+            'f' => 0x0c,
+            'n' => '\n',
+            'r' => '\r',
+            't' => '\t',
+            else => null,
+        };
+        if (simple) |c| {
+            dest[out] = c;
+            out += 1;
+            i += 2;
+            continue;
+        }
+        if (src[i + 1] == 'u') {
+            if (decodeUnicodeEscape(src[i..])) |decoded| {
+                out += std.unicode.utf8Encode(decoded.codepoint, dest[out..][0..4]) catch 0;
+                i += decoded.consumed;
+                continue;
+            }
+        }
+        dest[out] = src[i];
+        out += 1;
+        i += 1;
+    }
+    return out;
+}
+
+const Decoded = struct { codepoint: u21, consumed: usize };
+
+/// \uXXXX（以及 😀 这样的代理对）
+fn decodeUnicodeEscape(src: []const u8) ?Decoded {
+    if (src.len < 6) return null;
+    const high = std.fmt.parseInt(u16, src[2..6], 16) catch return null;
+    if (high >= 0xD800 and high < 0xDC00) {
+        if (src.len < 12 or src[6] != '\\' or src[7] != 'u') return null;
+        const low = std.fmt.parseInt(u16, src[8..12], 16) catch return null;
+        if (low < 0xDC00 or low >= 0xE000) return null;
+        const codepoint = 0x10000 + ((@as(u21, high) - 0xD800) << 10) + (@as(u21, low) - 0xDC00);
+        return .{ .codepoint = codepoint, .consumed = 12 };
+    }
+    if (high >= 0xDC00 and high < 0xE000) return null;
+    return .{ .codepoint = high, .consumed = 6 };
+}
+
+/// 语法错误在输入流中的字节偏移（没有错误时为 -1）
+export fn paw_json_error_offset(handle: i64) i64 {
+    const r = fromHandle(handle) orelse return -1;
+    if (!r.failed) return -1;
+    return @intCast(r.error_offset);
+}
+
+export fn paw_json_reader_free(handle: i64) void {
+    const r = fromHandle(handle) orelse return;
+    r.carry.deinit(allocator);
+    allocator.destroy(r);
+}
+
+// ============================================================================
+// 测试
+// ============================================================================
+
+fn expectEvents(handle: i64, expected: []const Event) !void {
+    for (expected) |event| {
+        try std.testing.expectEqual(@intFromEnum(event), paw_json_next(handle));
+    }
+}
+
+test "Pull events for a whole document" {
+    const h = paw_json_reader_new();
+    defer paw_json_reader_free(h);
+    paw_json_reader_feed_string(h, "{\"name\": \"paw\", \"tags\": [1, -2.5e1, true, null], \"ok\": false}");
+    paw_json_reader_finish(h);
+
+    try expectEvents(h, &.{ .object_start, .key });
+    try std.testing.expect(paw_json_value_equals(h, "name"));
+    try expectEvents(h, &.{.string});
+    try std.testing.expect(paw_json_value_equals(h, "paw"));
+    try expectEvents(h, &.{ .key, .array_start, .number });
+    try std.testing.expectEqual(@as(f64, 1), paw_json_value_number(h));
+    try expectEvents(h, &.{.number});
+    try std.testing.expectEqual(@as(f64, -25), paw_json_value_number(h));
+    try expectEvents(h, &.{ .true_value, .null_value, .array_end, .key, .false_value, .object_end, .end });
+}
+
+test "Tokens split across chunks" {
+    const h = paw_json_reader_new();
+    defer paw_json_reader_free(h);
+    const chunks = [_][:0]const u8{ "[\"hel", "lo\\", "\"x\", 12", "34, tr", "ue]" };
+    var events = std.ArrayList(Event){};
+    defer events.deinit(std.testing.allocator);
+    var strings = std.ArrayList(u8){};
+    defer strings.deinit(std.testing.allocator);
+
+    for (chunks) |chunk| {
+        paw_json_reader_feed_string(h, chunk);
+        while (true) {
+            const event: Event = @enumFromInt(paw_json_next(h));
+            if (event == .need_more) break;
+            try events.append(std.testing.allocator, event);
+            if (event == .string) {
+                const copy = paw_json_value_string(h, 0).?;
+                defer std.c.free(copy);
+                try strings.appendSlice(std.testing.allocator, std.mem.span(copy));
+            }
+            if (event == .number) try std.testing.expectEqual(@as(f64, 1234), paw_json_value_number(h));
+        }
+    }
+    paw_json_reader_finish(h);
+    try std.testing.expectEqual(@intFromEnum(Event.end), paw_json_next(h));
+    try std.testing.expectEqualSlices(Event, &.{ .array_start, .string, .number, .true_value, .array_end }, events.items);
+    try std.testing.expectEqualStrings("hello\"x", strings.items);
+}
+
+test "Skip nested values and NDJSON" {
+    const h = paw_json_reader_new();
+    defer paw_json_reader_free(h);
+    paw_json_reader_feed_string(h, "{\"big\": {\"a\": [1, {\"b\": 2}]}, \"id\": 7}\n{\"id\": 8}\n");
+    paw_json_reader_finish(h);
+
+    try expectEvents(h, &.{ .object_start, .key });
+    paw_json_skip(h, @intFromEnum(Event.key));
+    try expectEvents(h, &.{ .key, .number });
+    try std.testing.expectEqual(@as(f64, 7), paw_json_value_number(h));
+    try expectEvents(h, &.{ .object_end, .object_start });
+    paw_json_skip(h, @intFromEnum(Event.object_start));
+    try expectEvents(h, &.{.end});
+}
+
+test "Syntax errors report an offset" {
+    const h = paw_json_reader_new();
+    defer paw_json_reader_free(h);
+    paw_json_reader_feed_string(h, "[1, 01]");
+    paw_json_reader_finish(h);
+    try expectEvents(h, &.{ .array_start, .number, .syntax_error });
+    try std.testing.expectEqual(@as(i64, 4), paw_json_error_offset(h));
+}
+
+test "Unicode escapes" {
+    const h = paw_json_reader_new();
+    defer paw_json_reader_free(h);
+    paw_json_reader_feed_string(h, "\"caf\\u00e9 \\ud83d\\ude00\"");
+    paw_json_reader_finish(h);
+    try expectEvents(h, &.{.string});
+    const copy = paw_json_value_string(h, 0).?;
+    defer std.c.free(copy);
+    try std.testing.expectEqualStrings("café 😀", std.mem.span(copy));
+}
@@ -2,6 +2,13 @@
 //! 
 //! 为 PawLang 提供最小的动态内存支持
 //! 只暴露 malloc、free 等基础函数，让 Paw 层实现 Vec<T> 等数据结构
+//!
+//! 🆕 v0.2.0: 另外提供两种专用分配器（Paw 侧声明见 prelude）：
+//!   - arena：按顺序切分大块内存，整体 reset / free（请求级数据、JSON 树）
+//!   - pool ：16~512 字节的定长大小类，每个线程一条空闲链表，分配/释放不加锁
+//!
+//! 运行时的任务调度器（thread.zig）会在多个线程上执行 Paw 代码：paw_malloc 和内存池
+//! 在任何线程都可以使用；arena 默认只属于一个线程，跨线程共享时用 paw_arena_new_shared。
 
 const std = @import("std");
 
@@ -27,13 +34,24 @@ export fn paw_free(ptr: i64) void {
     std.c.free(actual_ptr);
 }
 
+/// 🆕 v0.2.0: 重新分配内存（保留前 min(旧大小, size) 字节）
+/// 参数: ptr - 原指针（0 时等同于 paw_malloc），size - 新的字节数
+/// 返回: 新指针；失败时返回 0，原内存保持不变
+export fn paw_realloc(ptr: i64, size: usize) i64 {
+    const old_ptr: ?*anyopaque = if (ptr == 0) null else @ptrFromInt(@as(usize, @bitCast(ptr)));
+    const new_ptr = std.c.realloc(old_ptr, size) orelse return 0;
+    const ptr_val: usize = @intFromPtr(new_ptr);
+    return @bitCast(ptr_val);
+}
+
 /// 内存清零
-/// 参数: ptr - 指针，size - 字节数
-export fn paw_memset(ptr: i64, value: u8, size: usize) void {
+/// 参数: ptr - 指针，value - 填充的字节（取低 8 位），size - 字节数
+/// 🆕 v0.2.0: value 按 i32 传递（Paw 的整数参数默认是 i32，避免调用方不做零扩展）
+export fn paw_memset(ptr: i64, value: i32, size: usize) void {
     if (ptr == 0) return;
     const ptr_val: usize = @bitCast(ptr);
     const actual_ptr: [*]u8 = @ptrFromInt(ptr_val);
-    @memset(actual_ptr[0..size], value);
+    @memset(actual_ptr[0..size], @truncate(@as(u32, @bitCast(value))));
 }
 
 /// 内存复制
@@ -83,6 +101,510 @@ export fn paw_read_f64(ptr: i64, offset: i32) f64 {
     return actual_ptr[@intCast(offset)];
 }
 
+/// 🆕 v0.2.0: 写入 i64 到指针
+export fn paw_write_i64(ptr: i64, offset: i32, value: i64) void {
+    if (ptr == 0) return;
+    const ptr_val: usize = @bitCast(ptr);
+    const actual_ptr: [*]i64 = @ptrFromInt(ptr_val);
+    actual_ptr[@intCast(offset)] = value;
+}
+
+/// 🆕 v0.2.0: 从指针读取 i64
+export fn paw_read_i64(ptr: i64, offset: i32) i64 {
+    if (ptr == 0) return 0;
+    const ptr_val: usize = @bitCast(ptr);
+    const actual_ptr: [*]i64 = @ptrFromInt(ptr_val);
+    return actual_ptr[@intCast(offset)];
+}
+
+/// 🆕 v0.2.0: 写入 f32 到指针
+export fn paw_write_f32(ptr: i64, offset: i32, value: f32) void {
+    if (ptr == 0) return;
+    const ptr_val: usize = @bitCast(ptr);
+    const actual_ptr: [*]f32 = @ptrFromInt(ptr_val);
+    actual_ptr[@intCast(offset)] = value;
+}
+
+/// 🆕 v0.2.0: 从指针读取 f32
+export fn paw_read_f32(ptr: i64, offset: i32) f32 {
+    if (ptr == 0) return 0.0;
+    const ptr_val: usize = @bitCast(ptr);
+    const actual_ptr: [*]f32 = @ptrFromInt(ptr_val);
+    return actual_ptr[@intCast(offset)];
+}
+
+// ============================================================================
+// 🆕 v0.2.0: Arena 分配器
+// ============================================================================
+//
+// 一次请求中创建的对象（例如整棵 JSON 树）从 arena 的当前块中按顺序切分，
+// 请求结束时 paw_arena_reset（保留最大的块给下一次请求）或 paw_arena_free
+// 一次性释放，不再逐个节点调用 free。
+//
+// 句柄 0 表示"不使用 arena"：paw_arena_alloc(0, n) 等同于 paw_malloc(n)，
+// reset / free 对 0 什么都不做。标准库容器用同一条代码路径支持两种模式。
+//
+// paw_arena_new 创建的 arena 只能在一个线程中使用（不加锁）；多个任务向同一个 arena
+// 分配时（例如 parallel_for 的各个分块共同构建结果）用 paw_arena_new_shared，
+// 它的每个操作都在 arena 自己的锁内完成。
+
+/// arena 返回的内存按 16 字节对齐（与 malloc 一致，可以存放任何 Paw 值）
+const arena_alignment = 16;
+/// 第一个块的大小；之后每个新块翻倍，直到 arena_max_chunk
+const arena_first_chunk = 8 * 1024;
+const arena_max_chunk = 1024 * 1024;
+
+const ArenaChunk = struct {
+    prev: ?*ArenaChunk,
+    capacity: usize,  // 块头之后的可用字节数
+    used: usize,
+
+    const header_size = std.mem.alignForward(usize, @sizeOf(ArenaChunk), arena_alignment);
+
+    fn data(self: *ArenaChunk) [*]u8 {
+        const base: [*]u8 = @ptrCast(self);
+        return base + header_size;
+    }
+};
+
+const Arena = struct {
+    chunk: ?*ArenaChunk,  // 当前块（链表头，prev 指向更早的块）
+    next_capacity: usize,
+    shared: bool,
+    mutex: std.Thread.Mutex = .{},
+
+    fn lock(self: *Arena) void {
+        if (self.shared) self.mutex.lock();
+    }
+
+    fn unlock(self: *Arena) void {
+        if (self.shared) self.mutex.unlock();
+    }
+};
+
+fn toHandle(ptr: *anyopaque) i64 {
+    return @bitCast(@intFromPtr(ptr));
+}
+
+fn fromHandle(comptime T: type, handle: i64) ?*T {
+    if (handle == 0) return null;
+    const ptr_val: usize = @bitCast(handle);
+    return @ptrFromInt(ptr_val);
+}
+
+/// 创建 arena（不预先分配内存，第一次 alloc 时才申请第一个块）
+/// 返回: arena 句柄，内存不足时返回 0
+export fn paw_arena_new() i64 {
+    return newArena(false);
+}
+
+/// 🆕 v0.2.0: 创建可以被多个线程同时使用的 arena（alloc / reset / used 加锁）
+export fn paw_arena_new_shared() i64 {
+    return newArena(true);
+}
+
+fn newArena(shared: bool) i64 {
+    const raw = std.c.malloc(@sizeOf(Arena)) orelse return 0;
+    const arena: *Arena = @ptrCast(@alignCast(raw));
+    arena.* = .{ .chunk = null, .next_capacity = arena_first_chunk, .shared = shared };
+    return toHandle(arena);
+}
+
+/// 从 arena 分配 size 字节（16 字节对齐）
+/// 返回: 指针，内存不足时返回 0；arena 为 0 时等同于 paw_malloc
+pub export fn paw_arena_alloc(handle: i64, size: i64) i64 {
+    if (size < 0) return 0;
+    const arena = fromHandle(Arena, handle) orelse return paw_malloc(@intCast(size));
+    arena.lock();
+    defer arena.unlock();
+    return arenaAlloc(arena, @intCast(size));
+}
+
+fn arenaAlloc(arena: *Arena, size: usize) i64 {
+    const bytes = std.mem.alignForward(usize, @max(size, 1), arena_alignment);
+
+    if (arena.chunk) |chunk| {
+        if (chunk.capacity - chunk.used >= bytes) return bumpChunk(chunk, bytes);
+    }
+
+    // 超过下一个块大小的请求单独占一个块，插在当前块后面，当前块的剩余空间继续使用
+    if (bytes > arena.next_capacity and arena.chunk != null) {
+        const head = arena.chunk.?;
+        const chunk = allocChunk(bytes, head.prev) orelse return 0;
+        head.prev = chunk;
+        return bumpChunk(chunk, bytes);
+    }
+
+    const chunk = allocChunk(@max(bytes, arena.next_capacity), arena.chunk) orelse return 0;
+    arena.chunk = chunk;
+    arena.next_capacity = @min(arena.next_capacity * 2, arena_max_chunk);
+    return bumpChunk(chunk, bytes);
+}
+
+fn allocChunk(capacity: usize, prev: ?*ArenaChunk) ?*ArenaChunk {
+    const raw = std.c.malloc(ArenaChunk.header_size + capacity) orelse return null;
+    const chunk: *ArenaChunk = @ptrCast(@alignCast(raw));
+    chunk.* = .{ .prev = prev, .capacity = capacity, .used = 0 };
+    return chunk;
+}
+
+fn bumpChunk(chunk: *ArenaChunk, bytes: usize) i64 {
+    const ptr = chunk.data() + chunk.used;
+    chunk.used += bytes;
+    return toHandle(ptr);
+}
+
+/// 释放 arena 中分配的所有对象，但保留最大的块，下一轮分配不必再向系统申请内存
+export fn paw_arena_reset(handle: i64) void {
+    const arena = fromHandle(Arena, handle) orelse return;
+    arena.lock();
+    defer arena.unlock();
+    var largest: ?*ArenaChunk = null;
+    var chunk = arena.chunk;
+    while (chunk) |current| {
+        chunk = current.prev;
+        if (largest == null or current.capacity > largest.?.capacity) {
+            if (largest) |previous| std.c.free(previous);
+            largest = current;
+        } else {
+            std.c.free(current);
+        }
+    }
+    if (largest) |kept| {
+        kept.prev = null;
+        kept.used = 0;
+    }
+    arena.chunk = largest;
+}
+
+/// 释放 arena 的全部内存和 arena 本身
+export fn paw_arena_free(handle: i64) void {
+    const arena = fromHandle(Arena, handle) orelse return;
+    var chunk = arena.chunk;
+    while (chunk) |current| {
+        chunk = current.prev;
+        std.c.free(current);
+    }
+    std.c.free(arena);
+}
+
+/// 已从 arena 分配出去的字节数（包括对齐填充）
+export fn paw_arena_used(handle: i64) i64 {
+    const arena = fromHandle(Arena, handle) orelse return 0;
+    arena.lock();
+    defer arena.unlock();
+    var total: usize = 0;
+    var chunk = arena.chunk;
+    while (chunk) |current| : (chunk = current.prev) {
+        total += current.used;
+    }
+    return @intCast(total);
+}
+
+/// 把 s[start..start+len] 复制到 arena 中，返回以 0 结尾的新字符串
+/// 用于从输入中切出子串（例如 JSON 字符串值），随 arena 一起释放
+export fn paw_arena_substring(handle: i64, s: ?[*]const u8, start: i32, len: i32) ?[*:0]u8 {
+    const source = s orelse return null;
+    if (start < 0 or len < 0) return null;
+    const count: usize = @intCast(len);
+    const ptr = fromHandle(u8, paw_arena_alloc(handle, len + 1)) orelse return null;
+    const dest: [*]u8 = @ptrCast(ptr);
+    @memcpy(dest[0..count], source[@intCast(start)..][0..count]);
+    dest[count] = 0;
+    return @ptrCast(dest);
+}
+
+// ============================================================================
+// 🆕 v0.2.0: 定长大小类内存池
+// ============================================================================
+//
+// 小对象（链表 / 树节点、短字符串）按 16/32/64/128/256/512 字节分成六个大小类。
+// 每个线程为每个大小类维护一条空闲链表（threadlocal），分配和释放都不加锁；
+// 链表为空时先从全局仓库（depot）取回一批块，仓库也为空时从一个新的 64 KiB slab 中切出一批。
+//
+// 释放时调用方传回分配时的大小（Paw 侧总是知道对象的大小），据此找到大小类。
+// 在其它线程释放的块进入释放线程自己的链表；链表超过两批时把一批交还仓库，
+// 这样一个线程分配、另一个线程释放的块可以循环使用，不会堆积在释放的一侧。
+// slab 不归还给系统，进程退出时统一回收。超过 512 字节的请求直接交给 malloc / free。
+
+pub const pool_size_classes = [_]usize{ 16, 32, 64, 128, 256, 512 };
+const pool_slab_size = 64 * 1024;
+
+const FreeBlock = struct {
+    next: ?*FreeBlock,
+    next_batch: ?*FreeBlock,  // 只在仓库中每一批的第一个块上有效
+};
+
+const PoolCache = struct {
+    head: ?*FreeBlock = null,
+    count: usize = 0,
+};
+
+const PoolDepot = struct {
+    mutex: std.Thread.Mutex = .{},
+    batches: ?*FreeBlock = null,
+};
+
+threadlocal var pool_caches: [pool_size_classes.len]PoolCache = [_]PoolCache{.{}} ** pool_size_classes.len;
+var pool_depots: [pool_size_classes.len]PoolDepot = [_]PoolDepot{.{}} ** pool_size_classes.len;
+
+fn sizeClass(size: usize) ?usize {
+    for (pool_size_classes, 0..) |class_size, index| {
+        if (size <= class_size) return index;
+    }
+    return null;
+}
+
+/// 线程与仓库之间一次移动的块数（半个 slab）
+fn batchSize(class: usize) usize {
+    return pool_slab_size / pool_size_classes[class] / 2;
+}
+
+/// 分配 size 字节（16 字节对齐）；size <= 0 或内存不足时返回 0
+export fn paw_pool_alloc(size: i64) i64 {
+    if (size <= 0) return 0;
+    const class = sizeClass(@intCast(size)) orelse return paw_malloc(@intCast(size));
+    const cache = &pool_caches[class];
+    if (cache.head == null and !refillPool(class)) return 0;
+    const block = cache.head.?;
+    cache.head = block.next;
+    cache.count -= 1;
+    return toHandle(block);
+}
+
+/// 释放 paw_pool_alloc 分配的内存；size 必须与分配时相同（可以在任何线程释放）
+export fn paw_pool_free(ptr: i64, size: i64) void {
+    if (ptr == 0 or size <= 0) return;
+    const class = sizeClass(@intCast(size)) orelse return paw_free(ptr);
+    const block = fromHandle(FreeBlock, ptr).?;
+    const cache = &pool_caches[class];
+    block.next = cache.head;
+    cache.head = block;
+    cache.count += 1;
+    if (cache.count > 2 * batchSize(class)) releaseBatch(class);
+}
+
+/// 把空闲链表头部的一批块交还仓库
+fn releaseBatch(class: usize) void {
+    const cache = &pool_caches[class];
+    const batch = batchSize(class);
+    const first = cache.head.?;
+    var last = first;
+    for (1..batch) |_| last = last.next.?;
+    cache.head = last.next;
+    cache.count -= batch;
+    last.next = null;
+
+    const depot = &pool_depots[class];
+    depot.mutex.lock();
+    defer depot.mutex.unlock();
+    first.next_batch = depot.batches;
+    depot.batches = first;
+}
+
+/// 补充当前线程的空闲链表：优先从仓库取回一批，
+/// 否则从新 slab 中切出一批块（按地址递增的顺序分配出去）
+fn refillPool(class: usize) bool {
+    const cache = &pool_caches[class];
+    const depot = &pool_depots[class];
+    depot.mutex.lock();
+    const batch = depot.batches;
+    if (batch) |first| depot.batches = first.next_batch;
+    depot.mutex.unlock();
+    if (batch) |first| {
+        cache.head = first;
+        cache.count = batchSize(class);
+        return true;
+    }
+
+    const raw = std.c.malloc(pool_slab_size) orelse return false;
+    const slab: [*]u8 = @ptrCast(raw);
+    const block_size = pool_size_classes[class];
+    var index = pool_slab_size / block_size;
+    cache.count = index;
+    while (index > 0) {
+        index -= 1;
+        const block: *FreeBlock = @ptrCast(@alignCast(slab + index * block_size));
+        block.next = cache.head;
+        cache.head = block;
+    }
+    return true;
+}
+
+// ============================================================================
+// 🆕 v0.2.0: 批量 / SIMD 内核
+// ============================================================================
+//
+// 逐元素的 paw_read_* / paw_write_* 每次都是一次跨库的函数调用（编译器会把
+// prelude 中的这几个访问器直接内联为 load / store，但循环本身仍是标量的）。
+// 对整段缓冲区的操作改为一次调用这里的批量函数，内部用 @Vector 按目标机器的
+// SIMD 宽度处理。
+//
+// 每种元素类型（后缀 _i32 / _i64 / _f32 / _f64）导出：
+//   paw_fill_<T>(ptr, value, count)          把 count 个元素设为 value
+//   paw_find_<T>(ptr, count, value) -> i64   第一个等于 value 的下标，没有时返回 -1
+//   paw_sum_<T>(ptr, count)                  求和
+//   paw_min_<T> / paw_max_<T>(ptr, count)    最小 / 最大值（count 为 0 时返回 0）
+//   paw_dot_<T>(a, b, count)                 点积
+// 整数的 sum / dot 用 i64 累加并返回 i64（回绕而不是溢出）；浮点按 SIMD 通道分组
+// 累加，结果可能与顺序累加在最后几位上不同。
+//
+// 与元素类型无关的按字节操作：paw_memmove（允许重叠）、paw_memcmp。
+// 所有函数对空指针或 count <= 0 都什么也不做（查找返回 -1，归约返回 0）。
+
+fn Kernels(comptime T: type) type {
+    return struct {
+        const is_int = @typeInfo(T) == .int;
+        const lanes = std.simd.suggestVectorLength(T) orelse 4;
+        const V = @Vector(lanes, T);
+        /// 归约的累加类型
+        const Acc = if (is_int) i64 else T;
+        const AccV = @Vector(lanes, Acc);
+
+        fn items(ptr: i64, count: i64) []T {
+            if (ptr == 0 or count <= 0) return &.{};
+            const ptr_val: usize = @bitCast(ptr);
+            const actual_ptr: [*]T = @ptrFromInt(ptr_val);
+            return actual_ptr[0..@intCast(count)];
+        }
+
+        fn load(slice: []const T, index: usize) V {
+            return slice[index..][0..lanes].*;
+        }
+
+        fn widen(vector: V) AccV {
+            return if (is_int) @intCast(vector) else vector;
+        }
+
+        fn add(a: anytype, b: @TypeOf(a)) @TypeOf(a) {
+            return if (is_int) a +% b else a + b;
+        }
+
+        fn mul(a: anytype, b: @TypeOf(a)) @TypeOf(a) {
+            return if (is_int) a *% b else a * b;
+        }
+
+        /// 通道求和（整数回绕）
+        fn total(acc: AccV) Acc {
+            if (!is_int) return @reduce(.Add, acc);
+            var result: Acc = 0;
+            for (0..lanes) |lane| result +%= acc[lane];
+            return result;
+        }
+
+        fn fill(ptr: i64, value: T, count: i64) callconv(.c) void {
+            @memset(items(ptr, count), value);
+        }
+
+        fn find(ptr: i64, count: i64, value: T) callconv(.c) i64 {
+            const slice = items(ptr, count);
+            const needle: V = @splat(value);
+            var i: usize = 0;
+            while (i + lanes <= slice.len) : (i += lanes) {
+                if (std.simd.firstTrue(load(slice, i) == needle)) |lane| return @intCast(i + lane);
+            }
+            for (slice[i..], i..) |item, index| {
+                if (item == value) return @intCast(index);
+            }
+            return -1;
+        }
+
+        fn sum(ptr: i64, count: i64) callconv(.c) Acc {
+            const slice = items(ptr, count);
+            var acc: AccV = @splat(0);
+            var i: usize = 0;
+            while (i + lanes <= slice.len) : (i += lanes) {
+                acc = add(acc, widen(load(slice, i)));
+            }
+            var result = total(acc);
+            for (slice[i..]) |item| result = add(result, @as(Acc, item));
+            return result;
+        }
+
+        fn extreme(comptime op: std.builtin.ReduceOp, ptr: i64, count: i64) T {
+            const slice = items(ptr, count);
+            if (slice.len == 0) return 0;
+            var result = slice[0];
+            var i: usize = 0;
+            if (slice.len >= lanes) {
+                var acc = load(slice, 0);
+                i = lanes;
+                while (i + lanes <= slice.len) : (i += lanes) {
+                    const chunk = load(slice, i);
+                    acc = if (op == .Min) @min(acc, chunk) else @max(acc, chunk);
+                }
+                result = @reduce(op, acc);
+            }
+            for (slice[i..]) |item| {
+                result = if (op == .Min) @min(result, item) else @max(result, item);
+            }
+            return result;
+        }
+
+        fn min(ptr: i64, count: i64) callconv(.c) T {
+            return extreme(.Min, ptr, count);
+        }
+
+        fn max(ptr: i64, count: i64) callconv(.c) T {
+            return extreme(.Max, ptr, count);
+        }
+
+        fn dot(a: i64, b: i64, count: i64) callconv(.c) Acc {
+            const xs = items(a, count);
+            const ys = items(b, count);
+            if (xs.len == 0 or ys.len == 0) return 0;
+            var acc: AccV = @splat(0);
+            var i: usize = 0;
+            while (i + lanes <= xs.len) : (i += lanes) {
+                acc = add(acc, mul(widen(load(xs, i)), widen(load(ys, i))));
+            }
+            var result = total(acc);
+            for (xs[i..], ys[i..]) |x, y| result = add(result, mul(@as(Acc, x), @as(Acc, y)));
+            return result;
+        }
+    };
+}
+
+comptime {
+    inline for (.{ .{ i32, "i32" }, .{ i64, "i64" }, .{ f32, "f32" }, .{ f64, "f64" } }) |entry| {
+        const K = Kernels(entry[0]);
+        @export(&K.fill, .{ .name = "paw_fill_" ++ entry[1] });
+        @export(&K.find, .{ .name = "paw_find_" ++ entry[1] });
+        @export(&K.sum, .{ .name = "paw_sum_" ++ entry[1] });
+        @export(&K.min, .{ .name = "paw_min_" ++ entry[1] });
+        @export(&K.max, .{ .name = "paw_max_" ++ entry[1] });
+        @export(&K.dot, .{ .name = "paw_dot_" ++ entry[1] });
+    }
+}
+
+/// 按字节移动内存（源和目标可以重叠）
+export fn paw_memmove(dest: i64, src: i64, size: i64) void {
+    if (dest == 0 or src == 0 or size <= 0) return;
+    const dest_ptr: [*]u8 = @ptrFromInt(@as(usize, @bitCast(dest)));
+    const src_ptr: [*]const u8 = @ptrFromInt(@as(usize, @bitCast(src)));
+    const len: usize = @intCast(size);
+    if (@intFromPtr(dest_ptr) <= @intFromPtr(src_ptr)) {
+        std.mem.copyForwards(u8, dest_ptr[0..len], src_ptr[0..len]);
+    } else {
+        std.mem.copyBackwards(u8, dest_ptr[0..len], src_ptr[0..len]);
+    }
+}
+
+/// 按字节比较：返回 <0、0、>0（与 C memcmp 相同）；空指针只等于空指针
+export fn paw_memcmp(a: i64, b: i64, size: i64) i32 {
+    if (size <= 0 or a == b) return 0;
+    if (a == 0) return -1;
+    if (b == 0) return 1;
+    const a_ptr: [*]const u8 = @ptrFromInt(@as(usize, @bitCast(a)));
+    const b_ptr: [*]const u8 = @ptrFromInt(@as(usize, @bitCast(b)));
+    const len: usize = @intCast(size);
+    return switch (std.mem.order(u8, a_ptr[0..len], b_ptr[0..len])) {
+        .lt => -1,
+        .eq => 0,
+        .gt => 1,
+    };
+}
+
 // ============================================================================
 // 调试辅助
 // ============================================================================
@@ -107,3 +629,157 @@ test "Memory allocation" {
     paw_free(ptr);
 }
 
+test "Realloc keeps contents" {
+    const ptr = paw_realloc(0, 2 * @sizeOf(i32));
+    try std.testing.expect(ptr != 0);
+    paw_write_i32(ptr, 0, 11);
+    paw_write_i32(ptr, 1, 22);
+
+    const grown = paw_realloc(ptr, 1024 * @sizeOf(i32));
+    try std.testing.expect(grown != 0);
+    try std.testing.expectEqual(@as(i32, 11), paw_read_i32(grown, 0));
+    try std.testing.expectEqual(@as(i32, 22), paw_read_i32(grown, 1));
+    paw_free(grown);
+}
+
+test "Arena allocation and reset" {
+    const arena = paw_arena_new();
+    try std.testing.expect(arena != 0);
+    defer paw_arena_free(arena);
+
+    const a = paw_arena_alloc(arena, 3);
+    const b = paw_arena_alloc(arena, 40);
+    try std.testing.expect(a != 0 and b != 0);
+    try std.testing.expectEqual(@as(i64, 0), @rem(b, arena_alignment));
+    try std.testing.expectEqual(@as(i64, 16), b - a);
+    try std.testing.expectEqual(@as(i64, 64), paw_arena_used(arena));
+
+    // 超大请求单独成块，当前块继续使用
+    const big = paw_arena_alloc(arena, 64 * 1024);
+    try std.testing.expect(big != 0);
+    try std.testing.expectEqual(b + 48, paw_arena_alloc(arena, 8));
+
+    // reset 后保留最大的块，从头开始分配
+    paw_arena_reset(arena);
+    try std.testing.expectEqual(@as(i64, 0), paw_arena_used(arena));
+    try std.testing.expectEqual(big, paw_arena_alloc(arena, 100));
+}
+
+test "Arena handle 0 falls back to malloc" {
+    const ptr = paw_arena_alloc(0, 32);
+    try std.testing.expect(ptr != 0);
+    paw_arena_reset(0);
+    paw_arena_free(0);
+    paw_free(ptr);
+}
+
+test "Shared arena across threads" {
+    const arena = paw_arena_new_shared();
+    defer paw_arena_free(arena);
+
+    const Worker = struct {
+        fn run(handle: i64) void {
+            for (0..1000) |_| std.debug.assert(paw_arena_alloc(handle, 24) != 0);
+        }
+    };
+    var threads: [4]std.Thread = undefined;
+    for (&threads) |*thread| thread.* = try std.Thread.spawn(.{}, Worker.run, .{arena});
+    for (threads) |thread| thread.join();
+    try std.testing.expectEqual(@as(i64, 4 * 1000 * 32), paw_arena_used(arena));
+}
+
+test "Arena substring" {
+    const arena = paw_arena_new();
+    defer paw_arena_free(arena);
+    const copy = paw_arena_substring(arena, "{\"key\": 1}", 2, 3).?;
+    try std.testing.expectEqualStrings("key", std.mem.span(copy));
+}
+
+test "Pool reuses freed blocks per size class" {
+    const a = paw_pool_alloc(24);
+    const b = paw_pool_alloc(24);
+    try std.testing.expect(a != 0 and b != 0);
+    try std.testing.expectEqual(@as(i64, 32), b - a);
+
+    paw_pool_free(a, 24);
+    try std.testing.expectEqual(a, paw_pool_alloc(20));  // 同一大小类，后进先出
+
+    // 超过最大大小类时走 malloc
+    const large = paw_pool_alloc(4096);
+    try std.testing.expect(large != 0);
+    paw_pool_free(large, 4096);
+
+    paw_pool_free(a, 20);
+    paw_pool_free(b, 24);
+}
+
+test "Pool blocks freed on another thread return through the depot" {
+    const count = comptime 3 * batchSize(sizeClass(512).?);
+    var blocks: [count]i64 = undefined;
+
+    // 另一个线程分配，当前线程释放：超过两批的部分交还仓库
+    const Producer = struct {
+        fn run(out: []i64) void {
+            for (out) |*block| block.* = paw_pool_alloc(512);
+        }
+    };
+    const producer = try std.Thread.spawn(.{}, Producer.run, .{@as([]i64, &blocks)});
+    producer.join();
+    for (blocks) |block| paw_pool_free(block, 512);
+
+    // 第三个线程的第一次分配来自仓库，而不是新的 slab
+    const Consumer = struct {
+        fn run(result: *i64) void {
+            result.* = paw_pool_alloc(512);
+        }
+    };
+    var reused: i64 = 0;
+    const consumer = try std.Thread.spawn(.{}, Consumer.run, .{&reused});
+    consumer.join();
+    try std.testing.expect(std.mem.indexOfScalar(i64, &blocks, reused) != null);
+}
+
+test "Bulk kernels" {
+    const I32 = Kernels(i32);
+    const I64 = Kernels(i64);
+    const F64 = Kernels(f64);
+
+    var ints: [37]i32 = undefined;
+    const ints_ptr: i64 = @bitCast(@intFromPtr(&ints));
+    I32.fill(ints_ptr, 3, ints.len);
+    try std.testing.expectEqual(@as(i64, 3 * 37), I32.sum(ints_ptr, ints.len));
+
+    ints[29] = -8;
+    ints[30] = 50;
+    try std.testing.expectEqual(@as(i64, 29), I32.find(ints_ptr, ints.len, -8));
+    try std.testing.expectEqual(@as(i64, -1), I32.find(ints_ptr, ints.len, 7));
+    try std.testing.expectEqual(@as(i32, -8), I32.min(ints_ptr, ints.len));
+    try std.testing.expectEqual(@as(i32, 50), I32.max(ints_ptr, ints.len));
+    try std.testing.expectEqual(@as(i64, 9 * 35 + 64 + 2500), I32.dot(ints_ptr, ints_ptr, ints.len));
+
+    // 整数求和用 i64 累加，不会在 i32 范围内溢出
+    const big = [_]i32{std.math.maxInt(i32)} ** 5;
+    const big_ptr: i64 = @bitCast(@intFromPtr(&big));
+    try std.testing.expectEqual(@as(i64, 5) * std.math.maxInt(i32), I32.sum(big_ptr, big.len));
+
+    const floats = [_]f64{ 1.5, -2.0, 4.25, 0.25, 8.0 };
+    const floats_ptr: i64 = @bitCast(@intFromPtr(&floats));
+    try std.testing.expectEqual(@as(f64, 12.0), F64.sum(floats_ptr, floats.len));
+    try std.testing.expectEqual(@as(f64, -2.0), F64.min(floats_ptr, floats.len));
+    try std.testing.expectEqual(@as(i64, 2), F64.find(floats_ptr, floats.len, 4.25));
+
+    try std.testing.expectEqual(@as(i64, 0), I64.sum(0, 10));
+    try std.testing.expectEqual(@as(i64, -1), I64.find(0, 10, 0));
+}
+
+test "Bulk byte operations" {
+    var bytes = [_]u8{ 1, 2, 3, 4, 5, 6 };
+    const ptr: i64 = @bitCast(@intFromPtr(&bytes));
+    paw_memmove(ptr + 1, ptr, 4);
+    try std.testing.expectEqualSlices(u8, &.{ 1, 1, 2, 3, 4, 6 }, &bytes);
+
+    const other = [_]u8{ 1, 1, 2, 9 };
+    const other_ptr: i64 = @bitCast(@intFromPtr(&other));
+    try std.testing.expectEqual(@as(i32, 0), paw_memcmp(ptr, other_ptr, 3));
+    try std.testing.expectEqual(@as(i32, -1), paw_memcmp(ptr, other_ptr, 4));
+}
@@ -4,7 +4,30 @@
 // 此模块导出所有内置函数，包括：
 // - 内存管理 (memory.zig)
 // - 文件系统 (fs.zig)
+// - 字符串构建 (string.zig) 🆕 v0.2.0
+// - 流式 JSON 读取 (json.zig) 🆕 v0.2.0
+// - 工作窃取任务调度 / 原子操作 (thread.zig) 🆕 v0.2.0
 
 pub const memory = @import("memory.zig");
 pub const fs = @import("fs.zig");
+pub const string = @import("string.zig");
+pub const json = @import("json.zig");
+pub const thread = @import("thread.zig");
+
+// 🆕 v0.2.0: 引用所有模块，保证它们的 export 函数进入 libpawrt.a 和 pawc
+comptime {
+    _ = memory;
+    _ = fs;
+    _ = string;
+    _ = json;
+    _ = thread;
+}
+
+test {
+    _ = memory;
+    _ = fs;
+    _ = string;
+    _ = json;
+    _ = thread;
+}
 
@@ -0,0 +1,287 @@
+//! 🆕 v0.2.0: Built-in String Building Functions for PawLang
+//!
+//! 两种字符串拼接方式，都记录长度，不反复 strlen / strcat：
+//!   - StrBuf   ：可增长的字符串缓冲区（按 2 倍扩容），stdlib/string 的 StringBuilder 是它的句柄
+//!   - 插值拼接 ："x = ${x}" 的每个部分先格式化为 Part（指针 + 长度），
+//!                paw_str_join 求出总长度后一次分配、逐段复制
+//!
+//! 所有结果都以 '\0' 结尾，可以直接作为 Paw 的 string 使用。
+
+const std = @import("std");
+
+// 数字格式与 printf 的 %lld / %llu / %g 完全一致
+extern "c" fn snprintf(buf: [*]u8, size: usize, format: [*:0]const u8, ...) c_int;
+
+// ============================================================================
+// StrBuf - 可增长的字符串缓冲区
+// ============================================================================
+
+const StrBuf = struct {
+    ptr: [*]u8,   // 缓冲区，始终多留 1 字节给结尾的 '\0'
+    len: usize,
+    cap: usize,   // 不含结尾 '\0' 的容量
+};
+
+const strbuf_min_capacity = 32;
+
+/// 内存不足时返回的空字符串；paw_str_free 认识它，不会把它交给 free
+var empty_string: [1:0]u8 = .{0};
+
+fn toHandle(ptr: *anyopaque) i64 {
+    return @bitCast(@intFromPtr(ptr));
+}
+
+fn fromHandle(handle: i64) ?*StrBuf {
+    if (handle == 0) return null;
+    const ptr_val: usize = @bitCast(handle);
+    return @ptrFromInt(ptr_val);
+}
+
+/// 创建字符串缓冲区
+/// 参数: capacity - 预留的字节数（<= 0 时使用默认值）
+/// 返回: 句柄，内存不足时返回 0
+export fn paw_strbuf_new(capacity: i64) i64 {
+    const cap: usize = if (capacity > strbuf_min_capacity) @intCast(capacity) else strbuf_min_capacity;
+    const raw = std.c.malloc(@sizeOf(StrBuf)) orelse return 0;
+    const data = std.c.malloc(cap + 1) orelse {
+        std.c.free(raw);
+        return 0;
+    };
+    const buf: *StrBuf = @ptrCast(@alignCast(raw));
+    buf.* = .{ .ptr = @ptrCast(data), .len = 0, .cap = cap };
+    buf.ptr[0] = 0;
+    return toHandle(buf);
+}
+
+/// 保证还能追加 additional 字节而不扩容；失败时返回 false，内容不变
+export fn paw_strbuf_reserve(handle: i64, additional: i64) bool {
+    const buf = fromHandle(handle) orelse return false;
+    if (additional <= 0) return true;
+    return reserve(buf, @intCast(additional));
+}
+
+fn reserve(buf: *StrBuf, additional: usize) bool {
+    const needed = buf.len + additional;
+    if (needed <= buf.cap) return true;
+    const new_cap = @max(buf.cap * 2, needed);
+    const data = std.c.realloc(buf.ptr, new_cap + 1) orelse return false;
+    buf.ptr = @ptrCast(data);
+    buf.cap = new_cap;
+    return true;
+}
+
+fn appendSlice(buf: *StrBuf, bytes: []const u8) bool {
+    if (!reserve(buf, bytes.len)) return false;
+    @memcpy(buf.ptr[buf.len..][0..bytes.len], bytes);
+    buf.len += bytes.len;
+    buf.ptr[buf.len] = 0;
+    return true;
+}
+
+/// 追加以 '\0' 结尾的字符串
+export fn paw_strbuf_append(handle: i64, s: ?[*:0]const u8) bool {
+    const buf = fromHandle(handle) orelse return false;
+    const str = s orelse return true;
+    return appendSlice(buf, std.mem.span(str));
+}
+
+/// 追加 len 个字节（可以是另一个字符串的一段）
+export fn paw_strbuf_append_bytes(handle: i64, ptr: ?[*]const u8, len: i64) bool {
+    const buf = fromHandle(handle) orelse return false;
+    const bytes = ptr orelse return true;
+    if (len <= 0) return true;
+    return appendSlice(buf, bytes[0..@intCast(len)]);
+}
+
+/// 追加单个字符（取低 8 位）
+export fn paw_strbuf_append_char(handle: i64, c: i32) bool {
+    const buf = fromHandle(handle) orelse return false;
+    const byte: u8 = @truncate(@as(u32, @bitCast(c)));
+    return appendSlice(buf, &[_]u8{byte});
+}
+
+export fn paw_strbuf_append_i64(handle: i64, value: i64) bool {
+    const buf = fromHandle(handle) orelse return false;
+    var part: Part = undefined;
+    paw_part_i64(&part, value);
+    return appendSlice(buf, part.slice());
+}
+
+export fn paw_strbuf_append_u64(handle: i64, value: u64) bool {
+    const buf = fromHandle(handle) orelse return false;
+    var part: Part = undefined;
+    paw_part_u64(&part, value);
+    return appendSlice(buf, part.slice());
+}
+
+export fn paw_strbuf_append_f64(handle: i64, value: f64) bool {
+    const buf = fromHandle(handle) orelse return false;
+    var part: Part = undefined;
+    paw_part_f64(&part, value);
+    return appendSlice(buf, part.slice());
+}
+
+export fn paw_strbuf_append_bool(handle: i64, value: bool) bool {
+    const buf = fromHandle(handle) orelse return false;
+    return appendSlice(buf, if (value) "true" else "false");
+}
+
+/// 当前长度（字节）
+export fn paw_strbuf_len(handle: i64) i64 {
+    const buf = fromHandle(handle) orelse return 0;
+    return @intCast(buf.len);
+}
+
+/// 缓冲区内容（'\0' 结尾）；下一次追加可能使它失效
+export fn paw_strbuf_cstr(handle: i64) [*:0]const u8 {
+    const buf = fromHandle(handle) orelse return "";
+    return @ptrCast(buf.ptr);
+}
+
+/// 清空内容，保留容量
+export fn paw_strbuf_clear(handle: i64) void {
+    const buf = fromHandle(handle) orelse return;
+    buf.len = 0;
+    buf.ptr[0] = 0;
+}
+
+/// 取出内容并释放缓冲区本身：返回的字符串归调用方所有（用 paw_str_free 释放）
+export fn paw_strbuf_finish(handle: i64) [*:0]u8 {
+    const buf = fromHandle(handle) orelse return &empty_string;
+    const result: [*:0]u8 = @ptrCast(buf.ptr);
+    // 多余的容量还给分配器（缩小失败时保留原缓冲区）
+    const data = std.c.realloc(buf.ptr, buf.len + 1);
+    std.c.free(buf);
+    return if (data) |shrunk| @ptrCast(shrunk) else result;
+}
+
+/// 释放缓冲区和它的内容
+export fn paw_strbuf_free(handle: i64) void {
+    const buf = fromHandle(handle) orelse return;
+    std.c.free(buf.ptr);
+    std.c.free(buf);
+}
+
+/// 🆕 v0.2.0: 字符串的地址（i64），用于把字符串交给按（指针，长度）工作的函数，例如 writev
+export fn paw_str_ptr(s: ?[*:0]const u8) i64 {
+    const str = s orelse return 0;
+    return @bitCast(@intFromPtr(str));
+}
+
+// ============================================================================
+// 字符串插值 - 按部分格式化，一次分配
+// ============================================================================
+
+/// 插值的一个部分：字面量直接指向常量字符串，数字格式化到自带的 scratch 中
+/// 布局与编译器生成的代码一致（C 后端的 PawStrPart、LLVM 后端的 { ptr, i64, [40 x i8] }）
+pub const Part = extern struct {
+    ptr: [*]const u8,
+    len: usize,
+    scratch: [40]u8,
+
+    fn slice(self: *const Part) []const u8 {
+        return self.ptr[0..self.len];
+    }
+
+    fn format(self: *Part, comptime fmt: [:0]const u8, value: anytype) void {
+        const written = snprintf(&self.scratch, self.scratch.len, fmt, value);
+        self.ptr = &self.scratch;
+        self.len = @min(@as(usize, @intCast(@max(written, 0))), self.scratch.len - 1);
+    }
+};
+
+export fn paw_part_str(part: *Part, s: ?[*:0]const u8) void {
+    const str = s orelse "";
+    part.ptr = str;
+    part.len = std.mem.len(str);
+}
+
+export fn paw_part_i64(part: *Part, value: i64) void {
+    part.format("%lld", @as(c_longlong, value));
+}
+
+export fn paw_part_u64(part: *Part, value: u64) void {
+    part.format("%llu", @as(c_ulonglong, value));
+}
+
+export fn paw_part_f64(part: *Part, value: f64) void {
+    part.format("%g", value);
+}
+
+export fn paw_part_bool(part: *Part, value: bool) void {
+    const text: []const u8 = if (value) "true" else "false";
+    part.ptr = text.ptr;
+    part.len = text.len;
+}
+
+export fn paw_part_char(part: *Part, c: i32) void {
+    part.scratch[0] = @truncate(@as(u32, @bitCast(c)));
+    part.ptr = &part.scratch;
+    part.len = 1;
+}
+
+/// 把 count 个部分拼接为一个新字符串：先求总长度，一次分配，逐段复制
+/// 返回的字符串归调用方所有（用 paw_str_free 释放）；内存不足时返回空字符串
+export fn paw_str_join(parts: [*]const Part, count: usize) [*:0]u8 {
+    var total: usize = 0;
+    for (parts[0..count]) |*part| total += part.len;
+
+    const raw = std.c.malloc(total + 1) orelse return &empty_string;
+    const out: [*]u8 = @ptrCast(raw);
+    var offset: usize = 0;
+    for (parts[0..count]) |*part| {
+        @memcpy(out[offset..][0..part.len], part.slice());
+        offset += part.len;
+    }
+    out[total] = 0;
+    return @ptrCast(out);
+}
+
+/// 释放 paw_str_join / paw_strbuf_finish 返回的字符串
+export fn paw_str_free(s: ?[*:0]u8) void {
+    const str = s orelse return;
+    if (str == @as([*:0]u8, &empty_string)) return;
+    std.c.free(str);
+}
+
+// ============================================================================
+// 测试
+// ============================================================================
+
+test "StrBuf grows and formats" {
+    const sb = paw_strbuf_new(0);
+    try std.testing.expect(sb != 0);
+    defer paw_strbuf_free(sb);
+
+    var i: usize = 0;
+    while (i < 100) : (i += 1) try std.testing.expect(paw_strbuf_append(sb, "ab"));
+    try std.testing.expectEqual(@as(i64, 200), paw_strbuf_len(sb));
+
+    paw_strbuf_clear(sb);
+    _ = paw_strbuf_append(sb, "n=");
+    _ = paw_strbuf_append_i64(sb, -42);
+    _ = paw_strbuf_append_char(sb, ' ');
+    _ = paw_strbuf_append_f64(sb, 1.5);
+    _ = paw_strbuf_append_char(sb, ' ');
+    _ = paw_strbuf_append_bool(sb, true);
+    try std.testing.expectEqualStrings("n=-42 1.5 true", std.mem.span(paw_strbuf_cstr(sb)));
+}
+
+test "StrBuf finish transfers ownership" {
+    const sb = paw_strbuf_new(4);
+    _ = paw_strbuf_append_bytes(sb, "hello world", 5);
+    const s = paw_strbuf_finish(sb);
+    defer paw_str_free(s);
+    try std.testing.expectEqualStrings("hello", std.mem.span(s));
+}
+
+test "Interpolation join" {
+    var parts: [4]Part = undefined;
+    paw_part_str(&parts[0], "x = ");
+    paw_part_i64(&parts[1], 12345);
+    paw_part_str(&parts[2], ", ok = ");
+    paw_part_bool(&parts[3], false);
+    const s = paw_str_join(&parts, parts.len);
+    defer paw_str_free(s);
+    try std.testing.expectEqualStrings("x = 12345, ok = false", std.mem.span(s));
+}
@@ -0,0 +1,698 @@
+//! 🆕 v0.2.0: Built-in Task Runtime for PawLang
+//!
+//! 工作窃取（work-stealing）调度器，stdlib/thread 的 Task / parallel_for 基于它：
+//!   - 每个工作线程一个 Chase-Lev 双端队列：线程自己在底部压入 / 弹出（LIFO，数据还在缓存里），
+//!     空闲线程从其它队列的顶部窃取（FIFO，偷到的是最早拆出、也就是最大的一块工作）
+//!   - join 不让线程空等：等待期间继续执行队列中的其它任务
+//!   - parallel_for 递归二分下标区间，右半边压入队列供其它线程窃取，左半边就地继续拆分
+//!   - paw_atomic_* 是 i64 单元上的原子操作，用于任务之间的计数和归约
+//!
+//! 线程池在第一次使用时启动，线程数 = CPU 核数（环境变量 PAW_THREADS 可以覆盖）；
+//! 第一个调用运行时的线程（通常是 main）自己就是 0 号工作线程，另外启动 N-1 个后台线程。
+//! 不是由运行时创建的其它线程提交的任务进入一个加锁的全局队列。
+//!
+//! Paw 函数以地址传入（`worker as i64`），按 C 调用约定调用：
+//!   任务      fn(arg: i64) -> i64
+//!   按下标    fn(ctx: i64, index: i64) -> void
+//!   按区间    fn(ctx: i64, begin: i64, end: i64) -> void
+//! 任务可以在任何工作线程上运行；main 返回前必须 join 所有 spawn 出去的任务。
+
+const std = @import("std");
+const builtin = @import("builtin");
+
+const allocator = std.heap.c_allocator;
+
+pub const TaskFn = *const fn (arg: i64) callconv(.c) i64;
+pub const IndexFn = *const fn (ctx: i64, index: i64) callconv(.c) void;
+pub const RangeFn = *const fn (ctx: i64, begin: i64, end: i64) callconv(.c) void;
+
+/// PAW_THREADS 的上限
+const max_workers = 256;
+/// 窃取失败后自旋的轮数，之后才睡眠（parallel_for 刚拆出的任务通常马上就会出现）
+const idle_spin_rounds = 64;
+/// join 的目标正在其它线程上运行时，每睡这么久就再找一次可做的工作
+const join_wait_ns = 100 * std.time.ns_per_us;
+
+fn toHandle(ptr: *anyopaque) i64 {
+    return @bitCast(@intFromPtr(ptr));
+}
+
+fn fromHandle(comptime T: type, handle: i64) ?*T {
+    if (handle == 0) return null;
+    const ptr_val: usize = @bitCast(handle);
+    return @ptrFromInt(ptr_val);
+}
+
+/// Paw 侧 `f as i64` 得到的函数地址
+fn toFn(comptime F: type, address: i64) ?F {
+    if (address == 0) return null;
+    const ptr_val: usize = @bitCast(address);
+    return @ptrFromInt(ptr_val);
+}
+
+// ============================================================================
+// 任务
+// ============================================================================
+
+/// 任务状态：等待者把 pending 改成 waiting 之后才会睡眠，完成方只在这种情况下唤醒它
+const task_pending: u32 = 0;
+const task_waiting: u32 = 1;
+const task_done: u32 = 2;
+
+/// 等待者睡眠用的全局字：完成方把任务标记为 done 之后不能再访问任务本身
+/// （join 返回后任务立刻被释放，parallel_for 的任务在拆分者的栈上），
+/// 所以唤醒通过这个计数器进行，而不是任务自己的 state
+var completions: std.atomic.Value(u32) = .init(0);
+
+const Task = struct {
+    execute: *const fn (*Task) void,
+    state: std.atomic.Value(u32) = .init(task_pending),
+
+    // paw_task_spawn 的任务
+    func: ?TaskFn = null,
+    arg: i64 = 0,
+    result: i64 = 0,
+
+    // parallel_for 拆出的区间（任务放在拆分者的栈上，拆分者 join 之后才返回）
+    job: ?*const ForJob = null,
+    begin: i64 = 0,
+    end: i64 = 0,
+
+    fn isDone(self: *const Task) bool {
+        return self.state.load(.acquire) == task_done;
+    }
+
+    fn run(self: *Task) void {
+        self.execute(self);
+        // swap 之后 self 可能已被释放：只访问全局的 completions
+        if (self.state.swap(task_done, .acq_rel) == task_waiting) {
+            _ = completions.fetchAdd(1, .release);
+            std.Thread.Futex.wake(&completions, std.math.maxInt(u32));
+        }
+    }
+};
+
+fn runCallTask(task: *Task) void {
+    task.result = task.func.?(task.arg);
+}
+
+// ============================================================================
+// Chase-Lev 双端队列
+// ============================================================================
+//
+// 所有者在 bottom 端 push / pop，窃取者在 top 端 steal；只剩一个任务时所有者和窃取者
+// 通过 top 上的 CAS 决定归属。数组满时所有者把它扩容为两倍，旧数组挂在新数组上，
+// 正在读取旧数组的窃取者不受影响（旧数组随队列一起释放）。
+// 内存序参照 Lê 等人 "Correct and Efficient Work-Stealing for Weak Memory Models"：
+// 论文中的 seq_cst fence 用相邻的 seq_cst store / load 代替。
+
+const Deque = struct {
+    top: std.atomic.Value(isize) = .init(0),
+    bottom: std.atomic.Value(isize) = .init(0),
+    buffer: std.atomic.Value(*Buffer),
+
+    const initial_capacity = 64;
+
+    const Buffer = struct {
+        slots: []std.atomic.Value(?*Task),
+        retired: ?*Buffer,   // 扩容前的旧数组
+
+        fn create(capacity: usize, retired: ?*Buffer) !*Buffer {
+            const buffer = try allocator.create(Buffer);
+            errdefer allocator.destroy(buffer);
+            buffer.* = .{ .slots = try allocator.alloc(std.atomic.Value(?*Task), capacity), .retired = retired };
+            return buffer;
+        }
+
+        fn slot(self: *Buffer, index: isize) *std.atomic.Value(?*Task) {
+            const position: usize = @bitCast(index);
+            return &self.slots[position & (self.slots.len - 1)];
+        }
+    };
+
+    const Steal = union(enum) {
+        empty,
+        retry,   // 与其它窃取者或所有者竞争失败，队列中可能还有任务
+        task: *Task,
+    };
+
+    fn init() !Deque {
+        return .{ .buffer = .init(try Buffer.create(initial_capacity, null)) };
+    }
+
+    fn deinit(self: *Deque) void {
+        var buffer: ?*Buffer = self.buffer.load(.monotonic);
+        while (buffer) |current| {
+            buffer = current.retired;
+            allocator.free(current.slots);
+            allocator.destroy(current);
+        }
+    }
+
+    /// 只能由所有者调用；内存不足（无法扩容）时返回错误，任务没有入队
+    fn push(self: *Deque, task: *Task) !void {
+        const b = self.bottom.load(.monotonic);
+        const t = self.top.load(.acquire);
+        var buffer = self.buffer.load(.monotonic);
+        if (b - t >= @as(isize, @intCast(buffer.slots.len))) {
+            buffer = try self.grow(buffer, t, b);
+        }
+        buffer.slot(b).store(task, .monotonic);
+        self.bottom.store(b + 1, .release);
+    }
+
+    fn grow(self: *Deque, old: *Buffer, t: isize, b: isize) !*Buffer {
+        const buffer = try Buffer.create(old.slots.len * 2, old);
+        var i = t;
+        while (i < b) : (i += 1) buffer.slot(i).store(old.slot(i).load(.monotonic), .monotonic);
+        self.buffer.store(buffer, .release);
+        return buffer;
+    }
+
+    /// 只能由所有者调用：取出最近压入的任务
+    fn pop(self: *Deque) ?*Task {
+        const b = self.bottom.load(.monotonic) - 1;
+        const buffer = self.buffer.load(.monotonic);
+        self.bottom.store(b, .seq_cst);
+        const t = self.top.load(.seq_cst);
+        if (t > b) {
+            self.bottom.store(b + 1, .monotonic);
+            return null;
+        }
+        const task = buffer.slot(b).load(.monotonic);
+        if (t == b) {
+            // 最后一个任务：与窃取者竞争
+            const won = self.top.cmpxchgStrong(t, t + 1, .seq_cst, .monotonic) == null;
+            self.bottom.store(b + 1, .monotonic);
+            return if (won) task else null;
+        }
+        return task;
+    }
+
+    /// 任何线程都可以调用：取出最早压入的任务
+    fn steal(self: *Deque) Steal {
+        const t = self.top.load(.seq_cst);
+        const b = self.bottom.load(.seq_cst);
+        if (t >= b) return .empty;
+        const buffer = self.buffer.load(.acquire);
+        const task = buffer.slot(t).load(.monotonic);
+        if (self.top.cmpxchgStrong(t, t + 1, .seq_cst, .monotonic) != null) return .retry;
+        return .{ .task = task.? };
+    }
+};
+
+// ============================================================================
+// 线程池
+// ============================================================================
+
+const Worker = struct {
+    pool: *Pool,
+    index: usize,
+    deque: Deque,
+    rng: u64,   // 挑选窃取对象（xorshift64）
+
+    fn nextRandom(self: *Worker) u64 {
+        self.rng ^= self.rng << 13;
+        self.rng ^= self.rng >> 7;
+        self.rng ^= self.rng << 17;
+        return self.rng;
+    }
+};
+
+/// 非工作线程提交的任务
+const Injector = struct {
+    mutex: std.Thread.Mutex = .{},
+    tasks: std.ArrayListUnmanaged(*Task) = .{},
+    count: std.atomic.Value(usize) = .init(0),   // 不加锁判空
+
+    fn push(self: *Injector, task: *Task) !void {
+        self.mutex.lock();
+        defer self.mutex.unlock();
+        try self.tasks.append(allocator, task);
+        self.count.store(self.tasks.items.len, .release);
+    }
+
+    fn pop(self: *Injector) ?*Task {
+        if (self.count.load(.acquire) == 0) return null;
+        self.mutex.lock();
+        defer self.mutex.unlock();
+        const task = self.tasks.pop() orelse return null;
+        self.count.store(self.tasks.items.len, .release);
+        return task;
+    }
+};
+
+const Pool = struct {
+    // 所有工作线程的槽位（启动线程之前就已确定，之后不再改变）；
+    // 后台线程没能启动的槽位队列始终为空，窃取时直接跳过
+    workers: []Worker,
+    threads: usize = 1,   // 实际在运行的线程数（包括调用线程）
+    injector: Injector = .{},
+
+    // 空闲线程的睡眠 / 唤醒：每次入队 epoch 加一，睡眠前发现 epoch 变了就不睡
+    sleep_mutex: std.Thread.Mutex = .{},
+    sleep_cond: std.Thread.Condition = .{},
+    sleepers: std.atomic.Value(u32) = .init(0),
+    epoch: std.atomic.Value(u64) = .init(0),
+
+    /// 任务入队：工作线程压入自己的队列，其它线程放进全局队列；内存不足时就地执行
+    fn submit(self: *Pool, task: *Task) void {
+        const queued = if (current_worker) |worker|
+            worker.deque.push(task)
+        else
+            self.injector.push(task);
+        queued catch return task.run();
+        self.notify();
+    }
+
+    fn notify(self: *Pool) void {
+        _ = self.epoch.fetchAdd(1, .seq_cst);
+        if (self.sleepers.load(.seq_cst) == 0) return;
+        self.sleep_mutex.lock();
+        defer self.sleep_mutex.unlock();
+        self.sleep_cond.signal();
+    }
+
+    fn waitForWork(self: *Pool, seen_epoch: u64) void {
+        self.sleep_mutex.lock();
+        defer self.sleep_mutex.unlock();
+        _ = self.sleepers.fetchAdd(1, .seq_cst);
+        defer _ = self.sleepers.fetchSub(1, .seq_cst);
+        while (self.epoch.load(.seq_cst) == seen_epoch) {
+            self.sleep_cond.wait(&self.sleep_mutex);
+        }
+    }
+
+    /// 找一个可以执行的任务：自己的队列 → 全局队列 → 从随机位置开始依次窃取
+    fn findTask(self: *Pool, worker: ?*Worker) ?*Task {
+        if (worker) |own| {
+            if (own.deque.pop()) |task| return task;
+        }
+        if (self.injector.pop()) |task| return task;
+
+        const count = self.workers.len;
+        while (true) {
+            var contended = false;
+            const start: usize = if (worker) |own| @intCast(own.nextRandom() % count) else 0;
+            for (0..count) |offset| {
+                const victim = &self.workers[(start + offset) % count];
+                if (worker != null and worker.? == victim) continue;
+                switch (victim.deque.steal()) {
+                    .task => |task| return task,
+                    .retry => contended = true,
+                    .empty => {},
+                }
+            }
+            if (!contended) return null;
+        }
+    }
+
+    /// 等待任务完成，期间执行其它任务（包括 task 本身，如果它还在队列里）
+    fn join(self: *Pool, task: *Task) void {
+        const worker = current_worker;
+        while (!task.isDone()) {
+            if (self.findTask(worker)) |other| {
+                other.run();
+                continue;
+            }
+            // 没有其它工作：task 正在别的线程上运行
+            // 先记下 completions，再登记 waiting：完成方的 fetchAdd 一定发生在这次读取之后
+            const seen = completions.load(.acquire);
+            if (task.state.cmpxchgStrong(task_pending, task_waiting, .acq_rel, .acquire)) |actual| {
+                if (actual == task_done) break;
+            }
+            std.Thread.Futex.timedWait(&completions, seen, join_wait_ns) catch {};
+        }
+    }
+};
+
+threadlocal var current_worker: ?*Worker = null;
+
+var global_pool: ?*Pool = null;
+var pool_once = std.once(startPool);
+
+/// 线程池（第一次调用时启动）；无法分配时返回 null，所有任务在调用线程上就地执行
+fn getPool() ?*Pool {
+    pool_once.call();
+    return global_pool;
+}
+
+fn workerCount() usize {
+    if (builtin.os.tag != .windows) {
+        if (std.posix.getenv("PAW_THREADS")) |value| {
+            const count = std.fmt.parseInt(usize, value, 10) catch 0;
+            if (count > 0) return @min(count, max_workers);
+        }
+    }
+    const cpus = std.Thread.getCpuCount() catch 1;
+    return @min(@max(cpus, 1), max_workers);
+}
+
+fn startPool() void {
+    const count = workerCount();
+    const pool = allocator.create(Pool) catch return;
+    const workers = allocator.alloc(Worker, count) catch {
+        allocator.destroy(pool);
+        return;
+    };
+    pool.* = .{ .workers = workers };
+
+    var ready: usize = 0;
+    for (workers, 0..) |*worker, index| {
+        const deque = Deque.init() catch break;
+        worker.* = .{ .pool = pool, .index = index, .deque = deque, .rng = @as(u64, 0x9E3779B97F4A7C15) *% (index + 1) };
+        ready += 1;
+    }
+    if (ready == 0) {
+        allocator.free(workers);
+        allocator.destroy(pool);
+        return;
+    }
+
+    // 槽位在启动任何后台线程之前确定：后台线程一启动就会遍历 workers 窃取任务
+    pool.workers = workers[0..ready];
+
+    // 调用线程是 0 号工作线程；后台线程启动失败时线程池就少几个线程。
+    // 没有线程的槽位保留（其它线程可能正在窃取它），它的队列没有所有者，始终为空
+    current_worker = &workers[0];
+    var started: usize = 1;
+    while (started < ready) : (started += 1) {
+        const thread = std.Thread.spawn(.{}, workerMain, .{&workers[started]}) catch break;
+        thread.detach();
+    }
+    pool.threads = started;
+    global_pool = pool;
+}
+
+fn workerMain(worker: *Worker) void {
+    current_worker = worker;
+    const pool = worker.pool;
+    var idle: u32 = 0;
+    while (true) {
+        const seen_epoch = pool.epoch.load(.seq_cst);
+        if (pool.findTask(worker)) |task| {
+            task.run();
+            idle = 0;
+            continue;
+        }
+        idle += 1;
+        if (idle < idle_spin_rounds) {
+            std.atomic.spinLoopHint();
+            continue;
+        }
+        pool.waitForWork(seen_epoch);
+        idle = 0;
+    }
+}
+
+// ============================================================================
+// 任务 API - C ABI 导出
+// ============================================================================
+
+/// 线程池中的线程数（包括调用线程）
+export fn paw_thread_count() i32 {
+    const pool = getPool() orelse return 1;
+    return @intCast(pool.threads);
+}
+
+/// 当前线程在线程池中的编号（0..thread_count-1）；不是工作线程时返回 -1
+export fn paw_thread_index() i32 {
+    _ = getPool();
+    const worker = current_worker orelse return -1;
+    return @intCast(worker.index);
+}
+
+/// 异步执行 func(arg)
+/// 返回: 任务句柄，必须用 paw_task_join 取回结果（同时释放句柄）；func 为 0 或内存不足时返回 0
+export fn paw_task_spawn(func: i64, arg: i64) i64 {
+    const f = toFn(TaskFn, func) orelse return 0;
+    const task = allocator.create(Task) catch return 0;
+    task.* = .{ .execute = &runCallTask, .func = f, .arg = arg };
+    if (getPool()) |pool| pool.submit(task) else task.run();
+    return toHandle(task);
+}
+
+/// 等待任务完成并释放句柄，返回 func 的返回值（句柄 0 返回 0）
+/// 等待期间当前线程继续执行其它任务
+export fn paw_task_join(handle: i64) i64 {
+    const task = fromHandle(Task, handle) orelse return 0;
+    if (getPool()) |pool| pool.join(task);
+    const result = task.result;
+    allocator.destroy(task);
+    return result;
+}
+
+/// 任务是否已经完成（不等待）
+export fn paw_task_done(handle: i64) bool {
+    const task = fromHandle(Task, handle) orelse return true;
+    return task.isDone();
+}
+
+// ============================================================================
+// parallel_for
+// ============================================================================
+
+const ForJob = struct {
+    pool: *Pool,
+    grain: i64,
+    ctx: i64,
+    index_fn: ?IndexFn,
+    range_fn: ?RangeFn,
+
+    fn runChunk(self: *const ForJob, begin: i64, end: i64) void {
+        if (self.range_fn) |body| return body(self.ctx, begin, end);
+        const body = self.index_fn.?;
+        var index = begin;
+        while (index < end) : (index += 1) body(self.ctx, index);
+    }
+
+    /// 不超过 grain 的区间直接执行；否则右半边交给线程池，左半边继续拆分
+    fn split(self: *const ForJob, begin: i64, end: i64) void {
+        if (end - begin <= self.grain) return self.runChunk(begin, end);
+        const mid = begin + @divTrunc(end - begin, 2);
+        var right = Task{ .execute = &runRangeTask, .job = self, .begin = mid, .end = end };
+        self.pool.submit(&right);
+        self.split(begin, mid);
+        self.pool.join(&right);
+    }
+};
+
+fn runRangeTask(task: *Task) void {
+    task.job.?.split(task.begin, task.end);
+}
+
+fn parallelFor(begin: i64, end: i64, grain: i64, ctx: i64, index_fn: ?IndexFn, range_fn: ?RangeFn) void {
+    if (end <= begin or (index_fn == null and range_fn == null)) return;
+    const len = end - begin;
+    const pool = getPool() orelse {
+        const job = ForJob{ .pool = undefined, .grain = len, .ctx = ctx, .index_fn = index_fn, .range_fn = range_fn };
+        return job.runChunk(begin, end);
+    };
+    // grain <= 0：每个线程大约分到 8 块，窃取足以弥补各块耗时的差异
+    const threads: i64 = @intCast(pool.threads);
+    const job = ForJob{
+        .pool = pool,
+        .grain = if (grain > 0) grain else @max(1, @divTrunc(len, threads * 8)),
+        .ctx = ctx,
+        .index_fn = index_fn,
+        .range_fn = range_fn,
+    };
+    if (threads == 1) return job.runChunk(begin, end);
+    job.split(begin, end);
+}
+
+/// 对 [begin, end) 中的每个下标调用 body(ctx, index)，返回时全部执行完
+/// grain: 不再拆分的区间长度，<= 0 时自动选择
+export fn paw_parallel_for(begin: i64, end: i64, grain: i64, body: i64, ctx: i64) void {
+    parallelFor(begin, end, grain, ctx, toFn(IndexFn, body), null);
+}
+
+/// 与 paw_parallel_for 相同，但每个分块只调用一次 body(ctx, chunk_begin, chunk_end)
+export fn paw_parallel_for_range(begin: i64, end: i64, grain: i64, body: i64, ctx: i64) void {
+    parallelFor(begin, end, grain, ctx, null, toFn(RangeFn, body));
+}
+
+// ============================================================================
+// 原子操作 - ptr 指向一个 8 字节对齐的 i64（例如 paw_malloc(8)）
+// ============================================================================
+//
+// 全部是顺序一致（seq_cst）的；add / min / max / exchange 返回修改之前的值，
+// 整数加法回绕而不是溢出。
+
+fn atomicCell(ptr: i64) ?*std.atomic.Value(i64) {
+    return fromHandle(std.atomic.Value(i64), ptr);
+}
+
+export fn paw_atomic_load(ptr: i64) i64 {
+    const cell = atomicCell(ptr) orelse return 0;
+    return cell.load(.seq_cst);
+}
+
+export fn paw_atomic_store(ptr: i64, value: i64) void {
+    const cell = atomicCell(ptr) orelse return;
+    cell.store(value, .seq_cst);
+}
+
+export fn paw_atomic_add(ptr: i64, delta: i64) i64 {
+    const cell = atomicCell(ptr) orelse return 0;
+    return cell.fetchAdd(delta, .seq_cst);
+}
+
+export fn paw_atomic_min(ptr: i64, value: i64) i64 {
+    const cell = atomicCell(ptr) orelse return 0;
+    return cell.fetchMin(value, .seq_cst);
+}
+
+export fn paw_atomic_max(ptr: i64, value: i64) i64 {
+    const cell = atomicCell(ptr) orelse return 0;
+    return cell.fetchMax(value, .seq_cst);
+}
+
+export fn paw_atomic_exchange(ptr: i64, value: i64) i64 {
+    const cell = atomicCell(ptr) orelse return 0;
+    return cell.swap(value, .seq_cst);
+}
+
+/// 当前值等于 expected 时改为 desired 并返回 true，否则什么都不做并返回 false
+export fn paw_atomic_cas(ptr: i64, expected: i64, desired: i64) bool {
+    const cell = atomicCell(ptr) orelse return false;
+    return cell.cmpxchgStrong(expected, desired, .seq_cst, .seq_cst) == null;
+}
+
+// ============================================================================
+// 测试
+// ============================================================================
+
+fn address(comptime f: anytype) i64 {
+    return @bitCast(@intFromPtr(&f));
+}
+
+fn noop(_: *Task) void {}
+
+fn taskIndex(all: []const Task, task: *const Task) usize {
+    return (@intFromPtr(task) - @intFromPtr(all.ptr)) / @sizeOf(Task);
+}
+
+test "Deque: owner pops LIFO, thieves steal FIFO, grows past initial capacity" {
+    var deque = try Deque.init();
+    defer deque.deinit();
+
+    var tasks: [Deque.initial_capacity * 3]Task = undefined;
+    for (&tasks) |*task| {
+        task.* = .{ .execute = &noop };
+        try deque.push(task);
+    }
+    try std.testing.expectEqual(&tasks[0], deque.steal().task);
+    try std.testing.expectEqual(&tasks[1], deque.steal().task);
+    try std.testing.expectEqual(&tasks[tasks.len - 1], deque.pop().?);
+
+    var remaining: usize = 0;
+    while (deque.pop()) |_| remaining += 1;
+    try std.testing.expectEqual(tasks.len - 3, remaining);
+    try std.testing.expect(deque.steal() == .empty);
+}
+
+test "Deque: every task is taken exactly once under concurrent stealing" {
+    var deque = try Deque.init();
+    defer deque.deinit();
+
+    const count = 20_000;
+    const tasks = try std.testing.allocator.alloc(Task, count);
+    defer std.testing.allocator.free(tasks);
+    const taken = try std.testing.allocator.alloc(std.atomic.Value(u32), count);
+    defer std.testing.allocator.free(taken);
+    for (taken) |*flag| flag.* = .init(0);
+
+    const Thief = struct {
+        fn run(queue: *Deque, all: []Task, marks: []std.atomic.Value(u32), stop: *std.atomic.Value(bool)) void {
+            while (!stop.load(.acquire)) {
+                switch (queue.steal()) {
+                    .task => |task| _ = marks[taskIndex(all, task)].fetchAdd(1, .monotonic),
+                    .retry, .empty => std.atomic.spinLoopHint(),
+                }
+            }
+        }
+    };
+    var stop = std.atomic.Value(bool).init(false);
+    var thieves: [3]std.Thread = undefined;
+    for (&thieves) |*thief| thief.* = try std.Thread.spawn(.{}, Thief.run, .{ &deque, tasks, taken, &stop });
+
+    // 所有者交替压入和弹出，与窃取者争夺最后一个任务
+    for (tasks, 0..) |*task, index| {
+        task.* = .{ .execute = &noop };
+        try deque.push(task);
+        if (index % 3 == 0) {
+            if (deque.pop()) |popped| _ = taken[taskIndex(tasks, popped)].fetchAdd(1, .monotonic);
+        }
+    }
+    while (deque.pop()) |popped| _ = taken[taskIndex(tasks, popped)].fetchAdd(1, .monotonic);
+    while (deque.steal() != .empty) {}
+
+    // 窃取者可能已经读到任务、尚未计数：等它们停下再检查
+    stop.store(true, .release);
+    for (thieves) |thief| thief.join();
+    for (taken) |flag| try std.testing.expectEqual(@as(u32, 1), flag.load(.monotonic));
+}
+
+fn fib(n: i64) callconv(.c) i64 {
+    if (n < 2) return n;
+    const left = paw_task_spawn(address(fib), n - 1);
+    const right = fib(n - 2);
+    return paw_task_join(left) + right;
+}
+
+test "Spawn and join nested tasks" {
+    try std.testing.expect(paw_thread_count() >= 1);
+    try std.testing.expectEqual(@as(i32, 0), paw_thread_index());
+    try std.testing.expectEqual(@as(i64, 6765), fib(20));
+    try std.testing.expectEqual(@as(i64, 0), paw_task_spawn(0, 1));
+    try std.testing.expectEqual(@as(i64, 0), paw_task_join(0));
+}
+
+fn markIndex(ctx: i64, index: i64) callconv(.c) void {
+    const marks = fromHandle(std.atomic.Value(i64), ctx).?;
+    const slot: [*]std.atomic.Value(i64) = @ptrCast(marks);
+    _ = slot[@intCast(index)].fetchAdd(1, .monotonic);
+}
+
+fn sumRange(ctx: i64, begin: i64, end: i64) callconv(.c) void {
+    var partial: i64 = 0;
+    var index = begin;
+    while (index < end) : (index += 1) partial += index;
+    _ = paw_atomic_add(ctx, partial);
+}
+
+test "parallel_for visits every index exactly once" {
+    var marks: [10_000]std.atomic.Value(i64) = undefined;
+    for (&marks) |*mark| mark.* = .init(0);
+    const ctx: i64 = @bitCast(@intFromPtr(&marks));
+
+    paw_parallel_for(0, marks.len, 0, address(markIndex), ctx);
+    paw_parallel_for(0, marks.len, 7, address(markIndex), ctx);
+    for (marks) |mark| try std.testing.expectEqual(@as(i64, 2), mark.load(.monotonic));
+
+    // 空区间和空函数什么都不做
+    paw_parallel_for(5, 5, 0, address(markIndex), ctx);
+    paw_parallel_for(0, 10, 0, 0, ctx);
+}
+
+test "parallel_for_range reduces with atomics" {
+    var total: i64 = 0;
+    const ctx: i64 = @bitCast(@intFromPtr(&total));
+    paw_parallel_for_range(0, 1_000_000, 0, address(sumRange), ctx);
+    try std.testing.expectEqual(@as(i64, 999_999 * 1_000_000 / 2), paw_atomic_load(ctx));
+}
+
+test "Atomic operations" {
+    var cell: i64 = 10;
+    const ptr: i64 = @bitCast(@intFromPtr(&cell));
+    try std.testing.expectEqual(@as(i64, 10), paw_atomic_add(ptr, 5));
+    try std.testing.expectEqual(@as(i64, 15), paw_atomic_max(ptr, 40));
+    try std.testing.expectEqual(@as(i64, 40), paw_atomic_min(ptr, 3));
+    try std.testing.expectEqual(@as(i64, 3), paw_atomic_exchange(ptr, 7));
+    try std.testing.expect(!paw_atomic_cas(ptr, 6, 1));
+    try std.testing.expect(paw_atomic_cas(ptr, 7, 1));
+    paw_atomic_store(ptr, -2);
+    try std.testing.expectEqual(@as(i64, -2), paw_atomic_load(ptr));
+    try std.testing.expectEqual(@as(i64, 0), paw_atomic_load(0));
+}
@@ -1,15 +1,114 @@
 const std = @import("std");
 const ast = @import("ast.zig");
-const CodeGen = @import("codegen.zig").CodeGen;
+const codegen = @import("codegen.zig");
+const CodeGen = codegen.CodeGen;
+const pgo = @import("pgo.zig");
+const prof = @import("profiler.zig");  // 🆕 v0.2.0: cc.json 中的 JSON 字符串
+const builtin = @import("builtin");
+
+/// 🆕 v0.2.0: 缓存目录下的编译器检测结果
+const driver_cache_file = "cc.json";
+/// 🆕 v0.2.0: 缓存目录下按内容哈希保存的翻译单元目标文件
+const object_subdir = "objects";
+/// 🆕 v0.2.0: 缓存目录下写出翻译单元源文件的工作目录
+const unit_subdir = "units";
+
+/// 🆕 v0.2.0: pawrt 运行时库（src/builtin，`zig build` 安装在 pawc 旁边的 ../lib/ 下）
+const runtime_library_name = if (builtin.os.tag == .windows) "pawrt.lib" else "libpawrt.a";
+
+/// 🆕 v0.2.0: 运行时库的任务调度器（thread.zig）使用系统线程；旧版本 glibc 的 pthread 在单独的库中
+pub const runtime_system_libs: []const []const u8 = switch (builtin.os.tag) {
+    .windows, .macos => &.{},
+    else => &.{"-lpthread"},
+};
+
+/// 查找 pawc 旁边的运行时库，找不到时返回 null
+/// （只在程序调用了 prelude 中声明的运行时函数时才需要，链接器会报告缺少的符号）
+/// 返回的路径由调用方释放
+pub fn findRuntimeLibrary(allocator: std.mem.Allocator) ?[]u8 {
+    const exe_dir = std.fs.selfExeDirPathAlloc(allocator) catch return null;
+    defer allocator.free(exe_dir);
+    const path = std.fs.path.join(allocator, &.{ exe_dir, "..", "lib", runtime_library_name }) catch return null;
+    std.fs.cwd().access(path, .{}) catch {
+        allocator.free(path);
+        return null;
+    };
+    return path;
+}
 
 /// C Backend - Compiles and executes C code using GCC
 /// Generates portable C code that can be compiled with any C compiler
 pub const CBackend = struct {
     allocator: std.mem.Allocator,
+    cache_dir: ?[]const u8 = null,   // 🆕 v0.2.0: null = 不缓存编译器检测结果和目标文件
+    jobs: usize = 1,                 // 🆕 v0.2.0: 并行编译翻译单元的进程数
+    driver: ?CompilerDriver = null,  // 🆕 v0.2.0: 本次运行中已检测到的编译器
+    driver_version: ?DriverVersion = null,  // 🆕 v0.2.0: 编译器 `--version` 输出的哈希（目标文件缓存键的一部分）
+    shared_driver: ?*?CompilerDriver = null,  // 🆕 v0.2.0: pawc serve 中跨请求共享的检测结果
+    debug_info: bool = false,        // 🆕 v0.2.0: -g
+    frame_pointers: bool = false,    // 🆕 v0.2.0: 保留帧指针（perf 调用栈展开）
+    pgo: pgo.Mode = .none,           // 🆕 v0.2.0: --pgo-generate / --pgo-use
+    pgo_flag: ?[]u8 = null,          // 🆕 v0.2.0: 按检测到的编译器生成的 -fprofile-* 参数
+    opt_flag: ?[]const u8 = null,    // 🆕 v0.2.0: 额外的 -O 参数（LLVM 后端 --pgo-use 时由 clang 优化 bitcode）
+    runtime_lib: ?[]u8 = null,       // 🆕 v0.2.0: 链接可执行文件时追加的 libpawrt.a
     
     pub fn init(allocator: std.mem.Allocator) CBackend {
         return CBackend{
             .allocator = allocator,
+            .runtime_lib = findRuntimeLibrary(allocator),
+        };
+    }
+    
+    pub fn deinit(self: *CBackend) void {
+        if (self.pgo_flag) |flag| self.allocator.free(flag);
+        if (self.runtime_lib) |path| self.allocator.free(path);
+    }
+    
+    /// 🆕 v0.2.0: 启用编译器检测结果缓存和翻译单元目标文件缓存
+    pub fn setCacheDir(self: *CBackend, cache_dir: []const u8) void {
+        self.cache_dir = cache_dir;
+    }
+    
+    /// 🆕 v0.2.0: 设置 compileUnits 同时运行的编译进程数
+    pub fn setJobs(self: *CBackend, jobs: usize) void {
+        self.jobs = @max(jobs, 1);
+    }
+    
+    /// 🆕 v0.2.0: 编译时生成调试信息（配合 CodeGen 的 #line，行号指向 .paw 源码）
+    pub fn setDebugInfo(self: *CBackend, enabled: bool) void {
+        self.debug_info = enabled;
+    }
+    
+    /// 🆕 v0.2.0: 编译时保留帧指针，perf / 火焰图可以不依赖 DWARF 展开调用栈
+    pub fn setFramePointers(self: *CBackend, enabled: bool) void {
+        self.frame_pointers = enabled;
+    }
+    
+    /// 🆕 v0.2.0: 插桩构建（-fprofile-generate）或使用剖析数据（-fprofile-use），见 pgo.zig
+    pub fn setPgo(self: *CBackend, mode: pgo.Mode) void {
+        self.pgo = mode;
+    }
+    
+    /// 🆕 v0.2.0: 编译时追加优化参数（如 "-O2"）
+    pub fn setOptFlag(self: *CBackend, flag: []const u8) void {
+        self.opt_flag = flag;
+    }
+    
+    /// 🆕 v0.2.0: 按编译器生成 PGO 参数（在启动编译进程之前调用，工作线程只读取结果）
+    /// gcc 直接读取目录中的 .gcda；clang 需要合并好的 .profdata
+    fn preparePgo(self: *CBackend, driver: CompilerDriver) !void {
+        if (self.pgo_flag != null) return;
+        self.pgo_flag = switch (self.pgo) {
+            .none => return,
+            .generate => |dir| try std.fmt.allocPrint(self.allocator, "-fprofile-generate={s}", .{dir}),
+            .use => |path| blk: {
+                if (std.mem.eql(u8, driver.name, "gcc")) {
+                    break :blk try std.fmt.allocPrint(self.allocator, "-fprofile-use={s}", .{path});
+                }
+                const profile = try pgo.resolveProfileData(self.allocator, path);
+                defer self.allocator.free(profile);
+                break :blk try std.fmt.allocPrint(self.allocator, "-fprofile-use={s}", .{profile});
+            },
         };
     }
     
@@ -36,79 +135,513 @@ pub const CBackend = struct {
         try self.compileWithGcc(temp_c_file, output_file);
     }
     
-           /// Compile using system C compiler (Zig CC -> GCC -> Clang)
-           fn compileWithGcc(
-               self: *CBackend,
-               c_file: []const u8,
-               output_file: []const u8,
-           ) !void {
-               // Try to find available C compiler
-               // Priority: Zig CC (if building from source) -> GCC -> Clang
-               var compiler: []const u8 = "gcc";
-               var use_zig_cc = false;
-               
-               // 1. Try Zig CC first (for users who build from source)
-               if (std.process.Child.run(.{
-                   .allocator = self.allocator,
-                   .argv = &[_][]const u8{ "zig", "cc", "--version" },
-               })) |zig_result| {
-                   self.allocator.free(zig_result.stdout);
-                   self.allocator.free(zig_result.stderr);
-                   compiler = "zig";
-                   use_zig_cc = true;
-                   std.debug.print("🚀 Compiling with Zig CC (Clang 20.1.2, best performance)...\n", .{});
-               } else |_| {
-                   // 2. Try gcc
-                   if (std.process.Child.run(.{
-                       .allocator = self.allocator,
-                       .argv = &[_][]const u8{ "gcc", "--version" },
-                   })) |gcc_result| {
-                       self.allocator.free(gcc_result.stdout);
-                       self.allocator.free(gcc_result.stderr);
-                       compiler = "gcc";
-                       std.debug.print("🔧 Compiling with GCC...\n", .{});
-                   } else |_| {
-                       // 3. Try clang as fallback
-                       if (std.process.Child.run(.{
-                           .allocator = self.allocator,
-                           .argv = &[_][]const u8{ "clang", "--version" },
-                       })) |clang_result| {
-                           self.allocator.free(clang_result.stdout);
-                           self.allocator.free(clang_result.stderr);
-                           compiler = "clang";
-                           std.debug.print("🔧 Compiling with Clang...\n", .{});
-                       } else |_| {
-                           std.debug.print("❌ No C compiler found (zig/gcc/clang)\n", .{});
-                           std.debug.print("💡 Please install a C compiler:\n", .{});
-                           std.debug.print("   • Zig (recommended): Already available if you built from source\n", .{});
-                           std.debug.print("   • Linux:   sudo apt-get install gcc\n", .{});
-                           std.debug.print("   • macOS:   brew install gcc or xcode-select --install\n", .{});
-                           std.debug.print("   • Windows: Install MinGW or MSVC\n", .{});
-                           return error.NoCompilerFound;
-                       }
-                   }
-               }
-               
-               // Build command line arguments
-               const argv = if (use_zig_cc) &[_][]const u8{
-                   "zig", "cc", "-o", output_file, c_file,
-               } else &[_][]const u8{
-                   compiler, "-o", output_file, c_file,
-               };
+    /// 🆕 v0.2.0: C 编译器/链接器驱动
+    pub const CompilerDriver = struct {
+        name: []const u8,
+        use_zig_cc: bool,
+        argv_prefix: []const []const u8,  // 命令行前缀（`zig cc` 或编译器名）
+        
+        fn announce(self: CompilerDriver) void {
+            if (self.use_zig_cc) {
+                std.debug.print("🚀 Compiling with Zig CC (Clang 20.1.2, best performance)...\n", .{});
+            } else if (std.mem.eql(u8, self.name, "gcc")) {
+                std.debug.print("🔧 Compiling with GCC...\n", .{});
+            } else {
+                std.debug.print("🔧 Compiling with Clang...\n", .{});
+            }
+        }
+    };
+    
+    /// 检测顺序：Zig CC（从源码构建的用户一定有）-> GCC -> Clang
+    const known_drivers = [_]CompilerDriver{
+        .{ .name = "zig", .use_zig_cc = true, .argv_prefix = &.{ "zig", "cc" } },
+        .{ .name = "gcc", .use_zig_cc = false, .argv_prefix = &.{"gcc"} },
+        .{ .name = "clang", .use_zig_cc = false, .argv_prefix = &.{"clang"} },
+    };
+    
+    /// 🆕 v0.2.0: 按名字取已知的编译器驱动
+    fn knownDriver(comptime name: []const u8) CompilerDriver {
+        inline for (known_drivers) |driver| {
+            if (comptime std.mem.eql(u8, driver.name, name)) return driver;
+        }
+        @compileError("unknown C compiler driver: " ++ name);
+    }
+    
+    /// 🆕 v0.2.0: 某个驱动的 `--version` 输出哈希
+    const DriverVersion = struct {
+        name: []const u8,
+        hash: u64,
+    };
+    
+    /// 🆕 v0.2.0: cc.json 的内容：选中的编译器 + 各驱动的版本哈希
+    const DriverCache = struct {
+        name: []const u8 = "",
+        versions: []const VersionEntry = &.{},
+    };
+    
+    /// 版本哈希按驱动可执行文件的路径、大小和修改时间记录：文件没变就不再启动 `--version`
+    const VersionEntry = struct {
+        driver: []const u8,
+        path: []const u8,
+        size: u64,
+        mtime: i128,
+        hash: u64,
+    };
+    
+    /// PATH 中找到的驱动可执行文件
+    const DriverStamp = struct {
+        path: []u8,
+        size: u64,
+        mtime: i128,
+        
+        fn matches(self: DriverStamp, driver: CompilerDriver, entry: VersionEntry) bool {
+            return std.mem.eql(u8, entry.driver, driver.name) and std.mem.eql(u8, entry.path, self.path) and
+                entry.size == self.size and entry.mtime == self.mtime;
+        }
+    };
+    
+    /// Detect system C compiler (Zig CC -> GCC -> Clang)
+    /// 🆕 v0.2.0: 结果在本次运行中复用，并缓存到 <cache_dir>/cc.json，
+    /// 之后的编译不必再逐个启动 `--version` 探测
+    fn detectCompiler(self: *CBackend) !CompilerDriver {
+        if (self.driver) |driver| return driver;
+        if (self.shared_driver) |shared| {
+            if (shared.*) |driver| {
+                self.driver = driver;
+                return driver;
+            }
+        }
+        
+        const driver = self.loadCachedDriver() orelse try self.probeCompiler();
+        driver.announce();
+        self.driver = driver;
+        if (self.shared_driver) |shared| shared.* = driver;
+        return driver;
+    }
+    
+    fn probeCompiler(self: *CBackend) !CompilerDriver {
+        for (known_drivers) |driver| {
+            if (self.driverVersion(driver)) |_| {
+                self.saveCachedDriver(driver);
+                return driver;
+            } else |_| {}
+        }
+        
+        std.debug.print("❌ No C compiler found (zig/gcc/clang)\n", .{});
+        std.debug.print("💡 Please install a C compiler:\n", .{});
+        std.debug.print("   • Zig (recommended): Already available if you built from source\n", .{});
+        std.debug.print("   • Linux:   sudo apt-get install gcc\n", .{});
+        std.debug.print("   • macOS:   brew install gcc or xcode-select --install\n", .{});
+        std.debug.print("   • Windows: Install MinGW or MSVC\n", .{});
+        return error.NoCompilerFound;
+    }
+    
+    fn driverCachePath(self: *CBackend) ?[]u8 {
+        const cache_dir = self.cache_dir orelse return null;
+        return std.fs.path.join(self.allocator, &.{ cache_dir, driver_cache_file }) catch null;
+    }
+    
+    fn loadDriverCache(self: *CBackend) ?std.json.Parsed(DriverCache) {
+        const path = self.driverCachePath() orelse return null;
+        defer self.allocator.free(path);
+        
+        const bytes = std.fs.cwd().readFileAlloc(self.allocator, path, 64 * 1024) catch return null;
+        defer self.allocator.free(bytes);
+        return std.json.parseFromSlice(DriverCache, self.allocator, bytes, .{
+            .ignore_unknown_fields = true,
+            .allocate = .alloc_always,
+        }) catch null;
+    }
+    
+    /// 读取缓存的检测结果（只接受已知的驱动名）
+    fn loadCachedDriver(self: *CBackend) ?CompilerDriver {
+        const parsed = self.loadDriverCache() orelse return null;
+        defer parsed.deinit();
+        
+        for (known_drivers) |driver| {
+            if (std.mem.eql(u8, driver.name, parsed.value.name)) return driver;
+        }
+        return null;
+    }
+    
+    /// 保存检测结果（失败时静默忽略，缓存只是加速手段）
+    fn saveCachedDriver(self: *CBackend, driver: CompilerDriver) void {
+        const parsed = self.loadDriverCache();
+        defer if (parsed) |p| p.deinit();
+        const versions = if (parsed) |p| p.value.versions else &.{};
+        self.writeDriverCache(.{ .name = driver.name, .versions = versions }) catch {};
+    }
+    
+    /// 记录驱动的版本哈希，替换同一驱动的旧记录
+    fn saveCachedVersion(self: *CBackend, entry: VersionEntry) void {
+        const parsed = self.loadDriverCache();
+        defer if (parsed) |p| p.deinit();
+        
+        var versions = std.ArrayList(VersionEntry){};
+        defer versions.deinit(self.allocator);
+        if (parsed) |p| {
+            for (p.value.versions) |old| {
+                if (!std.mem.eql(u8, old.driver, entry.driver)) versions.append(self.allocator, old) catch return;
+            }
+        }
+        versions.append(self.allocator, entry) catch return;
+        const name = if (parsed) |p| p.value.name else "";
+        self.writeDriverCache(.{ .name = name, .versions = versions.items }) catch {};
+    }
+    
+    fn writeDriverCache(self: *CBackend, cache: DriverCache) !void {
+        const cache_dir = self.cache_dir orelse return;
+        const path = self.driverCachePath() orelse return;
+        defer self.allocator.free(path);
+        
+        const gpa = self.allocator;
+        var buf = std.ArrayList(u8){};
+        defer buf.deinit(gpa);
+        try buf.appendSlice(gpa, "{\n  \"name\": ");
+        try prof.writeJsonString(&buf, gpa, cache.name);
+        try buf.appendSlice(gpa, ",\n  \"versions\": [");
+        for (cache.versions, 0..) |entry, idx| {
+            try buf.appendSlice(gpa, if (idx == 0) "\n    { \"driver\": " else ",\n    { \"driver\": ");
+            try prof.writeJsonString(&buf, gpa, entry.driver);
+            try buf.appendSlice(gpa, ", \"path\": ");
+            try prof.writeJsonString(&buf, gpa, entry.path);
+            try buf.print(gpa, ", \"size\": {d}, \"mtime\": {d}, \"hash\": {d} }}", .{ entry.size, entry.mtime, entry.hash });
+        }
+        try buf.appendSlice(gpa, "\n  ]\n}\n");
+        
+        try std.fs.cwd().makePath(cache_dir);
+        try std.fs.cwd().writeFile(.{ .sub_path = path, .data = buf.items });
+    }
+    
+    /// 在 PATH 中查找驱动的可执行文件（argv_prefix[0]），返回的路径由调用方释放
+    fn driverStamp(self: *CBackend, driver: CompilerDriver) ?DriverStamp {
+        const exe_ext = if (builtin.os.tag == .windows) ".exe" else "";
+        const path_env = std.process.getEnvVarOwned(self.allocator, "PATH") catch return null;
+        defer self.allocator.free(path_env);
+        
+        var dirs = std.mem.tokenizeScalar(u8, path_env, std.fs.path.delimiter);
+        while (dirs.next()) |dir| {
+            const candidate = std.fmt.allocPrint(self.allocator, "{s}{c}{s}{s}", .{ dir, std.fs.path.sep, driver.argv_prefix[0], exe_ext }) catch return null;
+            const stat = std.fs.cwd().statFile(candidate) catch {
+                self.allocator.free(candidate);
+                continue;
+            };
+            if (stat.kind == .directory) {
+                self.allocator.free(candidate);
+                continue;
+            }
+            return DriverStamp{ .path = candidate, .size = stat.size, .mtime = stat.mtime };
+        }
+        return null;
+    }
+    
+    /// 🆕 v0.2.0: PGO 构建使用的编译器
+    /// zig cc 没有 profile 运行时（-fprofile-generate 的程序无法链接），检测到它时改用 gcc / clang
+    fn detectPgoCompiler(self: *CBackend) !CompilerDriver {
+        const driver = try self.detectCompiler();
+        if (!driver.use_zig_cc) return driver;
+        
+        inline for (.{ "gcc", "clang" }) |name| {
+            const candidate = knownDriver(name);
+            if (self.driverVersion(candidate)) |_| {
+                std.debug.print("🔧 PGO: zig cc has no profile runtime, using {s}\n", .{candidate.name});
+                self.driver = candidate;
+                return candidate;
+            } else |_| {}
+        }
+        
+        std.debug.print("❌ PGO needs gcc or clang: zig cc has no profile runtime\n", .{});
+        std.debug.print("💡 Install gcc or clang, or build without --pgo-generate/--pgo-use\n", .{});
+        return error.PgoCompilerNotFound;
+    }
+    
+    /// 编译使用的编译器：PGO 构建需要带 profile 运行时的编译器
+    fn selectCompiler(self: *CBackend) !CompilerDriver {
+        if (self.pgo != .none) return self.detectPgoCompiler();
+        return self.detectCompiler();
+    }
+    
+    /// 🆕 v0.2.0: 编译器 `--version` 输出的哈希，每个驱动每次运行只查询一次
+    /// 同名编译器升级后版本输出改变，旧的目标文件缓存随之失效
+    /// 有缓存目录时哈希记录在 cc.json 中，驱动可执行文件的路径、大小和修改时间不变就直接复用
+    fn driverVersion(self: *CBackend, driver: CompilerDriver) !u64 {
+        if (self.driver_version) |version| {
+            if (std.mem.eql(u8, version.name, driver.name)) return version.hash;
+        }
+        
+        const stamp = if (self.cache_dir != null) self.driverStamp(driver) else null;
+        defer if (stamp) |s| self.allocator.free(s.path);
+        if (stamp) |s| {
+            if (self.loadDriverCache()) |parsed| {
+                defer parsed.deinit();
+                for (parsed.value.versions) |entry| {
+                    if (!s.matches(driver, entry)) continue;
+                    self.driver_version = .{ .name = driver.name, .hash = entry.hash };
+                    return entry.hash;
+                }
+            }
+        }
+        
+        var argv = std.ArrayList([]const u8){};
+        defer argv.deinit(self.allocator);
+        try argv.appendSlice(self.allocator, driver.argv_prefix);
+        try argv.append(self.allocator, "--version");
+        
+        const result = try std.process.Child.run(.{
+            .allocator = self.allocator,
+            .argv = argv.items,
+        });
+        defer self.allocator.free(result.stdout);
+        defer self.allocator.free(result.stderr);
+        
+        const hash = std.hash.Wyhash.hash(0, result.stdout);
+        self.driver_version = .{ .name = driver.name, .hash = hash };
+        if (stamp) |s| self.saveCachedVersion(.{
+            .driver = driver.name,
+            .path = s.path,
+            .size = s.size,
+            .mtime = s.mtime,
+            .hash = hash,
+        });
+        return hash;
+    }
+    
+    /// 缓存的编译器已不可用（例如被卸载）：删除缓存，下次重新检测
+    fn forgetDriver(self: *CBackend) void {
+        self.driver = null;
+        self.driver_version = null;
+        if (self.shared_driver) |shared| shared.* = null;
+        const path = self.driverCachePath() orelse return;
+        defer self.allocator.free(path);
+        std.fs.cwd().deleteFile(path) catch {};
+    }
+    
+    /// 🆕 v0.2.0: 用检测到的编译器运行一条命令（args 接在 `zig cc` / 编译器名之后）
+    /// 不修改 CBackend 的状态，可以在线程池的工作线程中并发调用
+    fn runCompiler(self: *CBackend, driver: CompilerDriver, args: []const []const u8) !void {
+        var argv = std.ArrayList([]const u8){};
+        defer argv.deinit(self.allocator);
+        try argv.appendSlice(self.allocator, driver.argv_prefix);
+        if (self.debug_info) try argv.append(self.allocator, "-g");
+        if (self.frame_pointers) try argv.append(self.allocator, "-fno-omit-frame-pointer");
+        if (self.opt_flag) |flag| try argv.append(self.allocator, flag);
+        if (self.pgo_flag) |flag| try argv.append(self.allocator, flag);
+        try argv.appendSlice(self.allocator, args);
         
         const compile_result = try std.process.Child.run(.{
             .allocator = self.allocator,
-            .argv = argv,
+            .argv = argv.items,
         });
         defer self.allocator.free(compile_result.stdout);
         defer self.allocator.free(compile_result.stderr);
         
-        if (compile_result.term.Exited != 0) {
-            std.debug.print("❌ {s} compilation failed:\n{s}\n", .{ compiler, compile_result.stderr });
+        if (compile_result.term != .Exited or compile_result.term.Exited != 0) {
+            std.debug.print("❌ {s} compilation failed:\n{s}\n", .{ driver.name, compile_result.stderr });
             return error.CompilationFailed;
         }
+    }
+    
+    /// Run the detected compiler driver on one input file
+    /// The input may be a C source file or an object file (link only)
+    fn runDriver(
+        self: *CBackend,
+        input_file: []const u8,
+        output_file: []const u8,
+    ) !void {
+        const driver = try self.selectCompiler();
+        try self.preparePgo(driver);
+        // 运行时库放在输入之后，链接器按需取用其中的目标文件
+        const runtime_args: []const []const u8 = if (self.runtime_lib) |lib| &.{lib} else &.{};
+        const system_args: []const []const u8 = if (self.runtime_lib != null) runtime_system_libs else &.{};
+        const args = try std.mem.concat(self.allocator, []const u8, &.{ &.{ "-o", output_file, input_file }, runtime_args, system_args });
+        defer self.allocator.free(args);
+        self.runCompiler(driver, args) catch |err| {
+            if (err == error.FileNotFound) self.forgetDriver();
+            return err;
+        };
+        std.debug.print("✅ Compilation successful (using {s}): {s}\n", .{ driver.name, output_file });
+    }
+    
+    /// Compile using system C compiler (Zig CC -> GCC -> Clang)
+    fn compileWithGcc(
+        self: *CBackend,
+        c_file: []const u8,
+        output_file: []const u8,
+    ) !void {
+        try self.runDriver(c_file, output_file);
+    }
+    
+    // ========================================================================
+    // 🆕 v0.2.0: 多翻译单元并行编译
+    // ========================================================================
+    
+    const UnitJob = struct {
+        backend: *CBackend,
+        driver: CompilerDriver,
+        source_path: []const u8,
+        object_path: []const u8,
+        temp_path: ?[]const u8,  // 缓存模式：先编译到临时文件再原子改名
+        failure: ?anyerror = null,
+    };
+    
+    fn runUnitJob(job: *UnitJob) void {
+        const output = job.temp_path orelse job.object_path;
+        job.backend.runCompiler(job.driver, &.{ "-c", "-o", output, job.source_path }) catch |err| {
+            job.failure = err;
+            return;
+        };
+        if (job.temp_path) |temp| {
+            std.fs.cwd().rename(temp, job.object_path) catch |err| {
+                job.failure = err;
+            };
+        }
+    }
+    
+    /// 编译 CodeGen.generateUnits 的输出：
+    ///   1. 共享头文件和每个翻译单元写入工作目录
+    ///   2. 各单元用 `-c` 并发编译（最多 jobs 个编译进程）
+    ///   3. 所有目标文件一次链接成 output_file
+    ///
+    /// 设置了缓存目录时，目标文件按 (编译器及其版本, 头文件, 单元源码) 的内容哈希
+    /// 保存在 <cache_dir>/objects/ 下；内容没有变化的单元直接复用上次的目标文件，
+    /// 只改动一个函数时通常只需重新编译它所在的分片，然后重新链接。
+    pub fn compileUnits(
+        self: *CBackend,
+        units: *const codegen.Units,
+        output_file: []const u8,
+    ) !void {
+        const driver = try self.selectCompiler();
+        try self.preparePgo(driver);
+        var driver_version: u64 = 0;
+        if (self.cache_dir != null) {
+            driver_version = self.driverVersion(driver) catch |err| {
+                if (err == error.FileNotFound) self.forgetDriver();
+                return err;
+            };
+        }
+        
+        // 与单元内容无关的缓存键部分只计算一次（--pgo-use 的剖析数据目录需要遍历）
+        var settings_key: u64 = 0;
+        if (self.cache_dir != null) {
+            var hasher = std.hash.Wyhash.init(0);
+            hasher.update(driver.name);
+            hasher.update(std.mem.asBytes(&driver_version));
+            hasher.update(&[_]u8{ 0, @intFromBool(self.debug_info), @intFromBool(self.frame_pointers) });
+            self.pgo.hash(self.allocator, &hasher);
+            settings_key = hasher.final();
+        }
+        
+        var arena_state = std.heap.ArenaAllocator.init(self.allocator);
+        defer arena_state.deinit();
+        const arena = arena_state.allocator();
+        
+        // 工作目录：缓存模式下位于缓存目录内（按输出路径区分），否则在输出文件旁边（链接后删除）
+        const work_dir = if (self.cache_dir) |cache_dir|
+            try std.fmt.allocPrint(arena, "{s}/{s}/{x:0>16}", .{ cache_dir, unit_subdir, std.hash.Wyhash.hash(0, output_file) })
+        else
+            try std.fmt.allocPrint(arena, "{s}.units", .{output_file});
+        try std.fs.cwd().makePath(work_dir);
+        
+        const object_dir = if (self.cache_dir) |cache_dir|
+            try std.fs.path.join(arena, &.{ cache_dir, object_subdir })
+        else
+            work_dir;
+        try std.fs.cwd().makePath(object_dir);
+        
+        const header_path = try std.fs.path.join(arena, &.{ work_dir, codegen.Units.header_name });
+        try std.fs.cwd().writeFile(.{ .sub_path = header_path, .data = units.header });
+        
+        var jobs = std.ArrayList(UnitJob){};
+        var object_paths = std.ArrayList([]const u8){};
+        for (units.sources, 0..) |source, idx| {
+            const source_path = try std.fmt.allocPrint(arena, "{s}/unit{d}.c", .{ work_dir, idx });
+            const contents = try std.fmt.allocPrint(arena, "#include \"{s}\"\n\n{s}", .{ codegen.Units.header_name, source });
+            try std.fs.cwd().writeFile(.{ .sub_path = source_path, .data = contents });
+            
+            var job = UnitJob{
+                .backend = self,
+                .driver = driver,
+                .source_path = source_path,
+                .object_path = undefined,
+                .temp_path = null,
+            };
+            if (self.cache_dir != null) {
+                var hasher = std.hash.Wyhash.init(settings_key);
+                hasher.update(units.header);
+                hasher.update(&[_]u8{0});
+                hasher.update(source);
+                const key = hasher.final();
+                job.object_path = try std.fmt.allocPrint(arena, "{s}/{x:0>16}.o", .{ object_dir, key });
+                try object_paths.append(arena, job.object_path);
+                
+                std.fs.cwd().access(job.object_path, .{}) catch {
+                    job.temp_path = try std.fmt.allocPrint(arena, "{s}.{d}.tmp", .{ job.object_path, idx });
+                    try jobs.append(arena, job);
+                };
+            } else {
+                job.object_path = try std.fmt.allocPrint(arena, "{s}/unit{d}.o", .{ work_dir, idx });
+                try object_paths.append(arena, job.object_path);
+                try jobs.append(arena, job);
+            }
+        }
+        
+        const n_jobs = @min(self.jobs, jobs.items.len);
+        std.debug.print("🧩 {d} translation units: {d} cached, {d} compiling on {d} job(s)\n", .{
+            units.sources.len, units.sources.len - jobs.items.len, jobs.items.len, @max(n_jobs, 1),
+        });
+        
+        if (n_jobs <= 1) {
+            for (jobs.items) |*job| runUnitJob(job);
+        } else {
+            var pool: std.Thread.Pool = undefined;
+            try pool.init(.{ .allocator = self.allocator, .n_jobs = n_jobs });
+            defer pool.deinit();
+            
+            var wait_group: std.Thread.WaitGroup = .{};
+            for (jobs.items) |*job| {
+                pool.spawnWg(&wait_group, runUnitJob, .{job});
+            }
+            pool.waitAndWork(&wait_group);
+        }
+        
+        var first_failure: ?anyerror = null;
+        for (jobs.items) |job| {
+            const err = job.failure orelse continue;
+            if (job.temp_path) |temp| std.fs.cwd().deleteFile(temp) catch {};
+            if (first_failure == null) first_failure = err;
+        }
+        if (first_failure) |err| {
+            if (err == error.FileNotFound) self.forgetDriver();
+            return err;
+        }
         
-        std.debug.print("✅ Compilation successful (using {s}): {s}\n", .{ compiler, output_file });
+        // 一次链接
+        var link_args = std.ArrayList([]const u8){};
+        try link_args.appendSlice(arena, &.{ "-o", output_file });
+        try link_args.appendSlice(arena, object_paths.items);
+        if (self.runtime_lib) |lib| {
+            try link_args.append(arena, lib);
+            try link_args.appendSlice(arena, runtime_system_libs);
+        }
+        try self.runCompiler(driver, link_args.items);
+        if (self.cache_dir == null) std.fs.cwd().deleteTree(work_dir) catch {};
+        
+        std.debug.print("✅ Compilation successful (using {s}): {s}\n", .{ driver.name, output_file });
+    }
+    
+    /// 🆕 v0.2.0: 链接 LLVM 后端生成的目标文件
+    /// 通过 C 编译器驱动链接，以便自动带上 libc 和启动文件
+    /// PGO 插桩的目标文件引用 clang 的 profile 运行时，--pgo-use 的输入是需要
+    /// clang 读取剖析数据并优化的 bitcode，因此 PGO 构建固定用 clang 链接
+    pub fn linkObject(
+        self: *CBackend,
+        object_file: []const u8,
+        output_file: []const u8,
+    ) !void {
+        if (self.pgo != .none) {
+            self.driver = knownDriver("clang");
+        }
+        try self.runDriver(object_file, output_file);
     }
     
     /// Compile and run (for REPL or quick testing)
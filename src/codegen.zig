@@ -19,11 +19,46 @@
 const std = @import("std");
 const ast = @import("ast.zig");
 const generics = @import("generics.zig");
+const prof = @import("profiler.zig");  // 🆕 v0.2.0
+const intrinsics = @import("intrinsics.zig");  // 🆕 v0.2.0
 
 // ============================================================================
 // CodeGen Structure
 // ============================================================================
 
+/// 🆕 v0.2.0: 声明的输出范围（generateUnits 分两遍生成头文件和实现）
+const EmitMode = enum {
+    all,             // 类型定义 + 函数实现（单文件输出）
+    interface,       // 类型定义 + 函数原型
+    implementation,  // 只有函数实现
+};
+
+/// 🆕 v0.2.0: generateUnits 的结果，所有内容归 arena 所有
+pub const Units = struct {
+    arena: std.heap.ArenaAllocator,
+    header: []const u8,
+    sources: []const []const u8,
+
+    /// 共享头文件的文件名（每个翻译单元用 #include "..." 引用它）
+    pub const header_name = "paw_units.h";
+
+    pub fn deinit(self: *Units) void {
+        self.arena.deinit();
+    }
+
+    /// 拼接成单个翻译单元（与 generate() 的输出等价）
+    pub fn join(self: *const Units, allocator: std.mem.Allocator) ![]u8 {
+        var out = std.ArrayList(u8){};
+        errdefer out.deinit(allocator);
+        try out.appendSlice(allocator, self.header);
+        for (self.sources) |source| {
+            try out.appendSlice(allocator, "\n");
+            try out.appendSlice(allocator, source);
+        }
+        return out.toOwnedSlice(allocator);
+    }
+};
+
 /// C Code Generator
 pub const CodeGen = struct {
     allocator: std.mem.Allocator,
@@ -47,6 +82,12 @@ pub const CodeGen = struct {
         type_params: [][]const u8,    // 类型参数 ([T])
         type_args: []ast.Type,        // 具体类型 ([i32])
     },
+    // 🆕 v0.2.0: --time-report 逐函数计时（null = 不记录）
+    profiler: ?*prof.Profiler = null,
+    // 🆕 v0.2.0: 当前输出的是接口（原型）、实现，还是两者（单文件）
+    emit: EmitMode = .all,
+    // 🆕 v0.2.0: -g：函数定义前输出 #line，调试器和 perf 显示 .paw 源码位置
+    debug_info: bool = false,
 
     pub fn init(allocator: std.mem.Allocator) CodeGen {
         var output = std.ArrayList(u8){};
@@ -77,6 +118,30 @@ pub const CodeGen = struct {
     }
     
     pub fn generate(self: *CodeGen, program: ast.Program) ![]const u8 {
+        try self.collectProgram(program);
+        
+        // 生成 C 代码头部
+        try self.generateIncludes();
+        try self.output.appendSlice(self.allocator, "// Generic function forward declarations\n");
+        
+        // 🆕 第三遍：生成单态化函数的前向声明和泛型结构体定义
+        try self.generateMonomorphizedDeclarations();
+        
+        // 第四遍：生成所有声明
+        for (program.declarations) |decl| {
+            try self.generateDecl(decl);
+            try self.output.appendSlice(self.allocator, "\n");
+        }
+        
+        // 🆕 第五遍：生成泛型实例化的函数实现
+        try self.generateMonomorphizedFunctions();
+        
+        // 🔧 v0.1.4: Return a copy to avoid use-after-free
+        return try self.allocator.dupe(u8, self.output.items);
+    }
+    
+    /// 第一、二遍：收集类型/函数/enum variant 表和所有泛型实例
+    fn collectProgram(self: *CodeGen, program: ast.Program) !void {
         // 🆕 第一遍：收集类型定义、函数和enum variants
         for (program.declarations) |decl| {
             if (decl == .type_decl) {
@@ -101,30 +166,124 @@ pub const CodeGen = struct {
         // 🆕 第二遍：收集所有泛型函数调用和泛型结构体实例
         try self.generic_context.collectGenericCalls(program);
         try self.collectGenericStructInstances(program);
-        
-        // 生成 C 代码头部
+    }
+    
+    /// C 代码头部
+    fn generateIncludes(self: *CodeGen) !void {
         try self.output.appendSlice(self.allocator, "#include <stdio.h>\n");
         try self.output.appendSlice(self.allocator, "#include <stdlib.h>\n");
         try self.output.appendSlice(self.allocator, "#include <stdint.h>\n");
         try self.output.appendSlice(self.allocator, "#include <stdbool.h>\n");
-        try self.output.appendSlice(self.allocator, "#include <string.h>\n");  // For string interpolation
+        try self.output.appendSlice(self.allocator, "#include <string.h>\n");
         try self.output.appendSlice(self.allocator, "\n");
-        try self.output.appendSlice(self.allocator, "// Generic function forward declarations\n");
+        try self.output.appendSlice(self.allocator, string_interp_runtime);
+    }
+    
+    /// 🆕 v0.2.0: 字符串插值使用的 pawrt 函数（src/builtin/string.zig）
+    /// PAW_PART 按表达式的 C 类型选择格式化函数；PawStrPart 的布局与运行时的 Part 一致
+    const string_interp_runtime =
+        \typedef struct { const char* ptr; size_t len; char scratch[40]; } PawStrPart;
+        \void paw_part_str(PawStrPart* part, const char* s);
+        \void paw_part_i64(PawStrPart* part, long long value);
+        \void paw_part_u64(PawStrPart* part, unsigned long long value);
+        \void paw_part_f64(PawStrPart* part, double value);
+        \void paw_part_bool(PawStrPart* part, bool value);
+        \void paw_part_char(PawStrPart* part, int c);
+        \char* paw_str_join(const PawStrPart* parts, size_t count);
+        \void paw_str_free(char* s);
+        \#define PAW_PART(part, x) _Generic((x), \
+        \    char*: paw_part_str, const char*: paw_part_str, \
+        \    double: paw_part_f64, float: paw_part_f64, \
+        \    bool: paw_part_bool, char: paw_part_char, \
+        \    unsigned char: paw_part_u64, unsigned short: paw_part_u64, unsigned int: paw_part_u64, \
+        \    unsigned long: paw_part_u64, unsigned long long: paw_part_u64, \
+        \    default: paw_part_i64)((part), (x))
+        \
+        \
+    ;
+    
+    // ============================================================================
+    // 🆕 v0.2.0: Translation Units - 分片输出，供 C 后端并行编译
+    // ============================================================================
+    
+    /// 每个函数分片至少包含的生成代码量（更小的分片省下的编译时间抵不上多启动一个编译进程）
+    const min_shard_bytes = 16 * 1024;
+    
+    /// 生成共享头文件 + 多个翻译单元
+    ///
+    /// header      : #include、类型定义、所有函数/方法/构造器的原型
+    /// sources[0]  : 类型方法、enum 构造器、泛型实例化函数
+    /// sources[1..]: 顶层函数，按生成代码的大小连续切成最多 shard_count 片
+    ///
+    /// 各单元不含 `#include` 头文件那一行（由 C 后端写文件时加上），
+    /// 因此 header ++ sources 按顺序拼接就是一个完整的单文件程序（join）。
+    /// 生成顺序与 generate() 完全一致，只是写入不同的缓冲区。
+    pub fn generateUnits(self: *CodeGen, program: ast.Program, shard_count: usize) !Units {
+        try self.collectProgram(program);
         
-        // 🆕 第三遍：生成单态化函数的前向声明和泛型结构体定义
-        try self.generateMonomorphizedDeclarations();
+        var units = Units{
+            .arena = std.heap.ArenaAllocator.init(self.allocator),
+            .header = "",
+            .sources = &.{},
+        };
+        errdefer units.deinit();
+        const arena = units.arena.allocator();
         
-        // 第四遍：生成所有声明
+        // 头文件：只有接口
+        self.emit = .interface;
+        self.output.clearRetainingCapacity();
+        try self.generateIncludes();
+        try self.generateMonomorphizedDeclarations();
         for (program.declarations) |decl| {
+            if (decl == .function) continue;
             try self.generateDecl(decl);
             try self.output.appendSlice(self.allocator, "\n");
         }
+        try self.output.appendSlice(self.allocator, "// Function prototypes\n");
+        for (program.declarations) |decl| {
+            if (decl == .function) try self.generateDecl(decl);
+        }
+        units.header = try arena.dupe(u8, self.output.items);
         
-        // 🆕 第五遍：生成泛型实例化的函数实现
+        // 实现：类型相关的实现写入 core，顶层函数写入 functions
+        self.emit = .implementation;
+        self.output.clearRetainingCapacity();
+        var functions = std.ArrayList(u8){};
+        defer functions.deinit(self.allocator);
+        var boundaries = std.ArrayList(usize){};  // 每个函数结束处的偏移
+        defer boundaries.deinit(self.allocator);
+        
+        for (program.declarations) |decl| {
+            if (decl == .function) {
+                std.mem.swap(std.ArrayList(u8), &self.output, &functions);
+                defer std.mem.swap(std.ArrayList(u8), &self.output, &functions);
+                try self.generateDecl(decl);
+                try self.output.appendSlice(self.allocator, "\n");
+                try boundaries.append(self.allocator, self.output.items.len);
+            } else {
+                try self.generateDecl(decl);
+            }
+        }
         try self.generateMonomorphizedFunctions();
+        self.emit = .all;
         
-        // 🔧 v0.1.4: Return a copy to avoid use-after-free
-        return try self.allocator.dupe(u8, self.output.items);
+        var sources = std.ArrayList([]const u8){};
+        try sources.append(arena, try arena.dupe(u8, self.output.items));
+        
+        // 按字节数均衡切分，切点总在函数边界上
+        const total = functions.items.len;
+        const shards = std.math.clamp(total / min_shard_bytes, 1, @max(shard_count, 1));
+        var start: usize = 0;
+        var next_cut: usize = 1;
+        for (boundaries.items) |end| {
+            if (end < total * next_cut / shards and end != total) continue;
+            if (end > start) try sources.append(arena, try arena.dupe(u8, functions.items[start..end]));
+            start = end;
+            while (next_cut < shards and total * next_cut / shards <= end) next_cut += 1;
+        }
+        
+        units.sources = sources.items;
+        return units;
     }
     
     // ============================================================================
@@ -135,8 +294,8 @@ pub const CodeGen = struct {
             switch (decl) {
             .function => |func| try self.generateFunction(func),
             .type_decl => |type_decl| try self.generateTypeDecl(type_decl),
-            .struct_decl => |struct_decl| try self.generateStructDecl(struct_decl),
-            .enum_decl => |enum_decl| try self.generateEnumDecl(enum_decl),
+            .struct_decl => |struct_decl| if (self.emit != .implementation) try self.generateStructDecl(struct_decl),
+            .enum_decl => |enum_decl| if (self.emit != .implementation) try self.generateEnumDecl(enum_decl),
             .import_decl => |import_decl| {
                 // TODO: 处理导入
                 _ = import_decl;
@@ -170,6 +329,12 @@ pub const CodeGen = struct {
             try self.output.writer(self.allocator).print("{d}", .{i});
         }
         
+        // 🆕 v0.2.0: 头文件中只生成原型
+        if (self.emit == .interface) {
+            try self.output.appendSlice(self.allocator, ");\n");
+            return;
+        }
+        
         try self.output.appendSlice(self.allocator, ") {\n");
         try self.output.appendSlice(self.allocator, "    ");
         try self.output.appendSlice(self.allocator, enum_name);
@@ -232,6 +397,8 @@ pub const CodeGen = struct {
     
     // 🆕 生成方法实现
     fn generateMethodImpl(self: *CodeGen, type_name: []const u8, method: ast.FunctionDecl) !void {
+        try self.emitLineDirective(method);  // 🆕 v0.2.0
+
         // 返回类型
         try self.output.appendSlice(self.allocator, self.typeToC(method.return_type));
         try self.output.appendSlice(self.allocator, " ");
@@ -259,6 +426,12 @@ pub const CodeGen = struct {
         
         try self.output.appendSlice(self.allocator, ") {\n");
         
+        // 🆕 v0.2.0: 登记 self 和结构体类型的参数，方法体中的 self.m() / p.m() 才能分派
+        var no_type_params = [_][]const u8{};
+        var no_type_args = [_]ast.Type{};
+        const saved = try self.bindParamTypes(method.params, type_name, &no_type_params, &no_type_args);
+        defer self.restoreVarTypes(saved);
+        
         // 生成方法体
         // 🆕 v0.1.6: 特殊处理最后一个表达式语句 - 应该生成 return
         for (method.body, 0..) |stmt, i| {
@@ -278,13 +451,122 @@ pub const CodeGen = struct {
         try self.output.appendSlice(self.allocator, "}\n\n");
     }
 
+    /// 🆕 v0.2.0: 方法体中变量名被参数遮蔽前的类型绑定
+    const SavedVarType = struct {
+        name: []const u8,
+        previous: ?[]const u8,
+    };
+    
+    /// 🆕 v0.2.0: 把 self（最终的单态化结构体名）和结构体类型的参数登记到 var_types
+    /// 返回被覆盖的旧绑定，方法体生成后用 restoreVarTypes 恢复，参数类型不会泄漏到其它函数
+    fn bindParamTypes(
+        self: *CodeGen,
+        params: []const ast.Param,
+        self_type: []const u8,
+        type_params: [][]const u8,
+        type_args: []ast.Type,
+    ) ![]SavedVarType {
+        var saved = std.ArrayList(SavedVarType){};
+        for (params) |param| {
+            const type_name = if (std.mem.eql(u8, param.name, "self"))
+                self_type
+            else blk: {
+                const param_type = try self.substituteGenericType(param.type, type_params, type_args);
+                break :blk switch (param_type) {
+                    .named => |name| if (self.type_decls.contains(name)) name else continue,
+                    .generic_instance => self.typeToC(param_type),
+                    else => continue,
+                };
+            };
+            try saved.append(self.arena.allocator(), .{ .name = param.name, .previous = self.var_types.get(param.name) });
+            try self.var_types.put(param.name, type_name);
+        }
+        return saved.items;
+    }
+    
+    fn restoreVarTypes(self: *CodeGen, saved: []const SavedVarType) void {
+        var i = saved.len;
+        while (i > 0) {
+            i -= 1;
+            if (saved[i].previous) |previous| {
+                self.var_types.put(saved[i].name, previous) catch {};
+            } else {
+                _ = self.var_types.remove(saved[i].name);
+            }
+        }
+    }
+
+    /// 🆕 v0.2.0: `static inline int32_t paw_read_i32(int64_t ptr, int32_t offset) { return ((int32_t*)(intptr_t)ptr)[offset]; }`
+    fn generateInlineAccessor(self: *CodeGen, func: ast.FunctionDecl, access: intrinsics.Accessor) !void {
+        const ptr = func.params[0].name;
+        const offset = func.params[1].name;
+        const c_type = access.element.cType();
+        
+        try self.output.print(self.allocator, "static inline {s} {s}(", .{ self.typeToC(func.return_type), func.name });
+        for (func.params, 0..) |param, i| {
+            if (i > 0) try self.output.appendSlice(self.allocator, ", ");
+            try self.output.print(self.allocator, "{s} {s}", .{ self.typeToC(param.type), param.name });
+        }
+        if (access.write) {
+            try self.output.print(self.allocator, ") {{ (({s}*)(intptr_t){s})[{s}] = {s}; }}\n", .{ c_type, ptr, offset, func.params[2].name });
+        } else {
+            try self.output.print(self.allocator, ") {{ return (({s}*)(intptr_t){s})[{s}]; }}\n", .{ c_type, ptr, offset });
+        }
+    }
+    
+    /// 🆕 v0.2.0: size_of<T> / ptr_read<T> / ptr_write<T> 展开为 sizeof 和下标访问（见 intrinsics.zig）
+    /// 在泛型方法体中，T 按当前方法实例的类型实参替换
+    fn generateGenericIntrinsic(self: *CodeGen, name: []const u8, type_args: []ast.Type, args: []ast.Expr) std.mem.Allocator.Error!bool {
+        const kind = intrinsics.generic(name) orelse return false;
+        const decl = self.function_table.get(name) orelse return false;
+        if (!decl.is_extern or type_args.len != 1 or args.len != kind.arity()) return false;
+        
+        const element = if (self.current_method_context) |ctx|
+            try self.substituteGenericType(type_args[0], ctx.type_params, ctx.type_args)
+        else
+            type_args[0];
+        const c_type = self.typeToC(element);
+        
+        if (kind == .size_of) {
+            try self.output.print(self.allocator, "((int64_t)sizeof({s}))", .{c_type});
+            return true;
+        }
+        
+        try self.output.print(self.allocator, "(({s}*)(intptr_t)(", .{c_type});
+        try self.generateExpr(args[0]);
+        try self.output.appendSlice(self.allocator, "))[");
+        try self.generateExpr(args[1]);
+        try self.output.appendSlice(self.allocator, "]");
+        if (kind == .ptr_write) {
+            try self.output.appendSlice(self.allocator, " = ");
+            try self.generateExpr(args[2]);
+        }
+        return true;
+    }
+    
     fn generateFunction(self: *CodeGen, func: ast.FunctionDecl) !void {
+        const zone = prof.zone(if (self.emit == .interface) null else self.profiler, "codegen", func.name);
+        defer zone.end();
+        
         // 🆕 跳过泛型函数（需要实例化后才能生成）
         if (func.type_params.len > 0) {
             // 泛型函数：跳过，等待实例化
             return;
         }
         
+        // 🆕 v0.2.0: 外部函数只有原型（分片输出时原型已在头文件中）
+        if (func.is_extern and self.emit == .implementation) return;
+        
+        // 🆕 v0.2.0: 内存访问器生成 static inline 定义，不调用运行时库（见 intrinsics.zig）
+        if (func.is_extern) {
+            if (intrinsics.accessor(func.name)) |access| {
+                if (func.params.len == access.arity()) return self.generateInlineAccessor(func, access);
+            }
+        }
+        
+        // 🆕 v0.2.0: 原型不需要位置信息
+        if (self.emit != .interface and !func.is_extern) try self.emitLineDirective(func);
+        
         // 生成函数签名
         try self.output.appendSlice(self.allocator, self.typeToC(func.return_type));
         try self.output.appendSlice(self.allocator, " ");
@@ -299,6 +581,12 @@ pub const CodeGen = struct {
             try self.output.appendSlice(self.allocator, param.name);
         }
         
+        // 🆕 v0.2.0: 头文件中只生成原型
+        if (self.emit == .interface or func.is_extern) {
+            try self.output.appendSlice(self.allocator, ");\n");
+            return;
+        }
+        
         try self.output.appendSlice(self.allocator, ") {\n");
         
         // 生成函数体
@@ -320,6 +608,17 @@ pub const CodeGen = struct {
         try self.output.appendSlice(self.allocator, "}\n");
     }
     
+    /// 🆕 v0.2.0: -g：把接下来的 C 代码映射回 .paw 文件中函数的声明行
+    fn emitLineDirective(self: *CodeGen, func: ast.FunctionDecl) !void {
+        if (!self.debug_info or func.line == 0 or func.source_file.len == 0) return;
+        try self.output.print(self.allocator, "#line {d} \"", .{func.line});
+        for (func.source_file) |c| {
+            if (c == '\\' or c == '"') try self.output.append(self.allocator, '\\');
+            try self.output.append(self.allocator, c);
+        }
+        try self.output.appendSlice(self.allocator, "\"\n");
+    }
+    
     fn generateTypeDecl(self: *CodeGen, type_decl: ast.TypeDecl) !void {
         switch (type_decl.kind) {
             .struct_type => |st| {
@@ -328,6 +627,14 @@ pub const CodeGen = struct {
                     return;
                 }
                 
+                // 🆕 v0.2.0: 实现单元中只需要方法实现
+                if (self.emit == .implementation) {
+                    for (st.methods) |method| {
+                        try self.generateMethodImpl(type_decl.name, method);
+                    }
+                    return;
+                }
+                
                 // 🆕 先声明 struct 类型
                 try self.output.appendSlice(self.allocator, "typedef struct ");
                 try self.output.appendSlice(self.allocator, type_decl.name);
@@ -354,13 +661,34 @@ pub const CodeGen = struct {
                 try self.output.appendSlice(self.allocator, "};\n\n");
                 
                 // 生成方法实现
-                for (st.methods) |method| {
-                    try self.generateMethodImpl(type_decl.name, method);
+                if (self.emit == .all) {
+                    for (st.methods) |method| {
+                        try self.generateMethodImpl(type_decl.name, method);
+                    }
                 }
             },
             .enum_type => |et| {
                 // 🆕 Rust风格的enum需要用tagged union实现
                 
+                // 有variant带参数时需要生成union和构造器
+                var has_data = false;
+                for (et.variants) |variant| {
+                    if (variant.fields.len > 0) {
+                        has_data = true;
+                        break;
+                    }
+                }
+                
+                // 🆕 v0.2.0: 实现单元中只需要构造器
+                if (self.emit == .implementation) {
+                    if (has_data) {
+                        for (et.variants) |variant| {
+                            try self.generateEnumConstructor(type_decl.name, variant);
+                        }
+                    }
+                    return;
+                }
+                
                 // 1. 生成Tag枚举（使用_TAG后缀避免冲突）
                 try self.output.appendSlice(self.allocator, "typedef enum {\n");
                 for (et.variants) |variant| {
@@ -375,14 +703,6 @@ pub const CodeGen = struct {
                 try self.output.appendSlice(self.allocator, "_Tag;\n\n");
                 
                 // 2. 如果有variant带参数，生成union
-                var has_data = false;
-                for (et.variants) |variant| {
-                    if (variant.fields.len > 0) {
-                        has_data = true;
-                        break;
-                    }
-                }
-                
                 if (has_data) {
                     // 生成包含tag和data的struct
                     try self.output.appendSlice(self.allocator, "typedef struct {\n");
@@ -624,6 +944,9 @@ pub const CodeGen = struct {
                             try self.output.appendSlice(self.allocator, smc.type_name);
                             type_name = smc.type_name;
                         }
+                    } else if (init_expr == .as_expr) {
+                        // 🆕 v0.2.0: 转换表达式的类型就是目标类型（内联展开的调用也是这种形式）
+                        try self.output.appendSlice(self.allocator, self.typeToC(init_expr.as_expr.target_type));
                     } else if (init_expr == .call and init_expr.call.callee.* == .identifier) {
                         // 🆕 检查是否是enum构造器调用
                         const callee_name = init_expr.call.callee.identifier;
@@ -798,10 +1121,11 @@ pub const CodeGen = struct {
                         const var_name = field.object.identifier;
                         if (self.var_types.get(var_name)) |type_name| {
                             // 找到类型，生成 TypeName_method(&obj, args...)
+                            // 🆕 v0.2.0: 方法体中的 self 本身就是 TypeName*，直接传递
                             try self.output.appendSlice(self.allocator, type_name);
                             try self.output.appendSlice(self.allocator, "_");
                             try self.output.appendSlice(self.allocator, field.field);
-                            try self.output.appendSlice(self.allocator, "(&");
+                            try self.output.appendSlice(self.allocator, if (std.mem.eql(u8, var_name, "self")) "(" else "(&");
                             try self.output.appendSlice(self.allocator, var_name);
                             for (call.args) |arg| {
                                 try self.output.appendSlice(self.allocator, ", ");
@@ -840,40 +1164,18 @@ pub const CodeGen = struct {
                         try self.output.appendSlice(self.allocator, ")");
                     } else if (std.mem.eql(u8, func_name, "println")) {
                         // 🆕 内置函数 println
-                        try self.output.appendSlice(self.allocator, "printf(\"%s\\n\", ");
-                        if (call.args.len > 0) {
-                            _ = try self.generateExpr(call.args[0]);
-                        } else {
-                            try self.output.appendSlice(self.allocator, "\"\"");
-                        }
-                        try self.output.appendSlice(self.allocator, ")");
+                        try self.generatePrintBuiltin("printf(\"%s\\n\", ", call.args);
                     } else if (std.mem.eql(u8, func_name, "print")) {
                         // 🆕 内置函数 print
-                        try self.output.appendSlice(self.allocator, "printf(\"%s\", ");
-                        if (call.args.len > 0) {
-                            _ = try self.generateExpr(call.args[0]);
-                        } else {
-                            try self.output.appendSlice(self.allocator, "\"\"");
-                        }
-                        try self.output.appendSlice(self.allocator, ")");
+                        try self.generatePrintBuiltin("printf(\"%s\", ", call.args);
                     } else if (std.mem.eql(u8, func_name, "eprintln")) {
                         // 🆕 内置函数 eprintln
-                        try self.output.appendSlice(self.allocator, "fprintf(stderr, \"%s\\n\", ");
-                        if (call.args.len > 0) {
-                            _ = try self.generateExpr(call.args[0]);
-                        } else {
-                            try self.output.appendSlice(self.allocator, "\"\"");
-                        }
-                        try self.output.appendSlice(self.allocator, ")");
+                        try self.generatePrintBuiltin("fprintf(stderr, \"%s\\n\", ", call.args);
                     } else if (std.mem.eql(u8, func_name, "eprint")) {
                         // 🆕 内置函数 eprint
-                        try self.output.appendSlice(self.allocator, "fprintf(stderr, \"%s\", ");
-                        if (call.args.len > 0) {
-                            _ = try self.generateExpr(call.args[0]);
-                        } else {
-                            try self.output.appendSlice(self.allocator, "\"\"");
-                        }
-                        try self.output.appendSlice(self.allocator, ")");
+                        try self.generatePrintBuiltin("fprintf(stderr, \"%s\", ", call.args);
+                    } else if (try self.generateGenericIntrinsic(func_name, call.type_args, call.args)) {
+                        // 🆕 v0.2.0: size_of / ptr_read / ptr_write 已按具体类型展开
                     } else {
                         // 普通函数调用（可能是泛型）
                         // 🆕 检查是否是泛型函数
@@ -1143,40 +1445,69 @@ pub const CodeGen = struct {
     }
     
     // 🆕 生成字符串插值代码
-    // 策略：使用 sprintf 拼接字符串
+    // 🆕 v0.2.0: 每个部分格式化为 PawStrPart（指针 + 长度），paw_str_join 一次分配拼接结果
+    // 结果在堆上，不截断、可重入；直接交给 println 等内置函数时打印后立即释放
     fn generateStringInterpolation(self: *CodeGen, parts: []ast.StringInterpPart) (std.mem.Allocator.Error)!void {
-        // 简化实现：生成立即执行的代码块，返回拼接后的字符串
+        var count_buf: [32]u8 = undefined;
+        const count = std.fmt.bufPrint(&count_buf, "{d}", .{parts.len}) catch unreachable;
+        
         try self.output.appendSlice(self.allocator, "({\n");
-        try self.output.appendSlice(self.allocator, "    static char __str_buf__[1024];\n");
-        try self.output.appendSlice(self.allocator, "    __str_buf__[0] = '\\0';\n");
+        try self.output.appendSlice(self.allocator, "    PawStrPart __parts__[");
+        try self.output.appendSlice(self.allocator, count);
+        try self.output.appendSlice(self.allocator, "];\n");
         
-        // 逐个拼接每个部分
-        for (parts) |part| {
+        for (parts, 0..) |part, i| {
+            var index_buf: [32]u8 = undefined;
+            const index = std.fmt.bufPrint(&index_buf, "{d}", .{i}) catch unreachable;
             switch (part) {
                 .literal => |lit| {
-                    if (lit.len > 0) {
-                        try self.output.appendSlice(self.allocator, "    strcat(__str_buf__, \"");
-                        try self.output.appendSlice(self.allocator, lit);
-                        try self.output.appendSlice(self.allocator, "\");\n");
-                    }
+                    // 字面量长度在编译期确定（sizeof 同时处理转义序列）
+                    try self.output.appendSlice(self.allocator, "    __parts__[");
+                    try self.output.appendSlice(self.allocator, index);
+                    try self.output.appendSlice(self.allocator, "].ptr = \"");
+                    try self.output.appendSlice(self.allocator, lit);
+                    try self.output.appendSlice(self.allocator, "\"; __parts__[");
+                    try self.output.appendSlice(self.allocator, index);
+                    try self.output.appendSlice(self.allocator, "].len = sizeof(\"");
+                    try self.output.appendSlice(self.allocator, lit);
+                    try self.output.appendSlice(self.allocator, "\") - 1;\n");
                 },
                 .expr => |expr| {
-                    // 将表达式转换为字符串并拼接
-                    try self.output.appendSlice(self.allocator, "    {\n");
-                    try self.output.appendSlice(self.allocator, "        char __tmp__[64];\n");
-                    try self.output.appendSlice(self.allocator, "        sprintf(__tmp__, \"%d\", ");
+                    try self.output.appendSlice(self.allocator, "    PAW_PART(&__parts__[");
+                    try self.output.appendSlice(self.allocator, index);
+                    try self.output.appendSlice(self.allocator, "], (");
                     try self.generateExpr(expr);
-                    try self.output.appendSlice(self.allocator, ");\n");
-                    try self.output.appendSlice(self.allocator, "        strcat(__str_buf__, __tmp__);\n");
-                    try self.output.appendSlice(self.allocator, "    }\n");
+                    try self.output.appendSlice(self.allocator, "));\n");
                 },
             }
         }
         
-        try self.output.appendSlice(self.allocator, "    __str_buf__;\n");
+        try self.output.appendSlice(self.allocator, "    paw_str_join(__parts__, ");
+        try self.output.appendSlice(self.allocator, count);
+        try self.output.appendSlice(self.allocator, ");\n");
         try self.output.appendSlice(self.allocator, "})");
     }
     
+    /// 🆕 v0.2.0: println / print / eprintln / eprint
+    /// head 是 "printf(\"%s\\n\", " 这样的调用开头；参数是字符串插值时打印后释放拼接结果
+    fn generatePrintBuiltin(self: *CodeGen, head: []const u8, args: []ast.Expr) (std.mem.Allocator.Error)!void {
+        if (args.len > 0 and args[0] == .string_interp) {
+            try self.output.appendSlice(self.allocator, "({ char* __msg__ = ");
+            try self.generateExpr(args[0]);
+            try self.output.appendSlice(self.allocator, "; int __ret__ = ");
+            try self.output.appendSlice(self.allocator, head);
+            try self.output.appendSlice(self.allocator, "__msg__); paw_str_free(__msg__); __ret__; })");
+            return;
+        }
+        try self.output.appendSlice(self.allocator, head);
+        if (args.len > 0) {
+            _ = try self.generateExpr(args[0]);
+        } else {
+            try self.output.appendSlice(self.allocator, "\"\"");
+        }
+        try self.output.appendSlice(self.allocator, ")");
+    }
+    
     // 🆕 生成 loop iterator (loop i in collection)
     fn generateLoopIterator(self: *CodeGen, iter: ast.LoopIterator, body: []ast.Stmt) (std.mem.Allocator.Error)!void {
         // 检查 iterable 是否是范围表达式
@@ -1500,7 +1831,6 @@ pub const CodeGen = struct {
     
     /// 获取类型的简化名（用于name mangling）
     fn getSimpleTypeName(self: *CodeGen, paw_type: ast.Type) []const u8 {
-        _ = self;
         return switch (paw_type) {
             .i8 => "i8",
             .i16 => "i16",
@@ -1520,6 +1850,14 @@ pub const CodeGen = struct {
             .void => "void",
             .generic => |name| name,
             .named => |name| name,
+            // 🆕 v0.2.0: 与 Monomorphizer 的修饰一致：[i32; 3] -> arr3_i32，[i32] -> arr_i32
+            .array => |arr| blk: {
+                const element = self.getSimpleTypeName(arr.element.*);
+                break :blk if (arr.size) |size|
+                    std.fmt.allocPrint(self.arena.allocator(), "arr{d}_{s}", .{ size, element }) catch "unknown"
+                else
+                    std.fmt.allocPrint(self.arena.allocator(), "arr_{s}", .{element}) catch "unknown";
+            },
             else => "unknown",
         };
     }
@@ -1735,7 +2073,7 @@ pub const CodeGen = struct {
         
         for (instances) |instance| {
             if (self.function_table.get(instance.generic_name)) |generic_func| {
-                if (generic_func.type_params.len > 0 and instance.type_args.len > 0) {
+                if (generic_func.type_params.len > 0 and instance.type_args.len > 0 and !generic_func.is_extern) {
                     // 🆕 返回类型：使用第一个类型参数（简化）
                     const return_type = instance.type_args[0];
                     
@@ -1879,7 +2217,7 @@ pub const CodeGen = struct {
         for (instances) |instance| {
             // 获取原始泛型函数
             if (self.function_table.get(instance.generic_name)) |generic_func| {
-                if (generic_func.type_params.len > 0 and instance.type_args.len > 0) {
+                if (generic_func.type_params.len > 0 and instance.type_args.len > 0 and !generic_func.is_extern) {
                     // 🆕 返回类型：使用第一个类型参数
                     const return_type = instance.type_args[0];
                     
@@ -1976,12 +2314,21 @@ pub const CodeGen = struct {
                                 .type_args = method_instance.type_args,
                             };
                             
+                            // 🆕 v0.2.0: self 的类型是单态化后的结构体（Vec_i32），
+                            // self.reserve(1) 生成 Vec_i32_reserve(self, 1)
+                            const self_type = self.typeToC(.{ .generic_instance = .{
+                                .name = method_instance.struct_name,
+                                .type_args = method_instance.type_args,
+                            } });
+                            const saved = try self.bindParamTypes(method.params, self_type, type_decl.type_params, method_instance.type_args);
+                            
                             // 生成方法体
                             for (method.body) |stmt| {
                                 try self.generateStmt(stmt);
                             }
                             
                             // 清除方法上下文
+                            self.restoreVarTypes(saved);
                             self.current_method_context = null;
                             
                             try self.output.appendSlice(self.allocator, "}\n\n");
@@ -18,6 +18,8 @@
 
 const std = @import("std");
 const Token = @import("token.zig").Token;
+const source_map = @import("source_map.zig");  // 🆕 v0.2.0
+const SourceMap = source_map.SourceMap;
 
 // ============================================================================
 // Span - Source Code Location
@@ -121,7 +123,8 @@ pub const Diagnostic = struct {
     }
     
     /// Print diagnostic to stderr with colors and source code snippet
-    pub fn print(self: Diagnostic, allocator: std.mem.Allocator) !void {
+    /// 🆕 v0.2.0: 片段取自本次编译共享的 SourceMap；为 null 时只打印位置
+    pub fn print(self: Diagnostic, sources: ?*SourceMap) !void {
         // Print main error message with color
         std.debug.print("{s}{s}\x1b[0m: {s}\n", .{
             self.level.color(),
@@ -139,7 +142,7 @@ pub const Diagnostic = struct {
             });
             
             // Print source code snippet
-            try printSourceSnippet(allocator, span);
+            if (sources) |map| try printSourceSnippet(span, map);
         }
         
         // Print notes
@@ -167,60 +170,43 @@ pub const Diagnostic = struct {
 // ============================================================================
 
 /// Print source code snippet with error marker
-fn printSourceSnippet(allocator: std.mem.Allocator, span: Span) !void {
-    // Read source file
-    const source = std.fs.cwd().readFileAlloc(
-        allocator,
-        span.filename,
-        10 * 1024 * 1024,
-    ) catch {
-        // If we can't read the file, just skip the snippet
-        return;
-    };
-    defer allocator.free(source);
-    
-    // Split into lines
-    var lines = std.mem.splitScalar(u8, source, '\n');
-    var current_line: usize = 1;
-    
-    // Find and print the relevant line
-    while (lines.next()) |line| {
-        if (current_line == span.start_line) {
-            // Print line number gutter
-            std.debug.print("   {s}|\x1b[0m\n", .{"\x1b[1;36m"});  // Cyan
-            
-            // Print line number and code
-            std.debug.print(" {s}{d:>3} |\x1b[0m {s}\n", .{
-                "\x1b[1;36m",  // Cyan
-                current_line,
-                line,
-            });
-            
-            // Print error marker
-            std.debug.print("   {s}|", .{"\x1b[1;36m"});  // Cyan
-            
-            // Calculate spaces before ^
-            var i: usize = 0;
-            while (i < span.start_col) : (i += 1) {
-                std.debug.print(" ", .{});
-            }
-            
-            // Print ^ markers
-            std.debug.print("\x1b[1;31m", .{});  // Red
-            const marker_len = if (span.end_col > span.start_col) 
-                span.end_col - span.start_col + 1 
-            else 
-                1;
-            i = 0;
-            while (i < marker_len) : (i += 1) {
-                std.debug.print("^", .{});
-            }
-            
-            std.debug.print("\x1b[0m\n", .{});
-            break;
-        }
-        current_line += 1;
+/// 🆕 v0.2.0: 使用 SourceMap 中已映射的文件和行索引，不再每条诊断都重读整个文件
+fn printSourceSnippet(span: Span, sources: *SourceMap) !void {
+    // If we can't read the file, just skip the snippet
+    const file = sources.open(span.filename) catch return;
+    const line = (try file.line(span.start_line)) orelse return;
+    
+    // Print line number gutter
+    std.debug.print("   {s}|\x1b[0m\n", .{"\x1b[1;36m"});  // Cyan
+    
+    // Print line number and code
+    std.debug.print(" {s}{d:>3} |\x1b[0m {s}\n", .{
+        "\x1b[1;36m",  // Cyan
+        span.start_line,
+        line,
+    });
+    
+    // Print error marker
+    std.debug.print("   {s}|", .{"\x1b[1;36m"});  // Cyan
+    
+    // Calculate spaces before ^
+    var i: usize = 0;
+    while (i < span.start_col) : (i += 1) {
+        std.debug.print(" ", .{});
     }
+    
+    // Print ^ markers
+    std.debug.print("\x1b[1;31m", .{});  // Red
+    const marker_len = if (span.end_col > span.start_col) 
+        span.end_col - span.start_col + 1 
+    else 
+        1;
+    i = 0;
+    while (i < marker_len) : (i += 1) {
+        std.debug.print("^", .{});
+    }
+    
+    std.debug.print("\x1b[0m\n", .{});
 }
 
 // ============================================================================
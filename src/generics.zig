@@ -88,6 +88,173 @@ pub const GenericMethodInstance = struct {
     }
 };
 
+// ============================================================================
+// 🆕 v0.2.0: 实例化键 - 按类型实参的结构化哈希去重
+// ============================================================================
+
+/// 把类型的结构写入 hasher：结构相同的类型哈希相同，与节点在内存中的位置无关
+/// 区分粒度与名称修饰一致：定长数组的长度参与（[i32; 3] 修饰为 arr3_i32），
+/// 函数类型只按种类区分（修饰名都是 unknown），同一个修饰名只对应一个实例
+pub fn hashType(hasher: *std.hash.Wyhash, ty: ast.Type) void {
+    hasher.update(&[_]u8{@intFromEnum(ty)});
+    switch (ty) {
+        .generic, .named => |name| hashName(hasher, name),
+        .pointer => |pointee| hashType(hasher, pointee.*),
+        .array => |arr| {
+            // 长度为 null（[T]）与任何定长数组都不同
+            hasher.update(&[_]u8{@intFromBool(arr.size != null)});
+            hasher.update(std.mem.asBytes(&@as(u64, arr.size orelse 0)));
+            hashType(hasher, arr.element.*);
+        },
+        .generic_instance => |gi| {
+            hashName(hasher, gi.name);
+            hashTypes(hasher, gi.type_args);
+        },
+        else => {},
+    }
+}
+
+fn hashTypes(hasher: *std.hash.Wyhash, types: []const ast.Type) void {
+    hasher.update(std.mem.asBytes(&@as(u64, types.len)));
+    for (types) |ty| hashType(hasher, ty);
+}
+
+fn hashName(hasher: *std.hash.Wyhash, name: []const u8) void {
+    hasher.update(std.mem.asBytes(&@as(u64, name.len)));
+    hasher.update(name);
+}
+
+/// 与 hashType 相同粒度的结构相等
+pub fn sameType(a: ast.Type, b: ast.Type) bool {
+    if (@intFromEnum(a) != @intFromEnum(b)) return false;
+    return switch (a) {
+        .generic => |name| std.mem.eql(u8, name, b.generic),
+        .named => |name| std.mem.eql(u8, name, b.named),
+        .pointer => |pointee| sameType(pointee.*, b.pointer.*),
+        .array => |arr| std.meta.eql(arr.size, b.array.size) and sameType(arr.element.*, b.array.element.*),
+        .generic_instance => |gi| std.mem.eql(u8, gi.name, b.generic_instance.name) and
+            sameTypes(gi.type_args, b.generic_instance.type_args),
+        else => true,
+    };
+}
+
+fn sameTypes(a: []const ast.Type, b: []const ast.Type) bool {
+    if (a.len != b.len) return false;
+    for (a, b) |x, y| {
+        if (!sameType(x, y)) return false;
+    }
+    return true;
+}
+
+/// 一个实例：泛型函数 / 泛型类型（owner 为空）或泛型类型的方法（owner = 类型名）
+/// 哈希在创建时算好，查表时不再遍历类型，也不需要先构造修饰名
+pub const InstanceKey = struct {
+    owner: []const u8,
+    name: []const u8,
+    type_args: []const ast.Type,
+    hash: u64,
+
+    pub fn init(owner: []const u8, name: []const u8, type_args: []const ast.Type) InstanceKey {
+        var hasher = std.hash.Wyhash.init(0);
+        hashName(&hasher, owner);
+        hashName(&hasher, name);
+        hashTypes(&hasher, type_args);
+        return InstanceKey{ .owner = owner, .name = name, .type_args = type_args, .hash = hasher.final() };
+    }
+
+    pub fn eql(self: InstanceKey, other: InstanceKey) bool {
+        return self.hash == other.hash and
+            std.mem.eql(u8, self.name, other.name) and
+            std.mem.eql(u8, self.owner, other.owner) and
+            sameTypes(self.type_args, other.type_args);
+    }
+};
+
+pub const InstanceKeyContext = struct {
+    pub fn hash(_: InstanceKeyContext, key: InstanceKey) u64 {
+        return key.hash;
+    }
+
+    pub fn eql(_: InstanceKeyContext, a: InstanceKey, b: InstanceKey) bool {
+        return a.eql(b);
+    }
+};
+
+/// 以 InstanceKey 为键的哈希表（键中的切片由调用方保证存活）
+pub fn InstanceMap(comptime V: type) type {
+    return std.HashMap(InstanceKey, V, InstanceKeyContext, std.hash_map.default_max_load_percentage);
+}
+
+/// 深拷贝类型（名字和嵌套的类型实参都分配在 allocator 中）
+pub fn cloneType(allocator: std.mem.Allocator, ty: ast.Type) std.mem.Allocator.Error!ast.Type {
+    return switch (ty) {
+        .generic => |name| ast.Type{ .generic = try allocator.dupe(u8, name) },
+        .named => |name| ast.Type{ .named = try allocator.dupe(u8, name) },
+        .pointer => |pointee| blk: {
+            const copy = try allocator.create(ast.Type);
+            copy.* = try cloneType(allocator, pointee.*);
+            break :blk ast.Type{ .pointer = copy };
+        },
+        .array => |arr| blk: {
+            const element = try allocator.create(ast.Type);
+            element.* = try cloneType(allocator, arr.element.*);
+            break :blk ast.Type{ .array = .{ .element = element, .size = arr.size } };
+        },
+        .function => |func| blk: {
+            const return_type = try allocator.create(ast.Type);
+            return_type.* = try cloneType(allocator, func.return_type.*);
+            break :blk ast.Type{ .function = .{ .params = try cloneTypes(allocator, func.params), .return_type = return_type } };
+        },
+        .generic_instance => |gi| ast.Type{ .generic_instance = .{
+            .name = try allocator.dupe(u8, gi.name),
+            .type_args = try cloneTypes(allocator, gi.type_args),
+        } },
+        else => ty,
+    };
+}
+
+fn cloneTypes(allocator: std.mem.Allocator, types: []const ast.Type) std.mem.Allocator.Error![]ast.Type {
+    const copies = try allocator.alloc(ast.Type, types.len);
+    for (types, copies) |ty, *copy| copy.* = try cloneType(allocator, ty);
+    return copies;
+}
+
+/// 🆕 v0.2.0: 跨模块共享的实例表：已经在之前的模块中生成过函数体的实例
+/// JIT 会话中 REPL 的每次输入都是一个新模块；有了它，Vec<i32> 的方法等特化
+/// 只在第一次用到的模块里生成，之后的模块只声明并链接到已有的定义
+/// 键复制到自己的 arena 中：登记它们的模块（及其 AST）之后会被释放
+pub const InstanceRegistry = struct {
+    arena: std.heap.ArenaAllocator,
+    defined: InstanceMap(void),
+
+    pub fn init(allocator: std.mem.Allocator) InstanceRegistry {
+        return InstanceRegistry{
+            .arena = std.heap.ArenaAllocator.init(allocator),
+            .defined = InstanceMap(void).init(allocator),
+        };
+    }
+
+    pub fn deinit(self: *InstanceRegistry) void {
+        self.defined.deinit();
+        self.arena.deinit();
+    }
+
+    pub fn contains(self: *const InstanceRegistry, key: InstanceKey) bool {
+        return self.defined.contains(key);
+    }
+
+    pub fn add(self: *InstanceRegistry, key: InstanceKey) !void {
+        if (self.defined.contains(key)) return;
+        const arena = self.arena.allocator();
+        try self.defined.put(InstanceKey{
+            .owner = try arena.dupe(u8, key.owner),
+            .name = try arena.dupe(u8, key.name),
+            .type_args = try cloneTypes(arena, key.type_args),
+            .hash = key.hash,
+        }, {});
+    }
+};
+
 // ============================================================================
 // 类型推导引擎
 // ============================================================================
@@ -283,23 +450,24 @@ pub const Monomorphizer = struct {
     allocator: std.mem.Allocator,
     instances: std.ArrayList(GenericInstance),
     /// 记录已实例化的泛型，避免重复
-    seen: std.StringHashMap(void),
+    /// 🆕 v0.2.0: 按结构化键查找，值是实例在对应列表中的下标；修饰名只在第一次遇到时构造
+    seen: InstanceMap(usize),
     /// 🆕 泛型结构体实例
     struct_instances: std.ArrayList(GenericStructInstance),
-    struct_seen: std.StringHashMap(void),
+    struct_seen: InstanceMap(usize),
     /// 🆕 泛型方法实例
     method_instances: std.ArrayList(GenericMethodInstance),
-    method_seen: std.StringHashMap(void),
+    method_seen: InstanceMap(usize),
 
     pub fn init(allocator: std.mem.Allocator) Monomorphizer {
         return Monomorphizer{
             .allocator = allocator,
             .instances = std.ArrayList(GenericInstance){},
-            .seen = std.StringHashMap(void).init(allocator),
+            .seen = InstanceMap(usize).init(allocator),
             .struct_instances = std.ArrayList(GenericStructInstance){},
-            .struct_seen = std.StringHashMap(void).init(allocator),
+            .struct_seen = InstanceMap(usize).init(allocator),
             .method_instances = std.ArrayList(GenericMethodInstance){},
-            .method_seen = std.StringHashMap(void).init(allocator),
+            .method_seen = InstanceMap(usize).init(allocator),
         };
     }
 
@@ -323,31 +491,24 @@ pub const Monomorphizer = struct {
         self.method_seen.deinit();
     }
 
-    /// 记录一个泛型实例化
+    /// 记录一个泛型实例化（接管 type_args 的所有权）
     pub fn recordInstance(
         self: *Monomorphizer,
         generic_name: []const u8,
         type_args: []ast.Type,
     ) ![]const u8 {
-        const mangled = try self.mangleName(generic_name, type_args);
-        
-        // 检查是否已经实例化过
-        if (self.seen.contains(mangled)) {
-            // 已存在，释放传入的 type_args 和 mangled
+        // 已经实例化过：释放传入的 type_args，返回已有实例的修饰名
+        const key = InstanceKey.init("", generic_name, type_args);
+        if (self.seen.get(key)) |index| {
             self.allocator.free(type_args);
-            self.allocator.free(mangled);
-            // 返回已存在的 mangled name
-            for (self.instances.items) |instance| {
-                if (std.mem.eql(u8, instance.generic_name, generic_name) and 
-                    instance.type_args.len == type_args.len) {
-                    return instance.mangled_name;
-                }
-            }
-            return generic_name; // fallback
+            return self.instances.items[index].mangled_name;
         }
 
-        try self.seen.put(mangled, {});
-        try self.instances.append(self.allocator, GenericInstance{
+        const mangled = try self.mangleName(generic_name, type_args);
+        errdefer self.allocator.free(mangled);
+        try self.instances.ensureUnusedCapacity(self.allocator, 1);
+        try self.seen.put(key, self.instances.items.len);
+        self.instances.appendAssumeCapacity(GenericInstance{
             .generic_name = generic_name,
             .type_args = type_args,
             .mangled_name = mangled,
@@ -356,33 +517,23 @@ pub const Monomorphizer = struct {
         return mangled;
     }
 
-    /// 🆕 记录一个泛型结构体实例化
+    /// 🆕 记录一个泛型结构体实例化（接管 type_args 的所有权）
     pub fn recordStructInstance(
         self: *Monomorphizer,
         struct_name: []const u8,
         type_args: []ast.Type,
     ) ![]const u8 {
-        const mangled = try self.mangleName(struct_name, type_args);
-        
-        // 检查是否已经实例化过
-        if (self.struct_seen.contains(mangled)) {
-            // 已存在，释放传入的 type_args 和 mangled
+        const key = InstanceKey.init("", struct_name, type_args);
+        if (self.struct_seen.get(key)) |index| {
             self.allocator.free(type_args);
-            self.allocator.free(mangled);
-            // 返回已存在的 mangled name
-            for (self.struct_instances.items) |instance| {
-                if (std.mem.eql(u8, instance.generic_name, struct_name)) {
-                    // 检查 type_args 是否匹配
-                    if (instance.type_args.len == type_args.len) {
-                        return instance.mangled_name;
-                    }
-                }
-            }
-            return mangled; // fallback
+            return self.struct_instances.items[index].mangled_name;
         }
 
-        try self.struct_seen.put(mangled, {});
-        try self.struct_instances.append(self.allocator, GenericStructInstance{
+        const mangled = try self.mangleName(struct_name, type_args);
+        errdefer self.allocator.free(mangled);
+        try self.struct_instances.ensureUnusedCapacity(self.allocator, 1);
+        try self.struct_seen.put(key, self.struct_instances.items.len);
+        self.struct_instances.appendAssumeCapacity(GenericStructInstance{
             .generic_name = struct_name,
             .type_args = type_args,
             .mangled_name = mangled,
@@ -391,40 +542,28 @@ pub const Monomorphizer = struct {
         return mangled;
     }
 
-    /// 🆕 记录一个泛型方法实例化
+    /// 🆕 记录一个泛型方法实例化（接管 type_args 的所有权）
     pub fn recordMethodInstance(
         self: *Monomorphizer,
         struct_name: []const u8,
         method_name: []const u8,
         type_args: []ast.Type,
     ) ![]const u8 {
+        const key = InstanceKey.init(struct_name, method_name, type_args);
+        if (self.method_seen.get(key)) |index| {
+            self.allocator.free(type_args);
+            return self.method_instances.items[index].mangled_name;
+        }
+
         // 生成方法的修饰名称: Vec_i32_new
         const struct_mangled = try self.mangleName(struct_name, type_args);
         defer self.allocator.free(struct_mangled);
-        
-        var mangled = std.ArrayList(u8){};
-        try mangled.appendSlice(self.allocator, struct_mangled);
-        try mangled.append(self.allocator, '_');
-        try mangled.appendSlice(self.allocator, method_name);
-        const mangled_name = try mangled.toOwnedSlice(self.allocator);
-        
-        // 检查是否已经实例化过
-        if (self.method_seen.contains(mangled_name)) {
-            // 已存在，释放传入的 type_args 和 mangled_name
-            self.allocator.free(type_args);
-            self.allocator.free(mangled_name);
-            // 返回已存在的 mangled name
-            for (self.method_instances.items) |instance| {
-                if (std.mem.eql(u8, instance.struct_name, struct_name) and
-                    std.mem.eql(u8, instance.method_name, method_name)) {
-                    return instance.mangled_name;
-                }
-            }
-            return mangled_name; // fallback
-        }
+        const mangled_name = try std.mem.concat(self.allocator, u8, &.{ struct_mangled, "_", method_name });
+        errdefer self.allocator.free(mangled_name);
 
-        try self.method_seen.put(mangled_name, {});
-        try self.method_instances.append(self.allocator, GenericMethodInstance{
+        try self.method_instances.ensureUnusedCapacity(self.allocator, 1);
+        try self.method_seen.put(key, self.method_instances.items.len);
+        self.method_instances.appendAssumeCapacity(GenericMethodInstance{
             .struct_name = struct_name,
             .method_name = method_name,
             .type_args = type_args,
@@ -482,7 +621,9 @@ pub const Monomorphizer = struct {
                 try self.appendTypeName(buf, ptr.*);
             },
             .array => |arr| {
-                try buf.appendSlice(self.allocator, "arr_");
+                try buf.appendSlice(self.allocator, "arr");
+                if (arr.size) |size| try buf.print(self.allocator, "{d}", .{size});
+                try buf.append(self.allocator, '_');
                 try self.appendTypeName(buf, arr.element.*);
             },
             .generic_instance => |gi| {
@@ -543,6 +684,8 @@ pub const Monomorphizer = struct {
             .body = try new_body.toOwnedSlice(),
             .is_public = func.is_public,
             .is_async = func.is_async,
+            .line = func.line,
+            .source_file = func.source_file,
         };
     }
 
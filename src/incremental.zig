@@ -0,0 +1,366 @@
+//! 🆕 v0.2.0: Incremental Compilation - 增量编译基础设施
+//!
+//! 每次成功的类型检查之后，为每个顶层声明记录：
+//!   - 内容哈希：声明 AST 的结构化哈希（与空白、注释、声明位置无关）
+//!   - 依赖：声明中引用到的其它顶层声明（函数、类型、泛型实例的泛型名）
+//! 保存在 `.paw-cache/incremental/<源文件路径哈希>.json`。
+//! 状态只在编译器版本、prelude 源码哈希和编译器构建指纹都一致时才会被复用：
+//! 同一个 VERSION 下重新构建的 pawc 可能对未改变的声明给出不同的检查结论。
+//!
+//! 下次编译时：
+//!   changed = 哈希改变 / 新增 / 被删除的声明
+//!   dirty   = changed ∪ 直接或间接依赖 changed 的声明
+//! 只有 dirty 声明的函数体需要重新类型检查；其它声明上次已检查通过，
+//! 且它们依赖的一切都没有变化。
+//!
+//! 依赖是按名字收集的保守近似：声明里出现的任何与顶层声明同名的
+//! 字符串都算作依赖（多算只会导致多检查，不会漏检）。
+//! 不带枚举名的变体引用（`Red`、`Some(x)`）算作对所属枚举的依赖；
+//! impl 块以 `impl <trait> for <type>` 为键，它的目标类型和 trait 依赖它，
+//! 因此修改 impl 的方法会传播到所有引用该类型（或 trait）的声明。
+
+const std = @import("std");
+const ast = @import("ast.zig");
+const prof = @import("profiler.zig");
+const prelude = @import("prelude.zig");
+const module_cache = @import("module_cache.zig");
+
+/// 状态文件所在的子目录（位于缓存目录下）
+const state_subdir = "incremental";
+
+pub const DeclInfo = struct {
+    name: []const u8,
+    hash: u64,
+    deps: []const []const u8,
+};
+
+/// 当前程序的声明图
+pub const Graph = struct {
+    arena: std.heap.ArenaAllocator,
+    decls: std.ArrayList(DeclInfo),
+
+    pub fn deinit(self: *Graph) void {
+        self.arena.deinit();
+    }
+
+    /// 对 declarations 中每个有名字的声明计算哈希和依赖
+    pub fn build(allocator: std.mem.Allocator, declarations: []const ast.TopLevelDecl) !Graph {
+        var graph = Graph{
+            .arena = std.heap.ArenaAllocator.init(allocator),
+            .decls = .{},
+        };
+        errdefer graph.deinit();
+        const arena = graph.arena.allocator();
+
+        var names = std.StringHashMap(void).init(arena);
+        var variants = std.StringHashMap([]const u8).init(arena);  // 变体名 -> 枚举名
+        var impls = std.StringHashMap(std.ArrayList([]const u8)).init(arena);  // 类型名 / trait 名 -> impl 键
+        for (declarations) |decl| {
+            const name = try declKey(arena, decl) orelse continue;
+            try names.put(name, {});
+            for (enumVariants(decl)) |variant| {
+                if (!variants.contains(variant.name)) try variants.put(variant.name, name);
+            }
+            if (decl == .impl_decl) {
+                for ([_]?[]const u8{ typeName(decl.impl_decl.target_type), decl.impl_decl.trait_name }) |owner| {
+                    const owner_name = owner orelse continue;
+                    if (owner_name.len == 0) continue;
+                    const entry = try impls.getOrPut(owner_name);
+                    if (!entry.found_existing) entry.value_ptr.* = .{};
+                    try entry.value_ptr.append(arena, name);
+                }
+            }
+        }
+
+        for (declarations) |decl| {
+            const name = try declKey(arena, decl) orelse continue;
+
+            var deps = std.StringHashMap(void).init(arena);
+            var walker = Walker{
+                .hasher = std.hash.Wyhash.init(0),
+                .names = &names,
+                .variants = &variants,
+                .deps = &deps,
+            };
+            try walker.walk(ast.TopLevelDecl, decl);
+            if (impls.get(name)) |impl_keys| {
+                for (impl_keys.items) |impl_key| try deps.put(impl_key, {});
+            }
+            _ = deps.remove(name);
+
+            var dep_list = std.ArrayList([]const u8){};
+            var it = deps.keyIterator();
+            while (it.next()) |dep| try dep_list.append(arena, dep.*);
+
+            try graph.decls.append(arena, DeclInfo{
+                .name = name,
+                .hash = walker.hasher.final(),
+                .deps = dep_list.items,
+            });
+        }
+        return graph;
+    }
+};
+
+/// 参与增量分析的声明名；import、impl 等没有独立名字的声明返回 null
+pub fn declName(decl: ast.TopLevelDecl) ?[]const u8 {
+    return switch (decl) {
+        .function => |f| f.name,
+        .type_decl => |td| td.name,
+        .struct_decl => |sd| sd.name,
+        .enum_decl => |ed| ed.name,
+        .trait_decl => |td| td.name,
+        else => null,
+    };
+}
+
+/// 声明图中的键：有名字的声明用 declName，impl 块用 `impl <trait> for <type>`
+/// （含空格，不会与标识符冲突）
+fn declKey(arena: std.mem.Allocator, decl: ast.TopLevelDecl) !?[]const u8 {
+    if (declName(decl)) |name| return name;
+    return switch (decl) {
+        .impl_decl => |impl| try std.fmt.allocPrint(arena, "impl {s} for {s}", .{
+            impl.trait_name,
+            typeName(impl.target_type) orelse "?",
+        }),
+        else => null,
+    };
+}
+
+fn typeName(ty: ast.Type) ?[]const u8 {
+    return switch (ty) {
+        .named => |name| name,
+        .generic_instance => |gi| gi.name,
+        else => null,
+    };
+}
+
+fn enumVariants(decl: ast.TopLevelDecl) []const ast.EnumVariant {
+    return switch (decl) {
+        .type_decl => |td| switch (td.kind) {
+            .enum_type => |et| et.variants,
+            else => &.{},
+        },
+        .enum_decl => |ed| ed.variants,
+        else => &.{},
+    };
+}
+
+/// 上次成功编译时保存下来的状态
+pub const State = struct {
+    version: []const u8,
+    prelude_hash: u64 = 0,
+    build_id: u64 = 0,
+    decls: []DeclInfo,
+};
+
+/// prelude 源码哈希：prelude 改变时未改变的用户声明也可能检查失败
+const prelude_hash: u64 = blk: {
+    @setEvalBranchQuota(4_000_000);
+    break :blk std.hash.Wyhash.hash(0, prelude.source);
+};
+
+pub const Tracker = struct {
+    allocator: std.mem.Allocator,
+    cache_dir: []const u8,
+    version: []const u8,
+    build_id: ?u64,
+    state_path: []const u8,
+    previous: ?std.json.Parsed(State),
+
+    /// 读取 source_file 上次的增量状态
+    /// 不存在、或版本 / prelude / 编译器构建不符时视为全量编译
+    pub fn init(allocator: std.mem.Allocator, cache_dir: []const u8, version: []const u8, source_file: []const u8) !Tracker {
+        const key = std.hash.Wyhash.hash(0, source_file);
+        const state_path = try std.fmt.allocPrint(allocator, "{s}/{s}/{x:0>16}.json", .{ cache_dir, state_subdir, key });
+        errdefer allocator.free(state_path);
+
+        var tracker = Tracker{
+            .allocator = allocator,
+            .cache_dir = cache_dir,
+            .version = version,
+            .build_id = module_cache.compilerBuildId(),
+            .state_path = state_path,
+            .previous = null,
+        };
+        if (tracker.build_id != null) {
+            tracker.previous = tracker.loadState() catch null;
+        }
+        return tracker;
+    }
+
+    pub fn deinit(self: *Tracker) void {
+        if (self.previous) |*previous| previous.deinit();
+        self.allocator.free(self.state_path);
+    }
+
+    fn loadState(self: *Tracker) !?std.json.Parsed(State) {
+        const bytes = std.fs.cwd().readFileAlloc(self.allocator, self.state_path, 64 * 1024 * 1024) catch |err| switch (err) {
+            error.FileNotFound => return null,
+            else => return err,
+        };
+        defer self.allocator.free(bytes);
+
+        const parsed = try std.json.parseFromSlice(State, self.allocator, bytes, .{
+            .ignore_unknown_fields = true,
+            .allocate = .alloc_always,
+        });
+        if (!std.mem.eql(u8, parsed.value.version, self.version) or
+            parsed.value.prelude_hash != prelude_hash or
+            parsed.value.build_id != self.build_id.?)
+        {
+            parsed.deinit();
+            return null;
+        }
+        return parsed;
+    }
+
+    /// 把未变化的声明（clean）加入 clean，键引用 graph 的内存
+    /// 没有历史状态时不加入任何声明（全部重新检查）
+    pub fn collectClean(self: *Tracker, graph: *const Graph, clean: *std.StringHashMap(void)) !void {
+        const previous = if (self.previous) |p| p.value else return;
+        const allocator = self.allocator;
+
+        var old_hashes = std.StringHashMap(u64).init(allocator);
+        defer old_hashes.deinit();
+        for (previous.decls) |info| try old_hashes.put(info.name, info.hash);
+
+        // changed：新增或哈希改变；被删除的声明也算 changed
+        var changed = std.StringHashMap(void).init(allocator);
+        defer changed.deinit();
+        var current_names = std.StringHashMap(void).init(allocator);
+        defer current_names.deinit();
+        for (graph.decls.items) |info| {
+            try current_names.put(info.name, {});
+            const old = old_hashes.get(info.name);
+            if (old == null or old.? != info.hash) try changed.put(info.name, {});
+        }
+        for (previous.decls) |info| {
+            if (!current_names.contains(info.name)) try changed.put(info.name, {});
+        }
+
+        // dirty：沿反向依赖传播直到不动点
+        var dirty = std.StringHashMap(void).init(allocator);
+        defer dirty.deinit();
+        var it = changed.keyIterator();
+        while (it.next()) |name| try dirty.put(name.*, {});
+
+        var grew = true;
+        while (grew) {
+            grew = false;
+            for (graph.decls.items) |info| {
+                if (dirty.contains(info.name)) continue;
+                for (info.deps) |dep| {
+                    if (dirty.contains(dep)) {
+                        try dirty.put(info.name, {});
+                        grew = true;
+                        break;
+                    }
+                }
+            }
+        }
+
+        for (graph.decls.items) |info| {
+            if (!dirty.contains(info.name)) try clean.put(info.name, {});
+        }
+    }
+
+    /// 保存本次的声明图（只在编译成功后调用；失败时静默忽略，增量信息只是加速手段）
+    pub fn save(self: *Tracker, graph: *const Graph) void {
+        self.saveInternal(graph) catch {};
+    }
+
+    fn saveInternal(self: *Tracker, graph: *const Graph) !void {
+        var buf = std.ArrayList(u8){};
+        defer buf.deinit(self.allocator);
+        const gpa = self.allocator;
+
+        try buf.appendSlice(gpa, "{\n  \"version\": ");
+        try prof.writeJsonString(&buf, gpa, self.version);
+        try buf.print(gpa, ",\n  \"prelude_hash\": {d},\n  \"build_id\": {d}", .{ prelude_hash, self.build_id orelse 0 });
+        try buf.appendSlice(gpa, ",\n  \"decls\": [");
+        for (graph.decls.items, 0..) |info, idx| {
+            try buf.appendSlice(gpa, if (idx == 0) "\n    " else ",\n    ");
+            try buf.appendSlice(gpa, "{ \"name\": ");
+            try prof.writeJsonString(&buf, gpa, info.name);
+            try buf.print(gpa, ", \"hash\": {d}, \"deps\": [", .{info.hash});
+            for (info.deps, 0..) |dep, dep_idx| {
+                if (dep_idx > 0) try buf.appendSlice(gpa, ", ");
+                try prof.writeJsonString(&buf, gpa, dep);
+            }
+            try buf.appendSlice(gpa, "] }");
+        }
+        try buf.appendSlice(gpa, "\n  ]\n}\n");
+
+        var dir = try std.fs.cwd().makeOpenPath(self.cache_dir, .{});
+        defer dir.close();
+        try dir.makePath(state_subdir);
+        try std.fs.cwd().writeFile(.{ .sub_path = self.state_path, .data = buf.items });
+    }
+};
+
+// ============================================================================
+// 基于 comptime 反射的结构化哈希 + 依赖收集
+// ============================================================================
+
+const Walker = struct {
+    hasher: std.hash.Wyhash,
+    names: *const std.StringHashMap(void),
+    variants: *const std.StringHashMap([]const u8),
+    deps: *std.StringHashMap(void),
+
+    fn update(self: *Walker, comptime T: type, value: T) void {
+        self.hasher.update(std.mem.asBytes(&value));
+    }
+
+    fn walk(self: *Walker, comptime T: type, value: T) std.mem.Allocator.Error!void {
+        switch (@typeInfo(T)) {
+            .void => {},
+            .bool => self.update(u8, @intFromBool(value)),
+            .int => self.update(T, value),
+            .float => self.update(u64, @bitCast(@as(f64, @floatCast(value)))),
+            .@"enum" => self.update(u32, @intCast(@intFromEnum(value))),
+            .optional => |info| {
+                if (value) |payload| {
+                    self.update(u8, 1);
+                    try self.walk(info.child, payload);
+                } else {
+                    self.update(u8, 0);
+                }
+            },
+            .pointer => |info| switch (info.size) {
+                .one => try self.walk(info.child, value.*),
+                .slice => {
+                    self.update(u64, value.len);
+                    if (info.child == u8) {
+                        self.hasher.update(value);
+                        if (self.names.getKey(value)) |name| try self.deps.put(name, {});
+                        if (self.variants.get(value)) |enum_name| try self.deps.put(enum_name, {});
+                    } else {
+                        for (value) |elem| try self.walk(info.child, elem);
+                    }
+                },
+                else => @compileError("incremental: unsupported pointer type " ++ @typeName(T)),
+            },
+            .@"struct" => |info| {
+                inline for (info.fields) |field| {
+                    // 声明位置不参与哈希：只移动位置的声明不需要重新检查
+                    if (comptime T == ast.FunctionDecl and isLocationField(field.name)) continue;
+                    try self.walk(field.type, @field(value, field.name));
+                }
+            },
+            .@"union" => |info| {
+                const Tag = info.tag_type orelse @compileError("incremental: untagged union " ++ @typeName(T));
+                self.update(u32, @intCast(@intFromEnum(@as(Tag, value))));
+                switch (value) {
+                    inline else => |payload| try self.walk(@TypeOf(payload), payload),
+                }
+            },
+            else => @compileError("incremental: unsupported type " ++ @typeName(T)),
+        }
+    }
+
+    fn isLocationField(comptime name: []const u8) bool {
+        return std.mem.eql(u8, name, "line") or std.mem.eql(u8, name, "source_file");
+    }
+};
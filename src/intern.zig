@@ -0,0 +1,128 @@
+//! 🆕 v0.2.0: String Interner - 标识符驻留
+//!
+//! Lexer 为每个不同的标识符分配一个稠密的 u32 编号（Symbol），
+//! 后续阶段可以用编号做数组下标或整数比较，不必反复哈希和 mem.eql 字符串。
+//!
+//! 关键字在初始化时预先驻留，占据编号 0..keywords.len-1，
+//! 因此识别关键字只需一次哈希查找（取代逐个 mem.eql 比较）。
+//!
+//! 驻留的字符串不会被复制：它们引用源码缓冲区（或静态关键字表），
+//! 调用者需保证源码比 Interner 活得更久（与 Token.lexeme 的约定相同）。
+
+const std = @import("std");
+const TokenType = @import("token.zig").TokenType;
+
+pub const Symbol = u32;
+
+/// 非标识符 token 的 symbol 值
+pub const no_symbol: Symbol = std.math.maxInt(Symbol);
+
+pub const Keyword = struct {
+    text: []const u8,
+    token_type: TokenType,
+};
+
+/// 关键字和内置类型名，按顺序占据最小的几个 Symbol 编号
+pub const keywords = [_]Keyword{
+    // Paw 核心关键字 (19个) - 极简设计
+    .{ .text = "fn", .token_type = .keyword_fn },
+    .{ .text = "let", .token_type = .keyword_let },
+    .{ .text = "type", .token_type = .keyword_type },
+    .{ .text = "import", .token_type = .keyword_import },
+    .{ .text = "pub", .token_type = .keyword_pub },
+    .{ .text = "if", .token_type = .keyword_if },
+    .{ .text = "else", .token_type = .keyword_else },
+    .{ .text = "loop", .token_type = .keyword_loop },
+    .{ .text = "break", .token_type = .keyword_break },
+    .{ .text = "return", .token_type = .keyword_return },
+    .{ .text = "is", .token_type = .keyword_is },
+    .{ .text = "as", .token_type = .keyword_as },
+    .{ .text = "async", .token_type = .keyword_async },
+    .{ .text = "await", .token_type = .keyword_await },
+    .{ .text = "self", .token_type = .keyword_self },
+    .{ .text = "Self", .token_type = .keyword_Self },
+    .{ .text = "mut", .token_type = .keyword_mut },
+    .{ .text = "true", .token_type = .keyword_true },
+    .{ .text = "false", .token_type = .keyword_false },
+    .{ .text = "in", .token_type = .keyword_in },
+
+    // 内置类型（Rust 风格，纯粹无别名）
+    .{ .text = "i8", .token_type = .type_i8 },
+    .{ .text = "i16", .token_type = .type_i16 },
+    .{ .text = "i32", .token_type = .type_i32 },
+    .{ .text = "i64", .token_type = .type_i64 },
+    .{ .text = "i128", .token_type = .type_i128 },
+    .{ .text = "u8", .token_type = .type_u8 },
+    .{ .text = "u16", .token_type = .type_u16 },
+    .{ .text = "u32", .token_type = .type_u32 },
+    .{ .text = "u64", .token_type = .type_u64 },
+    .{ .text = "u128", .token_type = .type_u128 },
+    .{ .text = "f32", .token_type = .type_f32 },
+    .{ .text = "f64", .token_type = .type_f64 },
+    .{ .text = "bool", .token_type = .type_bool },
+    .{ .text = "char", .token_type = .type_char },
+    .{ .text = "string", .token_type = .type_string },
+    .{ .text = "void", .token_type = .type_void },
+};
+
+pub const Interner = struct {
+    allocator: std.mem.Allocator,
+    map: std.StringHashMapUnmanaged(Symbol),
+    strings: std.ArrayList([]const u8),
+
+    pub fn init(allocator: std.mem.Allocator) Interner {
+        return Interner{
+            .allocator = allocator,
+            .map = .{},
+            .strings = std.ArrayList([]const u8){},
+        };
+    }
+
+    pub fn deinit(self: *Interner) void {
+        self.map.deinit(self.allocator);
+        self.strings.deinit(self.allocator);
+    }
+
+    /// 驻留字符串，返回其编号（同一字符串总是得到同一编号）
+    pub fn intern(self: *Interner, text: []const u8) !Symbol {
+        if (self.strings.items.len == 0) try self.seedKeywords();
+
+        const entry = try self.map.getOrPut(self.allocator, text);
+        if (!entry.found_existing) {
+            entry.value_ptr.* = @intCast(self.strings.items.len);
+            try self.strings.append(self.allocator, text);
+        }
+        return entry.value_ptr.*;
+    }
+
+    /// 关键字总是最先驻留（第一次 intern 时），保证编号与 keywords 表下标一致
+    fn seedKeywords(self: *Interner) !void {
+        try self.map.ensureTotalCapacity(self.allocator, keywords.len * 4);
+        try self.strings.ensureTotalCapacity(self.allocator, keywords.len * 4);
+        for (keywords, 0..) |kw, i| {
+            self.map.putAssumeCapacityNoClobber(kw.text, @intCast(i));
+            self.strings.appendAssumeCapacity(kw.text);
+        }
+    }
+
+    /// 查找已驻留的字符串，不存在时返回 null（不会插入）
+    pub fn lookup(self: *const Interner, text: []const u8) ?Symbol {
+        return self.map.get(text);
+    }
+
+    /// 根据编号取回字符串
+    pub fn get(self: *const Interner, symbol: Symbol) []const u8 {
+        return self.strings.items[symbol];
+    }
+
+    /// 已驻留的字符串数量（Symbol 的取值范围是 0..count()）
+    pub fn count(self: *const Interner) usize {
+        return self.strings.items.len;
+    }
+
+    /// 如果符号是关键字，返回对应的 token 类型
+    pub fn keywordType(symbol: Symbol) ?TokenType {
+        if (symbol < keywords.len) return keywords[symbol].token_type;
+        return null;
+    }
+};
@@ -0,0 +1,83 @@
+//! 🆕 v0.2.0: 运行时内存访问器的内联展开
+//!
+//! prelude 声明的 paw_read_<T>(ptr, offset) / paw_write_<T>(ptr, offset, value)
+//! 由运行时库 pawrt 实现，但在数值循环里逐元素调用它们时，开销几乎全在调用本身：
+//! 每次都跨越一个无法内联的函数边界，并重新检查一次空指针。
+//! 两个后端都把这些调用直接展开为一次 load / store：
+//!   - C 后端：生成 static inline 定义代替外部原型
+//!   - LLVM 后端：在调用处生成 inttoptr + getelementptr + load / store
+//! 展开后的访问器不检查空指针（与 C 的数组下标相同）。
+//! pawrt 中的导出版本保留给其它语言的调用者。
+//!
+//! 同样在这里登记的还有按类型参数展开的 size_of / ptr_read / ptr_write（见文件末尾）。
+
+const std = @import("std");
+
+pub const Element = enum {
+    i32,
+    i64,
+    f32,
+    f64,
+
+    pub fn cType(self: Element) []const u8 {
+        return switch (self) {
+            .i32 => "int32_t",
+            .i64 => "int64_t",
+            .f32 => "float",
+            .f64 => "double",
+        };
+    }
+};
+
+pub const Accessor = struct {
+    element: Element,
+    write: bool,
+
+    /// 参数个数：(ptr, offset) 或 (ptr, offset, value)
+    pub fn arity(self: Accessor) usize {
+        return if (self.write) 3 else 2;
+    }
+};
+
+/// 名字是 paw_read_<T> / paw_write_<T> 时返回对应的访问器
+pub fn accessor(name: []const u8) ?Accessor {
+    const write = if (std.mem.startsWith(u8, name, "paw_read_"))
+        false
+    else if (std.mem.startsWith(u8, name, "paw_write_"))
+        true
+    else
+        return null;
+    const suffix = name[if (write) "paw_write_".len else "paw_read_".len..];
+    const element = std.meta.stringToEnum(Element, suffix) orelse return null;
+    return Accessor{ .element = element, .write = write };
+}
+
+// ============================================================================
+// 泛型内存内建函数
+// ============================================================================
+//
+// prelude 中带类型参数、没有函数体的声明：
+//   size_of<T>() -> i64                          T 的大小（字节）
+//   ptr_read<T>(ptr: i64, index: i64) -> T       ((T*)ptr)[index]
+//   ptr_write<T>(ptr: i64, index: i64, value: T) ((T*)ptr)[index] = value
+// 类型参数在单态化之后才确定，因此没有对应的运行时函数，两个后端按具体类型展开，
+// Vec<i32> 和 Vec<f64> 的元素都按各自的大小连续存放。
+
+pub const Generic = enum {
+    size_of,
+    ptr_read,
+    ptr_write,
+
+    /// 值参数个数
+    pub fn arity(self: Generic) usize {
+        return switch (self) {
+            .size_of => 0,
+            .ptr_read => 2,
+            .ptr_write => 3,
+        };
+    }
+};
+
+pub fn generic(name: []const u8) ?Generic {
+    return std.meta.stringToEnum(Generic, name);
+}
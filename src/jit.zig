@@ -0,0 +1,227 @@
+//! 🆕 v0.2.0: JIT Execution - 基于 ORC LLJIT 的进程内执行引擎
+//!
+//! `pawc file.paw --backend=llvm --run` 和 REPL 不再经过
+//! 写文件 -> 外部编译器/链接器 -> 启动子进程，而是：
+//!   1. LLVMNativeBackend 在 JIT 会话的 context 中把程序降低为 LLVM 模块
+//!   2. 模块交给 LLJIT，按需编译到内存
+//!   3. 查找入口函数地址并在当前进程中直接调用
+//!
+//! 同一个 Session 可以不断加入新模块（REPL 每次输入一个模块），
+//! 新模块通过外部声明引用之前模块中已经定义的函数。
+//! 🆕 v0.2.0: 泛型实例同样如此：会话记录每个模块生成过的实例（InstanceRegistry），
+//! 之后的模块再用到 Vec<i32> 等同一特化时只声明，不再重新生成和优化函数体。
+//! 外部符号（printf、malloc 等 libc 函数）从 pawc 进程自身解析。
+//!
+//! 🆕 v0.2.0: perf_map 打开时（-g），每个模块的函数地址写入 /tmp/perf-<pid>.map，
+//! `perf record` / `perf report` 就能把 JIT 代码中的采样归到 Paw 函数名上。
+
+const std = @import("std");
+const builtin = @import("builtin");
+const ast = @import("ast.zig");
+const llvm = @import("llvm_c_api.zig");
+const prof = @import("profiler.zig");
+const backend = @import("llvm_native_backend.zig");
+const generics = @import("generics.zig");
+
+// 入口函数返回后刷新 C stdio 缓冲区，保证 JIT 代码的输出出现在 pawc 后续输出之前
+extern "c" fn fflush(stream: ?*anyopaque) c_int;
+
+pub const Session = struct {
+    allocator: std.mem.Allocator,
+    jit: llvm.LLJIT,
+    opt_level: backend.OptLevel,
+    module_count: usize,
+    instances: generics.InstanceRegistry,  // 🆕 v0.2.0: 已加入 JIT 的模块中生成过的泛型实例
+    profiler: ?*prof.Profiler = null,
+    perf_map: bool = false,        // 🆕 v0.2.0: 写 /tmp/perf-<pid>.map
+    frame_pointers: bool = false,  // 🆕 v0.2.0: JIT 代码保留帧指针
+
+    pub fn init(allocator: std.mem.Allocator, opt_level: backend.OptLevel) !Session {
+        return Session{
+            .allocator = allocator,
+            .jit = try llvm.LLJIT.create(),
+            .opt_level = opt_level,
+            .module_count = 0,
+            .instances = generics.InstanceRegistry.init(allocator),
+        };
+    }
+
+    pub fn deinit(self: *Session) void {
+        self.jit.dispose();
+        self.instances.deinit();
+    }
+
+    /// 把 program 降低为一个新模块并加入 JIT
+    /// externs 中的函数只生成声明（它们已经在之前加入的模块中定义）
+    pub fn addProgram(self: *Session, program: ast.Program, externs: []const ast.TopLevelDecl) !void {
+        const zone = prof.zone(self.profiler, "phase", "jit-lower");
+        defer zone.end();
+
+        const module_name = try std.fmt.allocPrint(self.allocator, "paw_jit_{d}", .{self.module_count});
+        defer self.allocator.free(module_name);
+
+        var lowering = try backend.LLVMNativeBackend.initInContext(self.allocator, module_name, self.opt_level, self.jit.context());
+        lowering.owns_context = false;
+        defer lowering.deinit();
+        lowering.profiler = self.profiler;
+        // 🆕 v0.2.0: JIT 模块从不以文本形式输出，优化时不保留指令名
+        lowering.setDiscardValueNames(self.opt_level != .O0);
+        lowering.setFramePointers(self.frame_pointers);
+        lowering.shared_instances = &self.instances;
+
+        try lowering.declareExternal(externs);
+        try lowering.lower(program);
+
+        // perf map 需要函数大小：JIT 不报告大小，从同一模块生成的目标文件的符号表中读取
+        var arena_state = std.heap.ArenaAllocator.init(self.allocator);
+        defer arena_state.deinit();
+        const symbols: []const PerfSymbol = if (self.perf_map and builtin.os.tag == .linux)
+            functionSymbols(arena_state.allocator(), &lowering) catch &.{}
+        else
+            &.{};
+
+        try self.jit.addModule(lowering.releaseModule());
+        self.module_count += 1;
+        try lowering.registerInstances(&self.instances);
+
+        if (symbols.len > 0) self.writePerfMap(symbols) catch |err| {
+            std.debug.print("⚠️  Could not write perf map: {}\n", .{err});
+        };
+    }
+
+    /// 追加 `<地址> <大小> <名字>` 行（perf 的 JIT 符号映射格式）
+    fn writePerfMap(self: *Session, symbols: []const PerfSymbol) !void {
+        var path_buf: [64]u8 = undefined;
+        const path = try std.fmt.bufPrint(&path_buf, "/tmp/perf-{d}.map", .{std.c.getpid()});
+        const file = try std.fs.createFileAbsolute(path, .{ .truncate = self.module_count == 1 });
+        defer file.close();
+        try file.seekFromEnd(0);
+
+        var lines = std.ArrayList(u8){};
+        defer lines.deinit(self.allocator);
+        for (symbols) |symbol| {
+            const name_z = try self.allocator.dupeZ(u8, symbol.name);
+            defer self.allocator.free(name_z);
+            // 查找会触发编译；perf map 模式下所有函数都按需立即编译
+            const address = self.jit.lookup(name_z) catch continue;
+            try lines.print(self.allocator, "{x} {x} {s}\n", .{ address, symbol.size, symbol.name });
+        }
+        try file.writeAll(lines.items);
+    }
+
+    /// 调用无参数的入口函数；returns_value 为 false 时（返回 void）结果为 0
+    pub fn call(self: *Session, name: []const u8, returns_value: bool) !i32 {
+        const name_z = try self.allocator.dupeZ(u8, name);
+        defer self.allocator.free(name_z);
+
+        const address = blk: {
+            const zone = prof.zone(self.profiler, "phase", "jit-compile");
+            defer zone.end();
+            break :blk try self.jit.lookup(name_z);
+        };
+
+        const zone = prof.zone(self.profiler, "phase", "jit-run");
+        defer zone.end();
+        defer _ = fflush(null);
+        if (returns_value) {
+            const entry: *const fn () callconv(.c) i32 = @ptrFromInt(address);
+            return entry();
+        }
+        const entry: *const fn () callconv(.c) void = @ptrFromInt(address);
+        entry();
+        return 0;
+    }
+};
+
+// ============================================================================
+// 🆕 v0.2.0: perf map 支持
+// ============================================================================
+
+const PerfSymbol = struct {
+    name: []const u8,
+    size: u64,
+};
+
+/// 用后端的本机 TargetMachine 把模块的副本编译为目标文件，读出其中已定义函数的大小
+/// （副本避免代码生成 pass 修改即将交给 JIT 的模块；两次代码生成的结果基本一致）
+fn functionSymbols(arena: std.mem.Allocator, lowering: *backend.LLVMNativeBackend) ![]const PerfSymbol {
+    const tm = lowering.target_machine orelse return &.{};
+    var copy = lowering.module.clone();
+    defer copy.dispose();
+    var object = try tm.emitToMemoryBuffer(copy, .Object);
+    defer object.dispose();
+    return elfFunctionSymbols(arena, object.bytes());
+}
+
+/// 解析 64 位 ELF 目标文件的 .symtab，返回所有已定义、大小非零的函数符号
+fn elfFunctionSymbols(arena: std.mem.Allocator, object: []const u8) ![]const PerfSymbol {
+    const elf = std.elf;
+    if (object.len < @sizeOf(elf.Elf64_Ehdr) or !std.mem.eql(u8, object[0..4], elf.MAGIC)) return &.{};
+    if (object[elf.EI_CLASS] != elf.ELFCLASS64) return &.{};
+
+    const header = std.mem.bytesAsValue(elf.Elf64_Ehdr, object[0..@sizeOf(elf.Elf64_Ehdr)]);
+    const sections = try sectionHeaders(object, header.e_shoff, header.e_shnum);
+
+    var symbols = std.ArrayList(PerfSymbol){};
+    for (0..header.e_shnum) |i| {
+        const symtab = sectionHeader(sections, i);
+        if (symtab.sh_type != elf.SHT_SYMTAB or symtab.sh_link >= header.e_shnum) continue;
+        const strtab = sectionHeader(sections, symtab.sh_link);
+        const names = try sectionBytes(object, strtab.sh_offset, strtab.sh_size);
+        const table = try sectionBytes(object, symtab.sh_offset, symtab.sh_size);
+
+        var offset: usize = 0;
+        while (offset + @sizeOf(elf.Elf64_Sym) <= table.len) : (offset += @sizeOf(elf.Elf64_Sym)) {
+            const sym = std.mem.bytesAsValue(elf.Elf64_Sym, table[offset..][0..@sizeOf(elf.Elf64_Sym)]);
+            if ((sym.st_info & 0xf) != elf.STT_FUNC or sym.st_shndx == elf.SHN_UNDEF or sym.st_size == 0) continue;
+            if (sym.st_name >= names.len) continue;
+            const name = std.mem.sliceTo(names[sym.st_name..], 0);
+            try symbols.append(arena, PerfSymbol{ .name = try arena.dupe(u8, name), .size = sym.st_size });
+        }
+    }
+    return symbols.items;
+}
+
+fn sectionHeaders(object: []const u8, offset: u64, count: u16) ![]const u8 {
+    return sectionBytes(object, offset, @as(u64, count) * @sizeOf(std.elf.Elf64_Shdr));
+}
+
+fn sectionHeader(sections: []const u8, index: usize) *align(1) const std.elf.Elf64_Shdr {
+    const size = @sizeOf(std.elf.Elf64_Shdr);
+    return std.mem.bytesAsValue(std.elf.Elf64_Shdr, sections[index * size ..][0..size]);
+}
+
+fn sectionBytes(object: []const u8, offset: u64, size: u64) ![]const u8 {
+    if (offset > object.len or size > object.len - offset) return error.InvalidObject;
+    return object[@intCast(offset)..][0..@intCast(size)];
+}
+
+pub const RunOptions = struct {
+    perf_map: bool = false,
+    frame_pointers: bool = false,
+};
+
+/// 在 JIT 中执行整个程序的 main 函数，返回它的退出码
+pub fn runMain(
+    allocator: std.mem.Allocator,
+    program: ast.Program,
+    opt_level: backend.OptLevel,
+    profiler: ?*prof.Profiler,
+    options: RunOptions,
+) !i32 {
+    const main_func = for (program.declarations) |decl| {
+        if (decl == .function and std.mem.eql(u8, decl.function.name, "main")) break decl.function;
+    } else {
+        std.debug.print("❌ Error: no main function to run\n", .{});
+        return error.NoMainFunction;
+    };
+
+    var session = try Session.init(allocator, opt_level);
+    defer session.deinit();
+    session.profiler = profiler;
+    session.perf_map = options.perf_map;
+    session.frame_pointers = options.frame_pointers;
+
+    try session.addProgram(program, &.{});
+    return session.call("main", main_func.return_type != .void);
+}
@@ -1,6 +1,7 @@
 const std = @import("std");
 const Token = @import("token.zig").Token;
 const TokenType = @import("token.zig").TokenType;
+const Interner = @import("intern.zig").Interner;  // 🆕 v0.2.0
 
 pub const Lexer = struct {
     allocator: std.mem.Allocator,
@@ -12,6 +13,7 @@ pub const Lexer = struct {
     line: usize,
     column: usize,
     line_offset: usize,  // 🆕 v0.1.8: 行号偏移（用于处理 prelude）
+    interner: Interner,  // 🆕 v0.2.0: 标识符驻留表（关键字预先驻留）
 
     pub fn init(allocator: std.mem.Allocator, source: []const u8, filename: []const u8) Lexer {
         var tokens: std.ArrayList(Token) = .{};
@@ -29,6 +31,7 @@ pub const Lexer = struct {
             .line = 1,
             .column = 1,
             .line_offset = 0,  // 🆕 v0.1.8: 默认无偏移
+            .interner = Interner.init(allocator),
         };
     }
     
@@ -39,6 +42,7 @@ pub const Lexer = struct {
 
     pub fn deinit(self: *Lexer) void {
         self.tokens.deinit(self.allocator);
+        self.interner.deinit();
     }
 
     pub fn tokenize(self: *Lexer) ![]Token {
@@ -57,10 +61,11 @@ pub const Lexer = struct {
     fn scanToken(self: *Lexer) !void {
         const c = self.advance();
         switch (c) {
-            ' ', '\r', '\t' => {}, // 忽略空白
+            ' ', '\r', '\t' => self.skipWhitespace(), // 忽略空白（🆕 v0.2.0: 整段跳过）
             '\n' => {
                 self.line += 1;
                 self.column = 1;
+                self.skipWhitespace();
             },
             '(' => try self.addToken(.lparen),
             ')' => try self.addToken(.rparen),
@@ -162,10 +167,9 @@ pub const Lexer = struct {
             },
             '/' => {
                 if (self.match('/')) {
-                    // 单行注释
-                    while (self.peek() != '\n' and !self.isAtEnd()) {
-                        _ = self.advance();
-                    }
+                    // 单行注释（🆕 v0.2.0: 直接定位行尾）
+                    const end = std.mem.indexOfScalarPos(u8, self.source, self.current, '\n') orelse self.source.len;
+                    self.skipTo(end);
                 } else if (self.match('*')) {
                     // 多行注释
                     try self.blockComment();
@@ -211,7 +215,11 @@ pub const Lexer = struct {
     }
 
     fn string(self: *Lexer) !void {
-        while (self.peek() != '"' and !self.isAtEnd()) {
+        while (true) {
+            // 🆕 v0.2.0: 整块跳过不含 " \\ 换行 的字符串内容
+            self.skipTo(skipClass(.string_body, self.source, self.current));
+            if (self.peek() == '"' or self.isAtEnd()) break;
+            
             if (self.peek() == '\n') {
                 self.line += 1;
                 self.column = 1;
@@ -263,17 +271,13 @@ pub const Lexer = struct {
     }
 
     fn number(self: *Lexer) !void {
-        while (isDigit(self.peek())) {
-            _ = self.advance();
-        }
+        self.skipTo(skipClass(.digit, self.source, self.current));
 
         // 查找小数部分
         if (self.peek() == '.' and isDigit(self.peekNext())) {
             _ = self.advance(); // 消耗 '.'
 
-            while (isDigit(self.peek())) {
-                _ = self.advance();
-            }
+            self.skipTo(skipClass(.digit, self.source, self.current));
 
             try self.addToken(.float_literal);
         } else {
@@ -282,64 +286,63 @@ pub const Lexer = struct {
     }
 
     fn identifier(self: *Lexer) !void {
-        while (isAlphaNumeric(self.peek())) {
-            _ = self.advance();
-        }
+        self.skipTo(skipClass(.ident_continue, self.source, self.current));
 
+        // 🆕 v0.2.0: 一次哈希同时完成关键字识别和标识符驻留
         const text = self.source[self.start..self.current];
-        const token_type = getKeywordType(text) orelse .identifier;
+        const symbol = try self.interner.intern(text);
+        const token_type = Interner.keywordType(symbol) orelse .identifier;
         try self.addToken(token_type);
+        if (token_type == .identifier) {
+            self.tokens.items[self.tokens.items.len - 1].symbol = symbol;
+        }
     }
-    
-    fn getKeywordType(text: []const u8) ?TokenType {
-        // Paw 核心关键字 (19个) - 极简设计
-        if (std.mem.eql(u8, text, "fn")) return .keyword_fn;
-        if (std.mem.eql(u8, text, "let")) return .keyword_let;
-        if (std.mem.eql(u8, text, "type")) return .keyword_type;
-        if (std.mem.eql(u8, text, "import")) return .keyword_import;
-        if (std.mem.eql(u8, text, "pub")) return .keyword_pub;
-        if (std.mem.eql(u8, text, "if")) return .keyword_if;
-        if (std.mem.eql(u8, text, "else")) return .keyword_else;
-        if (std.mem.eql(u8, text, "loop")) return .keyword_loop;
-        if (std.mem.eql(u8, text, "break")) return .keyword_break;
-        if (std.mem.eql(u8, text, "return")) return .keyword_return;
-        if (std.mem.eql(u8, text, "is")) return .keyword_is;
-        if (std.mem.eql(u8, text, "as")) return .keyword_as;
-        if (std.mem.eql(u8, text, "async")) return .keyword_async;
-        if (std.mem.eql(u8, text, "await")) return .keyword_await;
-        if (std.mem.eql(u8, text, "self")) return .keyword_self;
-        if (std.mem.eql(u8, text, "Self")) return .keyword_Self;
-        if (std.mem.eql(u8, text, "mut")) return .keyword_mut;
-        if (std.mem.eql(u8, text, "true")) return .keyword_true;
-        if (std.mem.eql(u8, text, "false")) return .keyword_false;
-        if (std.mem.eql(u8, text, "in")) return .keyword_in;
-        
-        // 内置类型（Rust 风格，纯粹无别名）
-        // 有符号整数
-        if (std.mem.eql(u8, text, "i8")) return .type_i8;
-        if (std.mem.eql(u8, text, "i16")) return .type_i16;
-        if (std.mem.eql(u8, text, "i32")) return .type_i32;
-        if (std.mem.eql(u8, text, "i64")) return .type_i64;
-        if (std.mem.eql(u8, text, "i128")) return .type_i128;
-        
-        // 无符号整数
-        if (std.mem.eql(u8, text, "u8")) return .type_u8;
-        if (std.mem.eql(u8, text, "u16")) return .type_u16;
-        if (std.mem.eql(u8, text, "u32")) return .type_u32;
-        if (std.mem.eql(u8, text, "u64")) return .type_u64;
-        if (std.mem.eql(u8, text, "u128")) return .type_u128;
-        
-        // 浮点类型
-        if (std.mem.eql(u8, text, "f32")) return .type_f32;
-        if (std.mem.eql(u8, text, "f64")) return .type_f64;
-        
-        // 其他类型
-        if (std.mem.eql(u8, text, "bool")) return .type_bool;
-        if (std.mem.eql(u8, text, "char")) return .type_char;
-        if (std.mem.eql(u8, text, "string")) return .type_string;
-        if (std.mem.eql(u8, text, "void")) return .type_void;
-        
-        return null;
+
+    /// 🆕 v0.2.0: 前进到 end（end 之前不含换行符），列号同步增加
+    fn skipTo(self: *Lexer, end: usize) void {
+        self.column += end - self.current;
+        self.current = end;
+    }
+
+    /// 🆕 v0.2.0: 跳过一段连续空白；换行数通过换行掩码的 popcount 统计
+    fn skipWhitespace(self: *Lexer) void {
+        const bytes = self.source;
+        var pos = self.current;
+        var newlines: usize = 0;
+        var last_newline: ?usize = null;
+
+        while (pos + vector_len <= bytes.len) {
+            const chunk: Chunk = bytes[pos..][0..vector_len].*;
+            const nl = matchByte(chunk, '\n');
+            const miss = ~(nl | matchByte(chunk, ' ') | matchByte(chunk, '\t') | matchByte(chunk, '\r'));
+            const run: usize = if (miss == 0) vector_len else @ctz(miss);
+            const in_run = if (run == vector_len) nl else nl & ((@as(Mask, 1) << @intCast(run)) - 1);
+            if (in_run != 0) {
+                newlines += @popCount(in_run);
+                last_newline = pos + (vector_len - 1 - @clz(in_run));
+            }
+            pos += run;
+            if (run < vector_len) break;
+        } else {
+            while (pos < bytes.len) : (pos += 1) {
+                switch (bytes[pos]) {
+                    ' ', '\t', '\r' => {},
+                    '\n' => {
+                        newlines += 1;
+                        last_newline = pos;
+                    },
+                    else => break,
+                }
+            }
+        }
+
+        self.line += newlines;
+        if (last_newline) |nl_pos| {
+            self.column = 1 + (pos - nl_pos - 1);
+        } else {
+            self.column += pos - self.current;
+        }
+        self.current = pos;
     }
 
     fn isDigit(c: u8) bool {
@@ -352,10 +355,6 @@ pub const Lexer = struct {
             c == '_';
     }
 
-    fn isAlphaNumeric(c: u8) bool {
-        return isAlpha(c) or isDigit(c);
-    }
-
     fn isAtEnd(self: *Lexer) bool {
         return self.current >= self.source.len;
     }
@@ -398,3 +397,61 @@ pub const Lexer = struct {
     }
 };
 
+// ============================================================================
+// 🆕 v0.2.0: SIMD 扫描
+// ============================================================================
+//
+// 每次比较一整块 (vector_len 字节)，把比较结果压成位掩码，
+// 用 @ctz 找到第一个不属于该字符类的字节。不足一块的尾部逐字节处理。
+
+const vector_len = std.simd.suggestVectorLength(u8) orelse 16;
+const Chunk = @Vector(vector_len, u8);
+const Mask = std.meta.Int(.unsigned, vector_len);
+
+const CharClass = enum {
+    ident_continue,  // [A-Za-z0-9_]
+    digit,           // [0-9]
+    string_body,     // 除 " \ 换行 以外的字符
+};
+
+inline fn matchByte(chunk: Chunk, byte: u8) Mask {
+    return @bitCast(chunk == @as(Chunk, @splat(byte)));
+}
+
+inline fn matchRange(chunk: Chunk, lo: u8, hi: u8) Mask {
+    const ge: Mask = @bitCast(chunk >= @as(Chunk, @splat(lo)));
+    const le: Mask = @bitCast(chunk <= @as(Chunk, @splat(hi)));
+    return ge & le;
+}
+
+inline fn classMask(comptime class: CharClass, chunk: Chunk) Mask {
+    return switch (class) {
+        // 'A'..'Z' | 0x20 落在 'a'..'z'，其它字节不会
+        .ident_continue => matchRange(chunk | @as(Chunk, @splat(0x20)), 'a', 'z') |
+            matchRange(chunk, '0', '9') | matchByte(chunk, '_'),
+        .digit => matchRange(chunk, '0', '9'),
+        .string_body => ~(matchByte(chunk, '"') | matchByte(chunk, '\\') | matchByte(chunk, '\n')),
+    };
+}
+
+inline fn classScalar(comptime class: CharClass, c: u8) bool {
+    return switch (class) {
+        .ident_continue => (c >= 'a' and c <= 'z') or (c >= 'A' and c <= 'Z') or (c >= '0' and c <= '9') or c == '_',
+        .digit => c >= '0' and c <= '9',
+        .string_body => c != '"' and c != '\\' and c != '\n',
+    };
+}
+
+/// 返回从 start 开始第一个不属于 class 的字节位置
+fn skipClass(comptime class: CharClass, bytes: []const u8, start: usize) usize {
+    var pos = start;
+    while (pos + vector_len <= bytes.len) : (pos += vector_len) {
+        const chunk: Chunk = bytes[pos..][0..vector_len].*;
+        const miss = ~classMask(class, chunk);
+        if (miss != 0) return pos + @ctz(miss);
+    }
+    while (pos < bytes.len and classScalar(class, bytes[pos])) {
+        pos += 1;
+    }
+    return pos;
+}
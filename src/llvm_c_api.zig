@@ -7,6 +7,7 @@
 //! We only bind the functions we actually need for PawLang's code generation.
 
 const std = @import("std");
+const builtin = @import("builtin");
 
 // LLVM C API types (opaque pointers)
 pub const ContextRef = ?*opaque {};
@@ -15,6 +16,26 @@ pub const BuilderRef = ?*opaque {};
 pub const TypeRef = ?*opaque {};
 pub const ValueRef = ?*opaque {};
 pub const BasicBlockRef = ?*opaque {};
+pub const ErrorRef = ?*opaque {};
+pub const PassBuilderOptionsRef = ?*opaque {};
+pub const TargetMachineRef = ?*opaque {};
+pub const TargetRef = ?*opaque {};
+pub const TargetDataRef = ?*opaque {};
+pub const MemoryBufferRef = ?*opaque {};
+
+// 🆕 v0.2.0: ORC JIT (opaque pointers)
+pub const OrcLLJITBuilderRef = ?*opaque {};
+pub const OrcLLJITRef = ?*opaque {};
+pub const OrcJITDylibRef = ?*opaque {};
+pub const OrcThreadSafeContextRef = ?*opaque {};
+pub const OrcThreadSafeModuleRef = ?*opaque {};
+pub const OrcDefinitionGeneratorRef = ?*opaque {};
+pub const OrcExecutorAddress = u64;
+
+// 🆕 v0.2.0: Debug info / attributes (opaque pointers)
+pub const DIBuilderRef = ?*opaque {};
+pub const MetadataRef = ?*opaque {};
+pub const AttributeRef = ?*opaque {};
 
 // LLVM Linkage Types
 pub const Linkage = enum(c_uint) {
@@ -51,6 +72,39 @@ pub const IntPredicate = enum(c_uint) {
     SLE = 41, // signed less or equal
 };
 
+// 🆕 v0.2.0: Target machine configuration (llvm-c/TargetMachine.h)
+pub const CodeGenOptLevel = enum(c_uint) {
+    None = 0,
+    Less = 1,
+    Default = 2,
+    Aggressive = 3,
+};
+
+pub const RelocMode = enum(c_uint) {
+    Default = 0,
+    Static = 1,
+    PIC = 2,
+    DynamicNoPic = 3,
+    ROPI = 4,
+    RWPI = 5,
+    ROPI_RWPI = 6,
+};
+
+pub const CodeModel = enum(c_uint) {
+    Default = 0,
+    JITDefault = 1,
+    Tiny = 2,
+    Small = 3,
+    Kernel = 4,
+    Medium = 5,
+    Large = 6,
+};
+
+pub const CodeGenFileType = enum(c_uint) {
+    Assembly = 0,
+    Object = 1,
+};
+
 // ============================================================================
 // Context Functions
 // ============================================================================
@@ -61,6 +115,9 @@ pub extern "c" fn LLVMContextCreate() ContextRef;
 /// Dispose of an LLVM context
 pub extern "c" fn LLVMContextDispose(C: ContextRef) void;
 
+/// 🆕 v0.2.0: 丢弃非全局值的名字（指令、参数、基本块不再需要唯一化名字）
+pub extern "c" fn LLVMContextSetDiscardValueNames(C: ContextRef, Discard: c_int) void;
+
 // ============================================================================
 // Module Functions
 // ============================================================================
@@ -440,6 +497,22 @@ pub extern "c" fn LLVMBuildFPTrunc(
     Name: [*:0]const u8,
 ) ValueRef;
 
+/// 🆕 v0.2.0: Build int-to-pointer cast
+pub extern "c" fn LLVMBuildIntToPtr(
+    Builder: BuilderRef,
+    Val: ValueRef,
+    DestTy: TypeRef,
+    Name: [*:0]const u8,
+) ValueRef;
+
+/// 🆕 v0.2.0: Build pointer-to-int cast
+pub extern "c" fn LLVMBuildPtrToInt(
+    Builder: BuilderRef,
+    Val: ValueRef,
+    DestTy: TypeRef,
+    Name: [*:0]const u8,
+) ValueRef;
+
 /// Build struct GEP
 pub extern "c" fn LLVMBuildStructGEP2(
     Builder: BuilderRef,
@@ -463,6 +536,464 @@ pub extern "c" fn LLVMStructTypeInContext(
     Packed: c_int,
 ) TypeRef;
 
+// ============================================================================
+// 🆕 v0.2.0: New Pass Manager (llvm-c/Transforms/PassBuilder.h)
+// ============================================================================
+
+/// Create pass builder options (must be disposed)
+pub extern "c" fn LLVMCreatePassBuilderOptions() PassBuilderOptionsRef;
+
+/// Dispose pass builder options
+pub extern "c" fn LLVMDisposePassBuilderOptions(Options: PassBuilderOptionsRef) void;
+
+/// Run the verifier after every pass
+pub extern "c" fn LLVMPassBuilderOptionsSetVerifyEach(
+    Options: PassBuilderOptionsRef,
+    VerifyEach: c_int,
+) void;
+
+/// Enable/disable the loop vectorizer
+pub extern "c" fn LLVMPassBuilderOptionsSetLoopVectorization(
+    Options: PassBuilderOptionsRef,
+    LoopVectorization: c_int,
+) void;
+
+/// Enable/disable the SLP vectorizer
+pub extern "c" fn LLVMPassBuilderOptionsSetSLPVectorization(
+    Options: PassBuilderOptionsRef,
+    SLPVectorization: c_int,
+) void;
+
+/// Enable/disable loop unrolling
+pub extern "c" fn LLVMPassBuilderOptionsSetLoopUnrolling(
+    Options: PassBuilderOptionsRef,
+    LoopUnrolling: c_int,
+) void;
+
+/// Enable/disable function merging
+pub extern "c" fn LLVMPassBuilderOptionsSetMergeFunctions(
+    Options: PassBuilderOptionsRef,
+    MergeFunctions: c_int,
+) void;
+
+/// Run a textual pass pipeline (e.g. "default<O2>") over a module
+/// TM may be null, in which case no target-specific analysis is used
+pub extern "c" fn LLVMRunPasses(
+    M: ModuleRef,
+    Passes: [*:0]const u8,
+    TM: TargetMachineRef,
+    Options: PassBuilderOptionsRef,
+) ErrorRef;
+
+/// Get the message of an error (consumes the error, free with LLVMDisposeErrorMessage)
+pub extern "c" fn LLVMGetErrorMessage(Err: ErrorRef) [*:0]u8;
+
+/// Dispose of an error message
+pub extern "c" fn LLVMDisposeErrorMessage(ErrMsg: [*:0]u8) void;
+
+// ============================================================================
+// 🆕 v0.2.0: Target / TargetMachine (llvm-c/Target.h, llvm-c/TargetMachine.h)
+// ============================================================================
+//
+// LLVMInitializeNativeTarget() 等在 C 头文件中是 static inline 函数，
+// 无法直接链接，所以这里绑定各架构实际导出的初始化函数。
+
+pub extern "c" fn LLVMInitializeX86TargetInfo() void;
+pub extern "c" fn LLVMInitializeX86Target() void;
+pub extern "c" fn LLVMInitializeX86TargetMC() void;
+pub extern "c" fn LLVMInitializeX86AsmPrinter() void;
+
+pub extern "c" fn LLVMInitializeAArch64TargetInfo() void;
+pub extern "c" fn LLVMInitializeAArch64Target() void;
+pub extern "c" fn LLVMInitializeAArch64TargetMC() void;
+pub extern "c" fn LLVMInitializeAArch64AsmPrinter() void;
+
+pub extern "c" fn LLVMInitializeRISCVTargetInfo() void;
+pub extern "c" fn LLVMInitializeRISCVTarget() void;
+pub extern "c" fn LLVMInitializeRISCVTargetMC() void;
+pub extern "c" fn LLVMInitializeRISCVAsmPrinter() void;
+
+pub extern "c" fn LLVMInitializeARMTargetInfo() void;
+pub extern "c" fn LLVMInitializeARMTarget() void;
+pub extern "c" fn LLVMInitializeARMTargetMC() void;
+pub extern "c" fn LLVMInitializeARMAsmPrinter() void;
+
+/// Get the default target triple of the host (free with LLVMDisposeMessage)
+pub extern "c" fn LLVMGetDefaultTargetTriple() [*:0]u8;
+
+/// Get the host CPU name (free with LLVMDisposeMessage)
+pub extern "c" fn LLVMGetHostCPUName() [*:0]u8;
+
+/// Get the host CPU features (free with LLVMDisposeMessage)
+pub extern "c" fn LLVMGetHostCPUFeatures() [*:0]u8;
+
+/// Look up a target by triple (returns non-zero on failure)
+pub extern "c" fn LLVMGetTargetFromTriple(
+    Triple: [*:0]const u8,
+    T: *TargetRef,
+    ErrorMessage: *[*:0]u8,
+) c_int;
+
+/// Create a target machine
+pub extern "c" fn LLVMCreateTargetMachine(
+    T: TargetRef,
+    Triple: [*:0]const u8,
+    CPU: [*:0]const u8,
+    Features: [*:0]const u8,
+    Level: CodeGenOptLevel,
+    Reloc: RelocMode,
+    CodeModel: CodeModel,
+) TargetMachineRef;
+
+/// Dispose of a target machine
+pub extern "c" fn LLVMDisposeTargetMachine(T: TargetMachineRef) void;
+
+/// Create the data layout of a target machine (must be disposed)
+pub extern "c" fn LLVMCreateTargetDataLayout(T: TargetMachineRef) TargetDataRef;
+
+/// Dispose of target data
+pub extern "c" fn LLVMDisposeTargetData(TD: TargetDataRef) void;
+
+/// Set the target triple of a module
+pub extern "c" fn LLVMSetTarget(M: ModuleRef, Triple: [*:0]const u8) void;
+
+/// Set the data layout of a module
+pub extern "c" fn LLVMSetModuleDataLayout(M: ModuleRef, DL: TargetDataRef) void;
+
+/// Emit a module to an object/assembly file (returns non-zero on failure)
+pub extern "c" fn LLVMTargetMachineEmitToFile(
+    T: TargetMachineRef,
+    M: ModuleRef,
+    Filename: [*:0]const u8,
+    codegen: CodeGenFileType,
+    ErrorMessage: *[*:0]u8,
+) c_int;
+
+/// Emit a module to a memory buffer (returns non-zero on failure)
+pub extern "c" fn LLVMTargetMachineEmitToMemoryBuffer(
+    T: TargetMachineRef,
+    M: ModuleRef,
+    codegen: CodeGenFileType,
+    ErrorMessage: *[*:0]u8,
+    OutMemBuf: *MemoryBufferRef,
+) c_int;
+
+/// Get the start of a memory buffer
+pub extern "c" fn LLVMGetBufferStart(MemBuf: MemoryBufferRef) [*]const u8;
+
+/// Get the size of a memory buffer
+pub extern "c" fn LLVMGetBufferSize(MemBuf: MemoryBufferRef) usize;
+
+/// Dispose of a memory buffer
+pub extern "c" fn LLVMDisposeMemoryBuffer(MemBuf: MemoryBufferRef) void;
+
+// ============================================================================
+// 🆕 v0.2.0: ORC LLJIT (llvm-c/LLJIT.h, llvm-c/Orc.h)
+// ============================================================================
+
+/// Create an LLJIT builder with default options
+pub extern "c" fn LLVMOrcCreateLLJITBuilder() OrcLLJITBuilderRef;
+
+/// Create an LLJIT instance (takes ownership of the builder)
+pub extern "c" fn LLVMOrcCreateLLJIT(Result: *OrcLLJITRef, Builder: OrcLLJITBuilderRef) ErrorRef;
+
+/// Dispose of an LLJIT instance
+pub extern "c" fn LLVMOrcDisposeLLJIT(J: OrcLLJITRef) ErrorRef;
+
+/// Get the main JITDylib of an LLJIT instance
+pub extern "c" fn LLVMOrcLLJITGetMainJITDylib(J: OrcLLJITRef) OrcJITDylibRef;
+
+/// Global symbol prefix of the JIT's target ('_' on Darwin, 0 elsewhere)
+pub extern "c" fn LLVMOrcLLJITGetGlobalPrefix(J: OrcLLJITRef) u8;
+
+/// Add an IR module to a JITDylib (takes ownership of the module)
+pub extern "c" fn LLVMOrcLLJITAddLLVMIRModule(
+    J: OrcLLJITRef,
+    JD: OrcJITDylibRef,
+    TSM: OrcThreadSafeModuleRef,
+) ErrorRef;
+
+/// Look up a symbol, compiling it on first use
+pub extern "c" fn LLVMOrcLLJITLookup(
+    J: OrcLLJITRef,
+    Result: *OrcExecutorAddress,
+    Name: [*:0]const u8,
+) ErrorRef;
+
+/// Create a generator that resolves symbols from the host process (libc etc.)
+pub extern "c" fn LLVMOrcCreateDynamicLibrarySearchGeneratorForProcess(
+    Result: *OrcDefinitionGeneratorRef,
+    GlobalPrefx: u8,
+    Filter: ?*const anyopaque,
+    FilterCtx: ?*anyopaque,
+) ErrorRef;
+
+/// Attach a definition generator to a JITDylib (takes ownership)
+pub extern "c" fn LLVMOrcJITDylibAddGenerator(JD: OrcJITDylibRef, DG: OrcDefinitionGeneratorRef) void;
+
+/// Create a thread-safe LLVM context
+pub extern "c" fn LLVMOrcCreateNewThreadSafeContext() OrcThreadSafeContextRef;
+
+/// Get the LLVM context wrapped by a thread-safe context
+pub extern "c" fn LLVMOrcThreadSafeContextGetContext(TSCtx: OrcThreadSafeContextRef) ContextRef;
+
+/// Dispose of a thread-safe context handle (modules keep the context alive)
+pub extern "c" fn LLVMOrcDisposeThreadSafeContext(TSCtx: OrcThreadSafeContextRef) void;
+
+/// Wrap a module (owned by the context of TSCtx) for the JIT
+pub extern "c" fn LLVMOrcCreateNewThreadSafeModule(M: ModuleRef, TSCtx: OrcThreadSafeContextRef) OrcThreadSafeModuleRef;
+
+// ============================================================================
+// 🆕 v0.2.0: Typed lowering (aggregates, type queries, float ops, globals)
+// ============================================================================
+
+/// LLVMTypeKind（llvm-c/Core.h），只列出后端用到的部分
+pub const TypeKind = enum(c_uint) {
+    Void = 0,
+    Half = 1,
+    Float = 2,
+    Double = 3,
+    Integer = 8,
+    Function = 9,
+    Struct = 10,
+    Array = 11,
+    Pointer = 12,
+    Vector = 13,
+    _,
+};
+
+// LLVM Real (floating point) Comparison Predicates
+pub const RealPredicate = enum(c_uint) {
+    OEQ = 1,  // ordered and equal
+    OGT = 2,  // ordered and greater than
+    OGE = 3,  // ordered and greater than or equal
+    OLT = 4,  // ordered and less than
+    OLE = 5,  // ordered and less than or equal
+    UNE = 14, // unordered or not equal
+};
+
+/// Create an empty named (identified) struct type
+pub extern "c" fn LLVMStructCreateNamed(C: ContextRef, Name: [*:0]const u8) TypeRef;
+
+/// Set the body of a named struct type
+pub extern "c" fn LLVMStructSetBody(
+    StructTy: TypeRef,
+    ElementTypes: [*]TypeRef,
+    ElementCount: c_uint,
+    Packed: c_int,
+) void;
+
+/// Get the kind of a type
+pub extern "c" fn LLVMGetTypeKind(Ty: TypeRef) TypeKind;
+
+/// Get the bit width of an integer type
+pub extern "c" fn LLVMGetIntTypeWidth(IntegerTy: TypeRef) c_uint;
+
+/// Get the element type of an array type
+pub extern "c" fn LLVMGetElementType(Ty: TypeRef) TypeRef;
+
+/// Get the length of an array type
+pub extern "c" fn LLVMGetArrayLength2(ArrayTy: TypeRef) u64;
+
+/// Get the return type of a function type
+pub extern "c" fn LLVMGetReturnType(FunctionTy: TypeRef) TypeRef;
+
+/// Get the number of parameters of a function type
+pub extern "c" fn LLVMCountParamTypes(FunctionTy: TypeRef) c_uint;
+
+/// Copy the parameter types of a function type into Dest
+pub extern "c" fn LLVMGetParamTypes(FunctionTy: TypeRef, Dest: [*]TypeRef) void;
+
+/// Get the value type of a global (the function type for functions)
+pub extern "c" fn LLVMGlobalGetValueType(Global: ValueRef) TypeRef;
+
+/// Look up a function in a module by name
+pub extern "c" fn LLVMGetNamedFunction(M: ModuleRef, Name: [*:0]const u8) ValueRef;
+
+/// Get the data layout of a module
+pub extern "c" fn LLVMGetModuleDataLayout(M: ModuleRef) TargetDataRef;
+
+/// ABI size of a type in bytes
+pub extern "c" fn LLVMABISizeOfType(TD: TargetDataRef, Ty: TypeRef) c_ulonglong;
+
+/// Add a global variable to a module
+pub extern "c" fn LLVMAddGlobal(M: ModuleRef, Ty: TypeRef, Name: [*:0]const u8) ValueRef;
+
+/// Set the initializer of a global variable
+pub extern "c" fn LLVMSetInitializer(GlobalVar: ValueRef, ConstantVal: ValueRef) void;
+
+/// Create an undef value
+pub extern "c" fn LLVMGetUndef(Ty: TypeRef) ValueRef;
+
+/// Get the entry block of a function
+pub extern "c" fn LLVMGetEntryBasicBlock(Fn: ValueRef) BasicBlockRef;
+
+/// Get the first instruction of a basic block (null if empty)
+pub extern "c" fn LLVMGetFirstInstruction(BB: BasicBlockRef) ValueRef;
+
+/// Position builder before an instruction
+pub extern "c" fn LLVMPositionBuilderBefore(Builder: BuilderRef, Instr: ValueRef) void;
+
+/// Build insertvalue instruction
+pub extern "c" fn LLVMBuildInsertValue(
+    Builder: BuilderRef,
+    AggVal: ValueRef,
+    EltVal: ValueRef,
+    Index: c_uint,
+    Name: [*:0]const u8,
+) ValueRef;
+
+/// Build extractvalue instruction
+pub extern "c" fn LLVMBuildExtractValue(
+    Builder: BuilderRef,
+    AggVal: ValueRef,
+    Index: c_uint,
+    Name: [*:0]const u8,
+) ValueRef;
+
+/// Build select instruction
+pub extern "c" fn LLVMBuildSelect(
+    Builder: BuilderRef,
+    If: ValueRef,
+    Then: ValueRef,
+    Else: ValueRef,
+    Name: [*:0]const u8,
+) ValueRef;
+
+/// Build unreachable instruction
+pub extern "c" fn LLVMBuildUnreachable(Builder: BuilderRef) ValueRef;
+
+/// Build unsigned division
+pub extern "c" fn LLVMBuildUDiv(Builder: BuilderRef, LHS: ValueRef, RHS: ValueRef, Name: [*:0]const u8) ValueRef;
+
+/// Build signed remainder
+pub extern "c" fn LLVMBuildSRem(Builder: BuilderRef, LHS: ValueRef, RHS: ValueRef, Name: [*:0]const u8) ValueRef;
+
+/// Build unsigned remainder
+pub extern "c" fn LLVMBuildURem(Builder: BuilderRef, LHS: ValueRef, RHS: ValueRef, Name: [*:0]const u8) ValueRef;
+
+/// Build floating point add
+pub extern "c" fn LLVMBuildFAdd(Builder: BuilderRef, LHS: ValueRef, RHS: ValueRef, Name: [*:0]const u8) ValueRef;
+
+/// Build floating point sub
+pub extern "c" fn LLVMBuildFSub(Builder: BuilderRef, LHS: ValueRef, RHS: ValueRef, Name: [*:0]const u8) ValueRef;
+
+/// Build floating point mul
+pub extern "c" fn LLVMBuildFMul(Builder: BuilderRef, LHS: ValueRef, RHS: ValueRef, Name: [*:0]const u8) ValueRef;
+
+/// Build floating point div
+pub extern "c" fn LLVMBuildFDiv(Builder: BuilderRef, LHS: ValueRef, RHS: ValueRef, Name: [*:0]const u8) ValueRef;
+
+/// Build floating point remainder
+pub extern "c" fn LLVMBuildFRem(Builder: BuilderRef, LHS: ValueRef, RHS: ValueRef, Name: [*:0]const u8) ValueRef;
+
+/// Build floating point negation
+pub extern "c" fn LLVMBuildFNeg(Builder: BuilderRef, V: ValueRef, Name: [*:0]const u8) ValueRef;
+
+/// Build floating point comparison
+pub extern "c" fn LLVMBuildFCmp(
+    Builder: BuilderRef,
+    Op: RealPredicate,
+    LHS: ValueRef,
+    RHS: ValueRef,
+    Name: [*:0]const u8,
+) ValueRef;
+
+// ============================================================================
+// 🆕 v0.2.0: Debug info (llvm-c/DebugInfo.h) and function attributes
+// ============================================================================
+
+/// LLVMDWARFSourceLanguage：Paw 没有自己的 DWARF 语言代码，按 C 处理
+pub const DWARFSourceLanguageC: c_uint = 1;
+/// LLVMDWARFEmissionKind
+pub const DWARFEmissionFull: c_uint = 1;
+/// LLVMModuleFlagBehavior
+pub const ModuleFlagBehaviorWarning: c_uint = 1;
+/// LLVMAttributeFunctionIndex（~0U）
+pub const AttributeFunctionIndex: c_uint = std.math.maxInt(c_uint);
+
+pub extern "c" fn LLVMCreateDIBuilder(M: ModuleRef) DIBuilderRef;
+pub extern "c" fn LLVMDisposeDIBuilder(Builder: DIBuilderRef) void;
+pub extern "c" fn LLVMDIBuilderFinalize(Builder: DIBuilderRef) void;
+pub extern "c" fn LLVMDIBuilderCreateFile(
+    Builder: DIBuilderRef,
+    Filename: [*]const u8,
+    FilenameLen: usize,
+    Directory: [*]const u8,
+    DirectoryLen: usize,
+) MetadataRef;
+pub extern "c" fn LLVMDIBuilderCreateCompileUnit(
+    Builder: DIBuilderRef,
+    Lang: c_uint,
+    FileRef: MetadataRef,
+    Producer: [*]const u8,
+    ProducerLen: usize,
+    isOptimized: c_int,
+    Flags: [*]const u8,
+    FlagsLen: usize,
+    RuntimeVer: c_uint,
+    SplitName: [*]const u8,
+    SplitNameLen: usize,
+    Kind: c_uint,
+    DWOId: c_uint,
+    SplitDebugInlining: c_int,
+    DebugInfoForProfiling: c_int,
+    SysRoot: [*]const u8,
+    SysRootLen: usize,
+    SDK: [*]const u8,
+    SDKLen: usize,
+) MetadataRef;
+pub extern "c" fn LLVMDIBuilderCreateSubroutineType(
+    Builder: DIBuilderRef,
+    File: MetadataRef,
+    ParameterTypes: ?[*]MetadataRef,
+    NumParameterTypes: c_uint,
+    Flags: c_int,
+) MetadataRef;
+pub extern "c" fn LLVMDIBuilderCreateFunction(
+    Builder: DIBuilderRef,
+    Scope: MetadataRef,
+    Name: [*]const u8,
+    NameLen: usize,
+    LinkageName: [*]const u8,
+    LinkageNameLen: usize,
+    File: MetadataRef,
+    LineNo: c_uint,
+    Ty: MetadataRef,
+    IsLocalToUnit: c_int,
+    IsDefinition: c_int,
+    ScopeLine: c_uint,
+    Flags: c_int,
+    IsOptimized: c_int,
+) MetadataRef;
+pub extern "c" fn LLVMSetSubprogram(Func: ValueRef, SP: MetadataRef) void;
+pub extern "c" fn LLVMDIBuilderCreateDebugLocation(
+    Ctx: ContextRef,
+    Line: c_uint,
+    Column: c_uint,
+    Scope: MetadataRef,
+    InlinedAt: MetadataRef,
+) MetadataRef;
+pub extern "c" fn LLVMSetCurrentDebugLocation2(Builder: BuilderRef, Loc: MetadataRef) void;
+pub extern "c" fn LLVMDebugMetadataVersion() c_uint;
+pub extern "c" fn LLVMAddModuleFlag(M: ModuleRef, Behavior: c_uint, Key: [*]const u8, KeyLen: usize, Val: MetadataRef) void;
+pub extern "c" fn LLVMValueAsMetadata(Val: ValueRef) MetadataRef;
+
+pub extern "c" fn LLVMCreateStringAttribute(C: ContextRef, K: [*]const u8, KLength: c_uint, V: [*]const u8, VLength: c_uint) AttributeRef;
+pub extern "c" fn LLVMAddAttributeAtIndex(F: ValueRef, Idx: c_uint, A: AttributeRef) void;
+
+pub extern "c" fn LLVMCloneModule(M: ModuleRef) ModuleRef;
+
+// ============================================================================
+// 🆕 v0.2.0: Profile-guided optimization support
+// ============================================================================
+
+pub extern "c" fn LLVMConstStringInContext2(C: ContextRef, Str: [*]const u8, Length: usize, DontNullTerminate: c_int) ValueRef;
+pub extern "c" fn LLVMSetGlobalConstant(GlobalVar: ValueRef, IsConstant: c_int) void;
+
+/// 写出 LLVM bitcode（--pgo-use 时交给 clang 带着剖析数据优化），成功返回 0
+pub extern "c" fn LLVMWriteBitcodeToFile(M: ModuleRef, Path: [*:0]const u8) c_int;
+
 // ============================================================================
 // Wrapper Types for Better Zig Experience
 // ============================================================================
@@ -478,6 +1009,11 @@ pub const Context = struct {
         LLVMContextDispose(self.ref);
     }
 
+    /// 🆕 v0.2.0: 发布构建中不保留指令名（省去 LLVM 的名字唯一化和存储）
+    pub fn setDiscardValueNames(self: Context, discard: bool) void {
+        LLVMContextSetDiscardValueNames(self.ref, if (discard) 1 else 0);
+    }
+
     pub fn createModule(self: Context, name: [:0]const u8) Module {
         return Module{
             .ref = LLVMModuleCreateWithNameInContext(name.ptr, self.ref),
@@ -540,6 +1076,11 @@ pub const Context = struct {
             if (is_packed) 1 else 0,
         );
     }
+    
+    /// 🆕 v0.2.0: 创建命名结构体类型（之后用 setStructBody 设置字段）
+    pub fn namedStructType(self: Context, name: [:0]const u8) TypeRef {
+        return LLVMStructCreateNamed(self.ref, name.ptr);
+    }
 };
 
 pub const Module = struct {
@@ -560,6 +1101,43 @@ pub const Module = struct {
         return LLVMAddFunction(self.ref, name.ptr, func_type);
     }
 
+    /// 🆕 v0.2.0: 按名字查找函数（不存在时返回 null）
+    pub fn getNamedFunction(self: Module, name: [:0]const u8) ValueRef {
+        return LLVMGetNamedFunction(self.ref, name.ptr);
+    }
+
+    /// 🆕 v0.2.0: 添加全局变量
+    pub fn addGlobal(self: Module, ty: TypeRef, name: [:0]const u8) ValueRef {
+        return LLVMAddGlobal(self.ref, ty, name.ptr);
+    }
+
+    /// 🆕 v0.2.0: 复制整个模块（同一个 context），由调用方 dispose
+    pub fn clone(self: Module) Module {
+        return Module{ .ref = LLVMCloneModule(self.ref), .context = self.context };
+    }
+
+    /// 🆕 v0.2.0: 添加以 NUL 结尾的字符串常量全局变量
+    pub fn addStringConstant(self: Module, name: [:0]const u8, value: []const u8, linkage: Linkage) ValueRef {
+        const init = LLVMConstStringInContext2(self.context.ref, value.ptr, value.len, 0);
+        const global = LLVMAddGlobal(self.ref, LLVMTypeOf(init), name.ptr);
+        LLVMSetInitializer(global, init);
+        LLVMSetGlobalConstant(global, 1);
+        LLVMSetLinkage(global, linkage);
+        return global;
+    }
+
+    /// 🆕 v0.2.0: 声明模块携带的调试信息版本（否则调试信息会被丢弃）
+    pub fn addDebugInfoVersionFlag(self: Module) void {
+        const version = LLVMConstInt(self.context.i32Type(), LLVMDebugMetadataVersion(), 0);
+        const key = "Debug Info Version";
+        LLVMAddModuleFlag(self.ref, ModuleFlagBehaviorWarning, key.ptr, key.len, LLVMValueAsMetadata(version));
+    }
+
+    /// 🆕 v0.2.0: 类型在该模块数据布局下的 ABI 大小（字节）
+    pub fn abiSizeOf(self: Module, ty: TypeRef) u64 {
+        return LLVMABISizeOfType(LLVMGetModuleDataLayout(self.ref), ty);
+    }
+
     pub fn verify(self: Module) !void {
         var error_msg: [*:0]u8 = undefined;
         const result = LLVMVerifyModule(self.ref, 2, &error_msg); // 2 = ReturnStatusAction
@@ -569,6 +1147,233 @@ pub const Module = struct {
             return error.VerificationFailed;
         }
     }
+
+    /// 🆕 v0.2.0: 运行新 Pass Manager 管道（如 "default<O2>"）
+    pub fn runPasses(self: Module, passes: [:0]const u8, tm: TargetMachineRef, options: PassBuilderOptions) !void {
+        const err = LLVMRunPasses(self.ref, passes.ptr, tm, options.ref);
+        if (err != null) {
+            const msg = LLVMGetErrorMessage(err);
+            defer LLVMDisposeErrorMessage(msg);
+            std.debug.print("LLVM pass pipeline '{s}' failed: {s}\n", .{ passes, msg });
+            return error.PassPipelineFailed;
+        }
+    }
+
+    /// 🆕 v0.2.0: 把模块写成 .bc 文件
+    pub fn writeBitcode(self: Module, path: [:0]const u8) !void {
+        if (LLVMWriteBitcodeToFile(self.ref, path.ptr) != 0) {
+            std.debug.print("LLVM failed to write bitcode: {s}\n", .{path});
+            return error.EmitFailed;
+        }
+    }
+};
+
+/// 🆕 v0.2.0: 初始化本机架构的 target（只需调用一次）
+/// 没有绑定初始化函数的架构返回 error.TargetNotFound（pawc 仍可使用 C 后端）
+pub fn initializeNativeTarget() !void {
+    switch (builtin.cpu.arch) {
+        .x86_64, .x86 => {
+            LLVMInitializeX86TargetInfo();
+            LLVMInitializeX86Target();
+            LLVMInitializeX86TargetMC();
+            LLVMInitializeX86AsmPrinter();
+        },
+        .aarch64 => {
+            LLVMInitializeAArch64TargetInfo();
+            LLVMInitializeAArch64Target();
+            LLVMInitializeAArch64TargetMC();
+            LLVMInitializeAArch64AsmPrinter();
+        },
+        .riscv64 => {
+            LLVMInitializeRISCVTargetInfo();
+            LLVMInitializeRISCVTarget();
+            LLVMInitializeRISCVTargetMC();
+            LLVMInitializeRISCVAsmPrinter();
+        },
+        .arm, .armeb, .thumb, .thumbeb => {
+            LLVMInitializeARMTargetInfo();
+            LLVMInitializeARMTarget();
+            LLVMInitializeARMTargetMC();
+            LLVMInitializeARMAsmPrinter();
+        },
+        else => {
+            std.debug.print("LLVM backend: no native target for host architecture '{s}'\n", .{@tagName(builtin.cpu.arch)});
+            return error.TargetNotFound;
+        },
+    }
+}
+
+/// 🆕 v0.2.0: Target machine wrapper (host triple / CPU / features)
+pub const TargetMachine = struct {
+    ref: TargetMachineRef,
+    triple: [*:0]u8,
+
+    /// 为本机创建 target machine
+    pub fn createHost(level: CodeGenOptLevel) !TargetMachine {
+        try initializeNativeTarget();
+
+        const triple = LLVMGetDefaultTargetTriple();
+        errdefer LLVMDisposeMessage(triple);
+
+        var target: TargetRef = null;
+        var error_msg: [*:0]u8 = undefined;
+        if (LLVMGetTargetFromTriple(triple, &target, &error_msg) != 0) {
+            defer LLVMDisposeMessage(error_msg);
+            std.debug.print("LLVM target lookup failed for '{s}': {s}\n", .{ triple, error_msg });
+            return error.TargetNotFound;
+        }
+
+        const cpu = LLVMGetHostCPUName();
+        defer LLVMDisposeMessage(cpu);
+        const features = LLVMGetHostCPUFeatures();
+        defer LLVMDisposeMessage(features);
+
+        const ref = LLVMCreateTargetMachine(target, triple, cpu, features, level, .PIC, .Default);
+        if (ref == null) return error.TargetMachineCreationFailed;
+
+        return TargetMachine{ .ref = ref, .triple = triple };
+    }
+
+    pub fn dispose(self: *TargetMachine) void {
+        LLVMDisposeTargetMachine(self.ref);
+        LLVMDisposeMessage(self.triple);
+    }
+
+    /// 把 triple 和 data layout 写入模块（优化前调用，pass 才能使用目标信息）
+    pub fn configureModule(self: TargetMachine, module: Module) void {
+        LLVMSetTarget(module.ref, self.triple);
+        const layout = LLVMCreateTargetDataLayout(self.ref);
+        defer LLVMDisposeTargetData(layout);
+        LLVMSetModuleDataLayout(module.ref, layout);
+    }
+
+    pub fn emitToFile(self: TargetMachine, module: Module, path: [:0]const u8, file_type: CodeGenFileType) !void {
+        var error_msg: [*:0]u8 = undefined;
+        if (LLVMTargetMachineEmitToFile(self.ref, module.ref, path.ptr, file_type, &error_msg) != 0) {
+            defer LLVMDisposeMessage(error_msg);
+            std.debug.print("LLVM code emission failed: {s}\n", .{error_msg});
+            return error.EmitFailed;
+        }
+    }
+
+    pub fn emitToMemoryBuffer(self: TargetMachine, module: Module, file_type: CodeGenFileType) !MemoryBuffer {
+        var error_msg: [*:0]u8 = undefined;
+        var buf: MemoryBufferRef = null;
+        if (LLVMTargetMachineEmitToMemoryBuffer(self.ref, module.ref, file_type, &error_msg, &buf) != 0) {
+            defer LLVMDisposeMessage(error_msg);
+            std.debug.print("LLVM code emission failed: {s}\n", .{error_msg});
+            return error.EmitFailed;
+        }
+        return MemoryBuffer{ .ref = buf };
+    }
+};
+
+/// 🆕 v0.2.0: Memory buffer wrapper
+pub const MemoryBuffer = struct {
+    ref: MemoryBufferRef,
+
+    pub fn dispose(self: *MemoryBuffer) void {
+        LLVMDisposeMemoryBuffer(self.ref);
+    }
+
+    pub fn bytes(self: MemoryBuffer) []const u8 {
+        return LLVMGetBufferStart(self.ref)[0..LLVMGetBufferSize(self.ref)];
+    }
+};
+
+/// 🆕 v0.2.0: ORC LLJIT wrapper
+/// 交给 JIT 的模块必须在 context() 返回的 context 中创建
+pub const LLJIT = struct {
+    ref: OrcLLJITRef,
+    ts_context: OrcThreadSafeContextRef,
+
+    pub fn create() !LLJIT {
+        try initializeNativeTarget();
+
+        var ref: OrcLLJITRef = null;
+        try checkOrcError(LLVMOrcCreateLLJIT(&ref, LLVMOrcCreateLLJITBuilder()), "LLJIT creation");
+        errdefer _ = LLVMOrcDisposeLLJIT(ref);
+
+        // JIT 代码中的外部符号（printf、malloc 等）从宿主进程中解析
+        var generator: OrcDefinitionGeneratorRef = null;
+        try checkOrcError(LLVMOrcCreateDynamicLibrarySearchGeneratorForProcess(
+            &generator,
+            LLVMOrcLLJITGetGlobalPrefix(ref),
+            null,
+            null,
+        ), "process symbol generator");
+        LLVMOrcJITDylibAddGenerator(LLVMOrcLLJITGetMainJITDylib(ref), generator);
+
+        return LLJIT{
+            .ref = ref,
+            .ts_context = LLVMOrcCreateNewThreadSafeContext(),
+        };
+    }
+
+    pub fn dispose(self: *LLJIT) void {
+        checkOrcError(LLVMOrcDisposeLLJIT(self.ref), "LLJIT disposal") catch {};
+        LLVMOrcDisposeThreadSafeContext(self.ts_context);
+    }
+
+    /// JIT 会话共享的 LLVM context（由 JIT 持有，调用方不能 dispose）
+    pub fn context(self: LLJIT) Context {
+        return Context{ .ref = LLVMOrcThreadSafeContextGetContext(self.ts_context) };
+    }
+
+    /// 把模块加入主 JITDylib；之后模块归 JIT 所有（无论成功与否都不能再 dispose）
+    pub fn addModule(self: LLJIT, module: Module) !void {
+        const tsm = LLVMOrcCreateNewThreadSafeModule(module.ref, self.ts_context);
+        try checkOrcError(LLVMOrcLLJITAddLLVMIRModule(self.ref, LLVMOrcLLJITGetMainJITDylib(self.ref), tsm), "adding module");
+    }
+
+    /// 查找符号地址（第一次查找时才真正编译所在的模块）
+    pub fn lookup(self: LLJIT, name: [:0]const u8) !usize {
+        var address: OrcExecutorAddress = 0;
+        try checkOrcError(LLVMOrcLLJITLookup(self.ref, &address, name.ptr), "symbol lookup");
+        return @intCast(address);
+    }
+};
+
+/// 🆕 v0.2.0: 打印并消费 ORC 返回的错误
+fn checkOrcError(err: ErrorRef, what: []const u8) !void {
+    if (err == null) return;
+    const msg = LLVMGetErrorMessage(err);
+    defer LLVMDisposeErrorMessage(msg);
+    std.debug.print("LLVM JIT error ({s}): {s}\n", .{ what, msg });
+    return error.JITFailed;
+}
+
+/// 🆕 v0.2.0: Pass builder options wrapper
+pub const PassBuilderOptions = struct {
+    ref: PassBuilderOptionsRef,
+
+    pub fn create() PassBuilderOptions {
+        return PassBuilderOptions{ .ref = LLVMCreatePassBuilderOptions() };
+    }
+
+    pub fn dispose(self: *PassBuilderOptions) void {
+        LLVMDisposePassBuilderOptions(self.ref);
+    }
+
+    pub fn setVerifyEach(self: PassBuilderOptions, enabled: bool) void {
+        LLVMPassBuilderOptionsSetVerifyEach(self.ref, if (enabled) 1 else 0);
+    }
+
+    pub fn setLoopVectorization(self: PassBuilderOptions, enabled: bool) void {
+        LLVMPassBuilderOptionsSetLoopVectorization(self.ref, if (enabled) 1 else 0);
+    }
+
+    pub fn setSLPVectorization(self: PassBuilderOptions, enabled: bool) void {
+        LLVMPassBuilderOptionsSetSLPVectorization(self.ref, if (enabled) 1 else 0);
+    }
+
+    pub fn setLoopUnrolling(self: PassBuilderOptions, enabled: bool) void {
+        LLVMPassBuilderOptionsSetLoopUnrolling(self.ref, if (enabled) 1 else 0);
+    }
+
+    pub fn setMergeFunctions(self: PassBuilderOptions, enabled: bool) void {
+        LLVMPassBuilderOptionsSetMergeFunctions(self.ref, if (enabled) 1 else 0);
+    }
 };
 
 pub const Builder = struct {
@@ -725,8 +1530,166 @@ pub const Builder = struct {
     pub fn buildFPTrunc(self: Builder, value: ValueRef, dest_ty: TypeRef, name: [:0]const u8) ValueRef {
         return LLVMBuildFPTrunc(self.ref, value, dest_ty, name.ptr);
     }
+    
+    /// 🆕 v0.2.0
+    pub fn buildIntToPtr(self: Builder, value: ValueRef, dest_ty: TypeRef, name: [:0]const u8) ValueRef {
+        return LLVMBuildIntToPtr(self.ref, value, dest_ty, name.ptr);
+    }
+    
+    /// 🆕 v0.2.0
+    pub fn buildPtrToInt(self: Builder, value: ValueRef, dest_ty: TypeRef, name: [:0]const u8) ValueRef {
+        return LLVMBuildPtrToInt(self.ref, value, dest_ty, name.ptr);
+    }
+    
+    // 🆕 v0.2.0: Typed lowering wrappers
+    /// 🆕 v0.2.0: 之后创建的指令附加该调试位置（null = 不附加）
+    pub fn setDebugLocation(self: Builder, location: MetadataRef) void {
+        LLVMSetCurrentDebugLocation2(self.ref, location);
+    }
+
+    pub fn positionBefore(self: Builder, instr: ValueRef) void {
+        LLVMPositionBuilderBefore(self.ref, instr);
+    }
+    
+    pub fn buildUDiv(self: Builder, lhs: ValueRef, rhs: ValueRef, name: [:0]const u8) ValueRef {
+        return LLVMBuildUDiv(self.ref, lhs, rhs, name.ptr);
+    }
+    
+    pub fn buildSRem(self: Builder, lhs: ValueRef, rhs: ValueRef, name: [:0]const u8) ValueRef {
+        return LLVMBuildSRem(self.ref, lhs, rhs, name.ptr);
+    }
+    
+    pub fn buildURem(self: Builder, lhs: ValueRef, rhs: ValueRef, name: [:0]const u8) ValueRef {
+        return LLVMBuildURem(self.ref, lhs, rhs, name.ptr);
+    }
+    
+    pub fn buildFAdd(self: Builder, lhs: ValueRef, rhs: ValueRef, name: [:0]const u8) ValueRef {
+        return LLVMBuildFAdd(self.ref, lhs, rhs, name.ptr);
+    }
+    
+    pub fn buildFSub(self: Builder, lhs: ValueRef, rhs: ValueRef, name: [:0]const u8) ValueRef {
+        return LLVMBuildFSub(self.ref, lhs, rhs, name.ptr);
+    }
+    
+    pub fn buildFMul(self: Builder, lhs: ValueRef, rhs: ValueRef, name: [:0]const u8) ValueRef {
+        return LLVMBuildFMul(self.ref, lhs, rhs, name.ptr);
+    }
+    
+    pub fn buildFDiv(self: Builder, lhs: ValueRef, rhs: ValueRef, name: [:0]const u8) ValueRef {
+        return LLVMBuildFDiv(self.ref, lhs, rhs, name.ptr);
+    }
+    
+    pub fn buildFRem(self: Builder, lhs: ValueRef, rhs: ValueRef, name: [:0]const u8) ValueRef {
+        return LLVMBuildFRem(self.ref, lhs, rhs, name.ptr);
+    }
+    
+    pub fn buildFNeg(self: Builder, value: ValueRef, name: [:0]const u8) ValueRef {
+        return LLVMBuildFNeg(self.ref, value, name.ptr);
+    }
+    
+    pub fn buildFCmp(self: Builder, op: RealPredicate, lhs: ValueRef, rhs: ValueRef, name: [:0]const u8) ValueRef {
+        return LLVMBuildFCmp(self.ref, op, lhs, rhs, name.ptr);
+    }
+    
+    pub fn buildInsertValue(self: Builder, aggregate: ValueRef, element: ValueRef, index: u32, name: [:0]const u8) ValueRef {
+        return LLVMBuildInsertValue(self.ref, aggregate, element, index, name.ptr);
+    }
+    
+    pub fn buildExtractValue(self: Builder, aggregate: ValueRef, index: u32, name: [:0]const u8) ValueRef {
+        return LLVMBuildExtractValue(self.ref, aggregate, index, name.ptr);
+    }
+    
+    pub fn buildSelect(self: Builder, cond: ValueRef, then_value: ValueRef, else_value: ValueRef, name: [:0]const u8) ValueRef {
+        return LLVMBuildSelect(self.ref, cond, then_value, else_value, name.ptr);
+    }
+    
+    pub fn buildCondBr(self: Builder, cond: ValueRef, then_block: BasicBlockRef, else_block: BasicBlockRef) ValueRef {
+        return LLVMBuildCondBr(self.ref, cond, then_block, else_block);
+    }
+    
+    pub fn buildUnreachable(self: Builder) ValueRef {
+        return LLVMBuildUnreachable(self.ref);
+    }
+};
+
+/// 🆕 v0.2.0: DIBuilder wrapper（只生成行号信息所需的文件、编译单元和函数）
+pub const DIBuilder = struct {
+    ref: DIBuilderRef,
+
+    pub fn create(module: Module) DIBuilder {
+        return DIBuilder{ .ref = LLVMCreateDIBuilder(module.ref) };
+    }
+
+    pub fn dispose(self: *DIBuilder) void {
+        LLVMDisposeDIBuilder(self.ref);
+    }
+
+    /// 生成函数体之后、验证和优化之前调用
+    pub fn finalize(self: DIBuilder) void {
+        LLVMDIBuilderFinalize(self.ref);
+    }
+
+    pub fn createFile(self: DIBuilder, filename: []const u8, directory: []const u8) MetadataRef {
+        return LLVMDIBuilderCreateFile(self.ref, filename.ptr, filename.len, directory.ptr, directory.len);
+    }
+
+    pub fn createCompileUnit(self: DIBuilder, file: MetadataRef, producer: []const u8, is_optimized: bool) MetadataRef {
+        return LLVMDIBuilderCreateCompileUnit(
+            self.ref,
+            DWARFSourceLanguageC,
+            file,
+            producer.ptr,
+            producer.len,
+            @intFromBool(is_optimized),
+            "",
+            0,
+            0,
+            "",
+            0,
+            DWARFEmissionFull,
+            0,
+            0,
+            0,
+            "",
+            0,
+            "",
+            0,
+        );
+    }
+
+    /// 函数定义的 DISubprogram（子程序类型不描述参数，只用于行号）
+    pub fn createFunction(self: DIBuilder, file: MetadataRef, name: []const u8, line: u32, is_optimized: bool) MetadataRef {
+        const subroutine_type = LLVMDIBuilderCreateSubroutineType(self.ref, file, null, 0, 0);
+        return LLVMDIBuilderCreateFunction(
+            self.ref,
+            file,
+            name.ptr,
+            name.len,
+            name.ptr,
+            name.len,
+            file,
+            line,
+            subroutine_type,
+            0,
+            1,
+            line,
+            0,
+            @intFromBool(is_optimized),
+        );
+    }
 };
 
+/// 🆕 v0.2.0: 调试位置（行、列、作用域）
+pub fn debugLocation(context: Context, line: u32, column: u32, scope: MetadataRef) MetadataRef {
+    return LLVMDIBuilderCreateDebugLocation(context.ref, line, column, scope, null);
+}
+
+/// 🆕 v0.2.0: 给函数添加字符串属性（例如 "frame-pointer"="all"）
+pub fn addFunctionAttribute(context: Context, func: ValueRef, key: []const u8, value: []const u8) void {
+    const attr = LLVMCreateStringAttribute(context.ref, key.ptr, @intCast(key.len), value.ptr, @intCast(value.len));
+    LLVMAddAttributeAtIndex(func, AttributeFunctionIndex, attr);
+}
+
 // Helper function to create constant int
 pub fn constI32(context: Context, value: i32) ValueRef {
     return LLVMConstInt(context.i32Type(), @intCast(value), 1);
@@ -770,21 +1733,35 @@ pub fn arrayType(element_type: TypeRef, count: u32) TypeRef {
     return LLVMArrayType(element_type, count);
 }
 
+/// 🆕 v0.2.0: 设置命名结构体的字段类型
+pub fn setStructBody(struct_type: TypeRef, element_types: []TypeRef) void {
+    LLVMStructSetBody(struct_type, element_types.ptr, @intCast(element_types.len), 0);
+}
+
+/// 🆕 v0.2.0: 类型种类；整数类型返回位宽，其它返回 0
+pub fn typeKind(ty: TypeRef) TypeKind {
+    return LLVMGetTypeKind(ty);
+}
+
+pub fn intWidth(ty: TypeRef) u32 {
+    if (LLVMGetTypeKind(ty) != .Integer) return 0;
+    return LLVMGetIntTypeWidth(ty);
+}
+
+/// 🆕 v0.2.0: 函数值的函数类型（调用时使用，不再假设参数都是 i32）
+pub fn functionTypeOf(func: ValueRef) TypeRef {
+    return LLVMGlobalGetValueType(func);
+}
+
 // ============================================================================
-// 🆕 v0.1.7: Optimization Level Support
+// 🆕 v0.2.0: Optimization Level Support
 // ============================================================================
 //
-// 注意：v0.1.7 采用实用方案
-// 优化级别参数会保存在 backend 中，提示用户在编译时使用相应的 clang 优化参数
-// 例如：
-//   pawc app.paw --backend=llvm -O2
-//   clang output.ll -O2 -o app
+// -O1/-O2/-O3 现在在进程内通过新 Pass Manager 执行：
+//   LLVMRunPasses(module, "default<O2>", tm, options)
+// 由 LLVMNativeBackend.optimize() 驱动（见 llvm_native_backend.zig）。
+// -O0 不运行任何 pass，optimize() 只校验模块后直接返回
+// （唯一的例外是 --pgo-generate：插桩 pass 在任何优化级别都要执行）。
 //
-// 这样做的优点：
-// - 不需要链接 LLVM Transform 库（避免符号未定义问题）
-// - 利用 clang 的成熟优化管道
-// - 更稳定可靠
-//
-// PawLang 生成的 LLVM IR 已经是高质量的 SSA 形式，
-// clang 可以直接进行各种优化。
-
+// 需要的 Transform/Passes 库已经由 build.zig 通过
+// `llvm-config --link-shared --libs` 一并链接。
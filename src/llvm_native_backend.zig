@@ -1,11 +1,28 @@
 //! LLVM Native Backend using direct C API
-//! 
+//!
 //! This backend uses our custom LLVM C API bindings to generate
 //! native code directly through LLVM, without generating text IR.
+//!
+//! 🆕 v0.2.0: 类型化降低
+//!   - 基础类型按实际位宽降低（bool = i1, char = i8, i64 = i64 ...）
+//!   - struct          -> LLVM 命名结构体（字段顺序与声明一致）
+//!   - enum            -> { i32 tag, [N x i64] payload }；所有变体都不带数据时就是 i32 tag
+//!   - [T; N]          -> [N x T]；[T] 和 string 是指针
+//!   - 方法            -> Type_method(ptr self, ...)（与 C 后端的命名和按指针传 self 一致）
+//!   - 泛型函数 / 泛型类型的方法在首次调用时单态化（Vec_i32_length），
+//!     以 linkonce_odr 链接，多个模块中的同一实例只保留一份
+//!     JIT 会话中共享一个 InstanceRegistry：之前的模块生成过的实例只声明不生成，
+//!     此时实例以 weak_odr 链接，优化时不会因为本模块没有用到而被删除
+//!   表达式类型沿用类型检查器的推导规则：从声明（函数签名、结构体字段、
+//!   枚举变体）和带类型的局部变量推出，而不是默认 i32。
 
 const std = @import("std");
 const ast = @import("ast.zig");
 const llvm = @import("llvm_c_api.zig");
+const prof = @import("profiler.zig");  // 🆕 v0.2.0
+const pgo = @import("pgo.zig");  // 🆕 v0.2.0
+const intrinsics = @import("intrinsics.zig");  // 🆕 v0.2.0
+const generics = @import("generics.zig");  // 🆕 v0.2.0
 
 // 🆕 v0.1.7: LLVM 优化级别
 pub const OptLevel = enum {
@@ -15,296 +32,780 @@ pub const OptLevel = enum {
     O3,  // Aggressive optimization
 };
 
+/// 🆕 v0.2.0: 降低过程中可能出现的错误（递归函数需要显式错误集）
+const LowerError = error{NoCurrentFunction} || std.mem.Allocator.Error;
+
+/// 🆕 v0.2.0: 类型参数 -> 具体类型的替换（单态化实例、方法中的 Self）
+const TypeContext = struct {
+    params: []const []const u8 = &.{},
+    args: []const ast.Type = &.{},
+    self_type: ?ast.Type = null,
+};
+
+/// 🆕 v0.2.0: 结构体布局（字段类型已替换为具体类型）
+const StructLayout = struct {
+    llvm_type: llvm.TypeRef,
+    field_names: []const []const u8,
+    field_types: []const ast.Type,
+};
+
+/// 🆕 v0.2.0: 枚举布局
+const EnumLayout = struct {
+    llvm_type: llvm.TypeRef,
+    has_data: bool,
+    variant_names: []const []const u8,
+    variant_fields: []const []const ast.Type,
+    payload_types: []const llvm.TypeRef,  // 每个变体的数据结构体（不带数据的变体为 null）
+};
+
+/// 🆕 v0.2.0: 已声明函数的签名（具体类型）
+const Signature = struct {
+    params: []const ast.Type,
+    return_type: ast.Type,
+    has_self: bool,  // 第一个参数是按指针传递的 self
+    is_extern: bool = false,  // 🆕 v0.2.0: 没有函数体的运行时函数声明
+};
+
+/// 🆕 v0.2.0: 等待生成函数体的泛型实例
+const PendingInstance = struct {
+    key: generics.InstanceKey,
+    name: []const u8,
+    func: ast.FunctionDecl,
+    type_ctx: TypeContext,
+};
+
+/// 🆕 v0.2.0: 解析后的调用目标（泛型实例在首次调用时才声明）
+const CallTarget = struct {
+    name: []const u8,
+    return_type: ast.Type,
+    has_self: bool = false,
+    instance: ?PendingInstance = null,
+};
+
+/// 🆕 v0.2.0: 局部变量：栈槽 + LLVM 类型 + Paw 类型
+const Variable = struct {
+    ptr: llvm.ValueRef,
+    llvm_type: llvm.TypeRef,
+    paw_type: ast.Type,
+};
+
+/// 🆕 v0.2.0: 预先取得的基础类型（避免每条指令都经过 LLVM*TypeInContext）
+const PrimitiveTypes = struct {
+    void_type: llvm.TypeRef,
+    i1: llvm.TypeRef,
+    i8: llvm.TypeRef,
+    i16: llvm.TypeRef,
+    i32: llvm.TypeRef,
+    i64: llvm.TypeRef,
+    i128: llvm.TypeRef,
+    f32: llvm.TypeRef,
+    f64: llvm.TypeRef,
+    ptr: llvm.TypeRef,
+
+    fn init(context: llvm.Context) PrimitiveTypes {
+        return PrimitiveTypes{
+            .void_type = context.voidType(),
+            .i1 = context.i1Type(),
+            .i8 = context.i8Type(),
+            .i16 = context.i16Type(),
+            .i32 = context.i32Type(),
+            .i64 = context.i64Type(),
+            .i128 = context.i128Type(),
+            .f32 = context.floatType(),
+            .f64 = context.doubleType(),
+            .ptr = context.pointerType(0),
+        };
+    }
+};
+
+/// 🆕 v0.2.0: -g 调试信息（DWARF 行号表）
+const DebugInfo = struct {
+    builder: llvm.DIBuilder,
+    compile_unit: llvm.MetadataRef,
+    main_file: llvm.MetadataRef,
+    files: std.StringHashMap(llvm.MetadataRef),  // 源文件路径 -> DIFile（prelude、导入的模块）
+};
+
+/// 被模式绑定 / 循环变量遮蔽的变量，作用域结束时恢复
+const SavedVariable = struct {
+    name: []const u8,
+    previous: ?Variable,
+};
+
 pub const LLVMNativeBackend = struct {
     allocator: std.mem.Allocator,
     context: llvm.Context,
     module: llvm.Module,
     builder: llvm.Builder,
-    
+    alloca_builder: llvm.Builder,  // 🆕 v0.2.0: 在入口块开头插入 alloca（便于 mem2reg）
+    types: PrimitiveTypes,  // 🆕 v0.2.0
+
+    // 🆕 v0.2.0: 名字缓冲区：LLVM 会复制传入的名字，所以一个可复用的缓冲区就够了
+    name_buffer: std.ArrayList(u8) = .{},
+    discard_value_names: bool = false,
+
     // Symbol tables
     functions: std.StringHashMap(llvm.ValueRef),
-    variables: std.StringHashMap(llvm.ValueRef),
-    variable_types: std.StringHashMap(llvm.TypeRef),  // Track variable types for load/store
-    
+    signatures: std.StringHashMap(Signature),  // 🆕 v0.2.0
+    variables: std.StringHashMap(Variable),
+
+    // 🆕 v0.2.0: 类型信息
+    arena: std.heap.ArenaAllocator,  // 修饰名、替换后的类型、布局
+    type_decls: std.StringHashMap(ast.TypeDecl),
+    generic_functions: std.StringHashMap(ast.FunctionDecl),
+    enum_variants: std.StringHashMap([]const u8),  // 变体名 -> 枚举名
+    struct_layouts: std.StringHashMap(StructLayout),  // 修饰后的类型名 -> 布局
+    enum_layouts: std.StringHashMap(EnumLayout),
+    pending_instances: std.ArrayList(PendingInstance),
+    type_ctx: TypeContext = .{},
+    // 🆕 v0.2.0: 实例 -> 修饰名：同一实例的每个调用点不再重新构造修饰名
+    instance_names: generics.InstanceMap([]const u8),
+    // 🆕 v0.2.0: JIT 会话中之前的模块已经生成的实例（null = 单独编译）
+    shared_instances: ?*const generics.InstanceRegistry = null,
+
     // Current function context
     current_function: ?llvm.ValueRef,
-    
+    current_return_type: ?llvm.TypeRef = null,  // 🆕 v0.2.0: null = void
+
     // Loop context for break/continue
     current_loop_exit: ?llvm.BasicBlockRef,
     current_loop_continue: ?llvm.BasicBlockRef,
-    
+
     // 🆕 v0.1.7: Optimization level
     opt_level: OptLevel,
-    
+
+    // 🆕 v0.2.0: 本机 target machine（用于优化和直接生成目标文件）
+    target_machine: ?llvm.TargetMachine,
+
+    // 🆕 v0.2.0: --time-report 逐函数计时（null = 不记录）
+    profiler: ?*prof.Profiler = null,
+
+    // 🆕 v0.2.0: -g 调试信息（null = 不生成）和帧指针保留
+    debug: ?DebugInfo = null,
+    frame_pointers: bool = false,
+
+    // 🆕 v0.2.0: --pgo-generate / --pgo-use（use 模式下是已合并的 .profdata 路径）
+    pgo: pgo.Mode = .none,
+
+    // 🆕 v0.2.0: context / module 是否由本后端释放（JIT 模式下归 JIT 所有）
+    owns_context: bool = true,
+    owns_module: bool = true,
+
     /// 初始化 LLVM 后端
     /// 创建 LLVM 上下文、模块和构建器
     /// 🆕 v0.1.7: 添加优化级别参数
     pub fn init(allocator: std.mem.Allocator, module_name: []const u8, opt_level: OptLevel) !LLVMNativeBackend {
-        const context = llvm.Context.create();
-        
+        var context = llvm.Context.create();
+        errdefer context.dispose();
+        return initInContext(allocator, module_name, opt_level, context);
+    }
+
+    /// 🆕 v0.2.0: 在已有的 context 中创建模块（JIT 会话的多个模块共享同一个 context）
+    /// 返回的后端默认拥有该 context；共享 context 时调用方需把 owns_context 设为 false
+    pub fn initInContext(allocator: std.mem.Allocator, module_name: []const u8, opt_level: OptLevel, context: llvm.Context) !LLVMNativeBackend {
         const module_name_z = try allocator.dupeZ(u8, module_name);
         defer allocator.free(module_name_z);
-        
+
         const module = context.createModule(module_name_z);
         const builder = context.createBuilder();
-        
+
+        // 🆕 v0.2.0: 创建本机 target machine；失败时仍可输出与目标无关的 IR
+        const target_machine: ?llvm.TargetMachine = llvm.TargetMachine.createHost(toCodeGenOptLevel(opt_level)) catch null;
+        if (target_machine) |tm| tm.configureModule(module);
+
         return LLVMNativeBackend{
             .allocator = allocator,
             .context = context,
             .module = module,
             .builder = builder,
+            .alloca_builder = context.createBuilder(),
+            .types = PrimitiveTypes.init(context),
             .functions = std.StringHashMap(llvm.ValueRef).init(allocator),
-            .variables = std.StringHashMap(llvm.ValueRef).init(allocator),
-            .variable_types = std.StringHashMap(llvm.TypeRef).init(allocator),
+            .signatures = std.StringHashMap(Signature).init(allocator),
+            .variables = std.StringHashMap(Variable).init(allocator),
+            .arena = std.heap.ArenaAllocator.init(allocator),
+            .type_decls = std.StringHashMap(ast.TypeDecl).init(allocator),
+            .generic_functions = std.StringHashMap(ast.FunctionDecl).init(allocator),
+            .enum_variants = std.StringHashMap([]const u8).init(allocator),
+            .struct_layouts = std.StringHashMap(StructLayout).init(allocator),
+            .enum_layouts = std.StringHashMap(EnumLayout).init(allocator),
+            .pending_instances = .{},
+            .instance_names = generics.InstanceMap([]const u8).init(allocator),
             .current_function = null,
             .current_loop_exit = null,
             .current_loop_continue = null,
             .opt_level = opt_level,  // 🆕 v0.1.7: 保存优化级别
+            .target_machine = target_machine,
         };
     }
-    
+
     /// 释放 LLVM 后端资源
     pub fn deinit(self: *LLVMNativeBackend) void {
         self.functions.deinit();
+        self.signatures.deinit();
         self.variables.deinit();
-        self.variable_types.deinit();
+        self.type_decls.deinit();
+        self.generic_functions.deinit();
+        self.enum_variants.deinit();
+        self.struct_layouts.deinit();
+        self.enum_layouts.deinit();
+        self.pending_instances.deinit(self.allocator);
+        self.instance_names.deinit();
+        self.name_buffer.deinit(self.allocator);
+        self.arena.deinit();
+        if (self.debug) |*debug| {
+            debug.files.deinit();
+            debug.builder.dispose();
+        }
+        if (self.target_machine) |*tm| tm.dispose();
+        self.alloca_builder.dispose();
         self.builder.dispose();
-        self.module.dispose();
-        self.context.dispose();
+        if (self.owns_module) self.module.dispose();
+        if (self.owns_context) self.context.dispose();
     }
-    
+
+    /// 🆕 v0.2.0: 不保留指令 / 参数 / 基本块的名字（发布构建；文本 IR 输出时保持默认的有名字）
+    /// 作用于整个 context；JIT 会话中所有模块共享同一个 context
+    pub fn setDiscardValueNames(self: *LLVMNativeBackend, discard: bool) void {
+        self.discard_value_names = discard;
+        self.context.setDiscardValueNames(discard);
+    }
+
+    /// 🆕 v0.2.0: -g：为每个函数生成 DISubprogram 和行号，perf / gdb 可以映射回 .paw 源码
+    /// 语句没有位置信息，函数中的指令都落在函数的声明行上
+    pub fn enableDebugInfo(self: *LLVMNativeBackend, source_file: []const u8) !void {
+        if (self.debug != null) return;
+        var debug = DebugInfo{
+            .builder = llvm.DIBuilder.create(self.module),
+            .compile_unit = null,
+            .main_file = null,
+            .files = std.StringHashMap(llvm.MetadataRef).init(self.allocator),
+        };
+        errdefer {
+            debug.files.deinit();
+            debug.builder.dispose();
+        }
+        debug.main_file = createDebugFile(debug.builder, source_file);
+        try debug.files.put(source_file, debug.main_file);
+        debug.compile_unit = debug.builder.createCompileUnit(debug.main_file, "pawc", self.opt_level != .O0);
+        self.module.addDebugInfoVersionFlag();
+        self.debug = debug;
+    }
+
+    /// 🆕 v0.2.0: 定义的函数带上 "frame-pointer"="all"，perf 不依赖 DWARF 也能展开调用栈
+    pub fn setFramePointers(self: *LLVMNativeBackend, enabled: bool) void {
+        self.frame_pointers = enabled;
+    }
+
+    /// 🆕 v0.2.0: 插桩构建或使用剖析数据优化（见 pgo.zig）
+    /// use 模式下 optimize() 只做验证，目标代码由 clang 从 emitBitcode() 的输出生成
+    pub fn setPgo(self: *LLVMNativeBackend, mode: pgo.Mode) void {
+        self.pgo = mode;
+    }
+
+    fn createDebugFile(builder: llvm.DIBuilder, path: []const u8) llvm.MetadataRef {
+        return builder.createFile(std.fs.path.basename(path), std.fs.path.dirname(path) orelse ".");
+    }
+
+    /// 函数声明所在文件的 DIFile（未知位置时归入主文件）
+    fn debugFile(self: *LLVMNativeBackend, path: []const u8) !llvm.MetadataRef {
+        const debug = &self.debug.?;
+        if (path.len == 0) return debug.main_file;
+        const entry = try debug.files.getOrPut(path);
+        if (!entry.found_existing) entry.value_ptr.* = createDebugFile(debug.builder, path);
+        return entry.value_ptr.*;
+    }
+
+    /// 🆕 v0.2.0: 交出模块的所有权（例如加入 JIT），deinit 时不再释放它
+    pub fn releaseModule(self: *LLVMNativeBackend) llvm.Module {
+        self.owns_module = false;
+        return self.module;
+    }
+
     // ============================================================================
     // 辅助函数
     // ============================================================================
-    
+
     /// 创建 null-terminated 字符串的辅助函数
+    /// 🆕 v0.2.0: 写入可复用的名字缓冲区，结果在下一次调用前有效（LLVM 会自行复制名字）
     fn createCString(self: *LLVMNativeBackend, str: []const u8) ![:0]const u8 {
-        return try self.allocator.dupeZ(u8, str);
+        self.name_buffer.clearRetainingCapacity();
+        try self.name_buffer.ensureTotalCapacity(self.allocator, str.len + 1);
+        self.name_buffer.appendSliceAssumeCapacity(str);
+        self.name_buffer.appendAssumeCapacity(0);
+        return self.name_buffer.items[0..str.len :0];
     }
-    
-    /// 创建函数类型的辅助函数
-    fn createFunctionType(self: *LLVMNativeBackend, param_count: usize) llvm.TypeRef {
-        const i32_type = self.context.i32Type();
-        var param_types = std.ArrayList(llvm.TypeRef){};
-        defer param_types.deinit(self.allocator);
-        
-        var i: usize = 0;
-        while (i < param_count) : (i += 1) {
-            param_types.append(self.allocator, i32_type) catch unreachable;
-        }
-        
-        return llvm.functionType(i32_type, param_types.items, false);
+
+    /// 🆕 v0.2.0: 指令 / 局部值的名字；丢弃名字时不做任何复制
+    fn valueName(self: *LLVMNativeBackend, str: []const u8) ![:0]const u8 {
+        if (self.discard_value_names) return "";
+        return self.createCString(str);
     }
-    
+
+    fn arenaAllocator(self: *LLVMNativeBackend) std.mem.Allocator {
+        return self.arena.allocator();
+    }
+
     /// 保存和恢复循环上下文
     const LoopContext = struct {
         exit: ?llvm.BasicBlockRef,
         continue_block: ?llvm.BasicBlockRef,
     };
-    
+
     fn saveLoopContext(self: *LLVMNativeBackend) LoopContext {
         return LoopContext{
             .exit = self.current_loop_exit,
             .continue_block = self.current_loop_continue,
         };
     }
-    
+
     fn restoreLoopContext(self: *LLVMNativeBackend, ctx: LoopContext) void {
         self.current_loop_exit = ctx.exit;
         self.current_loop_continue = ctx.continue_block;
     }
-    
+
+    /// 🆕 v0.2.0: 当前基本块是否已经有终结指令（return / break 之后的语句不再生成）
+    fn blockTerminated(self: *LLVMNativeBackend) bool {
+        return llvm.Builder.blockHasTerminator(self.builder.getInsertBlock());
+    }
+
+    /// 🆕 v0.2.0: 当前块尚未终结时跳转到 dest
+    fn branchIfOpen(self: *LLVMNativeBackend, dest: llvm.BasicBlockRef) void {
+        if (!self.blockTerminated()) _ = self.builder.buildBr(dest);
+    }
+
+    /// 🆕 v0.2.0: 在当前函数入口块的开头分配栈槽
+    /// 循环体中的 let / 临时值不会让栈不断增长，且 -O1 以上 mem2reg 可以把它们提升到寄存器
+    fn entryAlloca(self: *LLVMNativeBackend, ty: llvm.TypeRef, name: [:0]const u8) LowerError!llvm.ValueRef {
+        const func = self.current_function orelse return error.NoCurrentFunction;
+        const entry = llvm.LLVMGetEntryBasicBlock(func);
+        const first = llvm.LLVMGetFirstInstruction(entry);
+        if (first != null) {
+            self.alloca_builder.positionBefore(first);
+        } else {
+            self.alloca_builder.positionAtEnd(entry);
+        }
+        return self.alloca_builder.buildAlloca(ty, name);
+    }
+
+    /// 🆕 v0.2.0: 把值存入临时栈槽并返回其地址（按指针传 self、数组退化为指针）
+    fn spill(self: *LLVMNativeBackend, value: llvm.ValueRef) LowerError!llvm.ValueRef {
+        const slot = try self.entryAlloca(llvm.LLVMTypeOf(value), "tmp");
+        _ = self.builder.buildStore(value, slot);
+        return slot;
+    }
+
+    /// 🆕 v0.2.0: 声明一个带栈槽的局部变量
+    fn declareLocal(self: *LLVMNativeBackend, name: []const u8, paw_type: ast.Type, init_value: ?llvm.ValueRef) LowerError!Variable {
+        const ty = try self.toLLVMType(paw_type);
+        const slot = try self.entryAlloca(ty, try self.valueName(name));
+        const value = if (init_value) |v| try self.coerce(v, ty, isUnsignedType(paw_type)) else llvm.constNull(self.context, ty);
+        _ = self.builder.buildStore(value, slot);
+        return Variable{ .ptr = slot, .llvm_type = ty, .paw_type = paw_type };
+    }
+
+    fn bindVariable(self: *LLVMNativeBackend, name: []const u8, variable: Variable) !SavedVariable {
+        const previous = self.variables.get(name);
+        try self.variables.put(name, variable);
+        return SavedVariable{ .name = name, .previous = previous };
+    }
+
+    fn restoreVariable(self: *LLVMNativeBackend, saved: SavedVariable) void {
+        if (saved.previous) |previous| {
+            if (self.variables.getPtr(saved.name)) |slot| slot.* = previous;
+        } else {
+            _ = self.variables.remove(saved.name);
+        }
+    }
+
+    /// 🆕 v0.2.0: 查找或声明外部 C 函数（printf、snprintf ...）
+    fn externFunction(self: *LLVMNativeBackend, name: [:0]const u8, return_type: llvm.TypeRef, params: []llvm.TypeRef, is_var_arg: bool) llvm.ValueRef {
+        const existing = self.module.getNamedFunction(name);
+        if (existing != null) return existing;
+        return self.module.addFunction(name, llvm.functionType(return_type, params, is_var_arg));
+    }
+
+    fn zeroValue(self: *LLVMNativeBackend) llvm.ValueRef {
+        return llvm.constI32(self.context, 0);
+    }
+
     // ============================================================================
     // 代码生成主函数
     // ============================================================================
-    
+
+    /// 生成文本 IR（--backend=llvm 不带 --compile 时使用）
     pub fn generate(self: *LLVMNativeBackend, program: ast.Program) ![]const u8 {
-        // Generate all declarations
-        for (program.declarations) |decl| {
-            try self.generateDecl(decl);
-        }
-        
-        // Verify module (disabled for now due to linking complexity)
-        // self.module.verify() catch |err| {
-        //     std.debug.print("❌ LLVM module verification failed\n", .{});
-        //     return err;
-        // };
-        
+        try self.lower(program);
+
         // Get IR string
         const ir = self.module.toString();
-        
+
         // Copy to owned slice (caller must free with LLVMDisposeMessage)
         return try self.allocator.dupe(u8, ir);
     }
-    
+
+    /// 🆕 v0.2.0: 把程序降低到内存中的 LLVM 模块，并完成验证和优化
+    pub fn lower(self: *LLVMNativeBackend, program: ast.Program) !void {
+        // 先登记所有类型并声明所有函数原型：函数体中可以调用定义在后面的函数
+        try self.collectTypes(program.declarations);
+        try self.declarePrototypes(program.declarations);
+
+        // Generate all declarations
+        for (program.declarations) |decl| {
+            try self.generateDecl(decl);
+        }
+
+        // 生成函数体中用到的泛型实例（实例的函数体可能又引入新的实例）
+        try self.generatePendingInstances();
+
+        // 调试信息必须在验证之前完成
+        if (self.debug) |debug| debug.builder.finalize();
+
+        // 🆕 v0.2.0: 插桩程序把 .profraw 写到 --pgo-generate 指定的目录（profile 运行时读取该变量）
+        if (self.pgo == .generate) {
+            const pattern = try pgo.rawProfilePattern(self.arenaAllocator(), self.pgo.generate);
+            _ = self.module.addStringConstant("__llvm_profile_filename", pattern, .WeakAny);
+        }
+
+        // 验证模块并运行优化管道
+        try self.optimize();
+    }
+
+    /// 🆕 v0.2.0: 直接从内存中的模块生成目标文件（无需 .ll 文本往返）
+    /// 必须在 lower() 之后调用
+    pub fn emitObject(self: *LLVMNativeBackend, path: []const u8) !void {
+        const zone = prof.zone(self.profiler, "phase", "emit-object");
+        defer zone.end();
+
+        const tm = self.target_machine orelse {
+            std.debug.print("❌ Error: no LLVM target available for this host\n", .{});
+            return error.TargetNotFound;
+        };
+
+        const path_z = try self.allocator.dupeZ(u8, path);
+        defer self.allocator.free(path_z);
+
+        try tm.emitToFile(self.module, path_z, .Object);
+    }
+
+    /// 🆕 v0.2.0: --pgo-use：写出未优化的 bitcode，由 clang 读取剖析数据后优化并链接
+    /// 必须在 lower() 之后调用
+    pub fn emitBitcode(self: *LLVMNativeBackend, path: []const u8) !void {
+        const zone = prof.zone(self.profiler, "phase", "emit-bitcode");
+        defer zone.end();
+
+        const path_z = try self.allocator.dupeZ(u8, path);
+        defer self.allocator.free(path_z);
+
+        try self.module.writeBitcode(path_z);
+    }
+
+    /// 🆕 v0.2.0: 登记类型声明、枚举变体和泛型函数
+    fn collectTypes(self: *LLVMNativeBackend, declarations: []const ast.TopLevelDecl) !void {
+        for (declarations) |decl| {
+            switch (decl) {
+                .function => |func| {
+                    if (func.type_params.len > 0) try self.generic_functions.put(func.name, func);
+                },
+                .type_decl => |type_decl| try self.registerType(type_decl),
+                .struct_decl => |sd| try self.registerType(ast.TypeDecl{
+                    .name = sd.name,
+                    .type_params = sd.type_params,
+                    .kind = .{ .struct_type = .{ .fields = sd.fields, .methods = sd.methods } },
+                    .is_public = sd.is_public,
+                }),
+                .enum_decl => |ed| try self.registerType(ast.TypeDecl{
+                    .name = ed.name,
+                    .type_params = ed.type_params,
+                    .kind = .{ .enum_type = .{ .variants = ed.variants, .methods = ed.methods } },
+                    .is_public = ed.is_public,
+                }),
+                else => {},
+            }
+        }
+    }
+
+    fn registerType(self: *LLVMNativeBackend, type_decl: ast.TypeDecl) !void {
+        try self.type_decls.put(type_decl.name, type_decl);
+        if (type_decl.kind == .enum_type) {
+            for (type_decl.kind.enum_type.variants) |variant| {
+                try self.enum_variants.put(variant.name, type_decl.name);
+            }
+        }
+    }
+
+    /// 🆕 v0.2.0: 声明所有非泛型函数和非泛型类型的方法
+    fn declarePrototypes(self: *LLVMNativeBackend, declarations: []const ast.TopLevelDecl) !void {
+        for (declarations) |decl| {
+            switch (decl) {
+                .function => |func| {
+                    if (func.type_params.len == 0) _ = try self.declareFunction(func.name, func, .{});
+                },
+                .type_decl => |type_decl| try self.declareMethods(type_decl),
+                .struct_decl => |sd| if (self.type_decls.get(sd.name)) |td| try self.declareMethods(td),
+                .enum_decl => |ed| if (self.type_decls.get(ed.name)) |td| try self.declareMethods(td),
+                else => {},
+            }
+        }
+    }
+
+    fn declareMethods(self: *LLVMNativeBackend, type_decl: ast.TypeDecl) !void {
+        if (type_decl.type_params.len > 0) return;  // 泛型类型的方法在实例化时声明
+        const ctx = TypeContext{ .self_type = ast.Type{ .named = type_decl.name } };
+        for (typeMethods(type_decl)) |method| {
+            if (method.type_params.len > 0) continue;
+            _ = try self.declareFunction(try self.mangleMethod(type_decl.name, method.name), method, ctx);
+        }
+    }
+
     fn generateDecl(self: *LLVMNativeBackend, decl: ast.TopLevelDecl) !void {
         switch (decl) {
-            .function => |func| try self.generateFunction(func),
+            .function => |func| {
+                // 泛型函数在调用处单态化；外部函数（运行时库）只有声明
+                if (func.type_params.len == 0 and !func.is_extern) try self.defineFunction(func.name, func, .{});
+            },
+            .type_decl => |type_decl| try self.defineMethods(type_decl),
+            .struct_decl => |sd| if (self.type_decls.get(sd.name)) |td| try self.defineMethods(td),
+            .enum_decl => |ed| if (self.type_decls.get(ed.name)) |td| try self.defineMethods(td),
             else => {
-                // TODO: Handle other declaration types
+                // trait / impl / import 不产生代码
             },
         }
     }
-    
-    fn generateFunction(self: *LLVMNativeBackend, func: ast.FunctionDecl) !void {
-        // Get return type
-        const return_type = try self.toLLVMType(func.return_type);
-        
+
+    fn defineMethods(self: *LLVMNativeBackend, type_decl: ast.TypeDecl) !void {
+        if (type_decl.type_params.len > 0) return;
+        const ctx = TypeContext{ .self_type = ast.Type{ .named = type_decl.name } };
+        for (typeMethods(type_decl)) |method| {
+            if (method.type_params.len > 0 or method.is_extern) continue;
+            try self.defineFunction(try self.mangleMethod(type_decl.name, method.name), method, ctx);
+        }
+    }
+
+    fn generatePendingInstances(self: *LLVMNativeBackend) !void {
+        var index: usize = 0;
+        while (index < self.pending_instances.items.len) : (index += 1) {
+            const instance = self.pending_instances.items[index];
+            try self.defineFunction(instance.name, instance.func, instance.type_ctx);
+        }
+    }
+
+    /// 🆕 v0.2.0: 只声明 declarations 中的函数（外部链接，无函数体）
+    /// 用于 JIT 会话：函数已在之前加入 JIT 的模块中定义，新模块只需引用它们
+    pub fn declareExternal(self: *LLVMNativeBackend, declarations: []const ast.TopLevelDecl) !void {
+        try self.collectTypes(declarations);
+        try self.declarePrototypes(declarations);
+    }
+
+    /// 在模块中添加函数声明并登记到函数表（已声明过则直接返回）
+    /// 🆕 v0.2.0: 参数和返回值按 ctx 替换后的具体类型降低；方法的 self 按指针传递
+    fn declareFunction(self: *LLVMNativeBackend, name: []const u8, func: ast.FunctionDecl, ctx: TypeContext) LowerError!llvm.ValueRef {
+        if (self.functions.get(name)) |existing| return existing;
+
+        const saved_ctx = self.type_ctx;
+        self.type_ctx = ctx;
+        defer self.type_ctx = saved_ctx;
+
+        const has_self = ctx.self_type != null and isReceiver(func);
+        const params = try self.arenaAllocator().alloc(ast.Type, func.params.len);
+
         // Get parameter types
         var param_types = std.ArrayList(llvm.TypeRef){};
         defer param_types.deinit(self.allocator);
-        
-        for (func.params) |param| {
-            const param_type = try self.toLLVMType(param.type);
-            try param_types.append(self.allocator, param_type);
+
+        for (func.params, 0..) |param, i| {
+            if (i == 0 and has_self) {
+                params[i] = ctx.self_type.?;
+                try param_types.append(self.allocator, self.types.ptr);
+            } else {
+                params[i] = try self.resolveType(param.type);
+                try param_types.append(self.allocator, try self.toLLVMType(params[i]));
+            }
         }
-        
+
+        // Get return type
+        const return_type = try self.resolveType(func.return_type);
+
         // Create function type
-        const func_type = llvm.functionType(return_type, param_types.items, false);
-        
+        const func_type = llvm.functionType(try self.toLLVMType(return_type), param_types.items, false);
+
         // Create null-terminated function name
-        const func_name_z = try self.allocator.dupeZ(u8, func.name);
-        defer self.allocator.free(func_name_z);
-        
+        const func_name_z = try self.createCString(name);
+
         // Add function to module
         const llvm_func = self.module.addFunction(func_name_z, func_type);
-        try self.functions.put(func.name, llvm_func);
-        
+        try self.functions.put(name, llvm_func);
+        try self.signatures.put(name, Signature{
+            .params = params,
+            .return_type = return_type,
+            .has_self = has_self,
+            .is_extern = func.is_extern,
+        });
+        return llvm_func;
+    }
+
+    /// 🆕 v0.2.0: 生成函数体（普通函数、方法、泛型实例共用）
+    fn defineFunction(self: *LLVMNativeBackend, name: []const u8, func: ast.FunctionDecl, ctx: TypeContext) !void {
+        const zone = prof.zone(self.profiler, "codegen", name);
+        defer zone.end();
+
+        const llvm_func = try self.declareFunction(name, func, ctx);
+        const signature = self.signatures.get(name).?;
+
+        const saved_ctx = self.type_ctx;
+        self.type_ctx = ctx;
+        defer self.type_ctx = saved_ctx;
+
         // Set current function context
         self.current_function = llvm_func;
-        
+        self.current_return_type = if (signature.return_type == .void) null else try self.toLLVMType(signature.return_type);
+
+        // 🆕 v0.2.0: 帧指针和调试位置
+        if (self.frame_pointers) llvm.addFunctionAttribute(self.context, llvm_func, "frame-pointer", "all");
+        if (self.debug) |debug| {
+            const file = try self.debugFile(func.source_file);
+            const line: u32 = @intCast(func.line);
+            const subprogram = debug.builder.createFunction(file, name, line, self.opt_level != .O0);
+            llvm.LLVMSetSubprogram(llvm_func, subprogram);
+            const location = llvm.debugLocation(self.context, line, 0, subprogram);
+            self.builder.setDebugLocation(location);
+            self.alloca_builder.setDebugLocation(location);
+        }
+
         // Create entry basic block
         const entry_block = llvm.appendBasicBlock(self.context, llvm_func, "entry");
         self.builder.positionAtEnd(entry_block);
-        
+
         // Store parameters in variables map
         self.variables.clearRetainingCapacity();
-        self.variable_types.clearRetainingCapacity();
         for (func.params, 0..) |param, i| {
             const param_value = llvm.LLVMGetParam(llvm_func, @intCast(i));
-            const param_type = try self.toLLVMType(param.type);
-            
-            // Allocate space for parameter and store it
-            const alloca_name_z = try self.allocator.dupeZ(u8, param.name);
-            defer self.allocator.free(alloca_name_z);
-            const alloca = self.builder.buildAlloca(param_type, alloca_name_z);
-            _ = self.builder.buildStore(param_value, alloca);
-            
-            try self.variables.put(param.name, alloca);
-            try self.variable_types.put(param.name, param_type);
+            const param_type = signature.params[i];
+
+            if (i == 0 and signature.has_self) {
+                // self 本身就是指向对象的指针，直接作为变量地址
+                try self.variables.put(param.name, Variable{
+                    .ptr = param_value,
+                    .llvm_type = try self.toLLVMType(param_type),
+                    .paw_type = param_type,
+                });
+            } else {
+                // Allocate space for parameter and store it
+                try self.variables.put(param.name, try self.declareLocal(param.name, param_type, param_value));
+            }
         }
-        
+
         // Generate function body
         // 🆕 v0.1.6: 特殊处理最后一个表达式语句 - 应该生成 return
         for (func.body, 0..) |stmt, i| {
+            if (self.blockTerminated()) break;
+
             const is_last = (i == func.body.len - 1);
-            const is_non_void = func.return_type != .void;
-            
+
             // 如果是最后一个语句，且是表达式语句，且函数返回非void，生成return
-            if (is_last and stmt == .expr and is_non_void) {
+            if (is_last and stmt == .expr and self.current_return_type != null) {
                 const ret_value = try self.generateExpr(stmt.expr);
-                _ = self.builder.buildRet(ret_value);
+                if (!self.blockTerminated()) {
+                    _ = self.builder.buildRet(try self.coerceExpr(ret_value, stmt.expr, self.current_return_type.?));
+                }
             } else {
                 try self.generateStmt(stmt);
             }
         }
-        
+
+        // 🆕 v0.2.0: 保证最后一个基本块有终结指令（否则模块无法通过验证）
+        if (!self.blockTerminated()) {
+            if (self.current_return_type) |return_type| {
+                _ = self.builder.buildRet(llvm.constNull(self.context, return_type));
+            } else {
+                _ = self.builder.buildRetVoid();
+            }
+        }
+
         // Clear function context
+        if (self.debug != null) {
+            self.builder.setDebugLocation(null);
+            self.alloca_builder.setDebugLocation(null);
+        }
         self.current_function = null;
+        self.current_return_type = null;
     }
-    
-    fn generateStmt(self: *LLVMNativeBackend, stmt: ast.Stmt) (error{NoCurrentFunction} || std.mem.Allocator.Error)!void {
+
+    // ============================================================================
+    // Statement Generation
+    // ============================================================================
+
+    /// 🆕 v0.2.0: 依次生成语句；块终结（return / break / continue）后停止
+    fn generateStmts(self: *LLVMNativeBackend, stmts: []const ast.Stmt) LowerError!void {
+        for (stmts) |stmt| {
+            if (self.blockTerminated()) return;
+            try self.generateStmt(stmt);
+        }
+    }
+
+    fn generateStmt(self: *LLVMNativeBackend, stmt: ast.Stmt) LowerError!void {
         switch (stmt) {
             .return_stmt => |maybe_val| {
                 if (maybe_val) |val| {
                     const ret_value = try self.generateExpr(val);
-                    _ = self.builder.buildRet(ret_value);
+                    if (self.current_return_type) |return_type| {
+                        _ = self.builder.buildRet(try self.coerceExpr(ret_value, val, return_type));
+                    } else {
+                        _ = self.builder.buildRetVoid();
+                    }
+                } else if (self.current_return_type) |return_type| {
+                    _ = self.builder.buildRet(llvm.constNull(self.context, return_type));
                 } else {
                     _ = self.builder.buildRetVoid();
                 }
             },
             .let_decl => |let_stmt| {
-                if (let_stmt.init) |init_expr| {
-                    var init_value = try self.generateExpr(init_expr);
-                    
-                    // Determine variable type
-                    const var_type = if (let_stmt.type) |typ|
-                        try self.toLLVMType(typ)
-                    else
-                        llvm.LLVMTypeOf(init_value);
-                    
-                    // 🆕 v0.2.0: 如果初始值类型与变量类型不匹配，进行转换
-                    const init_type = llvm.LLVMTypeOf(init_value);
-                    if (init_type != var_type) {
-                        // 需要类型转换
-                        const cast_name_z = try self.allocator.dupeZ(u8, "auto_cast");
-                        defer self.allocator.free(cast_name_z);
-                        
-                        // 简化：假设 i8 -> i32 的扩展（最常见情况）
-                        init_value = self.builder.buildZExt(init_value, var_type, cast_name_z);
-                    }
-                    
-                    // Allocate space for variable
-                    const alloca_name_z = try self.allocator.dupeZ(u8, let_stmt.name);
-                    defer self.allocator.free(alloca_name_z);
-                    const alloca = self.builder.buildAlloca(var_type, alloca_name_z);
-                    
-                    // Store initial value (已转换到正确类型)
-                    _ = self.builder.buildStore(init_value, alloca);
-                    
-                    // Store pointer in variables map
-                    try self.variables.put(let_stmt.name, alloca);
-                    try self.variable_types.put(let_stmt.name, var_type);
-                }
+                // 🆕 v0.2.0: 变量类型 = 声明的类型，否则为初始值推导出的类型
+                const var_type = if (let_stmt.type) |typ|
+                    try self.resolveType(typ)
+                else if (let_stmt.init) |init_expr|
+                    try self.inferExprType(init_expr)
+                else
+                    ast.Type.i32;
+
+                const init_value: ?llvm.ValueRef = if (let_stmt.init) |init_expr| blk: {
+                    const value = try self.generateExpr(init_expr);
+                    break :blk try self.coerceExpr(value, init_expr, try self.toLLVMType(var_type));
+                } else null;
+
+                try self.variables.put(let_stmt.name, try self.declareLocal(let_stmt.name, var_type, init_value));
             },
             .assign => |assign_stmt| {
-                // Handle assignment to existing variable
-                if (assign_stmt.target == .identifier) {
-                    const var_name = assign_stmt.target.identifier;
-                    if (self.variables.get(var_name)) |var_ptr| {
-                        const new_value = try self.generateExpr(assign_stmt.value);
-                        _ = self.builder.buildStore(new_value, var_ptr);
-                    } else {
-                        std.debug.print("⚠️  Undefined variable in assignment: {s}\n", .{var_name});
-                    }
+                // 🆕 v0.2.0: 支持变量、字段（p.x = ...）和数组元素（a[i] = ...）
+                if (try self.addressOf(assign_stmt.target)) |place| {
+                    const new_value = try self.generateExpr(assign_stmt.value);
+                    _ = self.builder.buildStore(try self.coerceExpr(new_value, assign_stmt.value, place.llvm_type), place.ptr);
                 } else {
-                    std.debug.print("⚠️  Complex assignment target not yet supported\n", .{});
+                    std.debug.print("⚠️  Unsupported assignment target in LLVM backend\n", .{});
                 }
             },
             .compound_assign => |compound_stmt| {
                 // Handle compound assignment (+=, -=, etc.)
-                if (compound_stmt.target == .identifier) {
-                    const var_name = compound_stmt.target.identifier;
-                    if (self.variables.get(var_name)) |var_ptr| {
-                        if (self.variable_types.get(var_name)) |var_type| {
-                            // Load current value
-                            const load_name_z = try self.allocator.dupeZ(u8, var_name);
-                            defer self.allocator.free(load_name_z);
-                            const current_value = self.builder.buildLoad(var_type, var_ptr, load_name_z);
-                            
-                            // Generate right-hand side value
-                            const rhs_value = try self.generateExpr(compound_stmt.value);
-                            
-                            // Perform operation
-                            const op_name_z = try self.allocator.dupeZ(u8, "compound_op");
-                            defer self.allocator.free(op_name_z);
-                            
-                            const result = switch (compound_stmt.op) {
-                                .add_assign => self.builder.buildAdd(current_value, rhs_value, op_name_z),
-                                .sub_assign => self.builder.buildSub(current_value, rhs_value, op_name_z),
-                                .mul_assign => self.builder.buildMul(current_value, rhs_value, op_name_z),
-                                .div_assign => self.builder.buildSDiv(current_value, rhs_value, op_name_z),
-                                else => current_value,
-                            };
-                            
-                            // Store result back
-                            _ = self.builder.buildStore(result, var_ptr);
-                        }
-                    } else {
-                        std.debug.print("⚠️  Undefined variable in compound assignment: {s}\n", .{var_name});
-                    }
+                if (try self.addressOf(compound_stmt.target)) |place| {
+                    // Load current value
+                    const current_value = self.builder.buildLoad(place.llvm_type, place.ptr, "compound_cur");
+
+                    // Generate right-hand side value
+                    const rhs_value = try self.generateExpr(compound_stmt.value);
+
+                    const op: ast.BinaryOp = switch (compound_stmt.op) {
+                        .add_assign => .add,
+                        .sub_assign => .sub,
+                        .mul_assign => .mul,
+                        .div_assign => .div,
+                        .mod_assign => .mod,
+                    };
+                    const result = try self.buildBinary(op, current_value, rhs_value, place.paw_type);
+
+                    // Store result back
+                    _ = self.builder.buildStore(try self.coerce(result, place.llvm_type, isUnsignedType(place.paw_type)), place.ptr);
                 } else {
-                    std.debug.print("⚠️  Complex compound assignment target not yet supported\n", .{});
+                    std.debug.print("⚠️  Unsupported compound assignment target in LLVM backend\n", .{});
                 }
             },
             .expr => |expr| {
@@ -346,625 +847,1561 @@ pub const LLVMNativeBackend = struct {
             },
         }
     }
-    
+
     /// 生成 while 风格的条件循环
     /// 生成: while.cond -> while.body -> while.cond (循环) | while.exit
-    fn generateWhileLoop(self: *LLVMNativeBackend, loop: struct { condition: ast.Expr, body: []ast.Stmt }) !void {
+    fn generateWhileLoop(self: *LLVMNativeBackend, loop: struct { condition: ast.Expr, body: []ast.Stmt }) LowerError!void {
         const func = self.current_function orelse return error.NoCurrentFunction;
-        
+
         // 创建基本块
         const cond_block = llvm.appendBasicBlock(self.context, func, "while.cond");
         const body_block = llvm.appendBasicBlock(self.context, func, "while.body");
         const exit_block = llvm.appendBasicBlock(self.context, func, "while.exit");
-        
+
         // 保存并设置循环上下文
         const saved_ctx = self.saveLoopContext();
         defer self.restoreLoopContext(saved_ctx);
-        
+
         self.current_loop_exit = exit_block;
         self.current_loop_continue = cond_block;
-        
+
         // 跳转到条件块
         _ = self.builder.buildBr(cond_block);
-        
+
         // 生成条件块
         self.builder.positionAtEnd(cond_block);
-        const cond_value = try self.generateExpr(loop.condition);
-        _ = llvm.LLVMBuildCondBr(self.builder.ref, cond_value, body_block, exit_block);
-        
+        const cond_value = try self.toCondition(try self.generateExpr(loop.condition));
+        _ = self.builder.buildCondBr(cond_value, body_block, exit_block);
+
         // 生成循环体
         self.builder.positionAtEnd(body_block);
-        for (loop.body) |stmt| {
-            try self.generateStmt(stmt);
-        }
-        _ = self.builder.buildBr(cond_block);
-        
+        try self.generateStmts(loop.body);
+        self.branchIfOpen(cond_block);
+
         // 继续从退出块执行
         self.builder.positionAtEnd(exit_block);
     }
-    
-    /// 生成 loop 迭代器（范围迭代）
+
+    /// 生成 loop 迭代器（范围迭代 / 🆕 v0.2.0: 定长数组迭代）
     /// 生成: loop.cond -> loop.body -> loop.incr -> loop.cond (循环) | loop.exit
-    fn generateLoopIterator(self: *LLVMNativeBackend, iter: ast.LoopIterator, body: []ast.Stmt) !void {
+    fn generateLoopIterator(self: *LLVMNativeBackend, iter: ast.LoopIterator, body: []ast.Stmt) LowerError!void {
         const func = self.current_function orelse return error.NoCurrentFunction;
-        
-        // 只支持范围表达式
+
+        // 🆕 v0.2.0: loop item in array：对定长数组按下标迭代
+        var array_place: ?Place = null;
         if (iter.iterable != .range) {
-            std.debug.print("⚠️  Only range iterators are supported in LLVM backend\n", .{});
-            return;
+            array_place = try self.addressOf(iter.iterable);
+            const is_sized_array = if (array_place) |place| place.paw_type == .array and place.paw_type.array.size != null else false;
+            if (!is_sized_array) {
+                std.debug.print("⚠️  Only ranges and fixed-size arrays can be iterated in LLVM backend\n", .{});
+                return;
+            }
         }
-        
-        const range = iter.iterable.range;
-        const i32_type = self.context.i32Type();
-        
-        // 创建并初始化循环变量
-        const iter_name_z = try self.createCString(iter.binding);
-        defer self.allocator.free(iter_name_z);
-        
-        const iter_var = self.builder.buildAlloca(i32_type, iter_name_z);
-        const start_value = try self.generateExpr(range.start.*);
-        _ = self.builder.buildStore(start_value, iter_var);
-        
+
+        // 循环计数器：范围迭代时就是循环变量本身
+        const counter_type: ast.Type = if (array_place == null) blk: {
+            const t = try self.arithmeticType(
+                try self.inferExprType(iter.iterable.range.start.*),
+                try self.inferExprType(iter.iterable.range.end.*),
+            );
+            break :blk if (self.isIntType(t)) t else ast.Type.i32;
+        } else ast.Type.i32;
+        const counter_llvm_type = try self.toLLVMType(counter_type);
+
+        const start_value = if (array_place == null)
+            try self.generateExpr(iter.iterable.range.start.*)
+        else
+            llvm.constI32(self.context, 0);
+        const counter = try self.declareLocal(if (array_place == null) iter.binding else "loop.index", counter_type, start_value);
+
+        // 结束值
+        const end_value = if (array_place) |place|
+            llvm.LLVMConstInt(counter_llvm_type, place.paw_type.array.size.?, 0)
+        else
+            try self.coerce(try self.generateExpr(iter.iterable.range.end.*), counter_llvm_type, isUnsignedType(counter_type));
+
         // 注册循环变量（作用域内有效）
-        try self.variables.put(iter.binding, iter_var);
-        try self.variable_types.put(iter.binding, i32_type);
-        defer {
-            _ = self.variables.remove(iter.binding);
-            _ = self.variable_types.remove(iter.binding);
-        }
-        
-        // 生成结束值
-        const end_value = try self.generateExpr(range.end.*);
-        
+        const binding = if (array_place) |place|
+            try self.declareLocal(iter.binding, place.paw_type.array.element.*, null)
+        else
+            counter;
+        const saved_binding = try self.bindVariable(iter.binding, binding);
+        defer self.restoreVariable(saved_binding);
+
         // 创建基本块
         const cond_block = llvm.appendBasicBlock(self.context, func, "loop.cond");
         const body_block = llvm.appendBasicBlock(self.context, func, "loop.body");
         const incr_block = llvm.appendBasicBlock(self.context, func, "loop.incr");
         const exit_block = llvm.appendBasicBlock(self.context, func, "loop.exit");
-        
+
         // 保存并设置循环上下文
         const saved_ctx = self.saveLoopContext();
         defer self.restoreLoopContext(saved_ctx);
-        
+
         self.current_loop_exit = exit_block;
         self.current_loop_continue = incr_block;
-        
+
         // 跳转到条件块
         _ = self.builder.buildBr(cond_block);
-        
+
         // 生成条件块：检查 i < end 或 i <= end
         self.builder.positionAtEnd(cond_block);
-        const current_value = self.builder.buildLoad(i32_type, iter_var, iter_name_z);
-        const predicate = if (range.inclusive) llvm.IntPredicate.SLE else llvm.IntPredicate.SLT;
+        const current_value = self.builder.buildLoad(counter_llvm_type, counter.ptr, "loop.i");
+        const inclusive = array_place == null and iter.iterable.range.inclusive;
+        const unsigned = isUnsignedType(counter_type);
+        const predicate: llvm.IntPredicate = if (inclusive)
+            (if (unsigned) .ULE else .SLE)
+        else
+            (if (unsigned) .ULT else .SLT);
         const cond_value = self.builder.buildICmp(predicate, current_value, end_value, "loop_cond");
-        _ = llvm.LLVMBuildCondBr(self.builder.ref, cond_value, body_block, exit_block);
-        
+        _ = self.builder.buildCondBr(cond_value, body_block, exit_block);
+
         // 生成循环体
         self.builder.positionAtEnd(body_block);
-        for (body) |stmt| {
-            try self.generateStmt(stmt);
+        if (array_place) |place| {
+            // item = array[i]
+            var indices = [_]llvm.ValueRef{ llvm.constI32(self.context, 0), current_value };
+            const elem_ptr = self.builder.buildInBoundsGEP(place.llvm_type, place.ptr, &indices, "loop.elem");
+            _ = self.builder.buildStore(self.builder.buildLoad(binding.llvm_type, elem_ptr, "loop.item"), binding.ptr);
+        }
+        try self.generateStmts(body);
+        self.branchIfOpen(incr_block);
+
+        // 生成递增块：i = i + 1
+        self.builder.positionAtEnd(incr_block);
+        const current_value2 = self.builder.buildLoad(counter_llvm_type, counter.ptr, "loop.i");
+        const one = llvm.LLVMConstInt(counter_llvm_type, 1, 0);
+        const next_value = self.builder.buildAdd(current_value2, one, "loop_incr");
+        _ = self.builder.buildStore(next_value, counter.ptr);
+        _ = self.builder.buildBr(cond_block);
+
+        // 继续从退出块执行
+        self.builder.positionAtEnd(exit_block);
+    }
+
+    /// 生成无限循环
+    /// 生成: loop.body -> loop.body (无限循环，只能通过 break 退出)
+    fn generateInfiniteLoop(self: *LLVMNativeBackend, body: []ast.Stmt) LowerError!void {
+        const func = self.current_function orelse return error.NoCurrentFunction;
+
+        // 创建基本块
+        const body_block = llvm.appendBasicBlock(self.context, func, "loop.body");
+        const exit_block = llvm.appendBasicBlock(self.context, func, "loop.exit");
+
+        // 保存并设置循环上下文
+        const saved_ctx = self.saveLoopContext();
+        defer self.restoreLoopContext(saved_ctx);
+
+        self.current_loop_exit = exit_block;
+        self.current_loop_continue = body_block;
+
+        // 跳转到循环体
+        _ = self.builder.buildBr(body_block);
+
+        // 生成循环体（无限循环回自己）
+        self.builder.positionAtEnd(body_block);
+        try self.generateStmts(body);
+        self.branchIfOpen(body_block);
+
+        // 退出块（只能通过 break 到达）
+        self.builder.positionAtEnd(exit_block);
+    }
+
+    // ============================================================================
+    // Expression Generation
+    // ============================================================================
+
+    fn generateExpr(self: *LLVMNativeBackend, expr: ast.Expr) LowerError!llvm.ValueRef {
+        return switch (expr) {
+            .int_literal => |val| blk: {
+                // 🆕 v0.2.0: 超出 i32 范围的字面量按 i64 生成（有目标类型时 coerceExpr 会按目标类型重建）
+                const int_type = if (literalFitsI32(val)) self.types.i32 else self.types.i64;
+                break :blk llvm.LLVMConstInt(int_type, @bitCast(val), 1);
+            },
+            .float_literal => |val| blk: {
+                break :blk llvm.constDouble(self.context, val);
+            },
+            .bool_literal => |val| blk: {
+                const i1_type = self.types.i1;
+                break :blk llvm.LLVMConstInt(i1_type, if (val) 1 else 0, 0);
+            },
+            .char_literal => |val| blk: {
+                const i8_type = self.types.i8;
+                break :blk llvm.LLVMConstInt(i8_type, val & 0xff, 0);
+            },
+            .string_literal => |str| blk: {
+                // Create null-terminated string
+                const str_z = try self.createCString(str);
+
+                // Build global string pointer
+                break :blk self.builder.buildGlobalStringPtr(str_z, "str");
+            },
+            .identifier => |name| blk: {
+                if (self.variables.get(name)) |variable| {
+                    // Load value from pointer
+                    break :blk self.builder.buildLoad(variable.llvm_type, variable.ptr, try self.valueName(name));
+                }
+                // 🆕 v0.2.0: 不带数据的枚举变体可以直接按名字引用
+                if (self.enum_variants.contains(name)) {
+                    break :blk try self.constructVariant(try self.variantEnumType(name, &.{}), name, &.{});
+                }
+                if (self.functions.get(name)) |func| break :blk func;
+
+                std.debug.print("⚠️  Undefined variable: {s}\n", .{name});
+                break :blk self.zeroValue();
+            },
+            .binary => |binop| blk: {
+                const lhs = try self.generateExpr(binop.left.*);
+                const rhs = try self.generateExpr(binop.right.*);
+
+                // 🆕 v0.2.0: 按操作数类型选择整数（有/无符号）或浮点指令
+                const operand_type = try self.arithmeticType(
+                    try self.inferExprType(binop.left.*),
+                    try self.inferExprType(binop.right.*),
+                );
+                break :blk try self.buildBinary(binop.op, lhs, rhs, operand_type);
+            },
+            .unary => |unop| blk: {
+                const operand = try self.generateExpr(unop.operand.*);
+
+                const result = switch (unop.op) {
+                    .neg => if (isFloatKind(llvm.LLVMTypeOf(operand)))
+                        self.builder.buildFNeg(operand, "unop")
+                    else
+                        self.builder.buildNeg(operand, "unop"),
+                    .not => self.builder.buildNot(try self.toCondition(operand), "unop"),
+                };
+                break :blk result;
+            },
+            .if_expr => |if_expr| try self.generateIfExpr(if_expr.condition.*, if_expr.then_branch.*, if_expr.else_branch),
+            .block => |stmts| blk: {
+                // Execute all statements in the block
+                var last_value: ?llvm.ValueRef = null;
+                for (stmts) |stmt| {
+                    if (self.blockTerminated()) break;
+                    switch (stmt) {
+                        .expr => |block_expr| {
+                            // Save the last expression value as the block result
+                            last_value = try self.generateExpr(block_expr);
+                        },
+                        else => {
+                            try self.generateStmt(stmt);
+                        },
+                    }
+                }
+                // Return the last expression value, or 0 if none
+                break :blk last_value orelse self.zeroValue();
+            },
+            .array_index, .field_access => blk: {
+                // 🆕 v0.2.0: 可寻址时直接 GEP + load
+                if (try self.addressOf(expr)) |place| {
+                    break :blk self.builder.buildLoad(place.llvm_type, place.ptr, "elem");
+                }
+
+                // 不可寻址的结构体值（例如函数返回值）：extractvalue
+                if (expr == .field_access) {
+                    const field_expr = expr.field_access;
+                    const object_type = try self.inferExprType(field_expr.object.*);
+                    if (try self.structLayoutOf(object_type)) |layout| {
+                        if (fieldIndex(layout, field_expr.field)) |index| {
+                            const object = try self.generateExpr(field_expr.object.*);
+                            break :blk self.builder.buildExtractValue(object, index, "field");
+                        }
+                    }
+                    std.debug.print("⚠️  Unknown field in LLVM backend: {s}\n", .{field_expr.field});
+                } else {
+                    std.debug.print("⚠️  Unsupported index expression in LLVM backend\n", .{});
+                }
+                break :blk self.zeroValue();
+            },
+            .call => |call_expr| try self.generateCall(call_expr.callee.*, call_expr.args, call_expr.type_args),
+            .static_method_call => |smc| blk: {
+                // 🆕 v0.2.0: Enum::Variant(args) 构造枚举值
+                if (self.isEnumVariantOf(smc.type_name, smc.method_name)) {
+                    const enum_type = if (smc.type_args.len > 0)
+                        try self.instanceType(smc.type_name, smc.type_args)
+                    else
+                        try self.variantEnumType(smc.method_name, smc.args);
+                    break :blk try self.constructVariant(enum_type, smc.method_name, smc.args);
+                }
+
+                // 静态方法调用：Type<T>::method() -> Type_T_method
+                const receiver_type = try self.staticReceiverType(smc.type_name, smc.type_args, smc.method_name, smc.args);
+                const target = (try self.methodTarget(receiver_type, smc.method_name)) orelse {
+                    std.debug.print("⚠️  Undefined static method: {s}::{s}\n", .{ smc.type_name, smc.method_name });
+                    break :blk self.zeroValue();
+                };
+                break :blk try self.emitCall(target, null, smc.args);
+            },
+            .enum_variant => |ev| try self.constructVariant(try self.variantEnumType(ev.variant, ev.args), ev.variant, ev.args),
+            .array_literal => |elements| blk: {
+                // 🆕 v0.2.0: [a, b, c] -> [N x T] 聚合值
+                const array_type = try self.inferExprType(expr);
+                const llvm_array_type = try self.toLLVMType(array_type);
+                const element_type = try self.toLLVMType(array_type.array.element.*);
+
+                var aggregate = llvm.constNull(self.context, llvm_array_type);
+                for (elements, 0..) |element, i| {
+                    const value = try self.coerceExpr(try self.generateExpr(element), element, element_type);
+                    aggregate = self.builder.buildInsertValue(aggregate, value, @intCast(i), "array");
+                }
+                break :blk aggregate;
+            },
+            .struct_init => |si| blk: {
+                // 🆕 v0.2.0: Point { x: 1, y: 2 } -> 按声明顺序填充命名结构体
+                const struct_type = try self.structInitType(si.type_name, si.type_args, si.fields);
+                const layout = (try self.structLayoutOf(struct_type)) orelse {
+                    std.debug.print("⚠️  Unknown struct type in LLVM backend: {s}\n", .{si.type_name});
+                    break :blk self.zeroValue();
+                };
+
+                var aggregate = llvm.constNull(self.context, layout.llvm_type);
+                for (si.fields) |field| {
+                    const index = fieldIndex(layout, field.name) orelse continue;
+                    const field_type = try self.toLLVMType(layout.field_types[index]);
+                    const value = try self.coerceExpr(try self.generateExpr(field.value), field.value, field_type);
+                    aggregate = self.builder.buildInsertValue(aggregate, value, index, "struct");
+                }
+                break :blk aggregate;
+            },
+            .is_expr => |is_match| try self.generateMatch(is_match.value.*, is_match.arms),
+            .match_expr => |match| try self.generateMatch(match.value.*, match.arms),
+            .string_interp => |si| try self.generateStringInterpolation(si.parts),
+            // 🆕 v0.1.7: as 类型转换
+            .as_expr => |as_cast| blk: {
+                const value = try self.generateExpr(as_cast.value.*);
+                const target_type = try self.resolveType(as_cast.target_type);
+                const target_llvm_type = try self.toLLVMType(target_type);
+
+                // 生成类型转换指令
+                break :blk try self.generateCast(value, as_cast.value, target_type, target_llvm_type);
+            },
+            else => self.zeroValue(),
+        };
+    }
+
+    /// 🆕 v0.2.0: 二元运算（操作数先统一到同一 LLVM 类型）
+    fn buildBinary(self: *LLVMNativeBackend, op: ast.BinaryOp, lhs_value: llvm.ValueRef, rhs_value: llvm.ValueRef, operand_type: ast.Type) LowerError!llvm.ValueRef {
+        if (op == .and_op or op == .or_op) {
+            const lhs = try self.toCondition(lhs_value);
+            const rhs = try self.toCondition(rhs_value);
+            return if (op == .and_op) self.builder.buildAnd(lhs, rhs, "binop") else self.builder.buildOr(lhs, rhs, "binop");
+        }
+
+        const unsigned = isUnsignedType(operand_type);
+        const operands = try self.unifyOperands(lhs_value, rhs_value, unsigned);
+        const lhs = operands[0];
+        const rhs = operands[1];
+
+        if (isFloatKind(llvm.LLVMTypeOf(lhs))) {
+            return switch (op) {
+                .add => self.builder.buildFAdd(lhs, rhs, "binop"),
+                .sub => self.builder.buildFSub(lhs, rhs, "binop"),
+                .mul => self.builder.buildFMul(lhs, rhs, "binop"),
+                .div => self.builder.buildFDiv(lhs, rhs, "binop"),
+                .mod => self.builder.buildFRem(lhs, rhs, "binop"),
+                .eq => self.builder.buildFCmp(.OEQ, lhs, rhs, "binop"),
+                .ne => self.builder.buildFCmp(.UNE, lhs, rhs, "binop"),
+                .lt => self.builder.buildFCmp(.OLT, lhs, rhs, "binop"),
+                .le => self.builder.buildFCmp(.OLE, lhs, rhs, "binop"),
+                .gt => self.builder.buildFCmp(.OGT, lhs, rhs, "binop"),
+                .ge => self.builder.buildFCmp(.OGE, lhs, rhs, "binop"),
+                .and_op, .or_op => unreachable,
+            };
+        }
+
+        return switch (op) {
+            .add => self.builder.buildAdd(lhs, rhs, "binop"),
+            .sub => self.builder.buildSub(lhs, rhs, "binop"),
+            .mul => self.builder.buildMul(lhs, rhs, "binop"),
+            .div => if (unsigned) self.builder.buildUDiv(lhs, rhs, "binop") else self.builder.buildSDiv(lhs, rhs, "binop"),
+            .mod => if (unsigned) self.builder.buildURem(lhs, rhs, "binop") else self.builder.buildSRem(lhs, rhs, "binop"),
+            // Comparison operators
+            .eq => self.builder.buildICmp(.EQ, lhs, rhs, "binop"),
+            .ne => self.builder.buildICmp(.NE, lhs, rhs, "binop"),
+            .lt => self.builder.buildICmp(if (unsigned) .ULT else .SLT, lhs, rhs, "binop"),
+            .le => self.builder.buildICmp(if (unsigned) .ULE else .SLE, lhs, rhs, "binop"),
+            .gt => self.builder.buildICmp(if (unsigned) .UGT else .SGT, lhs, rhs, "binop"),
+            .ge => self.builder.buildICmp(if (unsigned) .UGE else .SGE, lhs, rhs, "binop"),
+            .and_op, .or_op => unreachable,
+        };
+    }
+
+    /// if 表达式：两个分支的值通过 PHI 合并（else 分支的值转换为 then 分支的类型）
+    fn generateIfExpr(self: *LLVMNativeBackend, condition: ast.Expr, then_branch: ast.Expr, else_branch: ?*ast.Expr) LowerError!llvm.ValueRef {
+        const func = self.current_function orelse return error.NoCurrentFunction;
+
+        // Generate condition
+        const cond_value = try self.toCondition(try self.generateExpr(condition));
+
+        // Create basic blocks
+        const then_block = llvm.appendBasicBlock(self.context, func, "if.then");
+        const else_block = llvm.appendBasicBlock(self.context, func, "if.else");
+        const cont_block = llvm.appendBasicBlock(self.context, func, "if.cont");
+
+        // Build conditional branch
+        _ = self.builder.buildCondBr(cond_value, then_block, else_block);
+
+        // Generate then branch
+        self.builder.positionAtEnd(then_block);
+        const then_value = try self.generateExpr(then_branch);
+        const then_end_block = self.builder.getInsertBlock();
+        // 🆕 v0.2.0: 只有当块没有终止符时才添加跳转
+        const then_has_terminator = self.blockTerminated();
+
+        // 结果类型取 then 分支；then 分支没有值（终止或 void）时取 else 分支
+        var result_type: ?llvm.TypeRef = if (then_has_terminator) null else llvm.LLVMTypeOf(then_value);
+        if (result_type != null and llvm.typeKind(result_type.?) == .Void) result_type = null;
+        self.branchIfOpen(cont_block);
+
+        // Generate else branch
+        self.builder.positionAtEnd(else_block);
+        var else_value = if (else_branch) |else_br|
+            try self.generateExpr(else_br.*)
+        else if (result_type) |ty|
+            llvm.constNull(self.context, ty)
+        else
+            self.zeroValue();
+        const else_has_terminator = self.blockTerminated();
+        if (!else_has_terminator) {
+            if (result_type) |ty| {
+                else_value = try self.coerce(else_value, ty, false);
+            } else if (then_has_terminator and llvm.typeKind(llvm.LLVMTypeOf(else_value)) != .Void) {
+                result_type = llvm.LLVMTypeOf(else_value);
+            }
+        }
+        const else_end_block = self.builder.getInsertBlock();
+        self.branchIfOpen(cont_block);
+
+        // Continue block with PHI node
+        self.builder.positionAtEnd(cont_block);
+
+        // 🆕 v0.2.0: 只为实际到达的分支创建 PHI
+        // 如果两个分支都终止了，cont_block 不可达
+        if (then_has_terminator and else_has_terminator) {
+            _ = self.builder.buildUnreachable();
+            const dead_block = llvm.appendBasicBlock(self.context, func, "if.dead");
+            self.builder.positionAtEnd(dead_block);
+            return self.zeroValue();
+        }
+        const phi_type = result_type orelse return self.zeroValue();
+
+        // Create PHI node to merge values from both branches
+        const phi = self.builder.buildPhi(phi_type, "if.result");
+        if (!then_has_terminator) {
+            var incoming_values = [_]llvm.ValueRef{then_value};
+            var incoming_blocks = [_]llvm.BasicBlockRef{then_end_block};
+            llvm.LLVMAddIncoming(phi, &incoming_values, &incoming_blocks, 1);
+        }
+        if (!else_has_terminator) {
+            var incoming_values = [_]llvm.ValueRef{else_value};
+            var incoming_blocks = [_]llvm.BasicBlockRef{else_end_block};
+            llvm.LLVMAddIncoming(phi, &incoming_values, &incoming_blocks, 1);
+        }
+        return phi;
+    }
+
+    /// 🆕 v0.2.0: 函数调用 / 方法调用 / 枚举构造 / 内置输出函数
+    fn generateCall(self: *LLVMNativeBackend, callee: ast.Expr, args: []ast.Expr, type_args: []ast.Type) LowerError!llvm.ValueRef {
+        // 实例方法调用 obj.method(args) -> Type_method(&obj, args)
+        if (callee == .field_access) {
+            const field = callee.field_access;
+            const object_type = try self.inferExprType(field.object.*);
+            if (try self.methodTarget(object_type, field.field)) |target| {
+                return self.emitCall(target, field.object, args);
+            }
+            std.debug.print("⚠️  Undefined method: {s}\n", .{field.field});
+            return self.zeroValue();
+        }
+
+        if (callee != .identifier) {
+            std.debug.print("⚠️  Indirect calls are not supported in LLVM backend\n", .{});
+            return self.zeroValue();
+        }
+        const func_name = callee.identifier;
+
+        if (try self.generateBuiltinPrint(func_name, args)) |result| return result;
+        if (try self.generateInlineAccessor(func_name, args)) |result| return result;
+        if (try self.generateGenericIntrinsic(func_name, args, type_args)) |result| return result;
+
+        // Some(5) / Ok(x)：枚举变体构造器
+        if (!self.functions.contains(func_name) and self.enum_variants.contains(func_name)) {
+            return self.constructVariant(try self.variantEnumType(func_name, args), func_name, args);
+        }
+
+        const target = (try self.functionTarget(func_name, args, type_args)) orelse {
+            std.debug.print("⚠️  Undefined function: {s}\n", .{func_name});
+            return self.zeroValue();
+        };
+        return self.emitCall(target, null, args);
+    }
+
+    /// 🆕 v0.2.0: 按被调函数的实际类型生成调用；实参转换为形参类型
+    fn emitCall(self: *LLVMNativeBackend, target: CallTarget, receiver: ?*const ast.Expr, args: []const ast.Expr) LowerError!llvm.ValueRef {
+        const func = (try self.ensureCallee(target)) orelse {
+            std.debug.print("⚠️  Undefined function: {s}\n", .{target.name});
+            return self.zeroValue();
+        };
+        const func_type = llvm.functionTypeOf(func);
+
+        const param_count = llvm.LLVMCountParamTypes(func_type);
+        const param_types = try self.allocator.alloc(llvm.TypeRef, param_count);
+        defer self.allocator.free(param_types);
+        if (param_count > 0) llvm.LLVMGetParamTypes(func_type, param_types.ptr);
+
+        var values = std.ArrayList(llvm.ValueRef){};
+        defer values.deinit(self.allocator);
+
+        // self 按指针传递：可寻址的对象直接传地址（方法可以修改它），否则存入临时栈槽
+        if (target.has_self) {
+            if (receiver) |object| {
+                const self_ptr = if (try self.addressOf(object.*)) |place|
+                    place.ptr
+                else
+                    try self.spill(try self.generateExpr(object.*));
+                try values.append(self.allocator, self_ptr);
+            }
+        }
+
+        for (args) |arg| {
+            const index = values.items.len;
+            var value = try self.generateExpr(arg);
+            if (index < param_types.len) value = try self.coerceExpr(value, arg, param_types[index]);
+            try values.append(self.allocator, value);
+        }
+
+        if (values.items.len != param_types.len) {
+            std.debug.print("⚠️  Wrong number of arguments for {s}\n", .{target.name});
+            return self.zeroValue();
+        }
+
+        // void 调用不能有名字
+        const returns_void = llvm.typeKind(llvm.LLVMGetReturnType(func_type)) == .Void;
+        return self.builder.buildCall(func_type, func, values.items, if (returns_void) "" else "call");
+    }
+
+    /// 🆕 v0.2.0: 取得调用目标的函数；泛型实例首次使用时声明并排队生成函数体
+    fn ensureCallee(self: *LLVMNativeBackend, target: CallTarget) LowerError!?llvm.ValueRef {
+        if (self.functions.get(target.name)) |func| return func;
+        const instance = target.instance orelse return null;
+
+        const func = try self.declareFunction(instance.name, instance.func, instance.type_ctx);
+        if (self.shared_instances) |shared| {
+            // 之前的模块已经生成过：保持外部声明，链接到已有的定义
+            if (shared.contains(instance.key)) return func;
+            llvm.LLVMSetLinkage(func, .WeakODR);
+        } else {
+            llvm.LLVMSetLinkage(func, .LinkOnceODR);
+        }
+        try self.pending_instances.append(self.allocator, instance);
+        return func;
+    }
+
+    /// 🆕 v0.2.0: 把本模块生成了函数体的实例登记到共享实例表
+    /// 应在模块成功加入 JIT 之后调用，之后的模块就直接引用这些定义
+    pub fn registerInstances(self: *const LLVMNativeBackend, registry: *generics.InstanceRegistry) !void {
+        for (self.pending_instances.items) |instance| {
+            try registry.add(instance.key);
+        }
+    }
+
+    /// 🆕 v0.2.0: 实例的修饰名，按结构化键缓存；miss 时由 mangle 构造
+    fn instanceName(self: *LLVMNativeBackend, key: generics.InstanceKey, receiver_type: ?ast.Type) LowerError![]const u8 {
+        const entry = try self.instance_names.getOrPut(key);
+        if (!entry.found_existing) {
+            entry.value_ptr.* = if (receiver_type) |receiver|
+                try self.mangleMethod(try self.typeName(receiver), key.name)
+            else
+                try self.mangleInstance(key.name, key.type_args);
+        }
+        return entry.value_ptr.*;
+    }
+
+    /// 🆕 v0.2.0: 普通函数或泛型函数实例（类型实参显式给出或从实参推导）
+    fn functionTarget(self: *LLVMNativeBackend, name: []const u8, args: []const ast.Expr, type_args: []const ast.Type) LowerError!?CallTarget {
+        if (self.signatures.get(name)) |signature| {
+            return CallTarget{ .name = name, .return_type = signature.return_type };
+        }
+
+        const generic = self.generic_functions.get(name) orelse return null;
+        const concrete_args = if (type_args.len > 0)
+            try self.resolveTypes(type_args)
+        else blk: {
+            var inference = try TypeArgInference.init(self, generic.type_params);
+            for (generic.params, 0..) |param, i| {
+                if (i >= args.len) break;
+                inference.bind(param.type, try self.inferExprType(args[i]));
+            }
+            break :blk inference.result;
+        };
+
+        const ctx = TypeContext{ .params = generic.type_params, .args = try self.padTypeArgs(generic.type_params, concrete_args) };
+        const key = generics.InstanceKey.init("", name, ctx.args);
+        const mangled = try self.instanceName(key, null);
+        return CallTarget{
+            .name = mangled,
+            .return_type = try self.substitute(generic.return_type, ctx),
+            .instance = PendingInstance{ .key = key, .name = mangled, .func = generic, .type_ctx = ctx },
+        };
+    }
+
+    /// 🆕 v0.2.0: receiver_type 上名为 method_name 的方法
+    fn methodTarget(self: *LLVMNativeBackend, receiver_type: ast.Type, method_name: []const u8) LowerError!?CallTarget {
+        const base_name = typeBaseName(receiver_type) orelse return null;
+        const type_decl = self.type_decls.get(base_name) orelse return null;
+        const method = findMethod(type_decl, method_name) orelse return null;
+
+        const type_args: []const ast.Type = if (receiver_type == .generic_instance) receiver_type.generic_instance.type_args else &.{};
+        const ctx = TypeContext{
+            .params = type_decl.type_params,
+            .args = try self.padTypeArgs(type_decl.type_params, type_args),
+            .self_type = receiver_type,
+        };
+        const has_self = isReceiver(method);
+
+        if (type_decl.type_params.len == 0) {
+            const name = try self.mangleMethod(base_name, method_name);
+            return CallTarget{
+                .name = name,
+                .return_type = try self.substitute(method.return_type, ctx),
+                .has_self = has_self,
+            };
+        }
+
+        // 泛型类型的方法：Vec<i32>.length -> Vec_i32_length
+        const key = generics.InstanceKey.init(base_name, method_name, type_args);
+        const name = try self.instanceName(key, receiver_type);
+        return CallTarget{
+            .name = name,
+            .return_type = try self.substitute(method.return_type, ctx),
+            .has_self = has_self,
+            .instance = PendingInstance{ .key = key, .name = name, .func = method, .type_ctx = ctx },
+        };
+    }
+
+    /// 🆕 v0.2.0: Type::method / Type<T>::method 的接收者类型
+    /// 泛型类型省略类型实参时：在该类型自己的方法中沿用 Self，否则从实参推导
+    fn staticReceiverType(self: *LLVMNativeBackend, type_name: []const u8, type_args: []const ast.Type, method_name: []const u8, args: []const ast.Expr) LowerError!ast.Type {
+        if (type_args.len > 0) return self.instanceType(type_name, type_args);
+
+        const type_decl = self.type_decls.get(type_name) orelse return ast.Type{ .named = type_name };
+        if (type_decl.type_params.len == 0) return ast.Type{ .named = type_name };
+        if (self.selfTypeNamed(type_name)) |self_type| return self_type;
+
+        var inference = try TypeArgInference.init(self, type_decl.type_params);
+        if (findMethod(type_decl, method_name)) |method| {
+            for (method.params, 0..) |param, i| {
+                if (i >= args.len) break;
+                inference.bind(param.type, try self.inferExprType(args[i]));
+            }
+        }
+        return ast.Type{ .generic_instance = .{ .name = type_name, .type_args = inference.result } };
+    }
+
+    /// 🆕 v0.2.0: 结构体字面量的类型（泛型结构体从字段值推导类型实参）
+    fn structInitType(self: *LLVMNativeBackend, type_name: []const u8, type_args: []const ast.Type, fields: []const ast.StructFieldInit) LowerError!ast.Type {
+        if (type_args.len > 0) return self.instanceType(type_name, type_args);
+
+        const type_decl = self.type_decls.get(type_name) orelse return ast.Type{ .named = type_name };
+        if (type_decl.type_params.len == 0 or type_decl.kind != .struct_type) return ast.Type{ .named = type_name };
+        if (self.selfTypeNamed(type_name)) |self_type| return self_type;
+
+        var inference = try TypeArgInference.init(self, type_decl.type_params);
+        for (fields) |field| {
+            for (type_decl.kind.struct_type.fields) |decl_field| {
+                if (std.mem.eql(u8, decl_field.name, field.name)) {
+                    inference.bind(decl_field.type, try self.inferExprType(field.value));
+                    break;
+                }
+            }
+        }
+        return ast.Type{ .generic_instance = .{ .name = type_name, .type_args = inference.result } };
+    }
+
+    /// 🆕 v0.2.0: 变体所属枚举的类型（泛型枚举从构造参数推导类型实参）
+    fn variantEnumType(self: *LLVMNativeBackend, variant_name: []const u8, args: []const ast.Expr) LowerError!ast.Type {
+        const enum_name = self.enum_variants.get(variant_name) orelse return ast.Type.i32;
+        const type_decl = self.type_decls.get(enum_name).?;
+        if (type_decl.type_params.len == 0) return ast.Type{ .named = enum_name };
+        if (self.selfTypeNamed(enum_name)) |self_type| return self_type;
+
+        var inference = try TypeArgInference.init(self, type_decl.type_params);
+        for (type_decl.kind.enum_type.variants) |variant| {
+            if (!std.mem.eql(u8, variant.name, variant_name)) continue;
+            for (variant.fields, 0..) |field_type, i| {
+                if (i >= args.len) break;
+                inference.bind(field_type, try self.inferExprType(args[i]));
+            }
+        }
+        return ast.Type{ .generic_instance = .{ .name = enum_name, .type_args = inference.result } };
+    }
+
+    fn isEnumVariantOf(self: *LLVMNativeBackend, type_name: []const u8, variant_name: []const u8) bool {
+        const enum_name = self.enum_variants.get(variant_name) orelse return false;
+        return std.mem.eql(u8, enum_name, type_name);
+    }
+
+    /// 🆕 v0.2.0: 构造枚举值：写入 tag，再把参数写入该变体的数据结构体
+    fn constructVariant(self: *LLVMNativeBackend, enum_type: ast.Type, variant_name: []const u8, args: []const ast.Expr) LowerError!llvm.ValueRef {
+        const layout = (try self.enumLayoutOf(enum_type)) orelse return self.zeroValue();
+        const index = variantIndex(layout, variant_name) orelse return self.zeroValue();
+        const tag = llvm.constI32(self.context, @intCast(index));
+        if (!layout.has_data) return tag;
+
+        const slot = try self.entryAlloca(layout.llvm_type, "variant");
+        _ = self.builder.buildStore(tag, self.builder.buildStructGEP(layout.llvm_type, slot, 0, "tag"));
+
+        const fields = layout.variant_fields[index];
+        if (fields.len > 0) {
+            const payload_type = layout.payload_types[index];
+            const payload = self.builder.buildStructGEP(layout.llvm_type, slot, 1, "payload");
+            for (args, 0..) |arg, i| {
+                if (i >= fields.len) break;
+                const field_type = try self.toLLVMType(fields[i]);
+                const value = try self.coerceExpr(try self.generateExpr(arg), arg, field_type);
+                _ = self.builder.buildStore(value, self.builder.buildStructGEP(payload_type, payload, @intCast(i), "payload.field"));
+            }
+        }
+        return self.builder.buildLoad(layout.llvm_type, slot, "variant");
+    }
+
+    /// 🆕 v0.2.0: is / match 模式匹配
+    /// 按顺序测试每个分支：变体模式比较 tag，字面量模式比较值，标识符模式绑定值，_ 总是匹配
+    /// 各分支结果通过 PHI 合并；都不匹配时结果为零值
+    fn generateMatch(self: *LLVMNativeBackend, value_expr: ast.Expr, arms: anytype) LowerError!llvm.ValueRef {
+        const func = self.current_function orelse return error.NoCurrentFunction;
+
+        const value_type = try self.inferExprType(value_expr);
+        const value = try self.generateExpr(value_expr);
+        const enum_layout = try self.enumLayoutOf(value_type);
+
+        // 绑定变体数据需要地址：把被匹配的值放进栈槽
+        const slot = try self.spill(value);
+        const tag = if (enum_layout) |layout|
+            (if (layout.has_data) self.builder.buildLoad(self.types.i32, self.builder.buildStructGEP(layout.llvm_type, slot, 0, "tag.ptr"), "tag") else value)
+        else
+            value;
+
+        const end_block = llvm.appendBasicBlock(self.context, func, "match.end");
+        var result_type: ?llvm.TypeRef = null;
+        var incoming_values = std.ArrayList(llvm.ValueRef){};
+        defer incoming_values.deinit(self.allocator);
+        var incoming_blocks = std.ArrayList(llvm.BasicBlockRef){};
+        defer incoming_blocks.deinit(self.allocator);
+
+        for (arms) |arm| {
+            const arm_block = llvm.appendBasicBlock(self.context, func, "match.arm");
+            const next_block = llvm.appendBasicBlock(self.context, func, "match.next");
+
+            var saved = std.ArrayList(SavedVariable){};
+            defer saved.deinit(self.allocator);
+
+            // 1. 模式测试
+            var variant: ?u32 = null;
+            switch (arm.pattern) {
+                .wildcard => _ = self.builder.buildBr(arm_block),
+                .identifier => |name| {
+                    variant = if (enum_layout) |layout| variantIndex(layout, name) else null;
+                    if (variant == null) _ = self.builder.buildBr(arm_block);
+                },
+                .variant => |v| {
+                    variant = if (enum_layout) |layout| variantIndex(layout, v.name) else null;
+                    if (variant == null) {
+                        std.debug.print("⚠️  Unknown variant in pattern: {s}\n", .{v.name});
+                        _ = self.builder.buildBr(next_block);
+                    }
+                },
+                .literal => |literal| {
+                    const literal_value = try self.generateExpr(literal);
+                    const matched = try self.buildBinary(.eq, value, literal_value, value_type);
+                    _ = self.builder.buildCondBr(matched, arm_block, next_block);
+                },
+            }
+            if (variant) |index| {
+                const matched = self.builder.buildICmp(.EQ, tag, llvm.constI32(self.context, @intCast(index)), "match.tag");
+                _ = self.builder.buildCondBr(matched, arm_block, next_block);
+            }
+
+            // 2. 绑定
+            self.builder.positionAtEnd(arm_block);
+            switch (arm.pattern) {
+                .identifier => |name| if (variant == null) {
+                    try saved.append(self.allocator, try self.bindVariable(name, try self.declareLocal(name, value_type, value)));
+                },
+                .variant => |v| if (variant) |index| {
+                    const layout = enum_layout.?;
+                    const fields = layout.variant_fields[index];
+                    if (layout.has_data and fields.len > 0) {
+                        const payload = self.builder.buildStructGEP(layout.llvm_type, slot, 1, "payload");
+                        for (v.bindings, 0..) |binding, i| {
+                            if (i >= fields.len) break;
+                            const field_type = try self.toLLVMType(fields[i]);
+                            const field_ptr = self.builder.buildStructGEP(layout.payload_types[index], payload, @intCast(i), "payload.field");
+                            const field_value = self.builder.buildLoad(field_type, field_ptr, "binding");
+                            try saved.append(self.allocator, try self.bindVariable(binding, try self.declareLocal(binding, fields[i], field_value)));
+                        }
+                    }
+                },
+                else => {},
+            }
+
+            // 3. guard（is 表达式）
+            if (@hasField(@TypeOf(arm), "guard")) {
+                if (arm.guard) |guard| {
+                    const body_block = llvm.appendBasicBlock(self.context, func, "match.body");
+                    _ = self.builder.buildCondBr(try self.toCondition(try self.generateExpr(guard)), body_block, next_block);
+                    self.builder.positionAtEnd(body_block);
+                }
+            }
+
+            // 4. 分支体
+            var arm_value = try self.generateExpr(arm.body);
+            if (!self.blockTerminated()) {
+                if (result_type == null and llvm.typeKind(llvm.LLVMTypeOf(arm_value)) != .Void) {
+                    result_type = llvm.LLVMTypeOf(arm_value);
+                }
+                if (result_type) |ty| {
+                    arm_value = try self.coerce(arm_value, ty, false);
+                    try incoming_values.append(self.allocator, arm_value);
+                    try incoming_blocks.append(self.allocator, self.builder.getInsertBlock());
+                }
+                _ = self.builder.buildBr(end_block);
+            }
+
+            for (saved.items) |binding| self.restoreVariable(binding);
+            self.builder.positionAtEnd(next_block);
+        }
+
+        // 没有分支匹配
+        if (result_type) |ty| {
+            try incoming_values.append(self.allocator, llvm.constNull(self.context, ty));
+            try incoming_blocks.append(self.allocator, self.builder.getInsertBlock());
+        }
+        _ = self.builder.buildBr(end_block);
+
+        self.builder.positionAtEnd(end_block);
+        const phi_type = result_type orelse return self.zeroValue();
+        const phi = self.builder.buildPhi(phi_type, "match.result");
+        llvm.LLVMAddIncoming(phi, incoming_values.items.ptr, incoming_blocks.items.ptr, @intCast(incoming_values.items.len));
+        return phi;
+    }
+
+    /// 🆕 v0.2.0: prelude 声明的 paw_read_<T> / paw_write_<T> 直接降低为 load / store（见 intrinsics.zig）
+    fn generateInlineAccessor(self: *LLVMNativeBackend, name: []const u8, args: []const ast.Expr) LowerError!?llvm.ValueRef {
+        const access = intrinsics.accessor(name) orelse return null;
+        const signature = self.signatures.get(name) orelse return null;
+        if (!signature.is_extern or args.len != access.arity()) return null;
+
+        const element_type = switch (access.element) {
+            .i32 => self.types.i32,
+            .i64 => self.types.i64,
+            .f32 => self.types.f32,
+            .f64 => self.types.f64,
+        };
+        const address = try self.coerceExpr(try self.generateExpr(args[0]), args[0], self.types.i64);
+        const offset = try self.coerceExpr(try self.generateExpr(args[1]), args[1], self.types.i64);
+        const base = self.builder.buildIntToPtr(address, self.types.ptr, "heap");
+        var indices = [_]llvm.ValueRef{offset};
+        const slot = self.builder.buildInBoundsGEP(element_type, base, &indices, "slot");
+
+        if (!access.write) return self.builder.buildLoad(element_type, slot, "elem");
+        const value = try self.coerceExpr(try self.generateExpr(args[2]), args[2], element_type);
+        _ = self.builder.buildStore(value, slot);
+        return self.zeroValue();
+    }
+
+    /// 🆕 v0.2.0: size_of<T> / ptr_read<T> / ptr_write<T> 按具体的 T 展开（见 intrinsics.zig）
+    fn generateGenericIntrinsic(self: *LLVMNativeBackend, name: []const u8, args: []const ast.Expr, type_args: []const ast.Type) LowerError!?llvm.ValueRef {
+        const kind = intrinsics.generic(name) orelse return null;
+        const decl = self.generic_functions.get(name) orelse return null;
+        if (!decl.is_extern or type_args.len != 1 or args.len != kind.arity()) return null;
+
+        const element_type = try self.toLLVMType(try self.resolveType(type_args[0]));
+        if (kind == .size_of) return llvm.constI64(self.context, @intCast(self.module.abiSizeOf(element_type)));
+
+        const address = try self.coerceExpr(try self.generateExpr(args[0]), args[0], self.types.i64);
+        const index = try self.coerceExpr(try self.generateExpr(args[1]), args[1], self.types.i64);
+        const base = self.builder.buildIntToPtr(address, self.types.ptr, "heap");
+        var indices = [_]llvm.ValueRef{index};
+        const slot = self.builder.buildInBoundsGEP(element_type, base, &indices, "slot");
+
+        if (kind == .ptr_read) return self.builder.buildLoad(element_type, slot, "elem");
+        const value = try self.coerceExpr(try self.generateExpr(args[2]), args[2], element_type);
+        _ = self.builder.buildStore(value, slot);
+        return self.zeroValue();
+    }
+
+    /// 🆕 v0.2.0: println / print / eprintln / eprint（与 C 后端一样按名字内置）
+    /// stdout 走 printf（与 JIT 结束时的 fflush 配合），stderr 走 dprintf(2, ...)
+    /// 参数是字符串插值时，打印后立即释放拼接结果
+    fn generateBuiltinPrint(self: *LLVMNativeBackend, name: []const u8, args: []const ast.Expr) LowerError!?llvm.ValueRef {
+        const Builtin = struct { name: []const u8, format: [:0]const u8, to_stderr: bool };
+        const builtins = [_]Builtin{
+            .{ .name = "println", .format = "%s\n", .to_stderr = false },
+            .{ .name = "print", .format = "%s", .to_stderr = false },
+            .{ .name = "eprintln", .format = "%s\n", .to_stderr = true },
+            .{ .name = "eprint", .format = "%s", .to_stderr = true },
+        };
+        const builtin = for (builtins) |b| {
+            if (std.mem.eql(u8, b.name, name)) break b;
+        } else return null;
+
+        const ptr_type = self.types.ptr;
+        const i32_type = self.types.i32;
+        const message = if (args.len > 0)
+            try self.coerce(try self.generateExpr(args[0]), ptr_type, false)
+        else
+            self.builder.buildGlobalStringPtr("", "str");
+        const format = self.builder.buildGlobalStringPtr(builtin.format, "fmt");
+
+        if (builtin.to_stderr) {
+            var params = [_]llvm.TypeRef{ i32_type, ptr_type };
+            const dprintf = self.externFunction("dprintf", i32_type, &params, true);
+            var call_args = [_]llvm.ValueRef{ llvm.constI32(self.context, 2), format, message };
+            _ = self.builder.buildCall(llvm.functionTypeOf(dprintf), dprintf, &call_args, "print");
+        } else {
+            var params = [_]llvm.TypeRef{ptr_type};
+            const printf = self.externFunction("printf", i32_type, &params, true);
+            var call_args = [_]llvm.ValueRef{ format, message };
+            _ = self.builder.buildCall(llvm.functionTypeOf(printf), printf, &call_args, "print");
+        }
+        if (args.len > 0 and args[0] == .string_interp) {
+            var params = [_]llvm.TypeRef{ptr_type};
+            const free_fn = self.externFunction("paw_str_free", self.types.void_type, &params, false);
+            var call_args = [_]llvm.ValueRef{message};
+            _ = self.builder.buildCall(llvm.functionTypeOf(free_fn), free_fn, &call_args, "");
+        }
+        // 与 prelude 中的声明一致：返回 0
+        return self.zeroValue();
+    }
+
+    /// 🆕 v0.2.0: 字符串插值："x = ${x}"
+    /// 与 C 后端相同：每个部分格式化为 { ptr, len, scratch }（运行时的 Part，见 builtin/string.zig），
+    /// paw_str_join 求出总长度后一次分配拼接结果（堆上，不截断，可重入）
+    fn generateStringInterpolation(self: *LLVMNativeBackend, parts: []ast.StringInterpPart) LowerError!llvm.ValueRef {
+        const part_scratch_size = 40;
+        const ptr_type = self.types.ptr;
+        const i64_type = self.types.i64;
+
+        var fields = [_]llvm.TypeRef{ ptr_type, i64_type, llvm.arrayType(self.types.i8, part_scratch_size) };
+        const part_type = self.context.structType(&fields, false);
+        const array_type = llvm.arrayType(part_type, @intCast(parts.len));
+        const array = try self.entryAlloca(array_type, "interp.parts");
+
+        for (parts, 0..) |part, i| {
+            var indices = [_]llvm.ValueRef{ llvm.constI64(self.context, 0), llvm.constI64(self.context, @intCast(i)) };
+            const slot = self.builder.buildInBoundsGEP(array_type, array, &indices, "part");
+            switch (part) {
+                .literal => |lit| {
+                    // 字面量直接指向常量字符串，长度在编译期确定
+                    const text = self.builder.buildGlobalStringPtr(try self.createCString(lit), "str");
+                    _ = self.builder.buildStore(text, self.builder.buildStructGEP(part_type, slot, 0, "part.ptr"));
+                    _ = self.builder.buildStore(llvm.constI64(self.context, @intCast(lit.len)), self.builder.buildStructGEP(part_type, slot, 1, "part.len"));
+                },
+                .expr => |part_expr| {
+                    const paw_type = try self.inferExprType(part_expr);
+                    const value = try self.generateExpr(part_expr);
+                    const ty = llvm.LLVMTypeOf(value);
+                    // 按值的类型选择运行时的格式化函数（与 C 后端的 PAW_PART 相同）
+                    const Formatter = struct { name: [:0]const u8, arg: llvm.ValueRef };
+                    const formatter: Formatter = switch (llvm.typeKind(ty)) {
+                        .Integer => if (llvm.intWidth(ty) == 1)
+                            .{ .name = "paw_part_bool", .arg = value }
+                        else if (paw_type == .char)
+                            .{ .name = "paw_part_char", .arg = self.builder.buildZExt(value, self.types.i32, "char") }
+                        else if (isUnsignedType(paw_type))
+                            .{ .name = "paw_part_u64", .arg = try self.coerce(value, i64_type, true) }
+                        else
+                            .{ .name = "paw_part_i64", .arg = try self.coerce(value, i64_type, false) },
+                        .Float, .Double => .{ .name = "paw_part_f64", .arg = try self.coerce(value, self.types.f64, false) },
+                        .Pointer => .{ .name = "paw_part_str", .arg = value },
+                        else => .{ .name = "paw_part_str", .arg = self.builder.buildGlobalStringPtr("?", "str") },
+                    };
+                    var params = [_]llvm.TypeRef{ ptr_type, llvm.LLVMTypeOf(formatter.arg) };
+                    const func = self.externFunction(formatter.name, self.types.void_type, &params, false);
+                    var call_args = [_]llvm.ValueRef{ slot, formatter.arg };
+                    _ = self.builder.buildCall(llvm.functionTypeOf(func), func, &call_args, "");
+                },
+            }
+        }
+
+        var params = [_]llvm.TypeRef{ ptr_type, i64_type };
+        const join = self.externFunction("paw_str_join", ptr_type, &params, false);
+        var call_args = [_]llvm.ValueRef{ array, llvm.constI64(self.context, @intCast(parts.len)) };
+        return self.builder.buildCall(llvm.functionTypeOf(join), join, &call_args, "interp");
+    }
+
+    // ============================================================================
+    // 🆕 v0.2.0: Places (addressable expressions)
+    // ============================================================================
+
+    /// 可寻址表达式的地址和类型
+    const Place = struct {
+        ptr: llvm.ValueRef,
+        llvm_type: llvm.TypeRef,
+        paw_type: ast.Type,
+    };
+
+    /// 变量、字段 (obj.f)、数组 / 字符串元素 (a[i]) 的地址；其它表达式返回 null
+    fn addressOf(self: *LLVMNativeBackend, expr: ast.Expr) LowerError!?Place {
+        switch (expr) {
+            .identifier => |name| {
+                const variable = self.variables.get(name) orelse return null;
+                return Place{ .ptr = variable.ptr, .llvm_type = variable.llvm_type, .paw_type = variable.paw_type };
+            },
+            .field_access => |field_expr| {
+                const base = (try self.addressOf(field_expr.object.*)) orelse return null;
+                const layout = (try self.structLayoutOf(base.paw_type)) orelse return null;
+                const index = fieldIndex(layout, field_expr.field) orelse return null;
+                const field_type = layout.field_types[index];
+                return Place{
+                    .ptr = self.builder.buildStructGEP(layout.llvm_type, base.ptr, index, "field.ptr"),
+                    .llvm_type = try self.toLLVMType(field_type),
+                    .paw_type = field_type,
+                };
+            },
+            .array_index => |index_expr| {
+                const base = try self.addressOf(index_expr.array.*);
+                const base_type = if (base) |b| b.paw_type else try self.inferExprType(index_expr.array.*);
+
+                const element_type: ast.Type = switch (base_type) {
+                    .array => |arr| arr.element.*,
+                    .string => ast.Type.char,
+                    else => return null,
+                };
+                const element_llvm_type = try self.toLLVMType(element_type);
+
+                // 定长数组变量：GEP [0, i]；[T] / string 是指针：先取出指针再 GEP [i]
+                if (base != null and base_type == .array and base_type.array.size != null) {
+                    const index_value = try self.generateExpr(index_expr.index.*);
+                    var indices = [_]llvm.ValueRef{ llvm.constI32(self.context, 0), index_value };
+                    return Place{
+                        .ptr = self.builder.buildInBoundsGEP(base.?.llvm_type, base.?.ptr, &indices, "index"),
+                        .llvm_type = element_llvm_type,
+                        .paw_type = element_type,
+                    };
+                }
+
+                const pointer = if (base) |b|
+                    self.builder.buildLoad(b.llvm_type, b.ptr, "array.ptr")
+                else
+                    try self.coerce(try self.generateExpr(index_expr.array.*), self.types.ptr, false);
+                if (llvm.typeKind(llvm.LLVMTypeOf(pointer)) != .Pointer) return null;
+
+                const index_value = try self.generateExpr(index_expr.index.*);
+                var indices = [_]llvm.ValueRef{index_value};
+                return Place{
+                    .ptr = self.builder.buildInBoundsGEP(element_llvm_type, pointer, &indices, "index"),
+                    .llvm_type = element_llvm_type,
+                    .paw_type = element_type,
+                };
+            },
+            else => return null,
+        }
+    }
+
+    // ============================================================================
+    // 🆕 v0.2.0: Value conversion
+    // ============================================================================
+
+    /// 把值转换为目标 LLVM 类型（隐式的数值扩展 / 截断、数组退化为指针）
+    fn coerce(self: *LLVMNativeBackend, value: llvm.ValueRef, target: llvm.TypeRef, unsigned: bool) LowerError!llvm.ValueRef {
+        const source = llvm.LLVMTypeOf(value);
+        if (source == target) return value;
+
+        const source_kind = llvm.typeKind(source);
+        const target_kind = llvm.typeKind(target);
+
+        if (source_kind == .Integer and target_kind == .Integer) {
+            const source_bits = llvm.intWidth(source);
+            const target_bits = llvm.intWidth(target);
+            if (source_bits > target_bits) return self.builder.buildTrunc(value, target, "conv");
+            if (unsigned or source_bits == 1) return self.builder.buildZExt(value, target, "conv");
+            return self.builder.buildSExt(value, target, "conv");
+        }
+        if (source_kind == .Integer and isFloatKind(target)) {
+            if (unsigned or llvm.intWidth(source) == 1) return self.builder.buildUIToFP(value, target, "conv");
+            return self.builder.buildSIToFP(value, target, "conv");
+        }
+        if (isFloatKind(source) and target_kind == .Integer) {
+            return self.builder.buildFPToSI(value, target, "conv");
+        }
+        if (isFloatKind(source) and isFloatKind(target)) {
+            if (source_kind == .Float) return self.builder.buildFPExt(value, target, "conv");
+            return self.builder.buildFPTrunc(value, target, "conv");
+        }
+        if (source_kind == .Pointer and target_kind == .Integer) {
+            return self.builder.buildPtrToInt(value, target, "conv");
+        }
+        if (source_kind == .Array and target_kind == .Pointer) {
+            // [T; N] 传给 [T]：退化为指向首元素的指针
+            return self.spill(value);
+        }
+        if (source_kind == .Struct and target_kind == .Struct) {
+            // 结构相同但名字不同的命名结构体（例如 JIT 共享 context 中的 Point 与 Point.1）
+            return self.builder.buildLoad(target, try self.spill(value), "conv");
         }
-        _ = self.builder.buildBr(incr_block);
-        
-        // 生成递增块：i = i + 1
-        self.builder.positionAtEnd(incr_block);
-        const current_value2 = self.builder.buildLoad(i32_type, iter_var, iter_name_z);
-        const one = llvm.constI32(self.context, 1);
-        const next_value = self.builder.buildAdd(current_value2, one, "loop_incr");
-        _ = self.builder.buildStore(next_value, iter_var);
-        _ = self.builder.buildBr(cond_block);
-        
-        // 继续从退出块执行
-        self.builder.positionAtEnd(exit_block);
+        return value;
     }
-    
-    /// 生成无限循环
-    /// 生成: loop.body -> loop.body (无限循环，只能通过 break 退出)
-    fn generateInfiniteLoop(self: *LLVMNativeBackend, body: []ast.Stmt) !void {
-        const func = self.current_function orelse return error.NoCurrentFunction;
-        
-        // 创建基本块
-        const body_block = llvm.appendBasicBlock(self.context, func, "loop.body");
-        const exit_block = llvm.appendBasicBlock(self.context, func, "loop.exit");
-        
-        // 保存并设置循环上下文
-        const saved_ctx = self.saveLoopContext();
-        defer self.restoreLoopContext(saved_ctx);
-        
-        self.current_loop_exit = exit_block;
-        self.current_loop_continue = body_block;
-        
-        // 跳转到循环体
-        _ = self.builder.buildBr(body_block);
-        
-        // 生成循环体（无限循环回自己）
-        self.builder.positionAtEnd(body_block);
-        for (body) |stmt| {
-            try self.generateStmt(stmt);
+
+    fn coerceExpr(self: *LLVMNativeBackend, value: llvm.ValueRef, expr: ast.Expr, target: llvm.TypeRef) LowerError!llvm.ValueRef {
+        if (llvm.LLVMTypeOf(value) == target) return value;
+        // 🆕 v0.2.0: 整数字面量（及其取负）直接按目标类型重建常量，
+        // `let big: i64 = 5000000000` 不会先被截断成 i32 再扩展
+        if (literalValue(expr)) |literal| {
+            switch (llvm.typeKind(target)) {
+                .Integer => return llvm.LLVMConstInt(target, @bitCast(literal), 1),
+                .Float, .Double => return llvm.LLVMConstReal(target, @floatFromInt(literal)),
+                else => {},
+            }
         }
-        _ = self.builder.buildBr(body_block);
-        
-        // 退出块（只能通过 break 到达）
-        self.builder.positionAtEnd(exit_block);
+        return self.coerce(value, target, isUnsignedType(try self.inferExprType(expr)));
     }
-    
-    fn generateExpr(self: *LLVMNativeBackend, expr: ast.Expr) !llvm.ValueRef {
+
+    /// 整数字面量或取负的整数字面量的值
+    fn literalValue(expr: ast.Expr) ?i64 {
         return switch (expr) {
-            .int_literal => |val| blk: {
-                const i32_type = self.context.i32Type();
-                break :blk llvm.LLVMConstInt(i32_type, @intCast(val), 1);
-            },
-            .float_literal => |val| blk: {
-                break :blk llvm.constDouble(self.context, val);
-            },
-            .bool_literal => |val| blk: {
-                const i1_type = self.context.i1Type();
-                break :blk llvm.LLVMConstInt(i1_type, if (val) 1 else 0, 0);
-            },
-            .char_literal => |val| blk: {
-                const i32_type = self.context.i32Type();
-                break :blk llvm.LLVMConstInt(i32_type, @intCast(val), 0);
-            },
-            .string_literal => |str| blk: {
-                // Create null-terminated string
-                const str_z = try self.allocator.dupeZ(u8, str);
-                defer self.allocator.free(str_z);
-                
-                const name_z = try self.allocator.dupeZ(u8, "str");
-                defer self.allocator.free(name_z);
-                
-                // Build global string pointer
-                break :blk self.builder.buildGlobalStringPtr(str_z, name_z);
-            },
-            .identifier => |name| blk: {
-                if (self.variables.get(name)) |var_ptr| {
-                    // Load value from pointer
-                    if (self.variable_types.get(name)) |var_type| {
-                        const load_name_z = try self.allocator.dupeZ(u8, name);
-                        defer self.allocator.free(load_name_z);
-                        break :blk self.builder.buildLoad(var_type, var_ptr, load_name_z);
-                    } else {
-                        // Fallback: assume it's a direct value (for backward compatibility)
-                        break :blk var_ptr;
-                    }
-                } else {
-                    std.debug.print("⚠️  Undefined variable: {s}\n", .{name});
-                    break :blk llvm.constI32(self.context, 0);
+            .int_literal => |val| val,
+            .unary => |un| if (un.op == .neg and un.operand.* == .int_literal) -%un.operand.int_literal else null,
+            else => null,
+        };
+    }
+
+    fn literalFitsI32(val: i64) bool {
+        return std.math.cast(i32, val) != null;
+    }
+
+    /// 把数值 / 指针转换为 i1 条件
+    fn toCondition(self: *LLVMNativeBackend, value: llvm.ValueRef) LowerError!llvm.ValueRef {
+        const ty = llvm.LLVMTypeOf(value);
+        return switch (llvm.typeKind(ty)) {
+            .Integer => if (llvm.intWidth(ty) == 1) value else self.builder.buildICmp(.NE, value, llvm.constNull(self.context, ty), "cond"),
+            .Float, .Double => self.builder.buildFCmp(.UNE, value, llvm.constNull(self.context, ty), "cond"),
+            .Pointer => self.builder.buildICmp(.NE, value, llvm.constNull(self.context, ty), "cond"),
+            else => value,
+        };
+    }
+
+    /// 二元运算前把两个操作数统一到同一类型（整数取较宽者，整数与浮点混合时转为浮点）
+    fn unifyOperands(self: *LLVMNativeBackend, lhs: llvm.ValueRef, rhs: llvm.ValueRef, unsigned: bool) LowerError![2]llvm.ValueRef {
+        const lhs_type = llvm.LLVMTypeOf(lhs);
+        const rhs_type = llvm.LLVMTypeOf(rhs);
+        if (lhs_type == rhs_type) return .{ lhs, rhs };
+
+        const lhs_float = isFloatKind(lhs_type);
+        const rhs_float = isFloatKind(rhs_type);
+        if (lhs_float and !rhs_float) return .{ lhs, try self.coerce(rhs, lhs_type, unsigned) };
+        if (rhs_float and !lhs_float) return .{ try self.coerce(lhs, rhs_type, unsigned), rhs };
+        if (lhs_float and rhs_float) {
+            return if (llvm.typeKind(lhs_type) == .Double)
+                .{ lhs, try self.coerce(rhs, lhs_type, false) }
+            else
+                .{ try self.coerce(lhs, rhs_type, false), rhs };
+        }
+        if (llvm.intWidth(lhs_type) >= llvm.intWidth(rhs_type)) {
+            return .{ lhs, try self.coerce(rhs, lhs_type, unsigned) };
+        }
+        return .{ try self.coerce(lhs, rhs_type, unsigned), rhs };
+    }
+
+    // ============================================================================
+    // 🆕 v0.2.0: Type resolution
+    // ============================================================================
+
+    /// 按当前上下文替换类型参数和 Self
+    fn resolveType(self: *LLVMNativeBackend, paw_type: ast.Type) LowerError!ast.Type {
+        return self.substitute(paw_type, self.type_ctx);
+    }
+
+    fn resolveTypes(self: *LLVMNativeBackend, types: []const ast.Type) LowerError![]ast.Type {
+        const result = try self.arenaAllocator().alloc(ast.Type, types.len);
+        for (types, 0..) |t, i| result[i] = try self.resolveType(t);
+        return result;
+    }
+
+    /// 把 paw_type 中的类型参数替换为 ctx 中的具体类型
+    fn substitute(self: *LLVMNativeBackend, paw_type: ast.Type, ctx: TypeContext) LowerError!ast.Type {
+        if (ctx.params.len == 0 and ctx.self_type == null) return paw_type;
+        if (!mentionsTypeParam(paw_type, ctx)) return paw_type;
+
+        const arena = self.arenaAllocator();
+        return switch (paw_type) {
+            .generic, .named => |name| blk: {
+                for (ctx.params, 0..) |param, i| {
+                    if (std.mem.eql(u8, param, name)) break :blk if (i < ctx.args.len) ctx.args[i] else ast.Type.i32;
                 }
+                break :blk ctx.self_type orelse paw_type;  // 只剩 Self
             },
-            .binary => |binop| blk: {
-                const lhs = try self.generateExpr(binop.left.*);
-                const rhs = try self.generateExpr(binop.right.*);
-                
-                const result_name_z = try self.allocator.dupeZ(u8, "binop");
-                defer self.allocator.free(result_name_z);
-                
-                const result = switch (binop.op) {
-                    .add => self.builder.buildAdd(lhs, rhs, result_name_z),
-                    .sub => self.builder.buildSub(lhs, rhs, result_name_z),
-                    .mul => self.builder.buildMul(lhs, rhs, result_name_z),
-                    .div => self.builder.buildSDiv(lhs, rhs, result_name_z),
-                    // Comparison operators
-                    .eq => self.builder.buildICmp(.EQ, lhs, rhs, result_name_z),
-                    .ne => self.builder.buildICmp(.NE, lhs, rhs, result_name_z),
-                    .lt => self.builder.buildICmp(.SLT, lhs, rhs, result_name_z),
-                    .le => self.builder.buildICmp(.SLE, lhs, rhs, result_name_z),
-                    .gt => self.builder.buildICmp(.SGT, lhs, rhs, result_name_z),
-                    .ge => self.builder.buildICmp(.SGE, lhs, rhs, result_name_z),
-                    // Logical operators
-                    .and_op => self.builder.buildAnd(lhs, rhs, result_name_z),
-                    .or_op => self.builder.buildOr(lhs, rhs, result_name_z),
-                    else => llvm.constI32(self.context, 0),
-                };
-                break :blk result;
+            .generic_instance => |gi| blk: {
+                const args = try arena.alloc(ast.Type, gi.type_args.len);
+                for (gi.type_args, 0..) |arg, i| args[i] = try self.substitute(arg, ctx);
+                break :blk ast.Type{ .generic_instance = .{ .name = gi.name, .type_args = args } };
             },
-            .unary => |unop| blk: {
-                const operand = try self.generateExpr(unop.operand.*);
-                
-                const result_name_z = try self.allocator.dupeZ(u8, "unop");
-                defer self.allocator.free(result_name_z);
-                
-                const result = switch (unop.op) {
-                    .neg => self.builder.buildNeg(operand, result_name_z),
-                    .not => self.builder.buildNot(operand, result_name_z),
-                };
-                break :blk result;
+            .array => |arr| blk: {
+                const element = try arena.create(ast.Type);
+                element.* = try self.substitute(arr.element.*, ctx);
+                break :blk ast.Type{ .array = .{ .element = element, .size = arr.size } };
             },
-            .if_expr => |if_expr| blk: {
-                const func = self.current_function orelse {
-                    break :blk llvm.constI32(self.context, 0);
-                };
-                
-                // Generate condition
-                const cond_value = try self.generateExpr(if_expr.condition.*);
-                
-                // Create basic blocks
-                const then_block = llvm.appendBasicBlock(self.context, func, "if.then");
-                const else_block = llvm.appendBasicBlock(self.context, func, "if.else");
-                const cont_block = llvm.appendBasicBlock(self.context, func, "if.cont");
-                
-                // Build conditional branch
-                _ = llvm.LLVMBuildCondBr(self.builder.ref, cond_value, then_block, else_block);
-                
-                // Generate then branch
-                self.builder.positionAtEnd(then_block);
-                const then_value = try self.generateExpr(if_expr.then_branch.*);
-                const then_end_block = self.builder.getInsertBlock();
-                // 🆕 v0.2.0: 只有当块没有终止符时才添加跳转
-                const then_has_terminator = llvm.Builder.blockHasTerminator(then_end_block);
-                if (!then_has_terminator) {
-                    _ = self.builder.buildBr(cont_block);
-                }
-                
-                // Generate else branch
-                self.builder.positionAtEnd(else_block);
-                const else_value = if (if_expr.else_branch) |else_br|
-                    try self.generateExpr(else_br.*)
-                else
-                    llvm.constI32(self.context, 0);
-                const else_end_block = self.builder.getInsertBlock();
-                // 🆕 v0.2.0: 只有当块没有终止符时才添加跳转
-                const else_has_terminator = llvm.Builder.blockHasTerminator(else_end_block);
-                if (!else_has_terminator) {
-                    _ = self.builder.buildBr(cont_block);
-                }
-                
-                // Continue block with PHI node
-                self.builder.positionAtEnd(cont_block);
-                
-                // 🆕 v0.2.0: 只为实际到达的分支创建 PHI
-                // 如果两个分支都终止了，cont_block 不可达
-                if (then_has_terminator and else_has_terminator) {
-                    // 两个分支都终止，返回默认值（cont_block 不可达）
-                    break :blk llvm.constI32(self.context, 0);
-                }
-                
-                // Create PHI node to merge values from both branches
-                const result_type = llvm.LLVMTypeOf(then_value);
-                const phi_name_z = try self.allocator.dupeZ(u8, "if.result");
-                defer self.allocator.free(phi_name_z);
-                const phi = self.builder.buildPhi(result_type, phi_name_z);
-                
-                // 🆕 v0.2.0: 只添加未终止的分支到 PHI
-                if (!then_has_terminator and !else_has_terminator) {
-                    // 两个分支都未终止
-                    var incoming_values = [_]llvm.ValueRef{ then_value, else_value };
-                    var incoming_blocks = [_]llvm.BasicBlockRef{ then_end_block, else_end_block };
-                    llvm.LLVMAddIncoming(phi, &incoming_values, &incoming_blocks, 2);
-                } else if (!then_has_terminator) {
-                    // 只有 then 分支未终止
-                    var incoming_values = [_]llvm.ValueRef{then_value};
-                    var incoming_blocks = [_]llvm.BasicBlockRef{then_end_block};
-                    llvm.LLVMAddIncoming(phi, &incoming_values, &incoming_blocks, 1);
-                } else {
-                    // 只有 else 分支未终止
-                    var incoming_values = [_]llvm.ValueRef{else_value};
-                    var incoming_blocks = [_]llvm.BasicBlockRef{else_end_block};
-                    llvm.LLVMAddIncoming(phi, &incoming_values, &incoming_blocks, 1);
-                }
-                
-                break :blk phi;
+            .pointer => |pointee| blk: {
+                const target = try arena.create(ast.Type);
+                target.* = try self.substitute(pointee.*, ctx);
+                break :blk ast.Type{ .pointer = target };
             },
-            .block => |stmts| blk: {
-                // Execute all statements in the block
-                var last_value: ?llvm.ValueRef = null;
-                for (stmts) |stmt| {
-                    switch (stmt) {
-                        .expr => |block_expr| {
-                            // Save the last expression value as the block result
-                            last_value = try self.generateExpr(block_expr);
-                        },
-                        else => {
-                            try self.generateStmt(stmt);
-                        },
-                    }
+            else => paw_type,
+        };
+    }
+
+    fn mentionsTypeParam(paw_type: ast.Type, ctx: TypeContext) bool {
+        return switch (paw_type) {
+            .generic, .named => |name| blk: {
+                if (ctx.self_type != null and std.mem.eql(u8, name, "Self")) break :blk true;
+                for (ctx.params) |param| {
+                    if (std.mem.eql(u8, param, name)) break :blk true;
                 }
-                // Return the last expression value, or 0 if none
-                break :blk last_value orelse llvm.constI32(self.context, 0);
+                break :blk false;
             },
-            .array_index => |index_expr| blk: {
-                // Array/string indexing: arr[index]
-                const array_value = try self.generateExpr(index_expr.array.*);
-                const index_value = try self.generateExpr(index_expr.index.*);
-                
-                // 🆕 v0.2.0: 检测是否是字符串索引
-                // 如果 array 是字符串字面量或字符串类型，使用 i8
-                const is_string = index_expr.array.* == .string_literal or
-                                 index_expr.array.* == .identifier;  // 简化判断
-                
-                const element_type = if (is_string) 
-                    self.context.i8Type()  // 字符串 -> i8 (char)
-                else 
-                    self.context.i32Type();  // 数组 -> i32
-                
-                // Build GEP instruction
-                var indices = [_]llvm.ValueRef{ llvm.constI32(self.context, 0), index_value };
-                
-                const gep_name_z = try self.allocator.dupeZ(u8, "index");
-                defer self.allocator.free(gep_name_z);
-                
-                const array_type = llvm.arrayType(element_type, 0);  // Size doesn't matter for GEP
-                
-                const gep = self.builder.buildInBoundsGEP(array_type, array_value, &indices, gep_name_z);
-                
-                // Load the value
-                const load_name_z = try self.allocator.dupeZ(u8, "elem");
-                defer self.allocator.free(load_name_z);
-                break :blk self.builder.buildLoad(element_type, gep, load_name_z);
+            .generic_instance => |gi| for (gi.type_args) |arg| {
+                if (mentionsTypeParam(arg, ctx)) break true;
+            } else false,
+            .array => |arr| mentionsTypeParam(arr.element.*, ctx),
+            .pointer => |pointee| mentionsTypeParam(pointee.*, ctx),
+            else => false,
+        };
+    }
+
+    /// 类型实参不足时用 i32 补齐（与 C 后端的默认一致）
+    fn padTypeArgs(self: *LLVMNativeBackend, params: []const []const u8, args: []const ast.Type) LowerError![]const ast.Type {
+        if (args.len >= params.len) return args;
+        const result = try self.arenaAllocator().alloc(ast.Type, params.len);
+        for (result, 0..) |*slot, i| slot.* = if (i < args.len) args[i] else ast.Type.i32;
+        return result;
+    }
+
+    fn instanceType(self: *LLVMNativeBackend, name: []const u8, type_args: []const ast.Type) LowerError!ast.Type {
+        return ast.Type{ .generic_instance = .{ .name = name, .type_args = try self.resolveTypes(type_args) } };
+    }
+
+    /// 当前方法的 Self 恰好是 type_name 的实例时返回它（泛型类型的方法中省略类型实参）
+    fn selfTypeNamed(self: *LLVMNativeBackend, type_name: []const u8) ?ast.Type {
+        const self_type = self.type_ctx.self_type orelse return null;
+        const base = typeBaseName(self_type) orelse return null;
+        return if (std.mem.eql(u8, base, type_name)) self_type else null;
+    }
+
+    /// 从实参类型推导泛型参数（对 T、Box<T>、[T] 等形参做简单的结构匹配）
+    const TypeArgInference = struct {
+        params: []const []const u8,
+        result: []ast.Type,
+        found: []bool,
+
+        fn init(backend: *LLVMNativeBackend, params: []const []const u8) !TypeArgInference {
+            const arena = backend.arenaAllocator();
+            const result = try arena.alloc(ast.Type, params.len);
+            const found = try arena.alloc(bool, params.len);
+            @memset(result, ast.Type.i32);
+            @memset(found, false);
+            return TypeArgInference{ .params = params, .result = result, .found = found };
+        }
+
+        fn bind(self: *TypeArgInference, pattern: ast.Type, actual: ast.Type) void {
+            switch (pattern) {
+                .generic, .named => |name| {
+                    for (self.params, 0..) |param, i| {
+                        if (std.mem.eql(u8, param, name) and !self.found[i]) {
+                            self.result[i] = actual;
+                            self.found[i] = true;
+                        }
+                    }
+                },
+                .generic_instance => |gi| {
+                    if (actual != .generic_instance) return;
+                    const other = actual.generic_instance;
+                    if (!std.mem.eql(u8, gi.name, other.name) or gi.type_args.len != other.type_args.len) return;
+                    for (gi.type_args, other.type_args) |p, a| self.bind(p, a);
+                },
+                .array => |arr| if (actual == .array) self.bind(arr.element.*, actual.array.element.*),
+                .pointer => |pointee| if (actual == .pointer) self.bind(pointee.*, actual.pointer.*),
+                else => {},
+            }
+        }
+    };
+
+    /// 推导表达式的 Paw 类型（结果已是具体类型）
+    /// 🆕 v0.2.0: 从变量、函数签名、结构体字段、枚举变体推出，不再默认 i32
+    fn inferExprType(self: *LLVMNativeBackend, expr: ast.Expr) LowerError!ast.Type {
+        return switch (expr) {
+            .int_literal => |val| if (literalFitsI32(val)) ast.Type.i32 else ast.Type.i64,
+            .float_literal => ast.Type.f64,
+            .bool_literal => ast.Type.bool,
+            .char_literal => ast.Type.char,
+            .string_literal, .string_interp => ast.Type.string,
+            .identifier => |name| blk: {
+                if (self.variables.get(name)) |variable| break :blk variable.paw_type;
+                if (self.enum_variants.contains(name)) break :blk try self.variantEnumType(name, &.{});
+                break :blk ast.Type.i32;
             },
-            .field_access => |field_expr| blk: {
-                // Struct field access: obj.field
-                _ = try self.generateExpr(field_expr.object.*);
-                
-                // For now, return a placeholder
-                // TODO: Need type information to determine field index
-                std.debug.print("⚠️  Field access not yet fully implemented: {s}\n", .{field_expr.field});
-                break :blk llvm.constI32(self.context, 0);
+            .binary => |binop| switch (binop.op) {
+                .eq, .ne, .lt, .le, .gt, .ge, .and_op, .or_op => ast.Type.bool,
+                else => try self.arithmeticType(
+                    try self.inferExprType(binop.left.*),
+                    try self.inferExprType(binop.right.*),
+                ),
             },
+            .unary => |unop| if (unop.op == .not) ast.Type.bool else try self.inferExprType(unop.operand.*),
             .call => |call_expr| blk: {
-                // 🆕 检查是否是实例方法调用 (obj.method 形式)
                 if (call_expr.callee.* == .field_access) {
                     const field = call_expr.callee.field_access;
-                    
-                    // 尝试获取对象类型和生成修饰后的方法名
-                    if (field.object.* == .identifier) {
-                        const var_name = field.object.identifier;
-                        // 简化实现：假设对象是 i32 类型，方法名是 TypeName_method
-                        // TODO: 需要类型系统支持才能正确查找类型
-                        
-                        // 生成修饰后的方法名（简化版）
-                        var method_name = std.ArrayList(u8){};
-                        defer method_name.deinit(self.allocator);
-                        
-                        // 假设类型名就是变量名的首字母大写形式
-                        try method_name.appendSlice(self.allocator, var_name);
-                        try method_name.appendSlice(self.allocator, "_");
-                        try method_name.appendSlice(self.allocator, field.field);
-                        
-                        const mangled_method_name = try method_name.toOwnedSlice(self.allocator);
-                        defer self.allocator.free(mangled_method_name);
-                        
-                        // 查找方法
-                        if (self.functions.get(mangled_method_name)) |func| {
-                            // 生成参数：第一个参数是 self
-                            var args = std.ArrayList(llvm.ValueRef){};
-                            defer args.deinit(self.allocator);
-                            
-                            // 添加 self 参数（对象本身）
-                            const obj_value = try self.generateExpr(field.object.*);
-                            try args.append(self.allocator, obj_value);
-                            
-                            // 添加其他参数
-                            for (call_expr.args) |arg| {
-                                const arg_value = try self.generateExpr(arg);
-                                try args.append(self.allocator, arg_value);
-                            }
-                            
-                            // 获取函数类型
-                            const i32_type = self.context.i32Type();
-                            var param_types = std.ArrayList(llvm.TypeRef){};
-                            defer param_types.deinit(self.allocator);
-                            for (args.items) |_| {
-                                try param_types.append(self.allocator, i32_type);
-                            }
-                            const func_type = llvm.functionType(i32_type, param_types.items, false);
-                            
-                            // 构建调用
-                            const call_name_z = try self.allocator.dupeZ(u8, "method_call");
-                            defer self.allocator.free(call_name_z);
-                            
-                            const result = self.builder.buildCall(func_type, func, args.items, call_name_z);
-                            break :blk result;
-                        }
-                    }
-                }
-                
-                // 普通函数调用
-                const func_name = if (call_expr.callee.* == .identifier)
-                    call_expr.callee.identifier
-                else
-                    "unknown";
-                
-                // Look up function
-                const func = self.functions.get(func_name) orelse {
-                    std.debug.print("⚠️  Undefined function: {s}\n", .{func_name});
-                    break :blk llvm.constI32(self.context, 0);
-                };
-                
-                // Generate arguments
-                var args = std.ArrayList(llvm.ValueRef){};
-                defer args.deinit(self.allocator);
-                
-                for (call_expr.args) |arg| {
-                    const arg_value = try self.generateExpr(arg);
-                    try args.append(self.allocator, arg_value);
+                    const object_type = try self.inferExprType(field.object.*);
+                    if (try self.methodTarget(object_type, field.field)) |target| break :blk target.return_type;
+                    break :blk ast.Type.i32;
                 }
-                
-                // Get function type
-                const i32_type = self.context.i32Type();
-                var param_types = std.ArrayList(llvm.TypeRef){};
-                defer param_types.deinit(self.allocator);
-                for (args.items) |_| {
-                    try param_types.append(self.allocator, i32_type);
+                if (call_expr.callee.* != .identifier) break :blk ast.Type.i32;
+                const name = call_expr.callee.identifier;
+                if (!self.functions.contains(name) and self.enum_variants.contains(name)) {
+                    break :blk try self.variantEnumType(name, call_expr.args);
                 }
-                const func_type = llvm.functionType(i32_type, param_types.items, false);
-                
-                // Build call
-                const call_name_z = try self.allocator.dupeZ(u8, "call");
-                defer self.allocator.free(call_name_z);
-                
-                const result = self.builder.buildCall(func_type, func, args.items, call_name_z);
-                break :blk result;
+                if (try self.functionTarget(name, call_expr.args, call_expr.type_args)) |target| break :blk target.return_type;
+                break :blk ast.Type.i32;
             },
             .static_method_call => |smc| blk: {
-                // 🆕 静态方法调用：Type<T>::method()
-                // 生成修饰后的函数名：Type_T_method
-                var func_name = std.ArrayList(u8){};
-                defer func_name.deinit(self.allocator);
-                
-                // 添加类型名
-                try func_name.appendSlice(self.allocator, smc.type_name);
-                
-                // 添加类型参数
-                for (smc.type_args) |type_arg| {
-                    try func_name.appendSlice(self.allocator, "_");
-                    const type_name = try self.getSimpleTypeName(type_arg);
-                    // 只有 generic_instance 返回的是需要释放的内存
-                    const needs_free = type_arg == .generic_instance;
-                    defer if (needs_free) self.allocator.free(type_name);
-                    try func_name.appendSlice(self.allocator, type_name);
-                }
-                
-                // 添加方法名
-                try func_name.appendSlice(self.allocator, "_");
-                try func_name.appendSlice(self.allocator, smc.method_name);
-                
-                const mangled_name = try func_name.toOwnedSlice(self.allocator);
-                defer self.allocator.free(mangled_name);
-                
-                // 查找函数
-                const func = self.functions.get(mangled_name) orelse {
-                    std.debug.print("⚠️  Undefined static method: {s}\n", .{mangled_name});
-                    break :blk llvm.constI32(self.context, 0);
-                };
-                
-                // 生成参数
-                var args = std.ArrayList(llvm.ValueRef){};
-                defer args.deinit(self.allocator);
-                
-                for (smc.args) |arg| {
-                    const arg_value = try self.generateExpr(arg);
-                    try args.append(self.allocator, arg_value);
-                }
-                
-                // 获取函数类型
-                const i32_type = self.context.i32Type();
-                var param_types = std.ArrayList(llvm.TypeRef){};
-                defer param_types.deinit(self.allocator);
-                for (args.items) |_| {
-                    try param_types.append(self.allocator, i32_type);
+                if (self.isEnumVariantOf(smc.type_name, smc.method_name)) {
+                    break :blk if (smc.type_args.len > 0)
+                        try self.instanceType(smc.type_name, smc.type_args)
+                    else
+                        try self.variantEnumType(smc.method_name, smc.args);
                 }
-                const func_type = llvm.functionType(i32_type, param_types.items, false);
-                
-                // 构建调用
-                const call_name_z = try self.allocator.dupeZ(u8, "static_call");
-                defer self.allocator.free(call_name_z);
-                
-                const result = self.builder.buildCall(func_type, func, args.items, call_name_z);
-                break :blk result;
+                const receiver_type = try self.staticReceiverType(smc.type_name, smc.type_args, smc.method_name, smc.args);
+                if (try self.methodTarget(receiver_type, smc.method_name)) |target| break :blk target.return_type;
+                break :blk ast.Type.i32;
             },
-            .array_literal => |elements| blk: {
-                // 🆕 数组字面量：[1, 2, 3]
-                // 简化实现：返回第一个元素的值
-                if (elements.len == 0) {
-                    break :blk llvm.constI32(self.context, 0);
-                }
-                
-                // 返回第一个元素的值（简化实现）
-                const first_element = try self.generateExpr(elements[0]);
-                break :blk first_element;
+            .field_access => |field_expr| blk: {
+                const object_type = try self.inferExprType(field_expr.object.*);
+                const layout = (try self.structLayoutOf(object_type)) orelse break :blk ast.Type.i32;
+                const index = fieldIndex(layout, field_expr.field) orelse break :blk ast.Type.i32;
+                break :blk layout.field_types[index];
             },
-            .struct_init => |si| blk: {
-                // 🆕 结构体字面量：Point { x: 1, y: 2 }
-                // 简化实现：返回第一个字段的值
-                if (si.fields.len == 0) {
-                    break :blk llvm.constI32(self.context, 0);
-                }
-                
-                // 返回第一个字段的值（简化实现）
-                const first_field_value = try self.generateExpr(si.fields[0].value);
-                break :blk first_field_value;
+            .struct_init => |si| try self.structInitType(si.type_name, si.type_args, si.fields),
+            .enum_variant => |ev| try self.variantEnumType(ev.variant, ev.args),
+            .array_literal => |elements| blk: {
+                const element = try self.arenaAllocator().create(ast.Type);
+                element.* = if (elements.len > 0) try self.inferExprType(elements[0]) else ast.Type.i32;
+                break :blk ast.Type{ .array = .{ .element = element, .size = elements.len } };
             },
-            // 🆕 v0.1.7: as 类型转换
-            .as_expr => |as_cast| blk: {
-                const value = try self.generateExpr(as_cast.value.*);
-                const target_llvm_type = try self.toLLVMType(as_cast.target_type);
-                
-                // 生成类型转换指令
-                break :blk try self.generateCast(value, as_cast.value, as_cast.target_type, target_llvm_type);
+            .array_index => |index_expr| switch (try self.inferExprType(index_expr.array.*)) {
+                .array => |arr| arr.element.*,
+                .string => ast.Type.char,
+                else => ast.Type.i32,
             },
-            else => llvm.constI32(self.context, 0),
+            .if_expr => |if_expr| try self.inferExprType(if_expr.then_branch.*),
+            .block => |stmts| if (stmts.len > 0 and stmts[stmts.len - 1] == .expr)
+                try self.inferExprType(stmts[stmts.len - 1].expr)
+            else
+                ast.Type.i32,
+            .as_expr => |as_cast| try self.resolveType(as_cast.target_type),
+            else => ast.Type.i32,
         };
     }
-    
-    fn toLLVMType(self: *LLVMNativeBackend, paw_type: ast.Type) !llvm.TypeRef {
-        return switch (paw_type) {
+
+    /// 算术运算的结果类型：有浮点取浮点（f64 优先），否则取较宽的整数
+    fn arithmeticType(self: *LLVMNativeBackend, lhs: ast.Type, rhs: ast.Type) LowerError!ast.Type {
+        if (lhs == .f64 or rhs == .f64) return ast.Type.f64;
+        if (lhs == .f32 or rhs == .f32) return ast.Type.f32;
+        if (self.isIntType(lhs) and self.isIntType(rhs)) {
+            return if (self.getTypeBits(rhs) > self.getTypeBits(lhs)) rhs else lhs;
+        }
+        return lhs;
+    }
+
+    // ============================================================================
+    // 🆕 v0.2.0: Type lowering
+    // ============================================================================
+
+    fn toLLVMType(self: *LLVMNativeBackend, paw_type: ast.Type) LowerError!llvm.TypeRef {
+        const resolved = try self.resolveType(paw_type);
+        return switch (resolved) {
             // 🆕 v0.1.7: 完整的类型映射（支持 as 转换）
-            .i8, .u8, .bool, .char => self.context.i8Type(),
-            .i16, .u16 => self.context.i16Type(),
-            .i32, .u32 => self.context.i32Type(),
-            .i64, .u64 => self.context.i64Type(),
-            .i128, .u128 => self.context.i128Type(),
-            .f32 => self.context.floatType(),
-            .f64 => self.context.doubleType(),
-            .void => self.context.voidType(),
-            .string => self.context.pointerType(0),
-            
+            .bool => self.types.i1,
+            .i8, .u8, .char => self.types.i8,
+            .i16, .u16 => self.types.i16,
+            .i32, .u32 => self.types.i32,
+            .i64, .u64 => self.types.i64,
+            .i128, .u128 => self.types.i128,
+            .f32 => self.types.f32,
+            .f64 => self.types.f64,
+            .void => self.types.void_type,
+            .string, .pointer, .function => self.types.ptr,
+
             .named => |name| blk: {
+                if (try self.structLayoutOf(resolved)) |layout| break :blk layout.llvm_type;
+                if (try self.enumLayoutOf(resolved)) |layout| break :blk layout.llvm_type;
+
                 if (std.mem.eql(u8, name, "i32") or std.mem.eql(u8, name, "int")) {
-                    break :blk self.context.i32Type();
+                    break :blk self.types.i32;
                 } else if (std.mem.eql(u8, name, "i64")) {
-                    break :blk self.context.i64Type();
+                    break :blk self.types.i64;
                 } else if (std.mem.eql(u8, name, "f64") or std.mem.eql(u8, name, "double")) {
-                    break :blk self.context.doubleType();
+                    break :blk self.types.f64;
                 } else if (std.mem.eql(u8, name, "void")) {
-                    break :blk self.context.voidType();
+                    break :blk self.types.void_type;
                 } else {
-                    break :blk self.context.i32Type(); // Default
+                    break :blk self.types.i32; // Default
                 }
             },
-            else => self.context.i32Type(), // Default
+            .generic_instance => blk: {
+                if (try self.structLayoutOf(resolved)) |layout| break :blk layout.llvm_type;
+                if (try self.enumLayoutOf(resolved)) |layout| break :blk layout.llvm_type;
+                break :blk self.types.i32;
+            },
+            .array => |arr| if (arr.size) |size|
+                llvm.arrayType(try self.toLLVMType(arr.element.*), @intCast(size))
+            else
+                self.types.ptr,
+            .generic => self.types.i32, // 未绑定的类型参数
         };
     }
-    
-    /// 获取类型的简化名（用于name mangling）
-    /// 注意：对于 generic_instance，调用者需要负责释放返回的字符串
-    fn getSimpleTypeName(self: *LLVMNativeBackend, paw_type: ast.Type) ![]const u8 {
+
+    /// 结构体类型的布局（泛型结构体按类型实参实例化，结果缓存）
+    fn structLayoutOf(self: *LLVMNativeBackend, paw_type: ast.Type) LowerError!?StructLayout {
+        const base_name = typeBaseName(paw_type) orelse return null;
+        const type_decl = self.type_decls.get(base_name) orelse return null;
+        if (type_decl.kind != .struct_type) return null;
+
+        const key = try self.typeName(paw_type);
+        if (self.struct_layouts.get(key)) |layout| return layout;
+
+        const type_args: []const ast.Type = if (paw_type == .generic_instance) paw_type.generic_instance.type_args else &.{};
+        const ctx = TypeContext{
+            .params = type_decl.type_params,
+            .args = try self.padTypeArgs(type_decl.type_params, type_args),
+            .self_type = paw_type,
+        };
+
+        const arena = self.arenaAllocator();
+        const fields = type_decl.kind.struct_type.fields;
+        const field_names = try arena.alloc([]const u8, fields.len);
+        const field_types = try arena.alloc(ast.Type, fields.len);
+        for (fields, 0..) |field, i| {
+            field_names[i] = field.name;
+            field_types[i] = try self.substitute(field.type, ctx);
+        }
+
+        // 先登记（字段中可以通过指针引用自身），再设置字段
+        const key_z = try arena.dupeZ(u8, key);
+        const layout = StructLayout{
+            .llvm_type = self.context.namedStructType(key_z),
+            .field_names = field_names,
+            .field_types = field_types,
+        };
+        try self.struct_layouts.put(key, layout);
+
+        const element_types = try self.allocator.alloc(llvm.TypeRef, fields.len);
+        defer self.allocator.free(element_types);
+        for (field_types, 0..) |field_type, i| element_types[i] = try self.toLLVMType(field_type);
+        llvm.setStructBody(layout.llvm_type, element_types);
+        return layout;
+    }
+
+    /// 枚举类型的布局：payload 区的大小取最大变体数据结构体的 ABI 大小
+    fn enumLayoutOf(self: *LLVMNativeBackend, paw_type: ast.Type) LowerError!?EnumLayout {
+        const base_name = typeBaseName(paw_type) orelse return null;
+        const type_decl = self.type_decls.get(base_name) orelse return null;
+        if (type_decl.kind != .enum_type) return null;
+
+        const key = try self.typeName(paw_type);
+        if (self.enum_layouts.get(key)) |layout| return layout;
+
+        const type_args: []const ast.Type = if (paw_type == .generic_instance) paw_type.generic_instance.type_args else &.{};
+        const ctx = TypeContext{
+            .params = type_decl.type_params,
+            .args = try self.padTypeArgs(type_decl.type_params, type_args),
+            .self_type = paw_type,
+        };
+
+        const arena = self.arenaAllocator();
+        const variants = type_decl.kind.enum_type.variants;
+        const variant_names = try arena.alloc([]const u8, variants.len);
+        const variant_fields = try arena.alloc([]const ast.Type, variants.len);
+        const payload_types = try arena.alloc(llvm.TypeRef, variants.len);
+
+        var max_payload: u64 = 0;
+        for (variants, 0..) |variant, i| {
+            variant_names[i] = variant.name;
+            const fields = try arena.alloc(ast.Type, variant.fields.len);
+            for (variant.fields, 0..) |field_type, j| fields[j] = try self.substitute(field_type, ctx);
+            variant_fields[i] = fields;
+
+            if (fields.len == 0) {
+                payload_types[i] = null;
+                continue;
+            }
+            const element_types = try arena.alloc(llvm.TypeRef, fields.len);
+            for (fields, 0..) |field_type, j| element_types[j] = try self.toLLVMType(field_type);
+            payload_types[i] = self.context.structType(element_types, false);
+            max_payload = @max(max_payload, self.module.abiSizeOf(payload_types[i]));
+        }
+
+        const has_data = max_payload > 0;
+        const llvm_type = if (has_data) blk: {
+            const key_z = try arena.dupeZ(u8, key);
+            const enum_type = self.context.namedStructType(key_z);
+            var element_types = [_]llvm.TypeRef{
+                self.types.i32,
+                llvm.arrayType(self.types.i64, @intCast((max_payload + 7) / 8)),
+            };
+            llvm.setStructBody(enum_type, &element_types);
+            break :blk enum_type;
+        } else self.types.i32;
+
+        const layout = EnumLayout{
+            .llvm_type = llvm_type,
+            .has_data = has_data,
+            .variant_names = variant_names,
+            .variant_fields = variant_fields,
+            .payload_types = payload_types,
+        };
+        try self.enum_layouts.put(key, layout);
+        return layout;
+    }
+
+    // ============================================================================
+    // 🆕 v0.2.0: Name mangling（与 C 后端一致：Type_T_method）
+    // ============================================================================
+
+    /// 类型的修饰名：Vec<i32> -> Vec_i32
+    fn typeName(self: *LLVMNativeBackend, paw_type: ast.Type) LowerError![]const u8 {
         return switch (paw_type) {
-            .i8 => "i8",
-            .i16 => "i16",
-            .i32 => "i32",
-            .i64 => "i64",
-            .i128 => "i128",
-            .u8 => "u8",
-            .u16 => "u16",
-            .u32 => "u32",
-            .u64 => "u64",
-            .u128 => "u128",
-            .f32 => "f32",
-            .f64 => "f64",
-            .bool => "bool",
-            .char => "char",
-            .string => "string",
-            .void => "void",
-            .generic => |name| name,
-            .named => |name| name,
-            .generic_instance => |gi| blk: {
-                // 🆕 处理泛型实例：Vec<i32> -> Vec_i32
-                // 注意：这会分配新内存，调用者需要释放
-                var buf = std.ArrayList(u8){};
-                errdefer buf.deinit(self.allocator);
-                
-                try buf.appendSlice(self.allocator, gi.name);
-                for (gi.type_args) |arg| {
-                    try buf.appendSlice(self.allocator, "_");
-                    const type_name = try self.getSimpleTypeName(arg);
-                    // 只有 generic_instance 返回的是需要释放的内存
-                    const needs_free = arg == .generic_instance;
-                    defer if (needs_free) self.allocator.free(type_name);
-                    try buf.appendSlice(self.allocator, type_name);
-                }
-                break :blk try buf.toOwnedSlice(self.allocator);
-            },
-            else => "unknown",
+            .generic_instance => |gi| self.mangleInstance(gi.name, gi.type_args),
+            .array => |arr| if (arr.size) |size|
+                std.fmt.allocPrint(self.arenaAllocator(), "array{d}_{s}", .{ size, try self.typeName(arr.element.*) })
+            else
+                std.fmt.allocPrint(self.arenaAllocator(), "array_{s}", .{try self.typeName(arr.element.*)}),
+            .pointer => |pointee| std.fmt.allocPrint(self.arenaAllocator(), "ptr_{s}", .{try self.typeName(pointee.*)}),
+            .generic, .named => |name| name,
+            .function => "fn",
+            else => @tagName(paw_type),
         };
     }
-    
+
+    fn mangleInstance(self: *LLVMNativeBackend, base: []const u8, type_args: []const ast.Type) LowerError![]const u8 {
+        var buf = std.ArrayList(u8){};
+        const arena = self.arenaAllocator();
+        try buf.appendSlice(arena, base);
+        for (type_args) |arg| {
+            try buf.append(arena, '_');
+            try buf.appendSlice(arena, try self.typeName(arg));
+        }
+        return buf.items;
+    }
+
+    fn mangleMethod(self: *LLVMNativeBackend, type_name: []const u8, method_name: []const u8) LowerError![]const u8 {
+        return std.fmt.allocPrint(self.arenaAllocator(), "{s}_{s}", .{ type_name, method_name });
+    }
+
     // ============================================================================
     // 🆕 v0.1.7: Optimization Support
     // ============================================================================
     
-    /// 获取优化级别对应的 clang 参数提示
+    /// 获取优化级别对应的命令行参数
     pub fn getOptLevelString(self: *LLVMNativeBackend) []const u8 {
         return switch (self.opt_level) {
             .O0 => "-O0",
@@ -974,6 +2411,63 @@ pub const LLVMNativeBackend = struct {
         };
     }
     
+    /// 🆕 v0.2.0: 优化级别对应的新 Pass Manager 管道
+    pub fn getPassPipeline(self: *LLVMNativeBackend) [:0]const u8 {
+        return switch (self.opt_level) {
+            .O0 => "default<O0>",
+            .O1 => "default<O1>",
+            .O2 => "default<O2>",
+            .O3 => "default<O3>",
+        };
+    }
+    
+    /// 🆕 v0.2.0: 验证模块，然后在进程内运行 default<On> 管道
+    /// -O0 只做验证：保持 IR 与源码一一对应，便于调试
+    /// -O1 及以上会运行 mem2reg/SROA/inline 等，消除 generateFunction 的逐变量 alloca
+    pub fn optimize(self: *LLVMNativeBackend) !void {
+        const zone = prof.zone(self.profiler, "phase", "llvm-optimize");
+        defer zone.end();
+        
+        try self.module.verify();
+        
+        // 🆕 v0.2.0: 插桩在任何优化级别都要做
+        // --pgo-use 不在进程内优化：C API 只能通过进程级的 cl::opt 传入剖析数据路径，
+        // 在 pawc serve 中会跨请求累积。emitBitcode() 写出未优化的模块，
+        // 由 clang 带着 -fprofile-use 运行同一个 default<On> 管道（见 CBackend.linkObject）
+        const pgo_passes: []const u8 = switch (self.pgo) {
+            .none => "",
+            .generate => "pgo-instr-gen,instrprof,",
+            .use => return,
+        };
+        
+        if (self.opt_level == .O0 and pgo_passes.len == 0) return;
+        
+        var options = llvm.PassBuilderOptions.create();
+        defer options.dispose();
+        
+        // 与 clang 的默认行为保持一致：O2/O3 开启向量化和循环展开
+        const aggressive = self.opt_level == .O2 or self.opt_level == .O3;
+        options.setLoopVectorization(aggressive);
+        options.setSLPVectorization(aggressive);
+        options.setLoopUnrolling(aggressive);
+        options.setMergeFunctions(self.opt_level == .O3);
+        
+        const tm_ref: llvm.TargetMachineRef = if (self.target_machine) |tm| tm.ref else null;
+        // 插桩 / 读取剖析数据在未优化的 IR 上进行，两次构建看到的控制流图一致
+        const pipeline = try std.mem.concatWithSentinel(self.arenaAllocator(), u8, &.{ pgo_passes, self.getPassPipeline() }, 0);
+        try self.module.runPasses(pipeline, tm_ref, options);
+    }
+    
+    /// 🆕 v0.2.0: 优化级别对应的后端代码生成级别
+    fn toCodeGenOptLevel(level: OptLevel) llvm.CodeGenOptLevel {
+        return switch (level) {
+            .O0 => .None,
+            .O1 => .Less,
+            .O2 => .Default,
+            .O3 => .Aggressive,
+        };
+    }
+    
     // ============================================================================
     // 🆕 v0.1.7: Type Cast Support
     // ============================================================================
@@ -985,12 +2479,16 @@ pub const LLVMNativeBackend = struct {
         source_expr: *ast.Expr,
         target_type: ast.Type,
         target_llvm_type: llvm.TypeRef,
-    ) !llvm.ValueRef {
+    ) LowerError!llvm.ValueRef {
+        // 🆕 v0.2.0: `f as i64`：函数（或其它指针）取地址
+        if (llvm.typeKind(llvm.LLVMTypeOf(value)) == .Pointer and self.isIntType(target_type)) {
+            return self.builder.buildPtrToInt(value, target_llvm_type, "addr");
+        }
+
         // 获取源类型（简化：从表达式推断）
         const source_type = try self.inferExprType(source_expr.*);
         
-        const cast_name_z = try self.allocator.dupeZ(u8, "cast");
-        defer self.allocator.free(cast_name_z);
+        const cast_name_z: [:0]const u8 = "cast";
         
         // 判断源类型和目标类型的类别
         const is_source_int = self.isIntType(source_type);
@@ -1063,26 +2561,15 @@ pub const LLVMNativeBackend = struct {
         } else if (is_source_int and target_type == .char) {
             // 整数 -> char
             return self.builder.buildTrunc(value, target_llvm_type, cast_name_z);
+        } else if (target_type == .bool) {
+            // 🆕 v0.2.0: 数值 -> bool（非零为 true）
+            return self.toCondition(value);
         } else {
             // 未知转换，返回原值
             return value;
         }
     }
     
-    /// 推断表达式的类型（简化版）
-    fn inferExprType(self: *LLVMNativeBackend, expr: ast.Expr) !ast.Type {
-        _ = self;
-        return switch (expr) {
-            .int_literal => ast.Type.i32,
-            .float_literal => ast.Type.f64,
-            .bool_literal => ast.Type.bool,
-            .char_literal => ast.Type.char,
-            .string_literal => ast.Type.string,
-            .identifier => ast.Type.i32,  // 简化
-            else => ast.Type.i32,
-        };
-    }
-    
     /// 检查是否是整数类型
     fn isIntType(_: *LLVMNativeBackend, t: ast.Type) bool {
         return switch (t) {
@@ -1121,3 +2608,64 @@ pub const LLVMNativeBackend = struct {
     }
 };
 
+
+// ============================================================================
+// 🆕 v0.2.0: 类型和声明的辅助函数
+// ============================================================================
+
+fn isUnsignedType(t: ast.Type) bool {
+    return switch (t) {
+        .u8, .u16, .u32, .u64, .u128, .char => true,
+        else => false,
+    };
+}
+
+fn isFloatKind(ty: llvm.TypeRef) bool {
+    return switch (llvm.typeKind(ty)) {
+        .Half, .Float, .Double => true,
+        else => false,
+    };
+}
+
+/// 结构体 / 枚举类型的名字（不含类型实参）
+fn typeBaseName(t: ast.Type) ?[]const u8 {
+    return switch (t) {
+        .named => |name| name,
+        .generic_instance => |gi| gi.name,
+        else => null,
+    };
+}
+
+fn typeMethods(type_decl: ast.TypeDecl) []const ast.FunctionDecl {
+    return switch (type_decl.kind) {
+        .struct_type => |st| st.methods,
+        .enum_type => |et| et.methods,
+        .trait_type => &.{},
+    };
+}
+
+fn findMethod(type_decl: ast.TypeDecl, name: []const u8) ?ast.FunctionDecl {
+    for (typeMethods(type_decl)) |method| {
+        if (std.mem.eql(u8, method.name, name)) return method;
+    }
+    return null;
+}
+
+/// 第一个参数是 self 的方法按指针接收对象
+fn isReceiver(func: ast.FunctionDecl) bool {
+    return func.params.len > 0 and std.mem.eql(u8, func.params[0].name, "self");
+}
+
+fn fieldIndex(layout: StructLayout, name: []const u8) ?u32 {
+    for (layout.field_names, 0..) |field_name, i| {
+        if (std.mem.eql(u8, field_name, name)) return @intCast(i);
+    }
+    return null;
+}
+
+fn variantIndex(layout: EnumLayout, name: []const u8) ?u32 {
+    for (layout.variant_names, 0..) |variant_name, i| {
+        if (std.mem.eql(u8, variant_name, name)) return @intCast(i);
+    }
+    return null;
+}
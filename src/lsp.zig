@@ -0,0 +1,454 @@
+//! 🆕 v0.2.0: Language Server - 编辑器语言服务器（`pawc lsp`）
+//!
+//! 通过 stdio 实现 Language Server Protocol（JSON-RPC，Content-Length 分帧）的一个子集：
+//!   - initialize / initialized / shutdown / exit
+//!   - textDocument/didOpen、didChange（全量同步）、didSave、didClose
+//!   - textDocument/publishDiagnostics：每次打开 / 修改 / 保存后检查文档
+//!
+//! 与 pawc serve 一样，服务器进程常驻：prelude 只解析一次，被导入的模块缓存在
+//! ModuleLoader 中，每次检查前按 mtime / 大小淘汰改动过的文件。
+//! 被检查的是编辑器中的内存文本，不需要先保存。
+//!
+//! stdout 只用于协议消息；词法 / 语法分析器的提示仍然打印到 stderr（编辑器的输出面板）。
+
+const std = @import("std");
+const Lexer = @import("lexer.zig").Lexer;
+const Parser = @import("parser.zig").Parser;
+const TypeChecker = @import("typechecker.zig").TypeChecker;
+const ModuleLoader = @import("module.zig").ModuleLoader;
+const module_cache = @import("module_cache.zig");
+const Prelude = @import("prelude.zig").Prelude;
+const ast = @import("ast.zig");
+const diagnostic = @import("diagnostic.zig");
+const prof = @import("profiler.zig");
+
+/// 单条消息的大小上限
+const max_message_len = 64 << 20;
+
+// ============================================================================
+// 消息读写
+// ============================================================================
+
+/// 标准输入的缓冲读取
+const Input = struct {
+    file: std.fs.File,
+    buf: [4096]u8 = undefined,
+    start: usize = 0,
+    end: usize = 0,
+
+    fn fill(self: *Input) !bool {
+        if (self.start < self.end) return true;
+        self.start = 0;
+        self.end = try self.file.read(&self.buf);
+        return self.end > 0;
+    }
+
+    /// 读一行（去掉 "\r\n"）到 line；EOF 时返回 false
+    fn readLine(self: *Input, allocator: std.mem.Allocator, line: *std.ArrayList(u8)) !bool {
+        line.clearRetainingCapacity();
+        while (true) {
+            if (!try self.fill()) return false;
+            const available = self.buf[self.start..self.end];
+            if (std.mem.indexOfScalar(u8, available, '\n')) |i| {
+                try line.appendSlice(allocator, available[0..i]);
+                self.start += i + 1;
+                if (line.items.len > 0 and line.items[line.items.len - 1] == '\r') line.items.len -= 1;
+                return true;
+            }
+            try line.appendSlice(allocator, available);
+            self.start = self.end;
+        }
+    }
+
+    fn readExact(self: *Input, out: []u8) !void {
+        var offset: usize = 0;
+        while (offset < out.len) {
+            if (!try self.fill()) return error.EndOfStream;
+            const n = @min(out.len - offset, self.end - self.start);
+            @memcpy(out[offset..][0..n], self.buf[self.start..][0..n]);
+            self.start += n;
+            offset += n;
+        }
+    }
+};
+
+/// 读取一条消息的正文；EOF 时返回 null
+fn readMessage(allocator: std.mem.Allocator, input: *Input) !?[]u8 {
+    var line = std.ArrayList(u8){};
+    defer line.deinit(allocator);
+
+    var content_length: ?usize = null;
+    while (true) {
+        if (!try input.readLine(allocator, &line)) return null;
+        if (line.items.len == 0) break;  // 头部结束
+        const name = "Content-Length:";
+        if (std.ascii.startsWithIgnoreCase(line.items, name)) {
+            const value = std.mem.trim(u8, line.items[name.len..], " \t");
+            content_length = std.fmt.parseInt(usize, value, 10) catch return error.InvalidHeader;
+        }
+    }
+
+    const len = content_length orelse return error.InvalidHeader;
+    if (len > max_message_len) return error.MessageTooLarge;
+    const body = try allocator.alloc(u8, len);
+    errdefer allocator.free(body);
+    try input.readExact(body);
+    return body;
+}
+
+fn writeMessage(body: []const u8) !void {
+    const stdout = std.fs.File.stdout();
+    var header: [64]u8 = undefined;
+    try stdout.writeAll(try std.fmt.bufPrint(&header, "Content-Length: {d}\r\n\r\n", .{body.len}));
+    try stdout.writeAll(body);
+}
+
+/// 原样写回请求的 id（整数或字符串）
+fn writeId(buf: *std.ArrayList(u8), allocator: std.mem.Allocator, id: std.json.Value) !void {
+    switch (id) {
+        .integer => |n| try buf.print(allocator, "{d}", .{n}),
+        .string => |s| try prof.writeJsonString(buf, allocator, s),
+        else => try buf.appendSlice(allocator, "null"),
+    }
+}
+
+fn getObject(value: ?std.json.Value) ?std.json.ObjectMap {
+    const v = value orelse return null;
+    return switch (v) {
+        .object => |o| o,
+        else => null,
+    };
+}
+
+fn getString(object: ?std.json.ObjectMap, key: []const u8) ?[]const u8 {
+    const o = object orelse return null;
+    const v = o.get(key) orelse return null;
+    return switch (v) {
+        .string => |s| s,
+        else => null,
+    };
+}
+
+// ============================================================================
+// 服务器
+// ============================================================================
+
+/// LSP 的 DiagnosticSeverity
+fn severity(level: diagnostic.DiagnosticLevel) u8 {
+    return switch (level) {
+        .Error => 1,
+        .Warning => 2,
+        .Note => 3,
+        .Help => 4,
+    };
+}
+
+/// file:// URI → 文件路径（解码 %XX）
+fn uriToPath(allocator: std.mem.Allocator, uri: []const u8) ![]u8 {
+    const prefix = "file://";
+    const encoded = if (std.mem.startsWith(u8, uri, prefix)) uri[prefix.len..] else uri;
+
+    var path = std.ArrayList(u8){};
+    errdefer path.deinit(allocator);
+    var i: usize = 0;
+    while (i < encoded.len) : (i += 1) {
+        if (encoded[i] == '%' and i + 2 < encoded.len) {
+            if (std.fmt.parseInt(u8, encoded[i + 1 .. i + 3], 16)) |byte| {
+                try path.append(allocator, byte);
+                i += 2;
+                continue;
+            } else |_| {}
+        }
+        try path.append(allocator, encoded[i]);
+    }
+    return path.toOwnedSlice(allocator);
+}
+
+const Server = struct {
+    allocator: std.mem.Allocator,
+    version: []const u8,
+    prelude: *Prelude,
+    modules: ModuleLoader,
+    /// 打开的文档：uri → 当前文本
+    documents: std.StringHashMap([]u8),
+
+    fn init(allocator: std.mem.Allocator, version: []const u8) !Server {
+        const prelude = try Prelude.load(allocator);
+        var modules = ModuleLoader.init(allocator);
+        modules.enableCache(module_cache.default_dir, version);
+        return .{
+            .allocator = allocator,
+            .version = version,
+            .prelude = prelude,
+            .modules = modules,
+            .documents = std.StringHashMap([]u8).init(allocator),
+        };
+    }
+
+    fn deinit(self: *Server) void {
+        var it = self.documents.iterator();
+        while (it.next()) |entry| {
+            self.allocator.free(entry.key_ptr.*);
+            self.allocator.free(entry.value_ptr.*);
+        }
+        self.documents.deinit();
+        self.modules.deinit();
+        self.prelude.deinit();
+    }
+
+    /// 处理一条消息；返回 true 表示收到 exit
+    fn handle(self: *Server, message: std.json.Value) !bool {
+        const object = getObject(message) orelse return false;
+        const method = getString(object, "method") orelse return false;  // 客户端的响应，忽略
+        const id = object.get("id");
+        const params = getObject(object.get("params"));
+
+        if (std.mem.eql(u8, method, "initialize")) {
+            try self.respondInitialize(id orelse .null);
+        } else if (std.mem.eql(u8, method, "initialized")) {
+            // 通知，无需响应
+        } else if (std.mem.eql(u8, method, "shutdown")) {
+            try self.respondNull(id orelse .null);
+        } else if (std.mem.eql(u8, method, "exit")) {
+            return true;
+        } else if (std.mem.eql(u8, method, "textDocument/didOpen")) {
+            const document = getObject((params orelse return false).get("textDocument"));
+            const uri = getString(document, "uri") orelse return false;
+            const text = getString(document, "text") orelse return false;
+            try self.setDocument(uri, text);
+            try self.publish(uri);
+        } else if (std.mem.eql(u8, method, "textDocument/didChange")) {
+            const p = params orelse return false;
+            const uri = getString(getObject(p.get("textDocument")), "uri") orelse return false;
+            // 全量同步：最后一次变化就是完整的新文本
+            const changes = p.get("contentChanges") orelse return false;
+            if (changes != .array or changes.array.items.len == 0) return false;
+            const last = changes.array.items[changes.array.items.len - 1];
+            const text = getString(getObject(last), "text") orelse return false;
+            try self.setDocument(uri, text);
+            try self.publish(uri);
+        } else if (std.mem.eql(u8, method, "textDocument/didSave")) {
+            const uri = getString(getObject((params orelse return false).get("textDocument")), "uri") orelse return false;
+            try self.publish(uri);
+        } else if (std.mem.eql(u8, method, "textDocument/didClose")) {
+            const uri = getString(getObject((params orelse return false).get("textDocument")), "uri") orelse return false;
+            if (self.documents.fetchRemove(uri)) |entry| {
+                self.allocator.free(entry.key);
+                self.allocator.free(entry.value);
+            }
+            try self.publishEmpty(uri);
+        } else if (id) |request_id| {
+            try self.respondError(request_id, -32601, "method not found");
+        }
+        return false;
+    }
+
+    fn setDocument(self: *Server, uri: []const u8, text: []const u8) !void {
+        const copy = try self.allocator.dupe(u8, text);
+        errdefer self.allocator.free(copy);
+        const gop = try self.documents.getOrPut(uri);
+        if (gop.found_existing) {
+            self.allocator.free(gop.value_ptr.*);
+        } else {
+            gop.key_ptr.* = self.allocator.dupe(u8, uri) catch |err| {
+                self.documents.removeByPtr(gop.key_ptr);
+                return err;
+            };
+        }
+        gop.value_ptr.* = copy;
+    }
+
+    // ------------------------------------------------------------------------
+    // 响应
+    // ------------------------------------------------------------------------
+
+    fn respondInitialize(self: *Server, id: std.json.Value) !void {
+        var buf = std.ArrayList(u8){};
+        defer buf.deinit(self.allocator);
+        try buf.appendSlice(self.allocator, "{\"jsonrpc\":\"2.0\",\"id\":");
+        try writeId(&buf, self.allocator, id);
+        try buf.appendSlice(self.allocator,
+            \\,"result":{"capabilities":{"textDocumentSync":{"openClose":true,"change":1,"save":{"includeText":false}}},"serverInfo":{"name":"pawc","version":
+        );
+        try prof.writeJsonString(&buf, self.allocator, self.version);
+        try buf.appendSlice(self.allocator, "}}}");
+        try writeMessage(buf.items);
+    }
+
+    fn respondNull(self: *Server, id: std.json.Value) !void {
+        var buf = std.ArrayList(u8){};
+        defer buf.deinit(self.allocator);
+        try buf.appendSlice(self.allocator, "{\"jsonrpc\":\"2.0\",\"id\":");
+        try writeId(&buf, self.allocator, id);
+        try buf.appendSlice(self.allocator, ",\"result\":null}");
+        try writeMessage(buf.items);
+    }
+
+    fn respondError(self: *Server, id: std.json.Value, code: i32, message: []const u8) !void {
+        var buf = std.ArrayList(u8){};
+        defer buf.deinit(self.allocator);
+        try buf.appendSlice(self.allocator, "{\"jsonrpc\":\"2.0\",\"id\":");
+        try writeId(&buf, self.allocator, id);
+        try buf.print(self.allocator, ",\"error\":{{\"code\":{d},\"message\":", .{code});
+        try prof.writeJsonString(&buf, self.allocator, message);
+        try buf.appendSlice(self.allocator, "}}");
+        try writeMessage(buf.items);
+    }
+
+    fn beginPublish(self: *Server, buf: *std.ArrayList(u8), uri: []const u8) !void {
+        try buf.appendSlice(self.allocator, "{\"jsonrpc\":\"2.0\",\"method\":\"textDocument/publishDiagnostics\",\"params\":{\"uri\":");
+        try prof.writeJsonString(buf, self.allocator, uri);
+        try buf.appendSlice(self.allocator, ",\"diagnostics\":[");
+    }
+
+    fn publishEmpty(self: *Server, uri: []const u8) !void {
+        var buf = std.ArrayList(u8){};
+        defer buf.deinit(self.allocator);
+        try self.beginPublish(&buf, uri);
+        try buf.appendSlice(self.allocator, "]}}");
+        try writeMessage(buf.items);
+    }
+
+    /// 检查文档并发布诊断
+    fn publish(self: *Server, uri: []const u8) !void {
+        const text = self.documents.get(uri) orelse return;
+        const path = try uriToPath(self.allocator, uri);
+        defer self.allocator.free(path);
+
+        var buf = std.ArrayList(u8){};
+        defer buf.deinit(self.allocator);
+        try self.beginPublish(&buf, uri);
+        var out = DiagnosticWriter{ .buf = &buf, .allocator = self.allocator };
+        self.checkDocument(path, text, &out) catch |err| {
+            try out.add(1, 0, 0, 0, 1, @errorName(err));
+        };
+        try buf.appendSlice(self.allocator, "]}}");
+        try writeMessage(buf.items);
+    }
+
+    // ------------------------------------------------------------------------
+    // 检查
+    // ------------------------------------------------------------------------
+
+    /// 对内存中的文本执行词法、语法和类型检查，诊断写入 out
+    fn checkDocument(self: *Server, path: []const u8, text: []const u8, out: *DiagnosticWriter) !void {
+        const allocator = self.allocator;
+
+        var lexer = Lexer.init(allocator, text, path);
+        defer lexer.deinit();
+        const tokens = lexer.tokenize() catch |err| {
+            try out.add(1, 0, 0, 0, 1, @errorName(err));
+            return;
+        };
+
+        var parser = Parser.init(allocator, tokens);
+        defer parser.deinit();
+        try parser.addKnownTypes(self.prelude.type_names.items);
+        const program = parser.parse() catch |err| {
+            const message = try std.fmt.allocPrint(allocator, "syntax error: {s}", .{@errorName(err)});
+            defer allocator.free(message);
+            if (tokens.len == 0) {
+                try out.add(1, 0, 0, 0, 1, message);
+            } else {
+                const token = tokens[@min(parser.current, tokens.len - 1)];
+                const line = token.line -| 1;
+                const col = token.column -| 1;
+                try out.add(1, line, col, line, col + @max(token.lexeme.len, 1), message);
+            }
+            return;
+        };
+
+        // 与编译时相同：prelude 声明在前，随后是本文件和被导入的声明
+        self.modules.evictChanged() catch {};
+        var declarations = std.ArrayList(ast.TopLevelDecl){};
+        defer declarations.deinit(allocator);
+        try declarations.appendSlice(allocator, self.prelude.declarations);
+        try self.modules.resolveImports(program.declarations, &declarations);
+
+        var type_checker = TypeChecker.init(allocator, path, tokens);
+        defer type_checker.deinit();
+        type_checker.setInterner(&lexer.interner);
+        type_checker.setPrintDiagnostics(false);
+        // 编辑器中打开的文件可能是被导入的模块，不要求定义 main
+        type_checker.setRequireMain(false);
+        try type_checker.registerPrelude(self.prelude.declarations);
+        type_checker.check(.{ .declarations = declarations.items }) catch |err| switch (err) {
+            error.TypeCheckFailed => {},
+            else => return err,
+        };
+
+        for (type_checker.diagnostics.items) |diag| {
+            const message = try formatMessage(allocator, diag);
+            defer allocator.free(message);
+            if (diag.span) |span| {
+                // 被导入模块中的诊断不属于这个文档
+                if (!std.mem.eql(u8, span.filename, path)) continue;
+                const line = span.start_line -| 1;
+                const col = span.start_col -| 1;
+                const end_line = @max(span.end_line -| 1, line);
+                var end_col = span.end_col -| 1;
+                if (end_line == line and end_col <= col) end_col = col + 1;
+                try out.add(severity(diag.level), line, col, end_line, end_col, message);
+            } else {
+                try out.add(severity(diag.level), 0, 0, 0, 1, message);
+            }
+        }
+        // 兼容：旧的简单错误没有位置信息
+        for (type_checker.errors.items) |message| {
+            try out.add(1, 0, 0, 0, 1, message);
+        }
+    }
+};
+
+/// 把 note / help 附在消息后面（LSP 诊断只有一个 message 字段）
+fn formatMessage(allocator: std.mem.Allocator, diag: diagnostic.Diagnostic) ![]u8 {
+    var message = std.ArrayList(u8){};
+    errdefer message.deinit(allocator);
+    try message.appendSlice(allocator, diag.message);
+    for (diag.notes) |note| try message.print(allocator, "\nnote: {s}", .{note});
+    if (diag.help) |help| try message.print(allocator, "\nhelp: {s}", .{help});
+    return message.toOwnedSlice(allocator);
+}
+
+/// 以 JSON 数组元素的形式追加诊断
+const DiagnosticWriter = struct {
+    buf: *std.ArrayList(u8),
+    allocator: std.mem.Allocator,
+    count: usize = 0,
+
+    fn add(self: *DiagnosticWriter, level: u8, line: usize, col: usize, end_line: usize, end_col: usize, message: []const u8) !void {
+        if (self.count > 0) try self.buf.append(self.allocator, ',');
+        self.count += 1;
+        try self.buf.print(
+            self.allocator,
+            "{{\"range\":{{\"start\":{{\"line\":{d},\"character\":{d}}},\"end\":{{\"line\":{d},\"character\":{d}}}}},\"severity\":{d},\"source\":\"pawc\",\"message\":",
+            .{ line, col, end_line, end_col, level },
+        );
+        try prof.writeJsonString(self.buf, self.allocator, message);
+        try self.buf.append(self.allocator, '}');
+    }
+};
+
+// ============================================================================
+// 入口
+// ============================================================================
+
+/// pawc lsp：处理 stdin 上的消息，直到收到 exit 或 stdin 关闭
+pub fn run(allocator: std.mem.Allocator, version: []const u8) !void {
+    var server = try Server.init(allocator, version);
+    defer server.deinit();
+
+    var input = Input{ .file = std.fs.File.stdin() };
+    while (true) {
+        const body = (try readMessage(allocator, &input)) orelse return;
+        defer allocator.free(body);
+
+        const parsed = std.json.parseFromSlice(std.json.Value, allocator, body, .{}) catch |err| {
+            std.debug.print("pawc lsp: invalid message: {any}\n", .{err});
+            continue;
+        };
+        defer parsed.deinit();
+
+        if (try server.handle(parsed.value)) return;
+    }
+}
@@ -3,10 +3,22 @@ const Lexer = @import("lexer.zig").Lexer;
 const Parser = @import("parser.zig").Parser;
 const TypeChecker = @import("typechecker.zig").TypeChecker;
 const CodeGen = @import("codegen.zig").CodeGen;
-const CBackend = @import("c_backend.zig").CBackend;
+const CodeGenUnits = @import("codegen.zig").Units;  // 🆕 v0.2.0
+const c_backend_mod = @import("c_backend.zig");  // 🆕 v0.2.0
+const CBackend = c_backend_mod.CBackend;
 const ModuleLoader = @import("module.zig").ModuleLoader;
+const module_cache = @import("module_cache.zig");  // 🆕 v0.2.0
 const ast_mod = @import("ast.zig");
 const REPL = @import("repl.zig").REPL;  // 🆕 v0.1.9
+const Prelude = @import("prelude.zig").Prelude;  // 🆕 v0.2.0
+const SourceMap = @import("source_map.zig").SourceMap;  // 🆕 v0.2.0
+const prof = @import("profiler.zig");  // 🆕 v0.2.0
+const bench = @import("bench.zig");  // 🆕 v0.2.0
+const incremental = @import("incremental.zig");  // 🆕 v0.2.0
+const pgo = @import("pgo.zig");  // 🆕 v0.2.0
+const server = @import("server.zig");  // 🆕 v0.2.0
+const optimizer = @import("optimizer.zig");  // 🆕 v0.2.0
+const lsp = @import("lsp.zig");  // 🆕 v0.2.0
 
 const builtin = @import("builtin");
 const build_options = @import("build_options");
@@ -19,53 +31,91 @@ const llvm_backend = if (llvm_available) @import("llvm_native_backend.zig") else
 };
 const LLVMNativeBackend = llvm_backend.LLVMNativeBackend;
 const LLVMOptLevel = llvm_backend.OptLevel; // 🆕 v0.1.7
+const jit = if (llvm_available) @import("jit.zig") else struct {};  // 🆕 v0.2.0: ORC JIT
+
+// 🆕 v0.2.0: 把运行时库编进 pawc 并导出（build.zig 中 rdynamic），
+// JIT 执行的代码调用 paw_malloc / paw_arena_* 等函数时从 pawc 进程中解析
+comptime {
+    _ = @import("builtin/mod.zig");
+}
 
 const VERSION = "0.1.9-dev";
 
+// 🆕 v0.2.0: LLVM 后端直接生成的目标文件扩展名
+const object_ext = if (builtin.os.tag == .windows) ".obj" else ".o";
+
 // 🆕 v0.1.9: 编译时间分析
 const CompilationTimer = struct {
-    total_start: i64,
-    lexer_time: i64 = 0,
-    parser_time: i64 = 0,
-    typecheck_time: i64 = 0,
-    codegen_time: i64 = 0,
+    // 🆕 v0.2.0: 纳秒精度（毫秒精度下不足 1ms 的阶段都显示为 0）
+    total_start: i128,
+    lexer_time: i128 = 0,
+    parser_time: i128 = 0,
+    module_time: i128 = 0,
+    typecheck_time: i128 = 0,
+    codegen_time: i128 = 0,
     
     pub fn init() CompilationTimer {
         return CompilationTimer{
-            .total_start = std.time.milliTimestamp(),
+            .total_start = std.time.nanoTimestamp(),
         };
     }
     
+    fn printRow(label: []const u8, phase_ns: i128, total_ns: i128) void {
+        std.debug.print("│  {s:<12}{d:>9.3}ms  ({d:>5.1}%) │\n", .{
+            label,
+            @as(f64, @floatFromInt(phase_ns)) / 1_000_000.0,
+            @as(f64, @floatFromInt(phase_ns)) / @as(f64, @floatFromInt(@max(total_ns, 1))) * 100.0,
+        });
+    }
+    
     pub fn printStats(self: CompilationTimer) void {
-        const total_time = std.time.milliTimestamp() - self.total_start;
+        const total_time = std.time.nanoTimestamp() - self.total_start;
         
         std.debug.print("\n", .{});
         std.debug.print("╭─────────────────────────────────────╮\n", .{});
         std.debug.print("│  ⏱️  Compilation Time Analysis      │\n", .{});
         std.debug.print("├─────────────────────────────────────┤\n", .{});
-        std.debug.print("│  Lexer:        {d:>6}ms  ({d:>5.1}%)  │\n", .{
-            self.lexer_time,
-            @as(f64, @floatFromInt(self.lexer_time)) / @as(f64, @floatFromInt(total_time)) * 100.0,
-        });
-        std.debug.print("│  Parser:       {d:>6}ms  ({d:>5.1}%)  │\n", .{
-            self.parser_time,
-            @as(f64, @floatFromInt(self.parser_time)) / @as(f64, @floatFromInt(total_time)) * 100.0,
-        });
-        std.debug.print("│  Type Check:   {d:>6}ms  ({d:>5.1}%)  │\n", .{
-            self.typecheck_time,
-            @as(f64, @floatFromInt(self.typecheck_time)) / @as(f64, @floatFromInt(total_time)) * 100.0,
-        });
-        std.debug.print("│  Code Gen:     {d:>6}ms  ({d:>5.1}%)  │\n", .{
-            self.codegen_time,
-            @as(f64, @floatFromInt(self.codegen_time)) / @as(f64, @floatFromInt(total_time)) * 100.0,
-        });
+        printRow("Lexer:", self.lexer_time, total_time);
+        printRow("Parser:", self.parser_time, total_time);
+        printRow("Modules:", self.module_time, total_time);
+        printRow("Type Check:", self.typecheck_time, total_time);
+        printRow("Code Gen:", self.codegen_time, total_time);
         std.debug.print("├─────────────────────────────────────┤\n", .{});
-        std.debug.print("│  Total:        {d:>6}ms  (100.0%)  │\n", .{total_time});
+        std.debug.print("│  Total:      {d:>9.3}ms  (100.0%) │\n", .{
+            @as(f64, @floatFromInt(total_time)) / 1_000_000.0,
+        });
         std.debug.print("╰─────────────────────────────────────╯\n", .{});
         std.debug.print("\n", .{});
     }
 };
 
+/// 🆕 v0.1.7: 命令行优化级别 -> LLVM 后端优化级别，默认 O0
+fn toLLVMOptLevel(opt_level: ?OptLevel) LLVMOptLevel {
+    return if (opt_level) |level| switch (level) {
+        .O0 => .O0,
+        .O1 => .O1,
+        .O2 => .O2,
+        .O3 => .O3,
+    } else .O0;
+}
+
+/// 🆕 v0.2.0: 优化级别对应的 clang 参数（LLVM 后端 --pgo-use 的 bitcode 由 clang 优化）
+fn clangOptFlag(opt_level: ?OptLevel) []const u8 {
+    return if (opt_level) |level| switch (level) {
+        .O0 => "-O0",
+        .O1 => "-O1",
+        .O2 => "-O2",
+        .O3 => "-O3",
+    } else "-O0";
+}
+
+/// 🆕 v0.2.0: --pgo-generate=<dir> / --pgo-use=<path> 的值；不带 = 时返回 null（使用默认目录）
+fn pgoArgument(arg: []const u8) ?[]const u8 {
+    const eq = std.mem.indexOfScalar(u8, arg, '=') orelse return null;
+    if (eq + 1 == arg.len) return null;
+    return arg[eq + 1 ..];
+}
+
 // 🆕 v0.1.4: Simplified backend selection
 const Backend = enum {
     c,      // C backend (default, stable)
@@ -89,33 +139,38 @@ const OptLevel = enum {
 };
 
 // 🆕 check command: type checking only
-fn checkFile(allocator: std.mem.Allocator, source_file: []const u8) !void {
+fn checkFile(allocator: std.mem.Allocator, source_file: []const u8, resident: server.Resident) !void {
     std.debug.print("🔍 Checking: {s}\n", .{source_file});
     
-    const source = std.fs.cwd().readFileAlloc(allocator, source_file, 1024 * 1024) catch |err| {
+    // 🆕 v0.2.0: 源文件映射到内存（无大小上限），诊断共享同一份映射
+    var sources = SourceMap.init(allocator);
+    defer sources.deinit();
+    const source = (sources.open(source_file) catch |err| {
         std.debug.print("Error: Cannot read file {s}: {any}\n", .{source_file, err});
         return;
-    };
-    defer allocator.free(source);
+    }).bytes;
     
-    // Load standard library
-    const prelude_source = @embedFile("prelude/prelude.paw");
-    const combined_source = try std.fmt.allocPrint(allocator, "{s}\n\n{s}", .{prelude_source, source});
-    defer allocator.free(combined_source);
+    // Load standard library (🆕 v0.2.0: 单独解析，不再拼接源码；pawc serve 中常驻)
+    const prelude = resident.prelude orelse try Prelude.load(allocator);
+    defer if (resident.prelude == null) prelude.deinit();
     
     // Lexical analysis
-    var lexer = Lexer.init(allocator, combined_source, source_file);
+    var lexer = Lexer.init(allocator, source, source_file);
     defer lexer.deinit();
     const tokens = try lexer.tokenize();
     
     // Parsing
     var parser = Parser.init(allocator, tokens);
     defer parser.deinit();
+    try parser.addKnownTypes(prelude.type_names.items);
     const ast = try parser.parse();
     
     // Type checking
     var type_checker = TypeChecker.init(allocator, source_file, tokens);
     defer type_checker.deinit();
+    type_checker.setInterner(&lexer.interner);  // 🆕 v0.2.0
+    type_checker.setSourceMap(&sources);  // 🆕 v0.2.0
+    try type_checker.registerPrelude(prelude.declarations);
     try type_checker.check(ast);
     
     std.debug.print("✅ Type checking passed!\n", .{});
@@ -162,11 +217,30 @@ fn initProject(allocator: std.mem.Allocator, project_name: []const u8) !void {
 pub fn main() !void {
     var gpa = std.heap.GeneralPurposeAllocator(.{}){};
     defer _ = gpa.deinit();
-    const allocator = gpa.allocator();
+    // 🆕 v0.2.0: 统计分配次数/字节数（--time-report 输出）
+    var counting = prof.CountingAllocator.init(gpa.allocator());
+    const allocator = counting.allocator();
 
     const args = try std.process.argsAlloc(allocator);
     defer std.process.argsFree(allocator, args);
 
+    // 🆕 v0.2.0: PAWC_SERVER 指向正在运行的 pawc serve 时，命令交给服务器执行
+    if (server.forward(allocator, args)) |exit_code| {
+        if (exit_code != 0) std.process.exit(exit_code);
+        return;
+    }
+
+    try run(allocator, &counting, args, .{});
+}
+
+/// 🆕 v0.2.0: 执行一条 pawc 命令（args[0] 是程序名）
+/// pawc serve 对每个请求调用它，resident 提供常驻的 prelude、模块表和 C 编译器检测结果
+fn run(
+    allocator: std.mem.Allocator,
+    counting: *prof.CountingAllocator,
+    args: []const [:0]u8,
+    resident: server.Resident,
+) anyerror!void {
     if (args.len < 2) {
         printUsage();
         return;
@@ -193,7 +267,7 @@ pub fn main() !void {
             std.debug.print("Usage: pawc check <file.paw>\n", .{});
             return;
         }
-        try checkFile(allocator, args[2]);
+        try checkFile(allocator, args[2], resident);
         return;
     }
 
@@ -208,6 +282,24 @@ pub fn main() !void {
         return;
     }
     
+    // 🆕 v0.2.0: Handle bench command
+    if (std.mem.eql(u8, args[1], "bench")) {
+        try bench.run(allocator, args[2..], llvm_available);
+        return;
+    }
+    
+    // 🆕 v0.2.0: Handle serve command（常驻编译服务）
+    if (std.mem.eql(u8, args[1], "serve")) {
+        try server.serve(allocator, counting, args[2..], .{ .version = VERSION, .run = run });
+        return;
+    }
+    
+    // 🆕 v0.2.0: Handle lsp command（编辑器语言服务器，stdio）
+    if (std.mem.eql(u8, args[1], "lsp")) {
+        try lsp.run(allocator, VERSION);
+        return;
+    }
+    
     // 🆕 v0.1.9: Handle repl command
     if (std.mem.eql(u8, args[1], "repl")) {
         var repl = REPL.init(allocator);
@@ -225,6 +317,13 @@ pub fn main() !void {
     var backend: ?Backend = null;     // 🆕 v0.1.8: 后端选择，null = 自动检测
     var opt_level: ?OptLevel = null;  // 🆕 v0.1.7: LLVM 优化级别
     var show_timing = false;          // 🆕 v0.1.9: 显示编译时间分析
+    var use_cache = true;             // 🆕 v0.2.0: 模块 AST 缓存
+    var ast_opt = true;               // 🆕 v0.2.0: 后端无关的内联 / 常量折叠 / 删除未使用的 prelude
+    var jobs: ?usize = null;          // 🆕 v0.2.0: 并行类型检查线程数，null = CPU 核数
+    var time_report: ?prof.Format = null;  // 🆕 v0.2.0: 机器可读的耗时报告
+    var debug_info = false;           // 🆕 v0.2.0: -g 调试信息（#line / DWARF / JIT perf map）
+    var frame_pointers = false;       // 🆕 v0.2.0: 保留帧指针
+    var pgo_mode: pgo.Mode = .none;   // 🆕 v0.2.0: --pgo-generate / --pgo-use
 
     // 解析命令行选项
     var i: usize = 2;
@@ -237,8 +336,41 @@ pub fn main() !void {
             optimize = true;
         } else if (std.mem.eql(u8, arg, "-v")) {
             verbose = true;
+        } else if (std.mem.eql(u8, arg, "-g")) {
+            debug_info = true;  // 🆕 v0.2.0
+        } else if (std.mem.eql(u8, arg, "--frame-pointers")) {
+            frame_pointers = true;  // 🆕 v0.2.0
+        } else if (std.mem.eql(u8, arg, "--pgo-generate") or std.mem.startsWith(u8, arg, "--pgo-generate=")) {
+            // 🆕 v0.2.0: --pgo-generate[=dir]，默认写到 paw-pgo/
+            pgo_mode = .{ .generate = pgoArgument(arg) orelse pgo.default_dir };
+        } else if (std.mem.eql(u8, arg, "--pgo-use") or std.mem.startsWith(u8, arg, "--pgo-use=")) {
+            // 🆕 v0.2.0: --pgo-use[=dir|file.profdata]
+            pgo_mode = .{ .use = pgoArgument(arg) orelse pgo.default_dir };
         } else if (std.mem.eql(u8, arg, "--time")) {
             show_timing = true;  // 🆕 v0.1.9: 显示编译时间分析
+        } else if (std.mem.startsWith(u8, arg, "--time-report=")) {
+            // 🆕 v0.2.0: --time-report=json | --time-report=chrome
+            time_report = prof.Format.fromString(arg["--time-report=".len..]) orelse {
+                std.debug.print("❌ Error: invalid value for --time-report: {s} (expected json or chrome)\n", .{arg});
+                return;
+            };
+        } else if (std.mem.eql(u8, arg, "--no-cache")) {
+            use_cache = false;  // 🆕 v0.2.0: 禁用模块 AST 缓存
+        } else if (std.mem.eql(u8, arg, "--no-ast-opt")) {
+            ast_opt = false;  // 🆕 v0.2.0: 后端直接使用类型检查过的 AST
+        } else if (std.mem.startsWith(u8, arg, "--jobs=")) {
+            // 🆕 v0.2.0: 并行类型检查线程数 / C 翻译单元数（--jobs=1 为串行）
+            jobs = std.fmt.parseInt(usize, arg["--jobs=".len..], 10) catch {
+                std.debug.print("❌ Error: invalid value for --jobs: {s}\n", .{arg});
+                return;
+            };
+        } else if (std.mem.eql(u8, arg, "-j") and i + 1 < args.len) {
+            // 🆕 v0.2.0: -j <n> 等同于 --jobs=<n>
+            i += 1;
+            jobs = std.fmt.parseInt(usize, args[i], 10) catch {
+                std.debug.print("❌ Error: invalid value for -j: {s}\n", .{args[i]});
+                return;
+            };
         } else if (std.mem.eql(u8, arg, "--run")) {
             should_run = true;
             should_compile = true;
@@ -288,9 +420,23 @@ pub fn main() !void {
         std.debug.print("💡 Tip: Remove optimization flag or use --backend=llvm\n", .{});
     }
 
+    // 🆕 v0.2.0: PGO 需要真正的可执行文件（插桩程序退出时写剖析数据）
+    if (pgo_mode != .none and !should_compile) {
+        std.debug.print("⚠️  Warning: --pgo-generate/--pgo-use only apply to --compile/--run builds\n", .{});
+    }
+
+    // 🆕 v0.2.0: 细粒度编译分析（阶段 / 模块 / 函数），编译结束（包括失败）时写出报告
+    // 分析器自身的内存不经过 CountingAllocator，避免干扰统计
+    var profiler = prof.Profiler.init(counting.child, counting);
+    defer profiler.deinit();
+    const profiler_ptr: ?*prof.Profiler = if (time_report != null) &profiler else null;
+    defer if (time_report) |format| writeTimeReport(allocator, &profiler, format, output_file orelse "output");
+    
     // 读取源文件
-    const source = try std.fs.cwd().readFileAlloc(allocator, source_file, 10 * 1024 * 1024);
-    defer allocator.free(source);
+    // 🆕 v0.2.0: 源文件映射到内存（无大小上限），Lexer、模块加载和诊断共享同一份映射
+    var sources = SourceMap.init(allocator);
+    defer sources.deinit();
+    const source = (try sources.open(source_file)).bytes;
 
     if (verbose) {
         std.debug.print("Compiling: {s}\n", .{source_file});
@@ -299,32 +445,27 @@ pub fn main() !void {
     // 编译流程
     const start_time = std.time.nanoTimestamp();
 
-    // 🆕 0. 自动加载标准库 prelude（嵌入到可执行文件中）
-    const prelude_source = @embedFile("prelude/prelude.paw");
-    
-    // 🆕 v0.1.8: 计算 prelude 行数用于行号偏移
-    var prelude_lines: usize = 0;
-    for (prelude_source) |c| {
-        if (c == '\n') prelude_lines += 1;
-    }
-    prelude_lines += 2;  // 加上分隔的两个换行符
-    
-    // 合并 prelude 和用户代码
-    const combined_source = try std.fmt.allocPrint(allocator, "{s}\n\n{s}", .{prelude_source, source});
-    defer allocator.free(combined_source);
-    
     // 🆕 v0.1.9: 初始化编译时间分析器
     var timer = if (show_timing) CompilationTimer.init() else undefined;
     
+    // 🆕 0. 自动加载标准库 prelude（嵌入到可执行文件中）
+    // 🆕 v0.2.0: prelude 单独解析一次，用户源码不再与其拼接，行号也无需偏移
+    // 🆕 v0.2.0: pawc serve 中 prelude 常驻，只在服务启动时解析一次
+    const prelude_zone = prof.zone(profiler_ptr, "phase", "prelude");
+    const prelude = resident.prelude orelse try Prelude.load(allocator);
+    defer if (resident.prelude == null) prelude.deinit();
+    prelude_zone.end();
+    
     // 1. Lexical analysis
-    const lexer_start = std.time.milliTimestamp();
-    var lexer = Lexer.init(allocator, combined_source, source_file);
-    lexer.setLineOffset(prelude_lines);  // 🆕 v0.1.8: 设置行号偏移
+    const lexer_start = std.time.nanoTimestamp();
+    const lexer_zone = prof.zone(profiler_ptr, "phase", "lexer");
+    var lexer = Lexer.init(allocator, source, source_file);
     defer lexer.deinit();
     
     const tokens = try lexer.tokenize();
+    lexer_zone.end();
     if (show_timing) {
-        timer.lexer_time = std.time.milliTimestamp() - lexer_start;
+        timer.lexer_time = std.time.nanoTimestamp() - lexer_start;
     }
     if (verbose) {
         const lex_time = std.time.nanoTimestamp();
@@ -332,13 +473,16 @@ pub fn main() !void {
     }
 
     // 2. Parsing
-    const parser_start = std.time.milliTimestamp();
+    const parser_start = std.time.nanoTimestamp();
+    const parser_zone = prof.zone(profiler_ptr, "phase", "parser");
     var parser = Parser.init(allocator, tokens);
     defer parser.deinit();  // 这会自动释放所有 AST 内存（通过 arena）
+    try parser.addKnownTypes(prelude.type_names.items);  // 🆕 v0.2.0: prelude 中的类型名
     
     const ast_result = try parser.parse();
+    parser_zone.end();
     if (show_timing) {
-        timer.parser_time = std.time.milliTimestamp() - parser_start;
+        timer.parser_time = std.time.nanoTimestamp() - parser_start;
     }
     // 注意: ast_result 的内存由 parser.arena 管理，不需要单独 deinit
     // AST 会在 parser.deinit() 时自动释放
@@ -349,52 +493,29 @@ pub fn main() !void {
     }
 
     // 2.5. 🆕 处理导入（模块系统）
-    var module_loader = ModuleLoader.init(allocator);
-    defer module_loader.deinit();
+    // 🆕 v0.2.0: pawc serve 中使用常驻的模块表（未改变的模块跨请求复用）
+    const module_start = std.time.nanoTimestamp();
+    const module_zone = prof.zone(profiler_ptr, "phase", "modules");
+    var local_loader = ModuleLoader.init(allocator);
+    defer local_loader.deinit();
+    const module_loader = if (use_cache) resident.modules orelse &local_loader else &local_loader;
+    if (module_loader == &local_loader) {
+        local_loader.setSourceMap(&sources);  // 🆕 v0.2.0
+        if (use_cache) {
+            local_loader.enableCache(module_cache.default_dir, VERSION);  // 🆕 v0.2.0
+        }
+    }
+    if (profiler_ptr) |p| module_loader.setProfiler(p);  // 🆕 v0.2.0
+    defer module_loader.profiler = null;
     
     var resolved_declarations = std.ArrayList(ast_mod.TopLevelDecl){};
     defer resolved_declarations.deinit(allocator);
     
-    for (ast_result.declarations) |decl| {
-        if (decl == .import_decl) {
-            const import_decl = decl.import_decl;
-            
-            // 🆕 处理单项或多项导入
-            switch (import_decl.items) {
-                .single => |item_name| {
-                    // 单项导入：import math.add;
-                    const imported_item = module_loader.getImportedItem(
-                        import_decl.module_path,
-                        item_name,
-                    ) catch |err| {
-                        std.debug.print("Error: Failed to import {s}.{s}: {any}\n", 
-                            .{import_decl.module_path, item_name, err});
-                        continue;
-                    };
-                    try resolved_declarations.append(allocator, imported_item);
-                },
-                .multiple => |item_names| {
-                    // 多项导入：import math.{add, sub, Vec2};
-                    for (item_names) |item_name| {
-                        const imported_item = module_loader.getImportedItem(
-                            import_decl.module_path,
-                            item_name,
-                        ) catch |err| {
-                            std.debug.print("Error: Failed to import {s}.{s}: {any}\n", 
-                                .{import_decl.module_path, item_name, err});
-                            continue;
-                        };
-                        try resolved_declarations.append(allocator, imported_item);
-                    }
-                },
-            }
-            
-            // 注意：module_path会在ast_result.deinit()中释放，这里不释放
-        } else {
-            // 非import声明，直接添加
-            try resolved_declarations.append(allocator, decl);
-        }
-    }
+    // 🆕 v0.2.0: prelude 声明放在最前面（与之前拼接源码时的顺序一致）
+    try resolved_declarations.appendSlice(allocator, prelude.declarations);
+    
+    // 🆕 v0.2.0: 先收集所有被导入的模块，在线程池中并行加载和解析
+    try module_loader.resolveImports(ast_result.declarations, &resolved_declarations);
     
     // 创建新的AST（包含导入的声明）
     const ast = ast_mod.Program{
@@ -412,26 +533,122 @@ pub fn main() !void {
     }
 
     // 3. Type checking
-    const typecheck_start = std.time.milliTimestamp();
+    module_zone.end();
+    if (show_timing) {
+        timer.module_time = std.time.nanoTimestamp() - module_start;
+    }
+    
+    const typecheck_start = std.time.nanoTimestamp();
+    const typecheck_zone = prof.zone(profiler_ptr, "phase", "typecheck");
     var type_checker = TypeChecker.init(allocator, source_file, tokens);
     defer type_checker.deinit();
+    type_checker.setInterner(&lexer.interner);  // 🆕 v0.2.0
+    type_checker.setSourceMap(&sources);  // 🆕 v0.2.0
+    if (profiler_ptr) |p| type_checker.setProfiler(p);  // 🆕 v0.2.0
     
-    try type_checker.check(ast);
+    // 🆕 v0.2.0: 函数体并行检查，诊断按源码顺序输出
+    type_checker.setJobs(jobs orelse (std.Thread.getCpuCount() catch 1));
+    
+    // 🆕 v0.2.0: prelude 只登记符号表，只检查用户代码（以及导入的声明）
+    try type_checker.registerPrelude(prelude.declarations);
+    const checked_program = ast_mod.Program{
+        .declarations = ast.declarations[prelude.declarations.len..],
+    };
+    
+    // 🆕 v0.2.0: 增量编译：跳过自上次成功编译后未变化（且依赖也未变化）的声明
+    var tracker: ?incremental.Tracker = null;
+    defer if (tracker) |*t| t.deinit();
+    var decl_graph: ?incremental.Graph = null;
+    defer if (decl_graph) |*g| g.deinit();
+    var clean_decls = std.StringHashMap(void).init(allocator);
+    defer clean_decls.deinit();
+    if (use_cache) {
+        tracker = try incremental.Tracker.init(allocator, module_cache.default_dir, VERSION, source_file);
+        decl_graph = try incremental.Graph.build(allocator, checked_program.declarations);
+        try tracker.?.collectClean(&decl_graph.?, &clean_decls);
+        type_checker.setCleanDecls(&clean_decls);
+        if (verbose) {
+            const total = decl_graph.?.decls.items.len;
+            std.debug.print("[INCR] {d}/{d} declarations unchanged, re-checking {d}\n", .{
+                clean_decls.count(), total, total - clean_decls.count(),
+            });
+        }
+    }
+    
+    try type_checker.check(checked_program);
+    if (tracker) |*t| t.save(&decl_graph.?);
+    typecheck_zone.end();
     if (show_timing) {
-        timer.typecheck_time = std.time.milliTimestamp() - typecheck_start;
+        timer.typecheck_time = std.time.nanoTimestamp() - typecheck_start;
     }
     if (verbose) {
         const typecheck_time = std.time.nanoTimestamp();
         std.debug.print("[PERF] Type checking: {d}μs\n", .{@divTrunc(typecheck_time - start_time, 1000)});
     }
 
+    // 🆕 v0.2.0: 后端无关的优化，C / LLVM / JIT 使用同一份优化后的程序
+    var ast_optimizer = optimizer.Optimizer.init(allocator);
+    defer ast_optimizer.deinit();
+    const program = if (ast_opt) blk: {
+        const optimize_zone = prof.zone(profiler_ptr, "phase", "optimize");
+        defer optimize_zone.end();
+        const optimized = try ast_optimizer.optimize(ast, prelude.declarations.len);
+        if (verbose) {
+            const stats = ast_optimizer.stats;
+            std.debug.print("[OPT] inlined {d} calls, folded {d} constants, removed {d} unused prelude declarations\n", .{
+                stats.inlined, stats.folded, stats.removed,
+            });
+        }
+        break :blk optimized;
+    } else ast;
+
+    // 🆕 v0.2.0: LLVM 后端 + --run：在进程内通过 ORC LLJIT 编译并执行，
+    // 不写目标文件、不调用外部链接器、不启动子进程
+    // 🆕 v0.2.0: PGO 构建仍然链接成可执行文件再运行
+    if (llvm_available and selected_backend == .llvm and should_run and pgo_mode == .none) {
+        if (verbose) {
+            std.debug.print("[INFO] Running {s} in the LLVM JIT\n", .{source_file});
+        }
+        const jit_start = std.time.nanoTimestamp();
+        const exit_code = jit.runMain(allocator, program, toLLVMOptLevel(opt_level), profiler_ptr, .{
+            .perf_map = debug_info,
+            .frame_pointers = frame_pointers,
+        }) catch |err| {
+            std.debug.print("❌ JIT execution failed: {}\n", .{err});
+            return;
+        };
+        if (show_timing) {
+            timer.codegen_time = std.time.nanoTimestamp() - jit_start;
+            timer.printStats();
+        }
+        if (verbose) {
+            std.debug.print("Exit code: {d}\n", .{exit_code});
+        }
+        return;
+    }
+
         // 4. Code generation - 🆕 v0.1.4: 双后端架构 (C + LLVM Native)
-        const codegen_start = std.time.milliTimestamp();
+        const codegen_start = std.time.nanoTimestamp();
+        const codegen_zone = prof.zone(profiler_ptr, "phase", "codegen");
+        // 🆕 v0.2.0: 编译为可执行文件时，C 代码按函数分片，由 C 后端并行编译
+        const job_count = jobs orelse (std.Thread.getCpuCount() catch 1);
+        var c_units: ?CodeGenUnits = null;
+        defer if (c_units) |*units| units.deinit();
+        var pgo_profile: ?[]u8 = null;  // 🆕 v0.2.0: --pgo-use 解析出的 .profdata（链接时交给 clang）
+        defer if (pgo_profile) |path| allocator.free(path);
+        var llvm_object: ?[]u8 = null;  // 🆕 v0.2.0: LLVM 后端 --compile/--run 生成的目标文件路径
+        defer if (llvm_object) |path| allocator.free(path);
         const output_code = switch (selected_backend) {
             .c => blk: {
                 var codegen = CodeGen.init(allocator);
                 defer codegen.deinit();
-                break :blk try codegen.generate(ast);
+                codegen.profiler = profiler_ptr;  // 🆕 v0.2.0
+                codegen.debug_info = debug_info;  // 🆕 v0.2.0
+                if (should_compile) {
+                    c_units = try codegen.generateUnits(program, job_count);
+                    break :blk try c_units.?.join(allocator);
+                }
+                break :blk try codegen.generate(program);
             },
             .llvm => blk: {
                 if (!llvm_available) {
@@ -444,22 +661,47 @@ pub fn main() !void {
                     std.debug.print("[INFO] Using LLVM native backend\n", .{});
                 }
                 // 🆕 v0.1.7: 传递优化级别，默认 O0
-                const llvm_opt_level: LLVMOptLevel = if (opt_level) |level| switch (level) {
-                    .O0 => .O0,
-                    .O1 => .O1,
-                    .O2 => .O2,
-                    .O3 => .O3,
-                } else .O0;
+                const llvm_opt_level = toLLVMOptLevel(opt_level);
                 
                 var llvm_native = try LLVMNativeBackend.init(allocator, "pawlang_module", llvm_opt_level);
                 defer llvm_native.deinit();
-                break :blk try llvm_native.generate(ast);
+                llvm_native.profiler = profiler_ptr;  // 🆕 v0.2.0
+                llvm_native.setFramePointers(frame_pointers);  // 🆕 v0.2.0
+                if (debug_info) try llvm_native.enableDebugInfo(source_file);  // 🆕 v0.2.0
+                // 🆕 v0.2.0: PGO；--pgo-use 先把 .profraw 合并为 .profdata
+                switch (pgo_mode) {
+                    .none => {},
+                    .generate => llvm_native.setPgo(pgo_mode),
+                    .use => |path| {
+                        pgo_profile = try pgo.resolveProfileData(allocator, path);
+                        llvm_native.setPgo(.{ .use = pgo_profile.? });
+                    },
+                }
+                
+                // 🆕 v0.2.0: --compile/--run 直接从内存模块生成目标文件，不经过 .ll 文本
+                if (should_compile) {
+                    // 🆕 v0.2.0: 发布构建（-O1 及以上）不保留指令名，IR 文本输出时保留
+                    llvm_native.setDiscardValueNames(llvm_opt_level != .O0);
+                    try llvm_native.lower(program);
+                    // 🆕 v0.2.0: --pgo-use 写出 bitcode，由 clang 读取剖析数据后优化
+                    const object_suffix = if (pgo_mode == .use) ".bc" else object_ext;
+                    llvm_object = try std.fmt.allocPrint(allocator, "{s}{s}", .{ output_file orelse "output", object_suffix });
+                    if (pgo_mode == .use) {
+                        try llvm_native.emitBitcode(llvm_object.?);
+                    } else {
+                        try llvm_native.emitObject(llvm_object.?);
+                    }
+                    // 没有文本形式的代码：目标文件已经写在磁盘上，只需链接
+                    break :blk try allocator.alloc(u8, 0);
+                }
+                break :blk try llvm_native.generate(program);
             },
         };
     defer allocator.free(output_code);  // 🔧 释放生成的代码（来自 codegen 或 llvm_native_backend）
     
+    codegen_zone.end();
     if (show_timing) {
-        timer.codegen_time = std.time.milliTimestamp() - codegen_start;
+        timer.codegen_time = std.time.nanoTimestamp() - codegen_start;
     }
     
     const total_time = std.time.nanoTimestamp();
@@ -503,6 +745,28 @@ pub fn main() !void {
             try clang_args.append(allocator, "-o");
             try clang_args.append(allocator, output_name);
             try clang_args.append(allocator, "-O2");
+            // 🆕 v0.2.0: 链接 pawrt 运行时库（prelude 中声明的 paw_* 函数）
+            const runtime_lib = c_backend_mod.findRuntimeLibrary(allocator);
+            defer if (runtime_lib) |lib| allocator.free(lib);
+            if (runtime_lib) |lib| {
+                try clang_args.append(allocator, lib);
+                try clang_args.appendSlice(allocator, c_backend_mod.runtime_system_libs);
+            }
+            if (debug_info) try clang_args.append(allocator, "-g");  // 🆕 v0.2.0
+            if (frame_pointers) try clang_args.append(allocator, "-fno-omit-frame-pointer");
+            
+            // 🆕 v0.2.0: PGO（clang 读取合并好的 .profdata）
+            const pgo_flag: ?[]u8 = switch (pgo_mode) {
+                .none => null,
+                .generate => |dir| try std.fmt.allocPrint(allocator, "-fprofile-generate={s}", .{dir}),
+                .use => |path| flag: {
+                    const profile = try pgo.resolveProfileData(allocator, path);
+                    defer allocator.free(profile);
+                    break :flag try std.fmt.allocPrint(allocator, "-fprofile-use={s}", .{profile});
+                },
+            };
+            defer if (pgo_flag) |flag| allocator.free(flag);
+            if (pgo_flag) |flag| try clang_args.append(allocator, flag);
             
             // macOS: 添加 SDK 路径
             if (builtin.os.tag == .macos) {
@@ -512,7 +776,9 @@ pub fn main() !void {
             
             var child = std.process.Child.init(clang_args.items, allocator);
             
+            const cc_zone = prof.zone(profiler_ptr, "phase", "cc");
             const result = try child.spawnAndWait();
+            cc_zone.end();
             
             if (result != .Exited or result.Exited != 0) {
                 std.debug.print("❌ Compilation failed\n", .{});
@@ -546,12 +812,55 @@ pub fn main() !void {
             }
             
         } else if (selected_backend == .llvm) {
-            // LLVM 后端: 生成 IR 然后用 Clang 编译
-            std.debug.print("❌ Error: LLVM backend does not support --compile/--run yet\n", .{});
-            std.debug.print("💡 Use manual workflow:\n", .{});
-            std.debug.print("   pawc file.paw --backend=llvm\n", .{});
-            std.debug.print("   llvm/install/bin/clang output.ll -o program\n", .{});
-            return;
+            // 🆕 v0.2.0: LLVM 后端: 目标文件已经生成，只需链接
+            const object_file = llvm_object.?;
+            
+            var c_backend = CBackend.init(allocator);
+            defer c_backend.deinit();
+            resident.shareCompilerDriver(&c_backend);  // 🆕 v0.2.0: pawc serve 中跨请求复用检测结果
+            if (use_cache) c_backend.setCacheDir(module_cache.default_dir);  // 🆕 v0.2.0: 缓存编译器检测结果
+            c_backend.setDebugInfo(debug_info);  // 🆕 v0.2.0
+            c_backend.setFramePointers(frame_pointers);
+            // 🆕 v0.2.0: 插桩的目标文件只需链接 profile 运行时；
+            // --pgo-use 的 bitcode 由 clang 带着剖析数据按同一优化级别优化
+            switch (pgo_mode) {
+                .none => {},
+                .generate => c_backend.setPgo(pgo_mode),
+                .use => {
+                    c_backend.setPgo(.{ .use = pgo_profile.? });
+                    c_backend.setOptFlag(clangOptFlag(opt_level));
+                },
+            }
+            const link_zone = prof.zone(profiler_ptr, "phase", "link");
+            c_backend.linkObject(object_file, output_name) catch |err| {
+                std.debug.print("❌ Linking failed: {}\n", .{err});
+                return;
+            };
+            link_zone.end();
+            
+            if (!verbose) {
+                std.fs.cwd().deleteFile(object_file) catch {};
+            }
+            
+            if (verbose) {
+                std.debug.print("✅ Compilation complete: {s} -> {s} ({d:.2}s)\n", .{
+                    source_file,
+                    output_name,
+                    @as(f64, @floatFromInt(total_time - start_time)) / 1_000_000_000.0,
+                });
+            }
+            
+            if (should_run) {
+                const run_path = try std.fmt.allocPrint(allocator, "./{s}", .{output_name});
+                defer allocator.free(run_path);
+                
+                var run_child = std.process.Child.init(&[_][]const u8{run_path}, allocator);
+                const run_result = try run_child.spawnAndWait();
+                
+                if (verbose) {
+                    std.debug.print("Exit code: {any}\n", .{run_result});
+                }
+            }
         } else {
             // Fallback to system C compiler
             if (verbose) {
@@ -559,12 +868,24 @@ pub fn main() !void {
             }
             
             var c_backend = CBackend.init(allocator);
+            defer c_backend.deinit();
+            resident.shareCompilerDriver(&c_backend);  // 🆕 v0.2.0: pawc serve 中跨请求复用检测结果
+            if (use_cache) c_backend.setCacheDir(module_cache.default_dir);  // 🆕 v0.2.0: 缓存编译器检测结果
+            c_backend.setDebugInfo(debug_info);  // 🆕 v0.2.0
+            c_backend.setFramePointers(frame_pointers);
+            c_backend.setPgo(pgo_mode);  // 🆕 v0.2.0
             
             if (should_run) {
                 std.debug.print("🔥 Compiling and running: {s}\n", .{source_file});
+                const cc_zone = prof.zone(profiler_ptr, "phase", "cc+run");
+                defer cc_zone.end();
                 try c_backend.compileAndRun(output_code);
             } else {
-                try c_backend.compile(output_code, output_name);
+                const cc_zone = prof.zone(profiler_ptr, "phase", "cc");
+                defer cc_zone.end();
+                // 🆕 v0.2.0: 多翻译单元并行编译，只重新编译内容变化的单元
+                c_backend.setJobs(job_count);
+                try c_backend.compileUnits(&c_units.?, output_name);
             }
             
             if (verbose) {
@@ -619,25 +940,13 @@ pub fn main() !void {
                                 .O2 => "-O2 (standard optimization) ⭐",
                                 .O3 => "-O3 (aggressive optimization)",
                             };
-                            std.debug.print("⚡ Optimization: {s}\n", .{opt_str});
+                            // 🆕 v0.2.0: 优化管道已在 pawc 内部运行，输出的 IR 已经是优化后的
+                            std.debug.print("⚡ Optimization: {s} (applied by pawc)\n", .{opt_str});
                         }
                         
                         std.debug.print("💡 Hints:\n", .{});
-                        
-                        // 🆕 v0.1.7: 根据优化级别提供不同的编译建议
-                        if (opt_level) |level| {
-                            const clang_opt = switch (level) {
-                                .O0 => "-O0",
-                                .O1 => "-O1",
-                                .O2 => "-O2",
-                                .O3 => "-O3",
-                            };
-                            std.debug.print("   • Compile with optimization: clang {s} {s} -o {s}\n", .{ code_filename, clang_opt, output_name });
-                            std.debug.print("   • Local LLVM: llvm/install/bin/clang {s} {s} -o {s}\n", .{ code_filename, clang_opt, output_name });
-                        } else {
-                            std.debug.print("   • Compile: llvm/install/bin/clang {s} -o {s}\n", .{ code_filename, output_name });
-                            std.debug.print("   • Or: clang {s} -o {s} (system clang)\n", .{ code_filename, output_name });
-                        }
+                        std.debug.print("   • Compile: llvm/install/bin/clang {s} -o {s}\n", .{ code_filename, output_name });
+                        std.debug.print("   • Or: clang {s} -o {s} (system clang)\n", .{ code_filename, output_name });
                         std.debug.print("   • Run: ./{s}\n", .{output_name});
                     },
                 }
@@ -652,6 +961,18 @@ pub fn main() !void {
     }
 }
 
+/// 🆕 v0.2.0: 写出 --time-report 报告（<output>.time.json 或 <output>.trace.json）
+fn writeTimeReport(allocator: std.mem.Allocator, profiler: *prof.Profiler, format: prof.Format, output_name: []const u8) void {
+    const path = std.fmt.allocPrint(allocator, "{s}{s}", .{ output_name, format.extension() }) catch return;
+    defer allocator.free(path);
+    
+    profiler.writeReport(path, format) catch |err| {
+        std.debug.print("⚠️  Warning: failed to write time report {s}: {}\n", .{ path, err });
+        return;
+    };
+    std.debug.print("⏱️  Time report: {s}\n", .{path});
+}
+
 fn printUsage() void {
     std.debug.print("\n", .{});
     std.debug.print("╔═══════════════════════════════════════════════════════════════╗\n", .{});
@@ -662,6 +983,10 @@ fn printUsage() void {
     std.debug.print("  pawc <file.paw> [options]       Compile Paw source file\n", .{});
     std.debug.print("  pawc check <file>               Type check only\n", .{});
     std.debug.print("  pawc init <name>                Create new project\n", .{});
+    std.debug.print("  pawc bench [path] [options]     Run benchmarks (see pawc bench --help) 🆕\n", .{});
+    std.debug.print("  pawc serve [--socket=<path>]    Run a compile server with warm caches 🆕\n", .{});
+    std.debug.print("  pawc serve --stop               Stop the running compile server 🆕\n", .{});
+    std.debug.print("  pawc lsp                        Language server for editors (stdio) 🆕\n", .{});
     std.debug.print("  pawc --version, -v              Show version\n", .{});
     std.debug.print("  pawc --help, -h                 Show this help\n", .{});
     std.debug.print("\n", .{});
@@ -669,8 +994,16 @@ fn printUsage() void {
     std.debug.print("  -o <file>        Specify output file name\n", .{});
     std.debug.print("  -v               Verbose output\n", .{});
     std.debug.print("  --time           Show compilation time analysis 🆕\n", .{});
-    std.debug.print("  --compile        Compile to executable (C backend only)\n", .{});
-    std.debug.print("  --run            Compile and run immediately (C backend only)\n", .{});
+    std.debug.print("  --time-report=json|chrome  Write per-phase/module/function timings 🆕\n", .{});
+    std.debug.print("  --no-cache       Do not read/write the .paw-cache module AST cache\n", .{});
+    std.debug.print("  --no-ast-opt     Skip inlining, constant folding and unused prelude removal 🆕\n", .{});
+    std.debug.print("  --jobs=<n>, -j <n>  Type check and compile C units on n threads (default: CPU count)\n", .{});
+    std.debug.print("  -g               Emit debug info (#line / DWARF; JIT: /tmp/perf-<pid>.map) 🆕\n", .{});
+    std.debug.print("  --frame-pointers Keep frame pointers for perf / flamegraphs 🆕\n", .{});
+    std.debug.print("  --pgo-generate[=dir]  Build an instrumented binary; running it writes a profile to dir (default paw-pgo) 🆕\n", .{});
+    std.debug.print("  --pgo-use[=path]      Optimize with a profile (.profdata file or profile dir) 🆕\n", .{});
+    std.debug.print("  --compile        Compile to executable\n", .{});
+    std.debug.print("  --run            Compile and run immediately (LLVM backend: in-process JIT)\n", .{});
     std.debug.print("\n", .{});
     std.debug.print("Backends:\n", .{});
     std.debug.print("  --backend=c              Use C backend\n", .{});
@@ -693,6 +1026,7 @@ fn printUsage() void {
     std.debug.print("  pawc fibonacci.paw -O3               Auto-detect + max optimization 🚀\n", .{});
     std.debug.print("  pawc check hello.paw                 Type check only\n", .{});
     std.debug.print("  pawc init my_project                 Create new project\n", .{});
+    std.debug.print("  PAWC_SERVER=<socket> pawc hello.paw  Forward to a running pawc serve 🆕\n", .{});
     std.debug.print("\n", .{});
     std.debug.print("Build with LLVM:\n", .{});
     std.debug.print("  zig build                            Auto-detect and use LLVM if available\n", .{});
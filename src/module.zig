@@ -14,27 +14,28 @@ const std = @import("std");
 const ast = @import("ast.zig");
 const Lexer = @import("lexer.zig").Lexer;
 const Parser = @import("parser.zig").Parser;
+const ModuleCache = @import("module_cache.zig").ModuleCache;  // 🆕 v0.2.0
+const SourceMap = @import("source_map.zig").SourceMap;  // 🆕 v0.2.0
+const prof = @import("profiler.zig");  // 🆕 v0.2.0
 
 /// 模块信息
+/// 🆕 v0.2.0: 模块的所有内存（源码、AST、pub 项表）都归属于模块自己的 arena
 pub const Module = struct {
+    arena: *std.heap.ArenaAllocator,          // 模块独占的 arena
     path: []const u8,                         // 模块路径（math）
     source_file: []const u8,                  // 源文件路径（math.paw）
-    source: []const u8,                       // 源代码（需要保留）
+    source: []const u8,                       // 源代码（需要保留；使用 SourceMap 时指向文件映射）
     declarations: []ast.TopLevelDecl,         // 所有声明
     public_items: std.StringHashMap(usize),   // pub项的索引（名称->索引）
+    from_cache: bool,                         // 🆕 v0.2.0: 是否来自 AST 缓存
+    mtime: i128,                              // 🆕 v0.2.0: 加载时源文件的修改时间和大小
+    size: u64,                                //    （常驻的加载器据此判断模块是否需要重新加载）
     
+    /// 注意：declarations 会被导入到主程序中使用，
+    /// 必须在代码生成完成后才能释放模块
     pub fn deinit(self: *Module, allocator: std.mem.Allocator) void {
-        // 释放public_items中的键
-        var it = self.public_items.iterator();
-        while (it.next()) |entry| {
-            allocator.free(entry.key_ptr.*);
-        }
-        self.public_items.deinit();
-        
-        allocator.free(self.path);
-        allocator.free(self.source_file);
-        allocator.free(self.source);
-        // declarations不在这里释放，因为它们可能被导入到主程序中使用
+        self.arena.deinit();
+        allocator.destroy(self.arena);
     }
 };
 
@@ -42,20 +43,133 @@ pub const Module = struct {
 pub const ModuleLoader = struct {
     allocator: std.mem.Allocator,
     modules: std.StringHashMap(Module),
+    cache: ?ModuleCache,  // 🆕 v0.2.0: AST 磁盘缓存（null = 禁用）
+    failed: std.StringHashMap(anyerror),  // 🆕 v0.2.0: 预加载失败的模块（避免重复报错）
+    sources: ?*SourceMap,  // 🆕 v0.2.0: 共享的源文件映射（null = 读入模块 arena）
+    profiler: ?*prof.Profiler,  // 🆕 v0.2.0: --time-report 逐模块计时
     
     pub fn init(allocator: std.mem.Allocator) ModuleLoader {
         return ModuleLoader{
             .allocator = allocator,
             .modules = std.StringHashMap(Module).init(allocator),
+            .cache = null,
+            .failed = std.StringHashMap(anyerror).init(allocator),
+            .sources = null,
+            .profiler = null,
         };
     }
     
     pub fn deinit(self: *ModuleLoader) void {
         var it = self.modules.iterator();
         while (it.next()) |entry| {
+            self.allocator.free(entry.key_ptr.*);
             entry.value_ptr.deinit(self.allocator);
         }
         self.modules.deinit();
+        
+        var failed_it = self.failed.keyIterator();
+        while (failed_it.next()) |key| {
+            self.allocator.free(key.*);
+        }
+        self.failed.deinit();
+    }
+    
+    /// 🆕 v0.2.0: 启用 AST 磁盘缓存
+    /// version 参与缓存键计算，编译器升级后旧缓存自动失效
+    pub fn enableCache(self: *ModuleLoader, dir_path: []const u8, version: []const u8) void {
+        self.cache = ModuleCache.init(self.allocator, dir_path, version);
+    }
+    
+    /// 🆕 v0.2.0: 通过共享的 SourceMap 打开模块源文件
+    /// SourceMap 必须比 ModuleLoader 活得更久（模块 AST 引用映射内存）
+    pub fn setSourceMap(self: *ModuleLoader, sources: *SourceMap) void {
+        self.sources = sources;
+    }
+    
+    /// 🆕 v0.2.0: 记录每个模块的加载耗时
+    pub fn setProfiler(self: *ModuleLoader, profiler: *prof.Profiler) void {
+        self.profiler = profiler;
+    }
+    
+    /// 🆕 v0.2.0: 常驻的加载器（pawc serve / pawc lsp）在每次编译前调用：
+    /// 源文件修改时间或大小变化（或已被删除）的模块被移除，下次导入时重新加载；
+    /// 之前加载失败的模块也重新尝试
+    pub fn evictChanged(self: *ModuleLoader) !void {
+        var stale = std.ArrayList([]const u8){};
+        defer stale.deinit(self.allocator);
+        
+        var it = self.modules.iterator();
+        while (it.next()) |entry| {
+            const module = entry.value_ptr;
+            const unchanged = if (std.fs.cwd().statFile(module.source_file)) |stat|
+                stat.mtime == module.mtime and stat.size == module.size
+            else |_|
+                false;
+            if (!unchanged) try stale.append(self.allocator, entry.key_ptr.*);
+        }
+        
+        for (stale.items) |key| {
+            const removed = self.modules.fetchRemove(key).?;
+            var module = removed.value;
+            module.deinit(self.allocator);
+            self.allocator.free(removed.key);
+        }
+        
+        var failed_it = self.failed.keyIterator();
+        while (failed_it.next()) |key| {
+            self.allocator.free(key.*);
+        }
+        self.failed.clearRetainingCapacity();
+    }
+    
+    /// 🆕 v0.2.0: 把 declarations 中的 import 替换为被导入的声明，其余声明原样追加到 out
+    /// out 使用加载器的 allocator
+    /// 所有被导入的模块先在线程池中并行预加载；导入失败时打印错误并跳过该项
+    pub fn resolveImports(
+        self: *ModuleLoader,
+        declarations: []const ast.TopLevelDecl,
+        out: *std.ArrayList(ast.TopLevelDecl),
+    ) !void {
+        {
+            var import_paths = std.ArrayList([]const u8){};
+            defer import_paths.deinit(self.allocator);
+            for (declarations) |decl| {
+                if (decl == .import_decl) {
+                    try import_paths.append(self.allocator, decl.import_decl.module_path);
+                }
+            }
+            try self.preload(import_paths.items);
+        }
+        
+        for (declarations) |decl| {
+            if (decl != .import_decl) {
+                try out.append(self.allocator, decl);
+                continue;
+            }
+            
+            const import_decl = decl.import_decl;
+            switch (import_decl.items) {
+                // import math.add;
+                .single => |item_name| try self.appendImport(out, import_decl.module_path, item_name),
+                // import math.{add, sub, Vec2};
+                .multiple => |item_names| for (item_names) |item_name| {
+                    try self.appendImport(out, import_decl.module_path, item_name);
+                },
+            }
+        }
+    }
+    
+    fn appendImport(
+        self: *ModuleLoader,
+        out: *std.ArrayList(ast.TopLevelDecl),
+        module_path: []const u8,
+        item_name: []const u8,
+    ) !void {
+        const imported_item = self.getImportedItem(module_path, item_name) catch |err| {
+            std.debug.print("Error: Failed to import {s}.{s}: {any}\n", .{module_path, item_name, err});
+            return;
+        };
+        try out.append(self.allocator, imported_item);
     }
     
     /// 从模块中获取导入项
@@ -64,6 +178,11 @@ pub const ModuleLoader = struct {
         module_path: []const u8,
         item_name: []const u8,
     ) !ast.TopLevelDecl {
+        // 🆕 v0.2.0: 预加载时已经失败（错误信息已打印过）
+        if (self.failed.get(module_path)) |err| {
+            return err;
+        }
+        
         // 如果模块未加载，先加载
         if (!self.modules.contains(module_path)) {
             try self.loadModuleInternal(module_path);
@@ -87,56 +206,178 @@ pub const ModuleLoader = struct {
         return error.ItemNotFound;
     }
     
+    /// 🆕 v0.2.0: 并行预加载一组模块
+    /// 每个模块在线程池中独立完成 读文件 -> 查缓存 -> 词法 -> 语法 分析，
+    /// 各自使用独立的 arena；modules 表只在调用线程中更新
+    /// 只预加载给出的这一层：resolveImports 不展开被导入模块自己的 import，
+    /// 逐层预加载只会多解析用不到的文件。导入开始传递解析时，应改为按层迭代本函数
+    pub fn preload(self: *ModuleLoader, module_paths: []const []const u8) !void {
+        // 去重并跳过已加载的模块
+        var pending = std.ArrayList(LoadTask){};
+        defer pending.deinit(self.allocator);
+        
+        for (module_paths) |path| {
+            if (self.modules.contains(path) or self.failed.contains(path)) continue;
+            const duplicate = for (pending.items) |task| {
+                if (std.mem.eql(u8, task.path, path)) break true;
+            } else false;
+            if (!duplicate) {
+                try pending.append(self.allocator, LoadTask{ .path = path });
+            }
+        }
+        
+        if (pending.items.len == 0) return;
+        
+        const cpu_count = std.Thread.getCpuCount() catch 1;
+        const n_jobs = @min(cpu_count, pending.items.len);
+        
+        if (n_jobs <= 1) {
+            // 只有一个模块（或单核）：直接在当前线程加载，省去线程池开销
+            for (pending.items) |*task| {
+                runLoadTask(self, task);
+            }
+        } else {
+            var pool: std.Thread.Pool = undefined;
+            try pool.init(.{ .allocator = self.allocator, .n_jobs = n_jobs });
+            defer pool.deinit();
+            
+            var wait_group: std.Thread.WaitGroup = .{};
+            for (pending.items) |*task| {
+                pool.spawnWg(&wait_group, runLoadTask, .{ self, task });
+            }
+            pool.waitAndWork(&wait_group);
+        }
+        
+        // 按导入顺序合并结果
+        for (pending.items) |*task| {
+            const result = task.result orelse continue;
+            if (result) |module| {
+                var owned = module;
+                const key = self.allocator.dupe(u8, task.path) catch |err| {
+                    owned.deinit(self.allocator);
+                    return err;
+                };
+                self.modules.put(key, owned) catch |err| {
+                    self.allocator.free(key);
+                    owned.deinit(self.allocator);
+                    return err;
+                };
+            } else |err| {
+                const key = try self.allocator.dupe(u8, task.path);
+                self.failed.put(key, err) catch |put_err| {
+                    self.allocator.free(key);
+                    return put_err;
+                };
+            }
+        }
+    }
+    
+    const LoadTask = struct {
+        path: []const u8,
+        result: ?anyerror!Module = null,
+    };
+    
+    fn runLoadTask(self: *const ModuleLoader, task: *LoadTask) void {
+        task.result = self.parseModule(task.path);
+    }
+    
     /// 内部方法：加载模块
     fn loadModuleInternal(self: *ModuleLoader, module_path: []const u8) !void {
+        var module = try self.parseModule(module_path);
+        errdefer module.deinit(self.allocator);
+        
+        const key = try self.allocator.dupe(u8, module_path);
+        errdefer self.allocator.free(key);
+        try self.modules.put(key, module);
+    }
+    
+    /// 读取并解析一个模块（不修改 ModuleLoader 状态，可在工作线程中调用）
+    fn parseModule(self: *const ModuleLoader, module_path: []const u8) !Module {
+        const zone = prof.zone(self.profiler, "module", module_path);
+        defer zone.end();
+        
         // 查找模块文件
         const source_file = try self.findModuleFile(module_path);
         defer self.allocator.free(source_file);
         
-        // 读取源文件（不释放，保留在模块中）
-        const source = try std.fs.cwd().readFileAlloc(
-            self.allocator,
-            source_file,
-            10 * 1024 * 1024,
-        );
-        
-        // 解析模块
-        var lexer = Lexer.init(self.allocator, source, source_file);
-        defer lexer.deinit();  // 🆕 v0.1.8: 确保清理
-        const tokens = try lexer.tokenize();
-        
-        var parser = Parser.init(self.allocator, tokens);
-        const program = try parser.parse();
-        
-        // 收集pub声明
-        var public_items = std.StringHashMap(usize).init(self.allocator);
-        for (program.declarations, 0..) |decl, idx| {
-            const name = switch (decl) {
-                .function => |f| if (f.is_public) f.name else null,
-                .type_decl => |td| if (td.is_public) td.name else null,
-                else => null,
-            };
-            
-            if (name) |n| {
-                const name_copy = try self.allocator.dupe(u8, n);
-                try public_items.put(name_copy, idx);
-            }
+        // 🆕 v0.2.0: 每个模块使用独立的 arena
+        const arena = try self.allocator.create(std.heap.ArenaAllocator);
+        arena.* = std.heap.ArenaAllocator.init(self.allocator);
+        errdefer {
+            arena.deinit();
+            self.allocator.destroy(arena);
         }
+        const arena_allocator = arena.allocator();
+        
+        // 读取源文件（保留在模块中，AST 中的字符串引用它）
+        // 🆕 v0.2.0: 优先使用共享的文件映射，不再限制文件大小
+        const source = if (self.sources) |sources|
+            (try sources.open(source_file)).bytes
+        else
+            try std.fs.cwd().readFileAlloc(arena_allocator, source_file, std.math.maxInt(usize));
         
-        // 创建模块
-        const module = Module{
-            .path = try self.allocator.dupe(u8, module_path),
-            .source_file = try self.allocator.dupe(u8, source_file),
+        var module = Module{
+            .arena = arena,
+            .path = try arena_allocator.dupe(u8, module_path),
+            .source_file = try arena_allocator.dupe(u8, source_file),
             .source = source,
-            .declarations = program.declarations,
-            .public_items = public_items,
+            .declarations = &[_]ast.TopLevelDecl{},
+            .public_items = undefined,
+            .from_cache = false,
+            .mtime = 0,
+            .size = 0,
         };
+        if (std.fs.cwd().statFile(source_file)) |stat| {
+            module.mtime = stat.mtime;
+            module.size = stat.size;
+        } else |_| {}
+        
+        // 🆕 v0.2.0: 源码未变时直接使用缓存的 AST
+        if (self.cache) |cache| {
+            if (cache.load(source, arena_allocator)) |cached| {
+                module.declarations = cached.declarations;
+                module.public_items = cached.public_items;
+                module.from_cache = true;
+            }
+        }
+        
+        if (!module.from_cache) {
+            // 解析模块
+            var lexer = Lexer.init(self.allocator, source, module.source_file);
+            defer lexer.deinit();  // 🆕 v0.1.8: 确保清理
+            const tokens = try lexer.tokenize();
+            
+            // Parser 的 arena 建立在模块 arena 之上，随模块一起释放
+            var parser = Parser.init(arena_allocator, tokens);
+            const program = try parser.parse();
+            
+            // 收集pub声明
+            var public_items = std.StringHashMap(usize).init(arena_allocator);
+            for (program.declarations, 0..) |decl, idx| {
+                const name = switch (decl) {
+                    .function => |f| if (f.is_public) f.name else null,
+                    .type_decl => |td| if (td.is_public) td.name else null,
+                    else => null,
+                };
+                
+                if (name) |n| {
+                    try public_items.put(n, idx);
+                }
+            }
+            
+            module.declarations = program.declarations;
+            module.public_items = public_items;
+            
+            if (self.cache) |cache| {
+                cache.store(source, module.declarations, module.public_items);
+            }
+        }
         
-        try self.modules.put(try self.allocator.dupe(u8, module_path), module);
+        return module;
     }
     
     /// 查找模块文件
-    fn findModuleFile(self: *ModuleLoader, module_path: []const u8) ![]const u8 {
+    fn findModuleFile(self: *const ModuleLoader, module_path: []const u8) ![]const u8 {
         // 尝试1: module_path.paw
         var buf = std.ArrayList(u8){};
         try buf.appendSlice(self.allocator, module_path);
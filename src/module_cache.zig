@@ -0,0 +1,387 @@
+//! 🆕 v0.2.0: Module Cache - 模块 AST 磁盘缓存
+//!
+//! 把解析好的模块声明（declarations）和 pub 项索引（public_items）
+//! 序列化到 `.paw-cache/ast/` 下，下次编译时若源码未变则直接反序列化，
+//! 跳过词法分析和语法分析。
+//!
+//! 缓存键：编译器版本 + AST 布局指纹 + 编译器构建指纹 + 源码内容的哈希
+//!   - 源码改变 -> 键改变 -> 重新解析
+//!   - 升级编译器或修改 ast.zig -> 所有旧缓存自动失效
+//!   - 重新构建 pawc（例如只改了语法分析）-> 构建指纹改变，旧缓存同样失效
+//!
+//! 序列化格式（小端序）：
+//!   magic "PAWAST" | format u16 | key u64 | source_len u64
+//!   | public_items: count, (name, index)* | declarations
+//!
+//! AST 的编码由 comptime 反射自动生成（见 Encoder/Decoder），
+//! 解码出的所有节点和字符串都分配在模块自己的 arena 中。
+
+const std = @import("std");
+const ast = @import("ast.zig");
+
+const magic = "PAWAST";
+const format_version: u16 = 1;
+
+/// 默认缓存目录（相对于当前工作目录）
+pub const default_dir = ".paw-cache";
+
+/// ast.zig 的内容指纹：AST 结构一变，旧缓存的二进制布局就不再有效
+const ast_layout_hash: u64 = blk: {
+    @setEvalBranchQuota(4_000_000);
+    break :blk std.hash.Wyhash.hash(0, @embedFile("ast.zig"));
+};
+
+pub const DecodeError = std.mem.Allocator.Error || error{InvalidCache};
+
+/// 编译器构建指纹：pawc 可执行文件的大小和修改时间
+/// 无法确定时返回 null，此时不复用任何缓存
+pub fn compilerBuildId() ?u64 {
+    var path_buf: [std.fs.max_path_bytes]u8 = undefined;
+    const exe_path = std.fs.selfExePath(&path_buf) catch return null;
+    const stat = std.fs.cwd().statFile(exe_path) catch return null;
+
+    var hasher = std.hash.Wyhash.init(0);
+    hasher.update(std.mem.asBytes(&stat.size));
+    hasher.update(std.mem.asBytes(&stat.mtime));
+    return hasher.final();
+}
+
+/// 从缓存中恢复的模块内容
+pub const CachedModule = struct {
+    declarations: []ast.TopLevelDecl,
+    public_items: std.StringHashMap(usize),
+};
+
+pub const ModuleCache = struct {
+    allocator: std.mem.Allocator,
+    dir_path: []const u8,
+    version: []const u8,
+    build_id: ?u64,  // null：无法确定编译器构建，缓存不读也不写
+
+    pub fn init(allocator: std.mem.Allocator, dir_path: []const u8, version: []const u8) ModuleCache {
+        return ModuleCache{
+            .allocator = allocator,
+            .dir_path = dir_path,
+            .version = version,
+            .build_id = compilerBuildId(),
+        };
+    }
+
+    /// 计算缓存键
+    pub fn key(self: ModuleCache, build_id: u64, source: []const u8) u64 {
+        var hasher = std.hash.Wyhash.init(ast_layout_hash);
+        hasher.update(self.version);
+        hasher.update(&[_]u8{0});
+        hasher.update(std.mem.asBytes(&build_id));
+        hasher.update(source);
+        return hasher.final();
+    }
+
+    fn entryName(buf: []u8, cache_key: u64) []const u8 {
+        return std.fmt.bufPrint(buf, "ast/{x:0>16}.ast", .{cache_key}) catch unreachable;
+    }
+
+    /// 查找缓存，未命中或缓存损坏时返回 null
+    /// public_items 的键和所有 AST 内存都分配在 arena 中
+    pub fn load(self: ModuleCache, source: []const u8, arena: std.mem.Allocator) ?CachedModule {
+        const cache_key = self.key(self.build_id orelse return null, source);
+
+        var name_buf: [64]u8 = undefined;
+        const name = entryName(&name_buf, cache_key);
+
+        var dir = std.fs.cwd().openDir(self.dir_path, .{}) catch return null;
+        defer dir.close();
+
+        const bytes = dir.readFileAlloc(self.allocator, name, 64 * 1024 * 1024) catch return null;
+        defer self.allocator.free(bytes);
+
+        return decodeEntry(bytes, cache_key, source.len, arena) catch null;
+    }
+
+    /// 写入缓存（失败时静默忽略，缓存只是加速手段）
+    pub fn store(
+        self: ModuleCache,
+        source: []const u8,
+        declarations: []const ast.TopLevelDecl,
+        public_items: std.StringHashMap(usize),
+    ) void {
+        self.storeInternal(source, declarations, public_items) catch {};
+    }
+
+    fn storeInternal(
+        self: ModuleCache,
+        source: []const u8,
+        declarations: []const ast.TopLevelDecl,
+        public_items: std.StringHashMap(usize),
+    ) !void {
+        const cache_key = self.key(self.build_id orelse return, source);
+
+        var encoder = Encoder{ .allocator = self.allocator };
+        defer encoder.buf.deinit(self.allocator);
+
+        try encoder.buf.appendSlice(self.allocator, magic);
+        try encoder.writeInt(u16, format_version);
+        try encoder.writeInt(u64, cache_key);
+        try encoder.writeInt(u64, source.len);
+
+        try encoder.writeInt(u64, public_items.count());
+        var it = public_items.iterator();
+        while (it.next()) |entry| {
+            try encoder.write([]const u8, entry.key_ptr.*);
+            try encoder.writeInt(u64, entry.value_ptr.*);
+        }
+
+        try encoder.write([]const ast.TopLevelDecl, declarations);
+
+        var dir = try std.fs.cwd().makeOpenPath(self.dir_path, .{});
+        defer dir.close();
+        try dir.makePath("ast");
+
+        var name_buf: [64]u8 = undefined;
+        const name = entryName(&name_buf, cache_key);
+
+        // 先写临时文件再重命名，避免并发编译读到写了一半的缓存
+        var tmp_buf: [96]u8 = undefined;
+        const tmp_name = try std.fmt.bufPrint(&tmp_buf, "{s}.tmp{x}", .{ name, std.crypto.random.int(u32) });
+
+        {
+            const file = try dir.createFile(tmp_name, .{});
+            defer file.close();
+            try file.writeAll(encoder.buf.items);
+        }
+        dir.rename(tmp_name, name) catch |err| {
+            dir.deleteFile(tmp_name) catch {};
+            return err;
+        };
+    }
+};
+
+fn decodeEntry(
+    bytes: []const u8,
+    cache_key: u64,
+    source_len: usize,
+    arena: std.mem.Allocator,
+) DecodeError!CachedModule {
+    var decoder = Decoder{ .bytes = bytes, .arena = arena };
+
+    const header = try decoder.take(magic.len);
+    if (!std.mem.eql(u8, header, magic)) return error.InvalidCache;
+    if (try decoder.readInt(u16) != format_version) return error.InvalidCache;
+    if (try decoder.readInt(u64) != cache_key) return error.InvalidCache;
+    if (try decoder.readInt(u64) != source_len) return error.InvalidCache;
+
+    var public_items = std.StringHashMap(usize).init(arena);
+    const item_count = try decoder.readInt(u64);
+    var i: u64 = 0;
+    while (i < item_count) : (i += 1) {
+        const name = try decoder.read([]const u8);
+        const index = std.math.cast(usize, try decoder.readInt(u64)) orelse return error.InvalidCache;
+        try public_items.put(name, index);
+    }
+
+    const declarations = try decoder.read([]ast.TopLevelDecl);
+    if (decoder.pos != bytes.len) return error.InvalidCache;
+
+    var index_it = public_items.valueIterator();
+    while (index_it.next()) |index| {
+        if (index.* >= declarations.len) return error.InvalidCache;
+    }
+
+    return CachedModule{
+        .declarations = declarations,
+        .public_items = public_items,
+    };
+}
+
+// ============================================================================
+// 🆕 v0.2.0: 构建期 AST 快照（prelude）
+// ============================================================================
+//
+// 格式：magic "PAWSNP" | format u16 | ast_layout_hash u64 | declarations
+// 由 src/prelude_gen.zig 在 `zig build` 时生成并嵌入 pawc，
+// 与磁盘缓存共用同一套编解码，但不需要源码哈希（快照与编译器一起构建）。
+
+const snapshot_magic = "PAWSNP";
+
+/// 把声明编码成一个独立的快照，返回的字节由调用方释放
+pub fn encodeSnapshot(allocator: std.mem.Allocator, declarations: []const ast.TopLevelDecl) ![]u8 {
+    var encoder = Encoder{ .allocator = allocator };
+    errdefer encoder.buf.deinit(allocator);
+
+    try encoder.buf.appendSlice(allocator, snapshot_magic);
+    try encoder.writeInt(u16, format_version);
+    try encoder.writeInt(u64, ast_layout_hash);
+    try encoder.write([]const ast.TopLevelDecl, declarations);
+
+    return encoder.buf.toOwnedSlice(allocator);
+}
+
+/// 解码 encodeSnapshot() 生成的快照，所有 AST 内存分配在 arena 中
+pub fn decodeSnapshot(bytes: []const u8, arena: std.mem.Allocator) DecodeError![]ast.TopLevelDecl {
+    var decoder = Decoder{ .bytes = bytes, .arena = arena };
+
+    const header = try decoder.take(snapshot_magic.len);
+    if (!std.mem.eql(u8, header, snapshot_magic)) return error.InvalidCache;
+    if (try decoder.readInt(u16) != format_version) return error.InvalidCache;
+    if (try decoder.readInt(u64) != ast_layout_hash) return error.InvalidCache;
+
+    const declarations = try decoder.read([]ast.TopLevelDecl);
+    if (decoder.pos != bytes.len) return error.InvalidCache;
+    return declarations;
+}
+
+// ============================================================================
+// 基于 comptime 反射的 AST 编解码
+// ============================================================================
+
+const Encoder = struct {
+    allocator: std.mem.Allocator,
+    buf: std.ArrayList(u8) = .{},
+
+    fn writeInt(self: *Encoder, comptime T: type, value: T) std.mem.Allocator.Error!void {
+        var bytes: [@sizeOf(T)]u8 = undefined;
+        std.mem.writeInt(T, &bytes, value, .little);
+        try self.buf.appendSlice(self.allocator, &bytes);
+    }
+
+    fn write(self: *Encoder, comptime T: type, value: T) std.mem.Allocator.Error!void {
+        switch (@typeInfo(T)) {
+            .void => {},
+            .bool => try self.buf.append(self.allocator, @intFromBool(value)),
+            .int => |info| {
+                if (info.signedness == .signed) {
+                    try self.writeInt(i64, @intCast(value));
+                } else {
+                    try self.writeInt(u64, @intCast(value));
+                }
+            },
+            .float => try self.writeInt(u64, @bitCast(@as(f64, @floatCast(value)))),
+            .@"enum" => try self.writeInt(u32, @intCast(@intFromEnum(value))),
+            .optional => |info| {
+                if (value) |payload| {
+                    try self.buf.append(self.allocator, 1);
+                    try self.write(info.child, payload);
+                } else {
+                    try self.buf.append(self.allocator, 0);
+                }
+            },
+            .pointer => |info| switch (info.size) {
+                .one => try self.write(info.child, value.*),
+                .slice => {
+                    try self.writeInt(u64, value.len);
+                    if (info.child == u8) {
+                        try self.buf.appendSlice(self.allocator, value);
+                    } else {
+                        for (value) |elem| {
+                            try self.write(info.child, elem);
+                        }
+                    }
+                },
+                else => @compileError("module cache: unsupported pointer type " ++ @typeName(T)),
+            },
+            .@"struct" => |info| {
+                inline for (info.fields) |field| {
+                    try self.write(field.type, @field(value, field.name));
+                }
+            },
+            .@"union" => |info| {
+                const Tag = info.tag_type orelse @compileError("module cache: untagged union " ++ @typeName(T));
+                try self.writeInt(u32, @intCast(@intFromEnum(@as(Tag, value))));
+                switch (value) {
+                    inline else => |payload| try self.write(@TypeOf(payload), payload),
+                }
+            },
+            else => @compileError("module cache: unsupported type " ++ @typeName(T)),
+        }
+    }
+};
+
+const Decoder = struct {
+    bytes: []const u8,
+    pos: usize = 0,
+    arena: std.mem.Allocator,
+
+    fn take(self: *Decoder, len: usize) DecodeError![]const u8 {
+        if (len > self.bytes.len - self.pos) return error.InvalidCache;
+        const slice = self.bytes[self.pos .. self.pos + len];
+        self.pos += len;
+        return slice;
+    }
+
+    fn readInt(self: *Decoder, comptime T: type) DecodeError!T {
+        const slice = try self.take(@sizeOf(T));
+        return std.mem.readInt(T, slice[0..@sizeOf(T)], .little);
+    }
+
+    fn read(self: *Decoder, comptime T: type) DecodeError!T {
+        switch (@typeInfo(T)) {
+            .void => return {},
+            .bool => return switch ((try self.take(1))[0]) {
+                0 => false,
+                1 => true,
+                else => error.InvalidCache,
+            },
+            .int => |info| {
+                if (info.signedness == .signed) {
+                    return std.math.cast(T, try self.readInt(i64)) orelse error.InvalidCache;
+                } else {
+                    return std.math.cast(T, try self.readInt(u64)) orelse error.InvalidCache;
+                }
+            },
+            .float => return @floatCast(@as(f64, @bitCast(try self.readInt(u64)))),
+            .@"enum" => |info| {
+                const raw = try self.readInt(u32);
+                inline for (info.fields) |field| {
+                    if (raw == field.value) return @field(T, field.name);
+                }
+                return error.InvalidCache;
+            },
+            .optional => |info| {
+                return switch ((try self.take(1))[0]) {
+                    0 => null,
+                    1 => try self.read(info.child),
+                    else => error.InvalidCache,
+                };
+            },
+            .pointer => |info| switch (info.size) {
+                .one => {
+                    const ptr = try self.arena.create(info.child);
+                    ptr.* = try self.read(info.child);
+                    return ptr;
+                },
+                .slice => {
+                    const len = std.math.cast(usize, try self.readInt(u64)) orelse return error.InvalidCache;
+                    // 每个元素至少占 1 字节，长度超过剩余数据一定是损坏的缓存
+                    if (len > self.bytes.len - self.pos) return error.InvalidCache;
+                    if (info.child == u8) {
+                        return try self.arena.dupe(u8, try self.take(len));
+                    }
+                    const items = try self.arena.alloc(info.child, len);
+                    for (items) |*item| {
+                        item.* = try self.read(info.child);
+                    }
+                    return items;
+                },
+                else => @compileError("module cache: unsupported pointer type " ++ @typeName(T)),
+            },
+            .@"struct" => |info| {
+                var result: T = undefined;
+                inline for (info.fields) |field| {
+                    @field(result, field.name) = try self.read(field.type);
+                }
+                return result;
+            },
+            .@"union" => |info| {
+                const Tag = info.tag_type orelse @compileError("module cache: untagged union " ++ @typeName(T));
+                const raw = try self.readInt(u32);
+                inline for (info.fields) |field| {
+                    if (raw == @intFromEnum(@field(Tag, field.name))) {
+                        return @unionInit(T, field.name, try self.read(field.type));
+                    }
+                }
+                return error.InvalidCache;
+            },
+            else => @compileError("module cache: unsupported type " ++ @typeName(T)),
+        }
+    }
+};
@@ -0,0 +1,984 @@
+//! 🆕 v0.2.0: AST Optimizer - 后端无关的程序级优化
+//!
+//! 类型检查之后、代码生成之前运行，C 后端和 LLVM 后端（包括 JIT）拿到的是同一份
+//! 优化后的程序：
+//!   1. 内联：函数体只有若干 `let` 加一个 `return` 表达式、只用到参数和标量运算的小函数
+//!      （is_digit、char_equals 这类 prelude 函数，以及用户的 square(x) 等），
+//!      在参数都是字面量 / 变量 / 字段访问的调用处展开为表达式
+//!   2. 常量折叠：i32 字面量的算术和比较、bool 字面量的逻辑运算、
+//!      `-字面量`、`!字面量`、`字面量 as 同类型`
+//!   3. 删除未使用的 prelude 声明：从用户代码出发，找不到引用的 prelude 函数
+//!      （包括运行时 extern 声明）和结构体类型不再交给后端
+//!
+//! 语义约定与两个后端一致：整数字面量是 i32，带符号运算；会溢出、除零的表达式不折叠，
+//! 交给后端按原样生成。浮点运算不折叠（f32 上下文中先按 f64 计算会有二次舍入）。
+//! 后端按所在位置的类型生成整数字面量（`let x: u32 = (0 - 1) / 2` 按 u32 计算），
+//! 因此整数运算只在确定是 i32 的位置折叠：无标注的 let、i32 的标注 / 返回类型 / 形参、
+//! 另一侧是 i32 的运算数；其他位置原样交给后端。
+//!
+//! 优化不修改输入的 AST：prelude 和导入模块的 AST 在 pawc serve / pawc lsp 中跨请求复用。
+//! 改写过的节点分配在 Optimizer 的 arena 中，没有变化的子树直接共享。
+
+const std = @import("std");
+const ast = @import("ast.zig");
+
+pub const Stats = struct {
+    inlined: usize = 0,  // 展开的调用
+    folded: usize = 0,   // 折叠的表达式
+    removed: usize = 0,  // 删除的 prelude 声明
+};
+
+/// 可内联函数的表达式节点数上限
+const max_inline_nodes = 32;
+
+/// 可以内联的函数：body 中的 let 已经展开，只引用参数
+const Inlinable = struct {
+    params: []const ast.Param,
+    body: ast.Expr,
+    return_type: ast.Type,
+};
+
+const Error = std.mem.Allocator.Error;
+
+pub const Optimizer = struct {
+    arena: std.heap.ArenaAllocator,
+    inline_table: std.StringHashMap(Inlinable),
+    signatures: std.StringHashMap([]const ast.Param),  // 顶层函数的形参（实参的折叠上下文）
+    locals: std.StringHashMap(?ast.Type),  // 当前函数中的名字 -> 类型（null = 不确定）
+    return_type: ast.Type = .void,
+    fold_ints: bool = true,  // 当前位置的整数字面量是否是 i32
+    stats: Stats = .{},
+
+    pub fn init(allocator: std.mem.Allocator) Optimizer {
+        return Optimizer{
+            .arena = std.heap.ArenaAllocator.init(allocator),
+            .inline_table = std.StringHashMap(Inlinable).init(allocator),
+            .signatures = std.StringHashMap([]const ast.Param).init(allocator),
+            .locals = std.StringHashMap(?ast.Type).init(allocator),
+        };
+    }
+
+    /// 释放优化后程序中新分配的节点（返回的 Program 随之失效）
+    pub fn deinit(self: *Optimizer) void {
+        self.locals.deinit();
+        self.signatures.deinit();
+        self.inline_table.deinit();
+        self.arena.deinit();
+    }
+
+    /// 优化整个程序
+    /// program.declarations 的前 prelude_len 项是 prelude 的声明（main.zig 中的顺序）
+    pub fn optimize(self: *Optimizer, program: ast.Program, prelude_len: usize) Error!ast.Program {
+        try self.collectInlinable(program.declarations);
+
+        const arena = self.arena.allocator();
+        const rewritten = try arena.alloc(ast.TopLevelDecl, program.declarations.len);
+        for (program.declarations, rewritten) |decl, *out| {
+            out.* = try self.rewriteDecl(decl);
+        }
+
+        return .{ .declarations = try self.removeUnusedPrelude(rewritten, @min(prelude_len, rewritten.len)) };
+    }
+
+    // ========================================================================
+    // 内联
+    // ========================================================================
+
+    /// 登记所有可以内联的顶层函数；同名函数出现多次时都不内联
+    fn collectInlinable(self: *Optimizer, declarations: []const ast.TopLevelDecl) Error!void {
+        var seen = std.StringHashMap(void).init(self.inline_table.allocator);
+        defer seen.deinit();
+
+        for (declarations) |decl| {
+            if (decl != .function) continue;
+            const func = decl.function;
+            if ((try seen.getOrPut(func.name)).found_existing) {
+                _ = self.inline_table.remove(func.name);
+                _ = self.signatures.remove(func.name);
+                continue;
+            }
+            if (func.type_params.len == 0) try self.signatures.put(func.name, func.params);
+            if (try self.inlineBody(func)) |body| {
+                try self.inline_table.put(func.name, .{
+                    .params = func.params,
+                    .body = body,
+                    .return_type = func.return_type,
+                });
+            }
+        }
+    }
+
+    /// 函数是否足够简单：返回展开了 let 之后的返回表达式
+    fn inlineBody(self: *Optimizer, func: ast.FunctionDecl) Error!?ast.Expr {
+        if (func.is_extern or func.is_async or func.type_params.len > 0) return null;
+        if (!isScalar(func.return_type) or func.body.len == 0) return null;
+        for (func.params) |param| {
+            if (!isScalar(param.type)) return null;
+        }
+
+        // let 名 -> 展开后的表达式
+        var env = std.StringHashMap(ast.Expr).init(self.inline_table.allocator);
+        defer env.deinit();
+
+        for (func.body[0 .. func.body.len - 1]) |stmt| {
+            if (stmt != .let_decl) return null;
+            const let = stmt.let_decl;
+            const init_expr = let.init orelse return null;
+            if (let.type) |t| if (!isScalar(t)) return null;
+            if (paramIndex(func.params, let.name) != null or env.contains(let.name)) return null;
+
+            var value = (try self.expandLocals(init_expr, func.params, &env)) orelse return null;
+            if (let.type) |t| {
+                if (!(value == .as_expr and value.as_expr.target_type.eql(t))) value = try self.cast(value, t);
+            }
+            try env.put(let.name, value);
+        }
+
+        const result = switch (func.body[func.body.len - 1]) {
+            .return_stmt => |ret| ret orelse return null,
+            .expr => |e| e,  // 末尾表达式即返回值
+            else => return null,
+        };
+        const body = (try self.expandLocals(result, func.params, &env)) orelse return null;
+        if (countNodes(body) > max_inline_nodes) return null;
+        return body;
+    }
+
+    /// 把 let 名替换为其表达式；遇到参数和 let 以外的名字、调用等不可内联的节点时返回 null
+    fn expandLocals(
+        self: *Optimizer,
+        expr: ast.Expr,
+        params: []const ast.Param,
+        env: *const std.StringHashMap(ast.Expr),
+    ) Error!?ast.Expr {
+        return switch (expr) {
+            .int_literal, .float_literal, .bool_literal, .char_literal, .string_literal => expr,
+            .identifier => |name| if (env.get(name)) |value|
+                value
+            else if (paramIndex(params, name) != null)
+                expr
+            else
+                null,
+            .binary => |bin| blk: {
+                const left = (try self.expandLocals(bin.left.*, params, env)) orelse break :blk null;
+                const right = (try self.expandLocals(bin.right.*, params, env)) orelse break :blk null;
+                break :blk ast.Expr{ .binary = .{ .left = try self.box(left), .op = bin.op, .right = try self.box(right) } };
+            },
+            .unary => |un| blk: {
+                const operand = (try self.expandLocals(un.operand.*, params, env)) orelse break :blk null;
+                break :blk ast.Expr{ .unary = .{ .op = un.op, .operand = try self.box(operand) } };
+            },
+            .as_expr => |as_cast| blk: {
+                if (!isScalar(as_cast.target_type)) break :blk null;
+                const value = (try self.expandLocals(as_cast.value.*, params, env)) orelse break :blk null;
+                break :blk try self.cast(value, as_cast.target_type);
+            },
+            else => null,
+        };
+    }
+
+    /// 调用处展开：参数替换为 `(实参 as 形参类型)`，结果转换为返回类型，
+    /// 这样后端推导出的类型与原来的调用完全一致
+    fn expandCall(self: *Optimizer, target: Inlinable, args: []const ast.Expr) Error!ast.Expr {
+        const body = try self.substitute(target.body, target.params, args);
+        return self.cast(body, target.return_type);
+    }
+
+    fn substitute(self: *Optimizer, expr: ast.Expr, params: []const ast.Param, args: []const ast.Expr) Error!ast.Expr {
+        return switch (expr) {
+            .identifier => |name| if (paramIndex(params, name)) |i|
+                try self.cast(args[i], params[i].type)
+            else
+                expr,
+            .binary => |bin| .{ .binary = .{
+                .left = try self.box(try self.substitute(bin.left.*, params, args)),
+                .op = bin.op,
+                .right = try self.box(try self.substitute(bin.right.*, params, args)),
+            } },
+            .unary => |un| .{ .unary = .{
+                .op = un.op,
+                .operand = try self.box(try self.substitute(un.operand.*, params, args)),
+            } },
+            .as_expr => |as_cast| try self.cast(try self.substitute(as_cast.value.*, params, args), as_cast.target_type),
+            else => expr,
+        };
+    }
+
+    /// 实参是否可以在展开后的表达式中重复出现（没有副作用、求值代价可以忽略）
+    fn isAtomic(expr: ast.Expr) bool {
+        return switch (expr) {
+            .int_literal, .float_literal, .bool_literal, .char_literal, .string_literal, .identifier => true,
+            .field_access => |fa| isAtomic(fa.object.*),
+            else => false,
+        };
+    }
+
+    // ========================================================================
+    // 改写（内联 + 常量折叠）
+    // ========================================================================
+
+    fn rewriteDecl(self: *Optimizer, decl: ast.TopLevelDecl) Error!ast.TopLevelDecl {
+        return switch (decl) {
+            .function => |func| .{ .function = try self.rewriteFunction(func) },
+            .type_decl => |td| blk: {
+                var copy = td;
+                switch (td.kind) {
+                    .struct_type => |st| copy.kind = .{ .struct_type = .{
+                        .fields = st.fields,
+                        .methods = try self.rewriteMethods(st.methods),
+                    } },
+                    .enum_type => |et| copy.kind = .{ .enum_type = .{
+                        .variants = et.variants,
+                        .methods = try self.rewriteMethods(et.methods),
+                    } },
+                    .trait_type => {},
+                }
+                break :blk .{ .type_decl = copy };
+            },
+            .struct_decl => |sd| blk: {
+                var copy = sd;
+                copy.methods = try self.rewriteMethods(sd.methods);
+                break :blk .{ .struct_decl = copy };
+            },
+            .enum_decl => |ed| blk: {
+                var copy = ed;
+                copy.methods = try self.rewriteMethods(ed.methods);
+                break :blk .{ .enum_decl = copy };
+            },
+            .impl_decl => |id| blk: {
+                var copy = id;
+                copy.methods = try self.rewriteMethods(id.methods);
+                break :blk .{ .impl_decl = copy };
+            },
+            .trait_decl, .import_decl => decl,
+        };
+    }
+
+    fn rewriteFunction(self: *Optimizer, func: ast.FunctionDecl) Error!ast.FunctionDecl {
+        var copy = func;
+        if (try self.rewriteBody(func)) |body| copy.body = body;
+        return copy;
+    }
+
+    fn rewriteMethods(self: *Optimizer, methods: []ast.FunctionDecl) Error![]ast.FunctionDecl {
+        var out: ?[]ast.FunctionDecl = null;
+        for (methods, 0..) |method, i| {
+            const body = (try self.rewriteBody(method)) orelse continue;
+            if (out == null) out = try self.arena.allocator().dupe(ast.FunctionDecl, methods);
+            out.?[i].body = body;
+        }
+        return out orelse methods;
+    }
+
+    /// 改写函数体：形参的类型作为折叠上下文
+    fn rewriteBody(self: *Optimizer, func: ast.FunctionDecl) Error!?[]ast.Stmt {
+        self.locals.clearRetainingCapacity();
+        for (func.params) |param| try self.declareLocal(param.name, param.type);
+        self.return_type = func.return_type;
+        return self.rewriteStmts(func.body);
+    }
+
+    /// 登记局部名的类型；同名的声明类型不一致时（不同作用域中的遮蔽）记为不确定
+    fn declareLocal(self: *Optimizer, name: []const u8, t: ?ast.Type) Error!void {
+        const entry = try self.locals.getOrPut(name);
+        if (entry.found_existing) {
+            const same = if (entry.value_ptr.*) |old| (if (t) |new| old.eql(new) else false) else false;
+            if (!same) entry.value_ptr.* = null;
+        } else {
+            entry.value_ptr.* = t;
+        }
+    }
+
+    /// 在给定的折叠上下文中改写表达式
+    fn rewriteIn(self: *Optimizer, expr: ast.Expr, fold_ints: bool) Error!?ast.Expr {
+        const saved = self.fold_ints;
+        self.fold_ints = fold_ints;
+        defer self.fold_ints = saved;
+        return self.rewriteExpr(expr);
+    }
+
+    fn rewriteChildIn(self: *Optimizer, expr: *ast.Expr, fold_ints: bool) Error!?*ast.Expr {
+        const new = (try self.rewriteIn(expr.*, fold_ints)) orelse return null;
+        return try self.box(new);
+    }
+
+    fn rewriteExprsIn(self: *Optimizer, exprs: []ast.Expr, fold_ints: bool) Error!?[]ast.Expr {
+        const saved = self.fold_ints;
+        self.fold_ints = fold_ints;
+        defer self.fold_ints = saved;
+        return self.rewriteExprs(exprs);
+    }
+
+    /// 表达式是否确定是 i32（决定另一侧运算数中字面量的类型）
+    fn isI32(self: *Optimizer, expr: ast.Expr) bool {
+        return switch (expr) {
+            .identifier => |name| if (self.locals.get(name)) |t| (if (t) |known| known == .i32 else false) else false,
+            .as_expr => |as_cast| as_cast.target_type == .i32,
+            .call => |call| call.callee.* == .identifier and call.type_args.len == 0 and
+                (if (self.inline_table.get(call.callee.identifier)) |target| target.return_type == .i32 else false),
+            else => isIntConstant(expr),
+        };
+    }
+
+    /// 二元运算两侧的折叠上下文：两侧都是整数常量时沿用外层上下文（比较运算的结果是 bool，
+    /// 字面量按默认的 i32），否则由另一侧的类型决定
+    fn operandContext(self: *Optimizer, op: ast.BinaryOp, side: ast.Expr, other: ast.Expr) bool {
+        if (op == .and_op or op == .or_op) return true;
+        if (isIntConstant(side) and isIntConstant(other)) return isComparison(op) or self.fold_ints;
+        return self.isI32(other);
+    }
+
+    /// 改写语句列表；没有任何变化时返回 null
+    fn rewriteStmts(self: *Optimizer, stmts: []ast.Stmt) Error!?[]ast.Stmt {
+        var out: ?[]ast.Stmt = null;
+        for (stmts, 0..) |stmt, i| {
+            const new = (try self.rewriteStmt(stmt)) orelse continue;
+            if (out == null) out = try self.arena.allocator().dupe(ast.Stmt, stmts);
+            out.?[i] = new;
+        }
+        return out;
+    }
+
+    fn rewriteStmt(self: *Optimizer, stmt: ast.Stmt) Error!?ast.Stmt {
+        switch (stmt) {
+            // 语句表达式可能是块的值，类型不确定
+            .expr => |e| return if (try self.rewriteIn(e, false)) |new| .{ .expr = new } else null,
+            .let_decl => |let| {
+                // 没有标注时类型由初始值推导：常量按 i32
+                const init_type: ?ast.Type = if (let.type) |t| t else if (let.init) |e| (if (isIntConstant(e)) .i32 else null) else null;
+                try self.declareLocal(let.name, init_type);
+                const init_expr = let.init orelse return null;
+                var copy = let;
+                copy.init = (try self.rewriteIn(init_expr, if (let.type) |t| t == .i32 else true)) orelse return null;
+                return .{ .let_decl = copy };
+            },
+            // 赋值目标是左值，只改写右侧
+            .assign => |assign| {
+                var copy = assign;
+                copy.value = (try self.rewriteIn(assign.value, self.isI32(assign.target))) orelse return null;
+                return .{ .assign = copy };
+            },
+            .compound_assign => |ca| {
+                var copy = ca;
+                copy.value = (try self.rewriteIn(ca.value, self.isI32(ca.target))) orelse return null;
+                return .{ .compound_assign = copy };
+            },
+            .return_stmt => |ret| {
+                const value = ret orelse return null;
+                return .{ .return_stmt = (try self.rewriteIn(value, self.return_type == .i32)) orelse return null };
+            },
+            .break_stmt => |brk| {
+                const value = brk orelse return null;
+                return .{ .break_stmt = (try self.rewriteIn(value, false)) orelse return null };
+            },
+            .continue_stmt => return null,
+            .loop_stmt => |loop| {
+                const condition = if (loop.condition) |c| try self.rewriteIn(c, true) else null;
+                const iterable = if (loop.iterator) |it| try self.rewriteIn(it.iterable, true) else null;
+                const body = try self.rewriteStmts(loop.body);
+                if (condition == null and iterable == null and body == null) return null;
+                var copy = loop;
+                if (condition) |c| copy.condition = c;
+                if (iterable) |it| copy.iterator.?.iterable = it;
+                if (body) |b| copy.body = b;
+                return .{ .loop_stmt = copy };
+            },
+            .while_loop => |loop| {
+                const condition = try self.rewriteIn(loop.condition, true);
+                const body = try self.rewriteStmts(loop.body);
+                if (condition == null and body == null) return null;
+                return .{ .while_loop = .{
+                    .condition = condition orelse loop.condition,
+                    .body = body orelse loop.body,
+                } };
+            },
+            .for_loop => |loop| {
+                const init_stmt = if (loop.init) |s| try self.rewriteStmt(s.*) else null;
+                const condition = if (loop.condition) |c| try self.rewriteIn(c, true) else null;
+                const step = if (loop.step) |s| try self.rewriteIn(s, false) else null;
+                const body = try self.rewriteStmts(loop.body);
+                if (init_stmt == null and condition == null and step == null and body == null) return null;
+                var copy = loop;
+                if (init_stmt) |s| {
+                    const ptr = try self.arena.allocator().create(ast.Stmt);
+                    ptr.* = s;
+                    copy.init = ptr;
+                }
+                if (condition) |c| copy.condition = c;
+                if (step) |s| copy.step = s;
+                if (body) |b| copy.body = b;
+                return .{ .for_loop = copy };
+            },
+        }
+    }
+
+    /// 改写子表达式；没有变化时返回 null
+    fn rewriteChild(self: *Optimizer, expr: *ast.Expr) Error!?*ast.Expr {
+        const new = (try self.rewriteExpr(expr.*)) orelse return null;
+        return try self.box(new);
+    }
+
+    fn rewriteExprs(self: *Optimizer, exprs: []ast.Expr) Error!?[]ast.Expr {
+        var out: ?[]ast.Expr = null;
+        for (exprs, 0..) |expr, i| {
+            const new = (try self.rewriteExpr(expr)) orelse continue;
+            if (out == null) out = try self.arena.allocator().dupe(ast.Expr, exprs);
+            out.?[i] = new;
+        }
+        return out;
+    }
+
+    /// 改写调用的实参：已知签名的函数按形参类型确定上下文，其余不折叠整数
+    fn rewriteArgs(self: *Optimizer, call: @FieldType(ast.Expr, "call")) Error!?[]ast.Expr {
+        const params: []const ast.Param = if (call.callee.* == .identifier and call.type_args.len == 0)
+            self.signatures.get(call.callee.identifier) orelse &.{}
+        else
+            &.{};
+        var out: ?[]ast.Expr = null;
+        for (call.args, 0..) |arg, i| {
+            const fold_ints = i < params.len and params[i].type == .i32;
+            const new = (try self.rewriteIn(arg, fold_ints)) orelse continue;
+            if (out == null) out = try self.arena.allocator().dupe(ast.Expr, call.args);
+            out.?[i] = new;
+        }
+        return out;
+    }
+
+    /// 改写表达式；没有变化时返回 null
+    fn rewriteExpr(self: *Optimizer, expr: ast.Expr) Error!?ast.Expr {
+        switch (expr) {
+            .binary => |bin| {
+                const left = try self.rewriteChildIn(bin.left, self.operandContext(bin.op, bin.left.*, bin.right.*));
+                const right = try self.rewriteChildIn(bin.right, self.operandContext(bin.op, bin.right.*, bin.left.*));
+                const lhs = if (left) |l| l.* else bin.left.*;
+                const rhs = if (right) |r| r.* else bin.right.*;
+                if (foldBinary(bin.op, lhs, rhs, isComparison(bin.op) or self.fold_ints)) |folded| {
+                    self.stats.folded += 1;
+                    return folded;
+                }
+                if (left == null and right == null) return null;
+                return .{ .binary = .{ .left = left orelse bin.left, .op = bin.op, .right = right orelse bin.right } };
+            },
+            .unary => |un| {
+                const operand = try self.rewriteChild(un.operand);
+                if (foldUnary(un.op, if (operand) |o| o.* else un.operand.*, self.fold_ints)) |folded| {
+                    self.stats.folded += 1;
+                    return folded;
+                }
+                return .{ .unary = .{ .op = un.op, .operand = operand orelse return null } };
+            },
+            // 转换的操作数按目标类型处理（内联展开的形参 / 返回值转换就是这样的位置）
+            .as_expr => |as_cast| {
+                const value = try self.rewriteChildIn(as_cast.value, as_cast.target_type == .i32);
+                if (foldCast(if (value) |v| v.* else as_cast.value.*, as_cast.target_type)) |folded| {
+                    self.stats.folded += 1;
+                    return folded;
+                }
+                return .{ .as_expr = .{ .value = value orelse return null, .target_type = as_cast.target_type } };
+            },
+            .call => |call| {
+                const callee = try self.rewriteChild(call.callee);
+                const args = try self.rewriteArgs(call);
+                const final_args = args orelse call.args;
+
+                if (call.callee.* == .identifier and call.type_args.len == 0) {
+                    if (self.inline_table.get(call.callee.identifier)) |target| {
+                        if (target.params.len == final_args.len and allAtomic(final_args)) {
+                            self.stats.inlined += 1;
+                            const expanded = try self.expandCall(target, final_args);
+                            return (try self.rewriteExpr(expanded)) orelse expanded;
+                        }
+                    }
+                }
+
+                if (callee == null and args == null) return null;
+                var copy = call;
+                copy.callee = callee orelse call.callee;
+                copy.args = final_args;
+                return .{ .call = copy };
+            },
+            .static_method_call => |smc| {
+                var copy = smc;
+                copy.args = (try self.rewriteExprsIn(smc.args, false)) orelse return null;
+                return .{ .static_method_call = copy };
+            },
+            .field_access => |fa| {
+                var copy = fa;
+                copy.object = (try self.rewriteChildIn(fa.object, false)) orelse return null;
+                return .{ .field_access = copy };
+            },
+            .struct_init => |si| {
+                var out: ?[]ast.StructFieldInit = null;
+                for (si.fields, 0..) |field, i| {
+                    const value = (try self.rewriteIn(field.value, false)) orelse continue;
+                    if (out == null) out = try self.arena.allocator().dupe(ast.StructFieldInit, si.fields);
+                    out.?[i].value = value;
+                }
+                var copy = si;
+                copy.fields = out orelse return null;
+                return .{ .struct_init = copy };
+            },
+            .enum_variant => |ev| {
+                var copy = ev;
+                copy.args = (try self.rewriteExprsIn(ev.args, false)) orelse return null;
+                return .{ .enum_variant = copy };
+            },
+            .block => |stmts| return .{ .block = (try self.rewriteStmts(stmts)) orelse return null },
+            .if_expr => |ie| {
+                const condition = try self.rewriteChildIn(ie.condition, true);
+                const then_branch = try self.rewriteChild(ie.then_branch);
+                const else_branch = if (ie.else_branch) |e| try self.rewriteChild(e) else null;
+                if (condition == null and then_branch == null and else_branch == null) return null;
+                return .{ .if_expr = .{
+                    .condition = condition orelse ie.condition,
+                    .then_branch = then_branch orelse ie.then_branch,
+                    .else_branch = else_branch orelse ie.else_branch,
+                } };
+            },
+            .is_expr => |is_e| {
+                const value = try self.rewriteChildIn(is_e.value, true);
+                var arms: ?[]ast.IsArm = null;
+                for (is_e.arms, 0..) |arm, i| {
+                    const guard = if (arm.guard) |g| try self.rewriteIn(g, true) else null;
+                    const body = try self.rewriteExpr(arm.body);
+                    if (guard == null and body == null) continue;
+                    if (arms == null) arms = try self.arena.allocator().dupe(ast.IsArm, is_e.arms);
+                    if (guard) |g| arms.?[i].guard = g;
+                    if (body) |b| arms.?[i].body = b;
+                }
+                if (value == null and arms == null) return null;
+                return .{ .is_expr = .{ .value = value orelse is_e.value, .arms = arms orelse is_e.arms } };
+            },
+            .match_expr => |me| {
+                const value = try self.rewriteChildIn(me.value, true);
+                var arms: ?[]ast.MatchArm = null;
+                for (me.arms, 0..) |arm, i| {
+                    const body = (try self.rewriteExpr(arm.body)) orelse continue;
+                    if (arms == null) arms = try self.arena.allocator().dupe(ast.MatchArm, me.arms);
+                    arms.?[i].body = body;
+                }
+                if (value == null and arms == null) return null;
+                return .{ .match_expr = .{ .value = value orelse me.value, .arms = arms orelse me.arms } };
+            },
+            .await_expr => |inner| return .{ .await_expr = (try self.rewriteChildIn(inner, false)) orelse return null },
+            .try_expr => |inner| return .{ .try_expr = (try self.rewriteChildIn(inner, false)) orelse return null },
+            .array_literal => |elems| return .{ .array_literal = (try self.rewriteExprsIn(elems, false)) orelse return null },
+            .array_index => |ai| {
+                const array = try self.rewriteChildIn(ai.array, false);
+                const index = try self.rewriteChildIn(ai.index, false);
+                if (array == null and index == null) return null;
+                return .{ .array_index = .{ .array = array orelse ai.array, .index = index orelse ai.index } };
+            },
+            .range => |rng| {
+                const start = try self.rewriteChildIn(rng.start, self.operandContext(.lt, rng.start.*, rng.end.*));
+                const end = try self.rewriteChildIn(rng.end, self.operandContext(.lt, rng.end.*, rng.start.*));
+                if (start == null and end == null) return null;
+                return .{ .range = .{ .start = start orelse rng.start, .end = end orelse rng.end, .inclusive = rng.inclusive } };
+            },
+            .string_interp => |si| {
+                var parts: ?[]ast.StringInterpPart = null;
+                for (si.parts, 0..) |part, i| {
+                    if (part != .expr) continue;
+                    const value = (try self.rewriteIn(part.expr, true)) orelse continue;
+                    if (parts == null) parts = try self.arena.allocator().dupe(ast.StringInterpPart, si.parts);
+                    parts.?[i] = .{ .expr = value };
+                }
+                return .{ .string_interp = .{ .parts = parts orelse return null } };
+            },
+            .int_literal, .float_literal, .string_literal, .char_literal, .bool_literal, .identifier => return null,
+        }
+    }
+
+    // ========================================================================
+    // 删除未使用的 prelude 声明
+    // ========================================================================
+
+    /// prelude 中可以删除的声明：函数和结构体类型
+    /// （枚举保留：Result / Option 被 `?` 的代码生成隐式使用）
+    fn removableName(decl: ast.TopLevelDecl) ?[]const u8 {
+        return switch (decl) {
+            .function => |func| func.name,
+            .type_decl => |td| if (td.kind == .struct_type) td.name else null,
+            .struct_decl => |sd| sd.name,
+            else => null,
+        };
+    }
+
+    fn removeUnusedPrelude(self: *Optimizer, declarations: []ast.TopLevelDecl, prelude_len: usize) Error![]ast.TopLevelDecl {
+        var usage = Usage.init(self.inline_table.allocator);
+        defer usage.deinit();
+
+        const kept = try self.inline_table.allocator.alloc(bool, prelude_len);
+        defer self.inline_table.allocator.free(kept);
+
+        // 根：用户代码、导入的声明，以及 prelude 中不可删除的声明
+        for (declarations, 0..) |decl, i| {
+            if (i < prelude_len) {
+                kept[i] = removableName(decl) == null;
+                if (!kept[i]) continue;
+            }
+            try usage.scanDecl(decl);
+        }
+
+        // 不动点：被引用的 prelude 声明保留下来，并继续扫描它引用的名字
+        var changed = true;
+        while (changed) {
+            changed = false;
+            for (declarations[0..prelude_len], kept) |decl, *keep| {
+                if (keep.*) continue;
+                if (!usage.names.contains(removableName(decl).?)) continue;
+                keep.* = true;
+                changed = true;
+                try usage.scanDecl(decl);
+            }
+        }
+
+        var out = std.ArrayList(ast.TopLevelDecl){};
+        try out.ensureTotalCapacityPrecise(self.arena.allocator(), declarations.len);
+        for (declarations, 0..) |decl, i| {
+            if (i < prelude_len and !kept[i]) {
+                self.stats.removed += 1;
+                continue;
+            }
+            out.appendAssumeCapacity(decl);
+        }
+        return out.items;
+    }
+
+    // ========================================================================
+    // 辅助函数
+    // ========================================================================
+
+    fn box(self: *Optimizer, expr: ast.Expr) Error!*ast.Expr {
+        const ptr = try self.arena.allocator().create(ast.Expr);
+        ptr.* = expr;
+        return ptr;
+    }
+
+    fn cast(self: *Optimizer, expr: ast.Expr, target: ast.Type) Error!ast.Expr {
+        return .{ .as_expr = .{ .value = try self.box(expr), .target_type = target } };
+    }
+};
+
+/// 标量类型：内联时用 `as` 固定类型，两个后端都支持这些类型之间的转换
+fn isScalar(t: ast.Type) bool {
+    return switch (t) {
+        .i8, .i16, .i32, .i64, .i128,
+        .u8, .u16, .u32, .u64, .u128,
+        .f32, .f64, .bool, .char => true,
+        else => false,
+    };
+}
+
+fn paramIndex(params: []const ast.Param, name: []const u8) ?usize {
+    for (params, 0..) |param, i| {
+        if (std.mem.eql(u8, param.name, name)) return i;
+    }
+    return null;
+}
+
+fn allAtomic(args: []const ast.Expr) bool {
+    for (args) |arg| {
+        if (!Optimizer.isAtomic(arg)) return false;
+    }
+    return true;
+}
+
+fn countNodes(expr: ast.Expr) usize {
+    return 1 + switch (expr) {
+        .binary => |bin| countNodes(bin.left.*) + countNodes(bin.right.*),
+        .unary => |un| countNodes(un.operand.*),
+        .as_expr => |as_cast| countNodes(as_cast.value.*),
+        else => 0,
+    };
+}
+
+// ============================================================================
+// 常量折叠
+// ============================================================================
+
+/// 整数字面量按 i32 处理（两个后端都这样生成），超出 i32 的字面量不参与折叠
+fn asI32(expr: ast.Expr) ?i32 {
+    if (expr != .int_literal) return null;
+    return std.math.cast(i32, expr.int_literal);
+}
+
+/// 折叠结果；不产生 minInt(i32)（C 中的 -2147483648 不是 int 字面量）
+fn intResult(value: i32) ?ast.Expr {
+    if (value == std.math.minInt(i32)) return null;
+    return .{ .int_literal = value };
+}
+
+/// 由整数字面量和算术运算组成、可以整体折叠的表达式
+fn isIntConstant(expr: ast.Expr) bool {
+    return switch (expr) {
+        .int_literal => true,
+        .unary => |un| un.op == .neg and isIntConstant(un.operand.*),
+        .binary => |bin| !isComparison(bin.op) and bin.op != .and_op and bin.op != .or_op and
+            isIntConstant(bin.left.*) and isIntConstant(bin.right.*),
+        else => false,
+    };
+}
+
+fn isComparison(op: ast.BinaryOp) bool {
+    return switch (op) {
+        .eq, .ne, .lt, .le, .gt, .ge => true,
+        else => false,
+    };
+}
+
+/// fold_ints = false 时（字面量不是 i32 的位置）整数运算不折叠
+fn foldBinary(op: ast.BinaryOp, lhs: ast.Expr, rhs: ast.Expr, fold_ints: bool) ?ast.Expr {
+    if (asI32(lhs)) |a| {
+        const b = asI32(rhs) orelse return null;
+        if (!fold_ints) return null;
+        return switch (op) {
+            .add => if (@addWithOverflow(a, b)[1] == 0) intResult(a + b) else null,
+            .sub => if (@subWithOverflow(a, b)[1] == 0) intResult(a - b) else null,
+            .mul => if (@mulWithOverflow(a, b)[1] == 0) intResult(a * b) else null,
+            .div => if (b == 0 or (a == std.math.minInt(i32) and b == -1)) null else intResult(@divTrunc(a, b)),
+            .mod => if (b == 0 or (a == std.math.minInt(i32) and b == -1)) null else intResult(@rem(a, b)),
+            .eq => .{ .bool_literal = a == b },
+            .ne => .{ .bool_literal = a != b },
+            .lt => .{ .bool_literal = a < b },
+            .le => .{ .bool_literal = a <= b },
+            .gt => .{ .bool_literal = a > b },
+            .ge => .{ .bool_literal = a >= b },
+            .and_op, .or_op => null,
+        };
+    }
+    if (lhs == .bool_literal and rhs == .bool_literal) {
+        const a = lhs.bool_literal;
+        const b = rhs.bool_literal;
+        return switch (op) {
+            .and_op => .{ .bool_literal = a and b },
+            .or_op => .{ .bool_literal = a or b },
+            .eq => .{ .bool_literal = a == b },
+            .ne => .{ .bool_literal = a != b },
+            else => null,
+        };
+    }
+    return null;
+}
+
+fn foldUnary(op: ast.UnaryOp, operand: ast.Expr, fold_ints: bool) ?ast.Expr {
+    return switch (op) {
+        .neg => if (!fold_ints) null else if (asI32(operand)) |a| (if (a == std.math.minInt(i32)) null else intResult(-a)) else null,
+        .not => if (operand == .bool_literal) .{ .bool_literal = !operand.bool_literal } else null,
+    };
+}
+
+/// 字面量转换为它本身的类型时去掉转换
+fn foldCast(value: ast.Expr, target: ast.Type) ?ast.Expr {
+    return switch (target) {
+        .i32 => if (asI32(value) != null) value else null,
+        .bool => if (value == .bool_literal) value else null,
+        .char => if (value == .char_literal) value else null,
+        .f64 => if (value == .float_literal) value else null,
+        else => null,
+    };
+}
+
+// ============================================================================
+// 引用扫描
+// ============================================================================
+
+/// 收集声明中出现的名字（标识符、类型名、构造的结构体 / 枚举名）
+/// 局部变量与 prelude 函数同名时也算引用：宁可多保留
+const Usage = struct {
+    names: std.StringHashMap(void),
+
+    fn init(allocator: std.mem.Allocator) Usage {
+        return .{ .names = std.StringHashMap(void).init(allocator) };
+    }
+
+    fn deinit(self: *Usage) void {
+        self.names.deinit();
+    }
+
+    fn add(self: *Usage, name: []const u8) Error!void {
+        try self.names.put(name, {});
+    }
+
+    fn scanDecl(self: *Usage, decl: ast.TopLevelDecl) Error!void {
+        switch (decl) {
+            .function => |func| try self.scanFunction(func),
+            .type_decl => |td| switch (td.kind) {
+                .struct_type => |st| {
+                    for (st.fields) |field| try self.scanType(field.type);
+                    for (st.methods) |method| try self.scanFunction(method);
+                },
+                .enum_type => |et| {
+                    for (et.variants) |variant| {
+                        for (variant.fields) |field| try self.scanType(field);
+                    }
+                    for (et.methods) |method| try self.scanFunction(method);
+                },
+                .trait_type => |tt| {
+                    for (tt.methods) |sig| try self.scanSignature(sig.params, sig.return_type);
+                },
+            },
+            .struct_decl => |sd| {
+                for (sd.fields) |field| try self.scanType(field.type);
+                for (sd.methods) |method| try self.scanFunction(method);
+            },
+            .enum_decl => |ed| {
+                for (ed.variants) |variant| {
+                    for (variant.fields) |field| try self.scanType(field);
+                }
+                for (ed.methods) |method| try self.scanFunction(method);
+            },
+            .trait_decl => |td| {
+                for (td.methods) |sig| try self.scanSignature(sig.params, sig.return_type);
+            },
+            .impl_decl => |id| {
+                try self.add(id.trait_name);
+                for (id.type_args) |t| try self.scanType(t);
+                try self.scanType(id.target_type);
+                for (id.methods) |method| try self.scanFunction(method);
+            },
+            .import_decl => {},
+        }
+    }
+
+    fn scanFunction(self: *Usage, func: ast.FunctionDecl) Error!void {
+        try self.scanSignature(func.params, func.return_type);
+        for (func.body) |stmt| try self.scanStmt(stmt);
+    }
+
+    fn scanSignature(self: *Usage, params: []const ast.Param, return_type: ast.Type) Error!void {
+        for (params) |param| try self.scanType(param.type);
+        try self.scanType(return_type);
+    }
+
+    fn scanType(self: *Usage, t: ast.Type) Error!void {
+        switch (t) {
+            .named => |name| try self.add(name),
+            .generic_instance => |gi| {
+                try self.add(gi.name);
+                for (gi.type_args) |arg| try self.scanType(arg);
+            },
+            .pointer => |inner| try self.scanType(inner.*),
+            .array => |arr| try self.scanType(arr.element.*),
+            .function => |func| {
+                for (func.params) |param| try self.scanType(param);
+                try self.scanType(func.return_type.*);
+            },
+            else => {},
+        }
+    }
+
+    fn scanStmt(self: *Usage, stmt: ast.Stmt) Error!void {
+        switch (stmt) {
+            .expr => |e| try self.scanExpr(e),
+            .let_decl => |let| {
+                if (let.type) |t| try self.scanType(t);
+                if (let.init) |e| try self.scanExpr(e);
+            },
+            .assign => |assign| {
+                try self.scanExpr(assign.target);
+                try self.scanExpr(assign.value);
+            },
+            .compound_assign => |ca| {
+                try self.scanExpr(ca.target);
+                try self.scanExpr(ca.value);
+            },
+            .return_stmt, .break_stmt => |value| if (value) |e| try self.scanExpr(e),
+            .continue_stmt => {},
+            .loop_stmt => |loop| {
+                if (loop.condition) |c| try self.scanExpr(c);
+                if (loop.iterator) |it| try self.scanExpr(it.iterable);
+                for (loop.body) |s| try self.scanStmt(s);
+            },
+            .while_loop => |loop| {
+                try self.scanExpr(loop.condition);
+                for (loop.body) |s| try self.scanStmt(s);
+            },
+            .for_loop => |loop| {
+                if (loop.init) |s| try self.scanStmt(s.*);
+                if (loop.condition) |c| try self.scanExpr(c);
+                if (loop.step) |s| try self.scanExpr(s);
+                for (loop.body) |s| try self.scanStmt(s);
+            },
+        }
+    }
+
+    fn scanPattern(self: *Usage, pattern: ast.Pattern) Error!void {
+        switch (pattern) {
+            .identifier => |name| try self.add(name),
+            .variant => |v| try self.add(v.name),
+            .literal => |e| try self.scanExpr(e),
+            .wildcard => {},
+        }
+    }
+
+    fn scanExpr(self: *Usage, expr: ast.Expr) Error!void {
+        switch (expr) {
+            .int_literal, .float_literal, .string_literal, .char_literal, .bool_literal => {},
+            .identifier => |name| try self.add(name),
+            .binary => |bin| {
+                try self.scanExpr(bin.left.*);
+                try self.scanExpr(bin.right.*);
+            },
+            .unary => |un| try self.scanExpr(un.operand.*),
+            .call => |call| {
+                try self.scanExpr(call.callee.*);
+                for (call.args) |arg| try self.scanExpr(arg);
+                for (call.type_args) |t| try self.scanType(t);
+            },
+            .static_method_call => |smc| {
+                try self.add(smc.type_name);
+                for (smc.type_args) |t| try self.scanType(t);
+                for (smc.args) |arg| try self.scanExpr(arg);
+            },
+            .field_access => |fa| try self.scanExpr(fa.object.*),
+            .struct_init => |si| {
+                try self.add(si.type_name);
+                for (si.type_args) |t| try self.scanType(t);
+                for (si.fields) |field| try self.scanExpr(field.value);
+            },
+            .enum_variant => |ev| {
+                try self.add(ev.enum_name);
+                for (ev.args) |arg| try self.scanExpr(arg);
+            },
+            .block => |stmts| for (stmts) |s| try self.scanStmt(s),
+            .if_expr => |ie| {
+                try self.scanExpr(ie.condition.*);
+                try self.scanExpr(ie.then_branch.*);
+                if (ie.else_branch) |e| try self.scanExpr(e.*);
+            },
+            .is_expr => |is_e| {
+                try self.scanExpr(is_e.value.*);
+                for (is_e.arms) |arm| {
+                    try self.scanPattern(arm.pattern);
+                    if (arm.guard) |g| try self.scanExpr(g);
+                    try self.scanExpr(arm.body);
+                }
+            },
+            .match_expr => |me| {
+                try self.scanExpr(me.value.*);
+                for (me.arms) |arm| {
+                    try self.scanPattern(arm.pattern);
+                    try self.scanExpr(arm.body);
+                }
+            },
+            .as_expr => |as_cast| {
+                try self.scanExpr(as_cast.value.*);
+                try self.scanType(as_cast.target_type);
+            },
+            .await_expr, .try_expr => |inner| try self.scanExpr(inner.*),
+            .array_literal => |elems| for (elems) |e| try self.scanExpr(e),
+            .array_index => |ai| {
+                try self.scanExpr(ai.array.*);
+                try self.scanExpr(ai.index.*);
+            },
+            .range => |rng| {
+                try self.scanExpr(rng.start.*);
+                try self.scanExpr(rng.end.*);
+            },
+            .string_interp => |si| for (si.parts) |part| {
+                if (part == .expr) try self.scanExpr(part.expr);
+            },
+        }
+    }
+};
@@ -50,6 +50,13 @@ pub const Parser = struct {
         self.arena.deinit();
     }
     
+    /// 🆕 v0.2.0: 预先登记在其他编译单元（如 prelude）中定义的类型名
+    pub fn addKnownTypes(self: *Parser, names: []const []const u8) !void {
+        for (names) |name| {
+            try self.known_types.put(name, {});
+        }
+    }
+    
     // 🆕 获取 arena allocator 用于 AST 节点
     fn arenaAllocator(self: *Parser) std.mem.Allocator {
         return self.arena.allocator();
@@ -280,10 +287,16 @@ pub const Parser = struct {
         _ = try self.consume(.arrow);
         const return_type = try self.parseType();
         
+        // 🆕 v0.2.0: `fn name(...) -> T;` 声明由运行时库实现的外部函数
+        const is_extern = self.match(.semicolon);
+        
         // 解析函数体
-        _ = try self.consume(.lbrace);
-        const body = try self.parseStmtList();
-        _ = try self.consume(.rbrace);
+        const body: []ast.Stmt = if (is_extern) try self.arenaAllocator().alloc(ast.Stmt, 0) else blk: {
+            _ = try self.consume(.lbrace);
+            const stmts = try self.parseStmtList();
+            _ = try self.consume(.rbrace);
+            break :blk stmts;
+        };
 
         return ast.FunctionDecl{
             .name = name.lexeme,
@@ -293,6 +306,9 @@ pub const Parser = struct {
             .body = body,
             .is_public = is_public,
             .is_async = is_async,
+            .is_extern = is_extern,
+            .line = name.line,
+            .source_file = name.filename,
         };
     }
 
@@ -0,0 +1,155 @@
+//! 🆕 v0.2.0: Profile-Guided Optimization - 两阶段 PGO 构建
+//!
+//!   1. pawc app.paw --compile -O2 --pgo-generate[=dir]
+//!      生成插桩的可执行文件；运行典型负载，计数器写入 <dir>/（默认 paw-pgo/）
+//!   2. pawc app.paw --compile -O2 --pgo-use[=dir|file]
+//!      读取剖析数据：分支权重和函数入口计数驱动基本块布局、内联和冷热代码拆分
+//!
+//! C 后端把 -fprofile-generate=<dir> / -fprofile-use=<path> 交给 C 编译器
+//! （gcc 在目录中写 .gcda；clang 写 .profraw，使用前需合并为 .profdata）。
+//! LLVM 后端在 default<On> 管道之前运行 pgo-instr-gen,instrprof（插桩），
+//! 插桩的目标文件通过 clang 链接 profile 运行时；--pgo-use 时写出未优化的
+//! bitcode，由 clang -fprofile-use 读取 .profdata 并优化（剖析数据路径不进入
+//! pawc 进程的 LLVM 全局选项，pawc serve 中的并发请求互不影响）。
+//! zig cc 没有 profile 运行时，C 后端的 PGO 构建改用系统的 gcc / clang。
+//!
+//! --pgo-use 指向的目录里只有 .profraw 时，自动调用 llvm-profdata merge 合并。
+
+const std = @import("std");
+
+/// 剖析数据的默认目录（相对于当前工作目录）
+pub const default_dir = "paw-pgo";
+
+/// 合并后的剖析数据文件名（与 clang -fprofile-use=<dir> 查找的文件名一致）
+pub const merged_name = "default.profdata";
+
+/// 本地安装的 llvm-profdata（与 main.zig 中本地 clang 的位置一致），找不到时使用 PATH 中的
+const local_profdata_path = "llvm/install/bin/llvm-profdata";
+
+pub const Mode = union(enum) {
+    none,
+    generate: []const u8,  // 插桩程序写剖析数据的目录
+    use: []const u8,       // .profdata 文件或剖析数据目录
+
+    /// 参与目标文件缓存键的标记：插桩 / 使用剖析数据的目标文件不能与普通构建混用
+    pub fn hash(self: Mode, allocator: std.mem.Allocator, hasher: *std.hash.Wyhash) void {
+        hasher.update(&[_]u8{@intFromEnum(std.meta.activeTag(self))});
+        switch (self) {
+            .none => {},
+            .generate => |dir| hasher.update(dir),
+            .use => |path| {
+                hasher.update(path);
+                // 剖析数据重新生成后，旧的目标文件作废
+                hasher.update(std.mem.asBytes(&profileStamp(allocator, path)));
+            },
+        }
+    }
+};
+
+/// 剖析数据的指纹：文件取大小和修改时间；目录（gcc 的 .gcda 目录）取其中每个文件的
+/// 相对路径、大小和修改时间——重写 .gcda 不会改变目录本身的修改时间
+/// 目录遍历顺序不固定，各文件的哈希相加，结果与顺序无关
+fn profileStamp(allocator: std.mem.Allocator, path: []const u8) u64 {
+    const stat = std.fs.cwd().statFile(path) catch return 0;
+    if (stat.kind != .directory) return fileStamp("", stat);
+
+    var dir = std.fs.cwd().openDir(path, .{ .iterate = true }) catch return 0;
+    defer dir.close();
+    var walker = dir.walk(allocator) catch return 0;
+    defer walker.deinit();
+
+    var stamp: u64 = 0;
+    while (walker.next() catch return stamp) |entry| {
+        if (entry.kind != .file) continue;
+        const file_stat = entry.dir.statFile(entry.basename) catch continue;
+        stamp +%= fileStamp(entry.path, file_stat);
+    }
+    return stamp;
+}
+
+fn fileStamp(name: []const u8, stat: std.fs.File.Stat) u64 {
+    var hasher = std.hash.Wyhash.init(0);
+    hasher.update(name);
+    hasher.update(std.mem.asBytes(&stat.mtime));
+    hasher.update(std.mem.asBytes(&stat.size));
+    return hasher.final();
+}
+
+/// 插桩程序写出的 .profraw 路径模式（%m：同一程序的多次运行合并到同一个文件）
+pub fn rawProfilePattern(allocator: std.mem.Allocator, dir: []const u8) ![]u8 {
+    return std.fmt.allocPrint(allocator, "{s}/default_%m.profraw", .{dir});
+}
+
+/// 把 --pgo-use 的参数解析为 LLVM 可以读取的 .profdata 文件：
+///   - .profraw 文件：合并为同名的 .profdata
+///   - 含有 .profraw 的目录：全部合并为 <dir>/default.profdata
+///   - 只有 default.profdata 的目录：直接使用
+///   - 其它文件：原样使用（假定已是 .profdata）
+/// 返回的路径由调用方释放
+pub fn resolveProfileData(allocator: std.mem.Allocator, path: []const u8) ![]u8 {
+    const stat = std.fs.cwd().statFile(path) catch |err| {
+        std.debug.print("❌ Error: profile data not found: {s} ({})\n", .{ path, err });
+        std.debug.print("💡 Build with --pgo-generate and run the program first\n", .{});
+        return error.ProfileNotFound;
+    };
+
+    if (stat.kind != .directory) {
+        if (!std.mem.endsWith(u8, path, ".profraw")) return allocator.dupe(u8, path);
+        const output = try std.fmt.allocPrint(allocator, "{s}.profdata", .{path[0 .. path.len - ".profraw".len]});
+        errdefer allocator.free(output);
+        try mergeRawProfiles(allocator, output, &.{path});
+        return output;
+    }
+
+    var arena_state = std.heap.ArenaAllocator.init(allocator);
+    defer arena_state.deinit();
+    const arena = arena_state.allocator();
+
+    var raw_files = std.ArrayList([]const u8){};
+    var dir = try std.fs.cwd().openDir(path, .{ .iterate = true });
+    defer dir.close();
+    var it = dir.iterate();
+    while (try it.next()) |entry| {
+        if (entry.kind != .file or !std.mem.endsWith(u8, entry.name, ".profraw")) continue;
+        try raw_files.append(arena, try std.fs.path.join(arena, &.{ path, entry.name }));
+    }
+
+    const output = try std.fs.path.join(allocator, &.{ path, merged_name });
+    errdefer allocator.free(output);
+    if (raw_files.items.len > 0) {
+        try mergeRawProfiles(allocator, output, raw_files.items);
+    } else {
+        std.fs.cwd().access(output, .{}) catch {
+            std.debug.print("❌ Error: no .profraw or {s} in {s}\n", .{ merged_name, path });
+            return error.ProfileNotFound;
+        };
+    }
+    return output;
+}
+
+/// llvm-profdata merge -o <output> <inputs...>
+fn mergeRawProfiles(allocator: std.mem.Allocator, output: []const u8, inputs: []const []const u8) !void {
+    const tool = blk: {
+        std.fs.cwd().access(local_profdata_path, .{}) catch break :blk "llvm-profdata";
+        break :blk local_profdata_path;
+    };
+
+    var argv = std.ArrayList([]const u8){};
+    defer argv.deinit(allocator);
+    try argv.appendSlice(allocator, &.{ tool, "merge", "-o", output });
+    try argv.appendSlice(allocator, inputs);
+
+    const result = std.process.Child.run(.{ .allocator = allocator, .argv = argv.items }) catch |err| {
+        std.debug.print("❌ Error: cannot run {s}: {}\n", .{ tool, err });
+        std.debug.print("💡 Install LLVM (llvm-profdata) or merge the .profraw files manually\n", .{});
+        return error.ProfileMergeFailed;
+    };
+    defer allocator.free(result.stdout);
+    defer allocator.free(result.stderr);
+
+    if (result.term != .Exited or result.term.Exited != 0) {
+        std.debug.print("❌ llvm-profdata merge failed:\n{s}\n", .{result.stderr});
+        return error.ProfileMergeFailed;
+    }
+    std.debug.print("📊 Merged {d} raw profile(s) into {s}\n", .{ inputs.len, output });
+}
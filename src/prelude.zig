@@ -0,0 +1,63 @@
+//! 🆕 v0.2.0: Standard library prelude
+//!
+//! prelude 在 `zig build` 时由 src/prelude_gen.zig 解析，并用 module_cache 的
+//! 编码器序列化成 AST 快照嵌入可执行文件；每次编译只解码快照，不再词法/语法分析：
+//! - 不再把 prelude 与用户源码拼接成一个新缓冲区
+//! - 不再逐字节统计 prelude 行数来修正用户代码的行号
+//! - TypeChecker 通过 registerPrelude() 直接登记 prelude 的函数/类型表，
+//!   不再重复检查 prelude 的函数体
+
+const std = @import("std");
+const ast = @import("ast.zig");
+const module_cache = @import("module_cache.zig");
+
+/// 嵌入的 prelude 源码（用于缓存键等需要 prelude 内容指纹的地方）
+pub const source = @embedFile("prelude/prelude.paw");
+
+/// 构建期生成的 prelude AST 快照（见 build.zig 中的 prelude_gen 步骤）
+const snapshot = @embedFile("prelude_ast");
+
+/// prelude 诊断中使用的文件名
+pub const filename = "<prelude>";
+
+pub const Prelude = struct {
+    allocator: std.mem.Allocator,
+    arena: std.heap.ArenaAllocator,
+    declarations: []ast.TopLevelDecl,
+    type_names: std.ArrayList([]const u8),
+
+    /// 解码嵌入的 prelude 快照
+    /// 所有 AST 节点分配在 Prelude 自己的 arena 中，在 deinit() 前保持有效
+    pub fn load(allocator: std.mem.Allocator) !*Prelude {
+        const self = try allocator.create(Prelude);
+        errdefer allocator.destroy(self);
+
+        self.allocator = allocator;
+        self.arena = std.heap.ArenaAllocator.init(allocator);
+        errdefer self.arena.deinit();
+
+        // 快照与编译器由同一份 ast.zig 构建，解码失败说明构建产物损坏
+        self.declarations = try module_cache.decodeSnapshot(snapshot, self.arena.allocator());
+
+        // 收集 prelude 定义的类型名，供用户代码的 Parser 消除泛型歧义
+        self.type_names = std.ArrayList([]const u8){};
+        errdefer self.type_names.deinit(allocator);
+        for (self.declarations) |decl| {
+            switch (decl) {
+                .type_decl => |td| try self.type_names.append(allocator, td.name),
+                .struct_decl => |sd| try self.type_names.append(allocator, sd.name),
+                .enum_decl => |ed| try self.type_names.append(allocator, ed.name),
+                else => {},
+            }
+        }
+
+        return self;
+    }
+
+    pub fn deinit(self: *Prelude) void {
+        const allocator = self.allocator;
+        self.type_names.deinit(allocator);
+        self.arena.deinit();
+        allocator.destroy(self);
+    }
+};
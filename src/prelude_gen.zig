@@ -0,0 +1,42 @@
+//! 🆕 v0.2.0: prelude 快照生成器（构建期工具，不随 pawc 发布）
+//!
+//! `zig build` 时由 build.zig 调用：
+//!   prelude_gen <prelude.paw> <output.ast>
+//!
+//! 词法/语法分析 prelude，用 module_cache 的编码器把声明写成 AST 快照，
+//! pawc 通过 @embedFile("prelude_ast") 嵌入它，运行时只需解码（见 src/prelude.zig）。
+
+const std = @import("std");
+const Lexer = @import("lexer.zig").Lexer;
+const Parser = @import("parser.zig").Parser;
+const module_cache = @import("module_cache.zig");
+
+pub fn main() !void {
+    var gpa = std.heap.GeneralPurposeAllocator(.{}){};
+    defer _ = gpa.deinit();
+    const allocator = gpa.allocator();
+
+    const args = try std.process.argsAlloc(allocator);
+    defer std.process.argsFree(allocator, args);
+
+    if (args.len != 3) {
+        std.debug.print("usage: prelude_gen <prelude.paw> <output.ast>\n", .{});
+        std.process.exit(2);
+    }
+
+    const source = try std.fs.cwd().readFileAlloc(allocator, args[1], 16 * 1024 * 1024);
+    defer allocator.free(source);
+
+    var lexer = Lexer.init(allocator, source, "<prelude>");
+    defer lexer.deinit();
+    const tokens = try lexer.tokenize();
+
+    var parser = Parser.init(allocator, tokens);
+    defer parser.deinit();
+    const program = try parser.parse();
+
+    const bytes = try module_cache.encodeSnapshot(allocator, program.declarations);
+    defer allocator.free(bytes);
+
+    try std.fs.cwd().writeFile(.{ .sub_path = args[2], .data = bytes });
+}
@@ -0,0 +1,287 @@
+//! 🆕 v0.2.0: Compile Profiler - 编译耗时与内存分析
+//!
+//! `pawc <file> --time-report=json|chrome` 记录：
+//! - 每个编译阶段（prelude、词法、语法、模块解析、类型检查、代码生成、
+//!   目标文件生成、外部 C 编译器 / 链接）的纳秒级耗时
+//! - 每个导入模块的加载耗时
+//! - 每个函数的类型检查和代码生成耗时
+//! - CountingAllocator 统计的分配次数、字节数和峰值
+//!
+//! json   : 扁平的事件列表 + 分配统计，便于导入构建看板
+//! chrome : Chrome trace-event 格式，可直接在 chrome://tracing / Perfetto 中打开
+//!
+//! 记录接口可以在线程池的工作线程中并发调用。
+
+const std = @import("std");
+
+pub const Format = enum {
+    json,
+    chrome,
+
+    pub fn fromString(s: []const u8) ?Format {
+        if (std.mem.eql(u8, s, "json")) return .json;
+        if (std.mem.eql(u8, s, "chrome")) return .chrome;
+        return null;
+    }
+
+    /// 报告文件的后缀
+    pub fn extension(self: Format) []const u8 {
+        return switch (self) {
+            .json => ".time.json",
+            .chrome => ".trace.json",
+        };
+    }
+};
+
+pub const Event = struct {
+    category: []const u8,  // phase / module / typecheck / codegen
+    name: []const u8,
+    start_ns: u64,  // 相对 Profiler 创建时刻
+    dur_ns: u64,
+    tid: u64,
+};
+
+pub const Profiler = struct {
+    allocator: std.mem.Allocator,
+    arena: std.heap.ArenaAllocator,  // 事件名的副本（AST 可能先于报告释放）
+    events: std.ArrayList(Event),
+    mutex: std.Thread.Mutex,
+    start: i128,
+    counting: ?*const CountingAllocator,
+
+    pub fn init(allocator: std.mem.Allocator, counting: ?*const CountingAllocator) Profiler {
+        return Profiler{
+            .allocator = allocator,
+            .arena = std.heap.ArenaAllocator.init(allocator),
+            .events = std.ArrayList(Event){},
+            .mutex = .{},
+            .start = std.time.nanoTimestamp(),
+            .counting = counting,
+        };
+    }
+
+    pub fn deinit(self: *Profiler) void {
+        self.events.deinit(self.allocator);
+        self.arena.deinit();
+    }
+
+    fn now(self: *const Profiler) u64 {
+        return @intCast(@max(std.time.nanoTimestamp() - self.start, 0));
+    }
+
+    fn record(self: *Profiler, category: []const u8, name: []const u8, start_ns: u64, end_ns: u64) void {
+        self.mutex.lock();
+        defer self.mutex.unlock();
+
+        // 分析数据丢失不应该让编译失败
+        const owned = self.arena.allocator().dupe(u8, name) catch return;
+        self.events.append(self.allocator, Event{
+            .category = category,
+            .name = owned,
+            .start_ns = start_ns,
+            .dur_ns = end_ns -| start_ns,
+            .tid = @intCast(std.Thread.getCurrentId()),
+        }) catch {};
+    }
+
+    /// 写出报告文件
+    pub fn writeReport(self: *Profiler, path: []const u8, format: Format) !void {
+        var buf = std.ArrayList(u8){};
+        defer buf.deinit(self.allocator);
+
+        self.mutex.lock();
+        defer self.mutex.unlock();
+
+        const total_ns = self.now();
+        switch (format) {
+            .json => try self.writeJson(&buf, total_ns),
+            .chrome => try self.writeChromeTrace(&buf),
+        }
+
+        const file = try std.fs.cwd().createFile(path, .{});
+        defer file.close();
+        try file.writeAll(buf.items);
+    }
+
+    fn writeJson(self: *Profiler, buf: *std.ArrayList(u8), total_ns: u64) !void {
+        const gpa = self.allocator;
+        try buf.print(gpa, "{{\n  \"total_ns\": {d},\n", .{total_ns});
+
+        if (self.counting) |counting| {
+            const stats = counting.snapshot();
+            try buf.print(gpa,
+                "  \"allocations\": {{ \"count\": {d}, \"frees\": {d}, \"bytes\": {d}, \"peak_bytes\": {d} }},\n",
+                .{ stats.alloc_count, stats.free_count, stats.bytes_allocated, stats.peak_bytes },
+            );
+        }
+
+        try buf.appendSlice(gpa, "  \"events\": [");
+        for (self.events.items, 0..) |event, idx| {
+            try buf.appendSlice(gpa, if (idx == 0) "\n    " else ",\n    ");
+            try buf.appendSlice(gpa, "{ \"cat\": ");
+            try writeJsonString(buf, gpa, event.category);
+            try buf.appendSlice(gpa, ", \"name\": ");
+            try writeJsonString(buf, gpa, event.name);
+            try buf.print(gpa, ", \"start_ns\": {d}, \"dur_ns\": {d}, \"tid\": {d} }}", .{
+                event.start_ns, event.dur_ns, event.tid,
+            });
+        }
+        try buf.appendSlice(gpa, "\n  ]\n}\n");
+    }
+
+    fn writeChromeTrace(self: *Profiler, buf: *std.ArrayList(u8)) !void {
+        const gpa = self.allocator;
+        try buf.appendSlice(gpa, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[");
+        for (self.events.items, 0..) |event, idx| {
+            if (idx > 0) try buf.append(gpa, ',');
+            try buf.appendSlice(gpa, "\n{\"ph\":\"X\",\"pid\":1,\"cat\":");
+            try writeJsonString(buf, gpa, event.category);
+            try buf.appendSlice(gpa, ",\"name\":");
+            try writeJsonString(buf, gpa, event.name);
+            // trace-event 的时间单位是微秒
+            try buf.print(gpa, ",\"tid\":{d},\"ts\":{d}.{d:0>3},\"dur\":{d}.{d:0>3}}}", .{
+                event.tid,
+                event.start_ns / 1000, event.start_ns % 1000,
+                event.dur_ns / 1000, event.dur_ns % 1000,
+            });
+        }
+        if (self.counting) |counting| {
+            const stats = counting.snapshot();
+            if (self.events.items.len > 0) try buf.append(gpa, ',');
+            try buf.print(gpa,
+                "\n{{\"ph\":\"C\",\"pid\":1,\"tid\":0,\"ts\":0,\"name\":\"allocations\",\"args\":{{\"count\":{d},\"bytes\":{d},\"peak_bytes\":{d}}}}}",
+                .{ stats.alloc_count, stats.bytes_allocated, stats.peak_bytes },
+            );
+        }
+        try buf.appendSlice(gpa, "\n]}\n");
+    }
+};
+
+/// 一段正在计时的区间；profiler 为 null 时不做任何事
+pub const Zone = struct {
+    profiler: ?*Profiler,
+    category: []const u8,
+    name: []const u8,
+    start_ns: u64,
+
+    pub fn end(self: Zone) void {
+        const profiler = self.profiler orelse return;
+        profiler.record(self.category, self.name, self.start_ns, profiler.now());
+    }
+};
+
+/// 开始计时：`const zone = prof.zone(self.profiler, "codegen", func.name); defer zone.end();`
+pub fn zone(profiler: ?*Profiler, category: []const u8, name: []const u8) Zone {
+    return Zone{
+        .profiler = profiler,
+        .category = category,
+        .name = name,
+        .start_ns = if (profiler) |p| p.now() else 0,
+    };
+}
+
+/// 写出 JSON 字符串字面量（含引号和转义）
+pub fn writeJsonString(buf: *std.ArrayList(u8), gpa: std.mem.Allocator, text: []const u8) !void {
+    try buf.append(gpa, '"');
+    for (text) |c| {
+        switch (c) {
+            '"' => try buf.appendSlice(gpa, "\\\""),
+            '\\' => try buf.appendSlice(gpa, "\\\\"),
+            '\n' => try buf.appendSlice(gpa, "\\n"),
+            '\r' => try buf.appendSlice(gpa, "\\r"),
+            '\t' => try buf.appendSlice(gpa, "\\t"),
+            0...8, 11, 12, 14...0x1f => try buf.print(gpa, "\\u{x:0>4}", .{c}),
+            else => try buf.append(gpa, c),
+        }
+    }
+    try buf.append(gpa, '"');
+}
+
+// ============================================================================
+// CountingAllocator - 分配统计
+// ============================================================================
+
+pub const AllocStats = struct {
+    alloc_count: u64,
+    free_count: u64,
+    bytes_allocated: u64,  // 累计分配的字节数
+    peak_bytes: u64,       // 同时存活字节数的峰值
+};
+
+/// 包装另一个分配器并统计分配情况（原子计数，线程安全）
+pub const CountingAllocator = struct {
+    child: std.mem.Allocator,
+    alloc_count: std.atomic.Value(u64) = .init(0),
+    free_count: std.atomic.Value(u64) = .init(0),
+    bytes_allocated: std.atomic.Value(u64) = .init(0),
+    live_bytes: std.atomic.Value(u64) = .init(0),
+    peak_bytes: std.atomic.Value(u64) = .init(0),
+
+    pub fn init(child: std.mem.Allocator) CountingAllocator {
+        return CountingAllocator{ .child = child };
+    }
+
+    pub fn allocator(self: *CountingAllocator) std.mem.Allocator {
+        return .{
+            .ptr = self,
+            .vtable = &.{
+                .alloc = alloc,
+                .resize = resize,
+                .remap = remap,
+                .free = free,
+            },
+        };
+    }
+
+    pub fn snapshot(self: *const CountingAllocator) AllocStats {
+        return AllocStats{
+            .alloc_count = self.alloc_count.load(.monotonic),
+            .free_count = self.free_count.load(.monotonic),
+            .bytes_allocated = self.bytes_allocated.load(.monotonic),
+            .peak_bytes = self.peak_bytes.load(.monotonic),
+        };
+    }
+
+    fn grow(self: *CountingAllocator, bytes: usize) void {
+        _ = self.bytes_allocated.fetchAdd(bytes, .monotonic);
+        const live = self.live_bytes.fetchAdd(bytes, .monotonic) + bytes;
+        _ = self.peak_bytes.fetchMax(live, .monotonic);
+    }
+
+    fn shrink(self: *CountingAllocator, bytes: usize) void {
+        _ = self.live_bytes.fetchSub(bytes, .monotonic);
+    }
+
+    fn resized(self: *CountingAllocator, old_len: usize, new_len: usize) void {
+        if (new_len > old_len) self.grow(new_len - old_len) else self.shrink(old_len - new_len);
+    }
+
+    fn alloc(ctx: *anyopaque, len: usize, alignment: std.mem.Alignment, ret_addr: usize) ?[*]u8 {
+        const self: *CountingAllocator = @ptrCast(@alignCast(ctx));
+        const ptr = self.child.rawAlloc(len, alignment, ret_addr) orelse return null;
+        _ = self.alloc_count.fetchAdd(1, .monotonic);
+        self.grow(len);
+        return ptr;
+    }
+
+    fn resize(ctx: *anyopaque, memory: []u8, alignment: std.mem.Alignment, new_len: usize, ret_addr: usize) bool {
+        const self: *CountingAllocator = @ptrCast(@alignCast(ctx));
+        if (!self.child.rawResize(memory, alignment, new_len, ret_addr)) return false;
+        self.resized(memory.len, new_len);
+        return true;
+    }
+
+    fn remap(ctx: *anyopaque, memory: []u8, alignment: std.mem.Alignment, new_len: usize, ret_addr: usize) ?[*]u8 {
+        const self: *CountingAllocator = @ptrCast(@alignCast(ctx));
+        const ptr = self.child.rawRemap(memory, alignment, new_len, ret_addr) orelse return null;
+        self.resized(memory.len, new_len);
+        return ptr;
+    }
+
+    fn free(ctx: *anyopaque, memory: []u8, alignment: std.mem.Alignment, ret_addr: usize) void {
+        const self: *CountingAllocator = @ptrCast(@alignCast(ctx));
+        self.child.rawFree(memory, alignment, ret_addr);
+        _ = self.free_count.fetchAdd(1, .monotonic);
+        self.shrink(memory.len);
+    }
+};
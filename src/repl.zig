@@ -8,86 +8,291 @@
 //! - Syntax highlighting (basic)
 //! - Type information display
 //! - Expression evaluation
+//!
+//! 🆕 v0.2.0: 输入在同一个 ORC JIT 会话中编译执行（需要 LLVM 后端）：
+//! - 顶层声明（fn / type / import）降低为一个新模块加入 JIT，之后的输入可以直接调用
+//! - 语句和表达式包装成一个求值函数，编译后立即调用；表达式的值按 i32 显示
+//! - let 绑定会在之后每次求值前重放（初始化表达式会重新求值）
 
 const std = @import("std");
+const ast = @import("ast.zig");
 const Lexer = @import("lexer.zig").Lexer;
+const Token = @import("token.zig").Token;
 const Parser = @import("parser.zig").Parser;
 const TypeChecker = @import("typechecker.zig").TypeChecker;
-const CodeGen = @import("codegen.zig").CodeGen;
-const CBackend = @import("c_backend.zig").CBackend;
+const Prelude = @import("prelude.zig").Prelude;
+
+const build_options = @import("build_options");
+const llvm_available = build_options.llvm_native_available;
+const jit = if (llvm_available) @import("jit.zig") else struct {};
+
+/// 输入诊断中使用的文件名
+const repl_filename = "<repl>";
 
 pub const REPL = struct {
     allocator: std.mem.Allocator,
     history: std.ArrayList([]const u8),
-    
+
+    // 🆕 v0.2.0: JIT 会话状态
+    prelude: ?*Prelude,
+    session: if (llvm_available) ?jit.Session else void,
+    decl_source: std.ArrayList(u8),  // 已加入 JIT 的顶层声明源码（每次输入前拼接，供解析和类型检查）
+    let_source: std.ArrayList(u8),   // 之前输入的 let 语句
+    decl_count: usize,               // decl_source 中的声明数量
+    eval_count: usize,
+    line: std.ArrayList(u8),         // 当前输入（可能跨多行）
+
     pub fn init(allocator: std.mem.Allocator) REPL {
         return REPL{
             .allocator = allocator,
             .history = std.ArrayList([]const u8){},
+            .prelude = null,
+            .session = if (llvm_available) null else {},
+            .decl_source = std.ArrayList(u8){},
+            .let_source = std.ArrayList(u8){},
+            .decl_count = 0,
+            .eval_count = 0,
+            .line = std.ArrayList(u8){},
         };
     }
-    
+
     pub fn deinit(self: *REPL) void {
         for (self.history.items) |item| {
             self.allocator.free(item);
         }
         self.history.deinit(self.allocator);
+        if (llvm_available) {
+            if (self.session) |*session| session.deinit();
+        }
+        if (self.prelude) |prelude| prelude.deinit();
+        self.decl_source.deinit(self.allocator);
+        self.let_source.deinit(self.allocator);
+        self.line.deinit(self.allocator);
     }
-    
+
     /// Start the REPL loop
     pub fn run(self: *REPL) !void {
         try self.printWelcome();
-        
-        std.debug.print("\n🚧 REPL is under construction in v0.1.9!\n", .{});
-        std.debug.print("📋 Current status: Basic framework implemented\n", .{});
-        std.debug.print("🎯 Coming soon: Full interactive evaluation\n", .{});
-        std.debug.print("\n💡 For now, use: pawc <file.paw> --run\n\n", .{});
-        
-        return;
-        
-        // 🚧 TODO: Full REPL implementation below
-        // var line_buffer: [1024]u8 = undefined;
-        // var prompt_num: usize = 1;
-        
-        // while (true) {
-        //     // 显示提示符
-        //     std.debug.print("\x1b[1;32mpaw[{d}]>\x1b[0m ", .{prompt_num});
-        //     
-        //     // ...command handling...
-        //     prompt_num += 1;
-        // }
-    }
-    
+
+        if (!llvm_available) {
+            std.debug.print("⚠️  The REPL runs code in the LLVM JIT, which is not available in this build\n", .{});
+            std.debug.print("💡 Rebuild with LLVM (zig build auto-detects it), or use: pawc <file.paw> --run\n\n", .{});
+            return;
+        }
+
+        try self.startSession();
+
+        var prompt_num: usize = 1;
+        while (true) {
+            // 显示提示符
+            std.debug.print("\x1b[1;32mpaw[{d}]>\x1b[0m ", .{prompt_num});
+
+            const input = (try self.readInput()) orelse break;  // Ctrl+D
+            const code = std.mem.trim(u8, input, " \t\r\n");
+            if (code.len == 0) continue;
+
+            if (std.mem.eql(u8, code, "exit") or std.mem.eql(u8, code, "quit")) break;
+            if (std.mem.eql(u8, code, "help")) {
+                try self.printHelp();
+                continue;
+            }
+            if (std.mem.eql(u8, code, "history")) {
+                try self.printHistory();
+                continue;
+            }
+            if (std.mem.eql(u8, code, "clear")) {
+                std.debug.print("\x1b[2J\x1b[H", .{});
+                continue;
+            }
+
+            try self.history.append(self.allocator, try self.allocator.dupe(u8, code));
+            self.eval(code) catch |err| {
+                std.debug.print("\x1b[1;31m✗ {s}\x1b[0m\n", .{@errorName(err)});
+            };
+            prompt_num += 1;
+        }
+        std.debug.print("\n👋 Bye!\n", .{});
+    }
+
+    /// 🆕 v0.2.0: 创建 JIT 会话，并把 prelude 作为第一个模块加入
+    fn startSession(self: *REPL) !void {
+        if (!llvm_available) return;
+
+        self.prelude = try Prelude.load(self.allocator);
+        self.session = try jit.Session.init(self.allocator, .O0);
+        try self.session.?.addProgram(.{ .declarations = self.prelude.?.declarations }, &.{});
+    }
+
+    /// 读取一次输入；花括号未闭合时继续读取下一行。EOF 时返回 null
+    fn readInput(self: *REPL) !?[]const u8 {
+        self.line.clearRetainingCapacity();
+        var depth: isize = 0;
+        while (true) {
+            const start = self.line.items.len;
+            if (!try self.readLine()) {
+                return if (self.line.items.len == 0) null else self.line.items;
+            }
+            for (self.line.items[start..]) |c| {
+                switch (c) {
+                    '{' => depth += 1,
+                    '}' => depth -= 1,
+                    else => {},
+                }
+            }
+            if (depth <= 0) return self.line.items;
+            try self.line.append(self.allocator, '\n');
+            std.debug.print("\x1b[1;32m   ...>\x1b[0m ", .{});
+        }
+    }
+
+    /// 把标准输入的一行追加到 self.line（不含换行符）；EOF 且没有读到内容时返回 false
+    fn readLine(self: *REPL) !bool {
+        const stdin = std.fs.File.stdin();
+        var byte: [1]u8 = undefined;
+        var got_any = false;
+        while (true) {
+            const n = try stdin.read(&byte);
+            if (n == 0) return got_any;
+            got_any = true;
+            if (byte[0] == '\n') return true;
+            try self.line.append(self.allocator, byte[0]);
+        }
+    }
+
     /// Evaluate a line of PawLang code
     fn eval(self: *REPL, code: []const u8) !void {
-        
-        // 🚧 TODO: 实现完整的代码评估
-        // 当前只是一个占位符
-        
-        // 1. Wrap in main function for easier parsing
+        if (isDeclaration(code)) {
+            return self.evalDeclaration(code);
+        }
+
+        // 语句以 ; 或 } 结尾；否则是表达式，作为求值函数的返回值显示
+        const is_expression = !(std.mem.endsWith(u8, code, ";") or std.mem.endsWith(u8, code, "}"));
+
+        const entry = try std.fmt.allocPrint(self.allocator, "paw_repl_eval_{d}", .{self.eval_count});
+        defer self.allocator.free(entry);
+        self.eval_count += 1;
+
+        // 1. Wrap in an evaluation function
         const wrapped = try std.fmt.allocPrint(
             self.allocator,
-            "fn main() {{ {s} }}", 
-            .{code},
+            "{s}\nfn {s}() -> i32 {{\n{s}{s}\n{s}}}\n",
+            .{ self.decl_source.items, entry, self.let_source.items, code, if (is_expression) "" else "0\n" },
         );
         defer self.allocator.free(wrapped);
-        
-        // 2. Tokenize
-        var lexer = Lexer.init(self.allocator, wrapped, "<repl>");
+
+        const value = try self.compileAndCall(wrapped, entry);
+        if (is_expression) {
+            std.debug.print("\x1b[1;36m→ {d}\x1b[0m\n", .{value});
+        }
+
+        // 执行成功的 let 绑定在之后的输入中仍然可见
+        if (std.mem.startsWith(u8, code, "let ")) {
+            try self.let_source.appendSlice(self.allocator, code);
+            try self.let_source.append(self.allocator, '\n');
+        }
+    }
+
+    /// 🆕 v0.2.0: 顶层声明：检查通过后降低为新模块加入 JIT 会话
+    fn evalDeclaration(self: *REPL, code: []const u8) !void {
+        if (!llvm_available) return;
+
+        const source = try std.fmt.allocPrint(self.allocator, "{s}\n{s}\n", .{ self.decl_source.items, code });
+        defer self.allocator.free(source);
+
+        var lexer = Lexer.init(self.allocator, source, repl_filename);
         defer lexer.deinit();
-        _ = lexer.tokenize() catch |err| {
-            std.debug.print("Lexer error: {any}\n", .{err});
-            return;
-        };
-        
-        std.debug.print("\x1b[1;36m→ Code parsed successfully\x1b[0m\n", .{});
-        
-        // TODO: Continue with parsing, type checking, and execution
+        const tokens = try lexer.tokenize();
+        var parser = Parser.init(self.allocator, tokens);
+        defer parser.deinit();
+        try parser.addKnownTypes(self.prelude.?.type_names.items);
+        const program = try parser.parse();
+        try self.typeCheck(&lexer, tokens, program);
+
+        // 本次输入之前的声明已经在 JIT 中定义，新模块只声明它们
+        const externs = program.declarations[0..self.decl_count];
+        const defined = program.declarations[self.decl_count..];
+        for (defined) |decl| {
+            if (decl != .function) continue;
+            if (self.isDefined(externs, decl.function.name)) {
+                std.debug.print("❌ Error: '{s}' is already defined in this session\n", .{decl.function.name});
+                return error.DuplicateDefinition;
+            }
+        }
+
+        const all_externs = try self.withPrelude(externs);
+        defer self.allocator.free(all_externs);
+        try self.session.?.addProgram(.{ .declarations = defined }, all_externs);
+        try self.decl_source.appendSlice(self.allocator, code);
+        try self.decl_source.append(self.allocator, '\n');
+        self.decl_count = program.declarations.len;
+
+        for (defined) |decl| {
+            if (decl == .function) {
+                std.debug.print("\x1b[1;36m✓ fn {s}\x1b[0m\n", .{decl.function.name});
+            }
+        }
     }
-    
+
+    /// 编译 source（之前的声明 + 求值函数），只把求值函数加入 JIT 并调用它
+    fn compileAndCall(self: *REPL, source: []const u8, entry: []const u8) !i32 {
+        if (!llvm_available) return 0;
+
+        var lexer = Lexer.init(self.allocator, source, repl_filename);
+        defer lexer.deinit();
+        const tokens = try lexer.tokenize();
+        var parser = Parser.init(self.allocator, tokens);
+        defer parser.deinit();
+        try parser.addKnownTypes(self.prelude.?.type_names.items);
+        const program = try parser.parse();
+        try self.typeCheck(&lexer, tokens, program);
+
+        const decls = program.declarations;
+        const externs = decls[0 .. decls.len - 1];
+        const all_externs = try self.withPrelude(externs);
+        defer self.allocator.free(all_externs);
+        try self.session.?.addProgram(.{ .declarations = decls[decls.len - 1 ..] }, all_externs);
+        return self.session.?.call(entry, true);
+    }
+
+    fn typeCheck(self: *REPL, lexer: *Lexer, tokens: []Token, program: ast.Program) !void {
+        var type_checker = TypeChecker.init(self.allocator, repl_filename, tokens);
+        defer type_checker.deinit();
+        type_checker.setInterner(&lexer.interner);
+        type_checker.setRequireMain(false);
+        try type_checker.registerPrelude(self.prelude.?.declarations);
+        try type_checker.check(program);
+    }
+
+    /// prelude 声明 + 之前输入的声明（新模块中作为外部声明），调用方负责释放
+    fn withPrelude(self: *REPL, externs: []const ast.TopLevelDecl) ![]const ast.TopLevelDecl {
+        const prelude_decls = self.prelude.?.declarations;
+        const all = try self.allocator.alloc(ast.TopLevelDecl, prelude_decls.len + externs.len);
+        @memcpy(all[0..prelude_decls.len], prelude_decls);
+        @memcpy(all[prelude_decls.len..], externs);
+        return all;
+    }
+
+    fn isDefined(self: *REPL, decls: []const ast.TopLevelDecl, name: []const u8) bool {
+        for (self.prelude.?.declarations) |decl| {
+            if (decl == .function and std.mem.eql(u8, decl.function.name, name)) return true;
+        }
+        for (decls) |decl| {
+            if (decl == .function and std.mem.eql(u8, decl.function.name, name)) return true;
+        }
+        return false;
+    }
+
+    fn isDeclaration(code: []const u8) bool {
+        const starters = [_][]const u8{ "fn ", "pub ", "type ", "import ", "async fn " };
+        for (starters) |starter| {
+            if (std.mem.startsWith(u8, code, starter)) return true;
+        }
+        return false;
+    }
+
     fn printWelcome(self: *REPL) !void {
         _ = self;
-        
+
         std.debug.print("\n", .{});
         std.debug.print("╔═══════════════════════════════════════════════════════════╗\n", .{});
         std.debug.print("║  🐾 PawLang REPL v0.1.9                                  ║\n", .{});
@@ -105,10 +310,10 @@ pub const REPL = struct {
         std.debug.print("🚀 Try: let x = 42;\n", .{});
         std.debug.print("\n", .{});
     }
-    
+
     fn printHelp(self: *REPL) !void {
         _ = self;
-        
+
         std.debug.print("\n", .{});
         std.debug.print("📚 REPL Commands:\n", .{});
         std.debug.print("   help      - Show this help message\n", .{});
@@ -121,15 +326,16 @@ pub const REPL = struct {
         std.debug.print("   • Functions:     fn add(a: i32, b: i32) -> i32 {{ return a + b; }}\n", .{});
         std.debug.print("   • Types:         type Point = struct {{ x: i32; y: i32; }};\n", .{});
         std.debug.print("   • Generics:      fn identity<T>(x: T) -> T {{ return x; }}\n", .{});
+        std.debug.print("   • Expressions:   add(1, 2)   (no trailing ';' shows the value)\n", .{});
         std.debug.print("\n", .{});
     }
-    
+
     fn printHistory(self: *REPL) !void {
         if (self.history.items.len == 0) {
             std.debug.print("📝 No history yet\n", .{});
             return;
         }
-        
+
         std.debug.print("\n📝 Command History:\n", .{});
         for (self.history.items, 0..) |item, idx| {
             std.debug.print("  {d}: {s}\n", .{idx + 1, item});
@@ -137,4 +343,3 @@ pub const REPL = struct {
         std.debug.print("\n", .{});
     }
 };
-
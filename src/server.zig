@@ -0,0 +1,549 @@
+//! 🆕 v0.2.0: Compile Server - 常驻编译服务
+//!
+//! `pawc serve` 启动一个常驻进程，通过 Unix 域套接字接收命令并在进程内执行，
+//! 请求之间保留“热”状态，省去每次启动都要重复的工作：
+//!   - prelude 快照只解码一次（Prelude.load）
+//!   - 每个工作目录一个 ModuleLoader：已解析的模块常驻内存，
+//!     每个请求开始时按 mtime / 大小淘汰改动过的文件（ModuleLoader.evictChanged）
+//!   - C 编译器（zig cc / clang / gcc）只检测一次
+//!
+//! 客户端就是 pawc 本身：设置 PAWC_SERVER=<socket> 后，`pawc ...` 把当前目录和
+//! 参数发给服务器，转发服务器回传的 stdout / stderr，并以服务器给出的退出码退出。
+//! 连接失败时退回本地编译，所以 PAWC_SERVER 可以放心写进 shell 配置。
+//!
+//! 协议（小端序）：
+//!   请求：[u32 个数] 之后每项 [u32 长度][字节]；第 0 项是客户端 cwd，其余是 argv
+//!   响应：若干帧 [u8 标记][u32 长度][负载]
+//!         'o' = stdout 数据，'e' = stderr 数据，'x' = 结束（负载为 i32 退出码）
+//!
+//! 限制：
+//!   - 请求串行执行（命令会 chdir 到客户端目录，并占用进程的 fd 1 / 2）
+//!   - 不转发 stdin；带 --run 的命令总是在本地执行（见 local_only_flags）
+//!   - 仅支持 POSIX 系统
+
+const std = @import("std");
+const builtin = @import("builtin");
+const Prelude = @import("prelude.zig").Prelude;
+const ModuleLoader = @import("module.zig").ModuleLoader;
+const module_cache = @import("module_cache.zig");
+const CBackend = @import("c_backend.zig").CBackend;
+const prof = @import("profiler.zig");
+
+const posix = std.posix;
+
+/// 是否支持常驻服务（依赖 Unix 域套接字、pipe 和 dup2）
+pub const supported = builtin.os.tag != .windows;
+
+/// 默认的套接字路径（相对于启动服务器的目录）
+pub const default_socket = module_cache.default_dir ++ "/pawc.sock";
+
+/// 客户端读取服务器地址的环境变量
+pub const env_var = "PAWC_SERVER";
+
+/// `pawc serve --stop` 发出的特殊命令
+const shutdown_command = "--server-shutdown";
+
+/// 不能在服务器中执行的命令：会阻塞服务器、读取 stdin，或直接调用 process.exit
+const local_only_commands = [_][]const u8{ "serve", "lsp", "repl", "bench" };
+
+/// 带这些参数的命令也只在本地执行：--run 会执行用户程序（LLVM 后端在进程内 JIT 执行，
+/// 程序崩溃或调用 exit 会带走服务器；C 后端的程序会占用服务器的 stdin）
+const local_only_flags = [_][]const u8{"--run"};
+
+// ============================================================================
+// 常驻状态
+// ============================================================================
+
+/// 一次命令可以复用的常驻状态；本地执行时所有字段都是 null
+pub const Resident = struct {
+    prelude: ?*Prelude = null,
+    modules: ?*ModuleLoader = null,
+    cc_driver: ?*?CBackend.CompilerDriver = null,
+
+    /// 让 C 后端复用（并记录）常驻的编译器检测结果
+    pub fn shareCompilerDriver(self: Resident, backend: *CBackend) void {
+        backend.shared_driver = self.cc_driver;
+    }
+};
+
+/// 执行一条命令的入口（main.zig 中的 run）
+pub const RunFn = *const fn (
+    std.mem.Allocator,
+    *prof.CountingAllocator,
+    []const [:0]u8,
+    Resident,
+) anyerror!void;
+
+pub const ServeOptions = struct {
+    version: []const u8,
+    run: RunFn,
+};
+
+/// argv[0] 是程序名，argv[1] 是命令（或源文件）
+fn isLocalOnly(argv: []const [:0]u8) bool {
+    if (argv.len < 2) return false;
+    for (local_only_commands) |name| {
+        if (std.mem.eql(u8, argv[1], name)) return true;
+    }
+    for (argv[1..]) |arg| {
+        for (local_only_flags) |flag| {
+            if (std.mem.eql(u8, arg, flag)) return true;
+        }
+    }
+    return false;
+}
+
+// ============================================================================
+// 帧读写
+// ============================================================================
+
+const Tag = enum(u8) {
+    stdout = 'o',
+    stderr = 'e',
+    exit = 'x',
+};
+
+fn writeAll(fd: posix.fd_t, bytes: []const u8) !void {
+    var offset: usize = 0;
+    while (offset < bytes.len) {
+        offset += try posix.write(fd, bytes[offset..]);
+    }
+}
+
+/// 读满 buf；对端提前关闭时返回 error.EndOfStream
+fn readExact(fd: posix.fd_t, buf: []u8) !void {
+    var offset: usize = 0;
+    while (offset < buf.len) {
+        const n = try posix.read(fd, buf[offset..]);
+        if (n == 0) return error.EndOfStream;
+        offset += n;
+    }
+}
+
+fn writeU32(fd: posix.fd_t, value: u32) !void {
+    var bytes: [4]u8 = undefined;
+    std.mem.writeInt(u32, &bytes, value, .little);
+    try writeAll(fd, &bytes);
+}
+
+fn readU32(fd: posix.fd_t) !u32 {
+    var bytes: [4]u8 = undefined;
+    try readExact(fd, &bytes);
+    return std.mem.readInt(u32, &bytes, .little);
+}
+
+fn writeFrame(fd: posix.fd_t, tag: Tag, payload: []const u8) !void {
+    try writeAll(fd, &[_]u8{@intFromEnum(tag)});
+    try writeU32(fd, @intCast(payload.len));
+    try writeAll(fd, payload);
+}
+
+fn writeExit(fd: posix.fd_t, code: i32) !void {
+    var bytes: [4]u8 = undefined;
+    std.mem.writeInt(i32, &bytes, code, .little);
+    try writeFrame(fd, .exit, &bytes);
+}
+
+/// 单个请求项的长度上限（cwd / 参数都远小于它，防止异常请求耗尽内存）
+const max_item_len = 1 << 20;
+const max_items = 4096;
+
+/// 请求：cwd + argv（都以 '\0' 结尾，argv 可以直接交给 run）
+const Request = struct {
+    items: [][:0]u8,
+
+    fn read(allocator: std.mem.Allocator, fd: posix.fd_t) !Request {
+        const count = try readU32(fd);
+        if (count < 1 or count > max_items) return error.InvalidRequest;
+
+        const items = try allocator.alloc([:0]u8, count);
+        var filled: usize = 0;
+        errdefer {
+            for (items[0..filled]) |item| allocator.free(item);
+            allocator.free(items);
+        }
+        while (filled < count) : (filled += 1) {
+            const len = try readU32(fd);
+            if (len > max_item_len) return error.InvalidRequest;
+            const item = try allocator.allocSentinel(u8, len, 0);
+            errdefer allocator.free(item);
+            try readExact(fd, item);
+            items[filled] = item;
+        }
+        return .{ .items = items };
+    }
+
+    fn deinit(self: Request, allocator: std.mem.Allocator) void {
+        for (self.items) |item| allocator.free(item);
+        allocator.free(self.items);
+    }
+
+    fn cwd(self: Request) [:0]const u8 {
+        return self.items[0];
+    }
+
+    fn argv(self: Request) []const [:0]u8 {
+        return self.items[1..];
+    }
+
+    fn command(self: Request) []const u8 {
+        return if (self.items.len >= 3) self.items[2] else "";
+    }
+};
+
+/// argv: []const [:0]u8 或 [:0]const u8 的数组
+fn writeRequest(fd: posix.fd_t, cwd: []const u8, argv: anytype) !void {
+    try writeU32(fd, @intCast(argv.len + 1));
+    try writeU32(fd, @intCast(cwd.len));
+    try writeAll(fd, cwd);
+    for (argv) |arg| {
+        try writeU32(fd, @intCast(arg.len));
+        try writeAll(fd, arg);
+    }
+}
+
+// ============================================================================
+// 客户端
+// ============================================================================
+
+/// 把命令交给 PAWC_SERVER 指向的服务器执行
+/// 返回: 服务器给出的退出码；返回 null 表示应该在本地执行
+///       （没有设置 PAWC_SERVER、命令只能本地执行，或者连接失败）
+pub fn forward(allocator: std.mem.Allocator, args: []const [:0]u8) ?u8 {
+    if (!supported) return null;
+    if (args.len < 2 or isLocalOnly(args)) return null;
+    const socket_path = posix.getenv(env_var) orelse return null;
+    if (socket_path.len == 0) return null;
+
+    const stream = std.net.connectUnixSocket(socket_path) catch return null;
+    defer stream.close();
+
+    const cwd = std.process.getCwdAlloc(allocator) catch return null;
+    defer allocator.free(cwd);
+
+    writeRequest(stream.handle, cwd, args) catch return null;
+
+    // 请求已经发出：此后的失败不能再退回本地执行（命令可能已经执行了一部分）
+    return relayOutput(allocator, stream.handle) catch |err| {
+        std.debug.print("Error: lost connection to compile server {s}: {any}\n", .{ socket_path, err });
+        return 1;
+    };
+}
+
+/// 把服务器回传的输出写到本进程的 stdout / stderr，直到收到结束帧
+fn relayOutput(allocator: std.mem.Allocator, fd: posix.fd_t) !u8 {
+    var payload = std.ArrayList(u8){};
+    defer payload.deinit(allocator);
+
+    while (true) {
+        var tag: [1]u8 = undefined;
+        try readExact(fd, &tag);
+        const len = try readU32(fd);
+        if (len > max_item_len) return error.InvalidResponse;
+        try payload.resize(allocator, len);
+        try readExact(fd, payload.items);
+
+        switch (tag[0]) {
+            @intFromEnum(Tag.stdout) => try writeAll(posix.STDOUT_FILENO, payload.items),
+            @intFromEnum(Tag.stderr) => try writeAll(posix.STDERR_FILENO, payload.items),
+            @intFromEnum(Tag.exit) => {
+                if (payload.items.len != 4) return error.InvalidResponse;
+                const code = std.mem.readInt(i32, payload.items[0..4], .little);
+                return @intCast(std.math.clamp(code, 0, 255));
+            },
+            else => return error.InvalidResponse,
+        }
+    }
+}
+
+// ============================================================================
+// 服务器
+// ============================================================================
+
+/// pawc serve [--socket=<path>] [--stop]
+pub const serve = if (supported) servePosix else serveUnsupported;
+
+fn serveUnsupported(
+    allocator: std.mem.Allocator,
+    counting: *prof.CountingAllocator,
+    args: []const [:0]u8,
+    options: ServeOptions,
+) !void {
+    _ = allocator;
+    _ = counting;
+    _ = args;
+    _ = options;
+    std.debug.print("Error: pawc serve is not supported on this platform\n", .{});
+}
+
+fn servePosix(
+    allocator: std.mem.Allocator,
+    counting: *prof.CountingAllocator,
+    args: []const [:0]u8,
+    options: ServeOptions,
+) !void {
+    var socket_arg: []const u8 = default_socket;
+    var stop = false;
+    for (args) |arg| {
+        if (std.mem.startsWith(u8, arg, "--socket=")) {
+            socket_arg = arg["--socket=".len..];
+        } else if (std.mem.eql(u8, arg, "--stop")) {
+            stop = true;
+        } else {
+            std.debug.print("Error: unknown serve option: {s}\n", .{arg});
+            std.debug.print("Usage: pawc serve [--socket=<path>] [--stop]\n", .{});
+            return;
+        }
+    }
+
+    // 客户端可能在任意目录，所以服务器始终公布绝对路径
+    const root = try std.process.getCwdAlloc(allocator);
+    defer allocator.free(root);
+    const socket_path = try std.fs.path.resolve(allocator, &.{ root, socket_arg });
+    defer allocator.free(socket_path);
+
+    if (stop) {
+        stopServer(socket_path);
+        return;
+    }
+
+    // 套接字文件已存在：另一个服务器还在运行，或者上次没有正常退出
+    if (std.net.connectUnixSocket(socket_path)) |stream| {
+        stream.close();
+        std.debug.print("Error: a compile server is already listening on {s}\n", .{socket_path});
+        return;
+    } else |_| {
+        std.fs.deleteFileAbsolute(socket_path) catch {};
+    }
+    if (std.fs.path.dirname(socket_path)) |dir| try std.fs.cwd().makePath(dir);
+
+    const address = std.net.Address.initUnix(socket_path) catch |err| {
+        std.debug.print("Error: invalid socket path {s}: {any}\n", .{ socket_path, err });
+        return;
+    };
+    var listener = try address.listen(.{});
+    defer {
+        listener.deinit();
+        std.fs.deleteFileAbsolute(socket_path) catch {};
+    }
+
+    // 常驻状态
+    const prelude = try Prelude.load(allocator);
+    defer prelude.deinit();
+
+    var loaders = std.StringHashMap(*ModuleLoader).init(allocator);
+    defer {
+        var it = loaders.iterator();
+        while (it.next()) |entry| {
+            entry.value_ptr.*.deinit();
+            allocator.destroy(entry.value_ptr.*);
+            allocator.free(entry.key_ptr.*);
+        }
+        loaders.deinit();
+    }
+
+    var cc_driver: ?CBackend.CompilerDriver = null;
+
+    std.debug.print("🐾 pawc compile server listening on {s}\n", .{socket_path});
+    std.debug.print("   export {s}={s}\n", .{ env_var, socket_path });
+
+    var requests: usize = 0;
+    while (true) {
+        const connection = listener.accept() catch |err| {
+            std.debug.print("Error: accept failed: {any}\n", .{err});
+            continue;
+        };
+        defer connection.stream.close();
+        const fd = connection.stream.handle;
+
+        const request = Request.read(allocator, fd) catch |err| {
+            std.debug.print("Error: invalid request: {any}\n", .{err});
+            continue;
+        };
+        defer request.deinit(allocator);
+
+        if (std.mem.eql(u8, request.command(), shutdown_command)) {
+            writeExit(fd, 0) catch {};
+            std.debug.print("🐾 pawc compile server stopped after {d} request(s)\n", .{requests});
+            return;
+        }
+        requests += 1;
+
+        const loader = resolveLoader(allocator, &loaders, request.cwd(), options.version) catch |err| {
+            std.debug.print("Error: cannot prepare modules for {s}: {any}\n", .{ request.cwd(), err });
+            continue;
+        };
+
+        const exit_code = handleRequest(allocator, counting, fd, request, options, .{
+            .prelude = prelude,
+            .modules = loader,
+            .cc_driver = &cc_driver,
+        });
+        writeExit(fd, exit_code) catch {};
+
+        posix.chdir(root) catch {};
+    }
+}
+
+/// 同一个工作目录的请求共享一个 ModuleLoader（模块路径相对于 cwd）
+fn resolveLoader(
+    allocator: std.mem.Allocator,
+    loaders: *std.StringHashMap(*ModuleLoader),
+    cwd: []const u8,
+    version: []const u8,
+) !*ModuleLoader {
+    if (loaders.get(cwd)) |loader| return loader;
+
+    const key = try allocator.dupe(u8, cwd);
+    errdefer allocator.free(key);
+    const loader = try allocator.create(ModuleLoader);
+    errdefer allocator.destroy(loader);
+    loader.* = ModuleLoader.init(allocator);
+    loader.enableCache(module_cache.default_dir, version);
+    try loaders.put(key, loader);
+    return loader;
+}
+
+/// 在客户端的目录中执行一条命令，把 fd 1 / 2 的输出转发给客户端
+/// 返回: 退出码
+fn handleRequest(
+    allocator: std.mem.Allocator,
+    counting: *prof.CountingAllocator,
+    client: posix.fd_t,
+    request: Request,
+    options: ServeOptions,
+    resident: Resident,
+) i32 {
+    if (isLocalOnly(request.argv())) {
+        const message = std.fmt.allocPrint(allocator, "Error: 'pawc {s}' cannot run in the compile server\n", .{request.command()}) catch return 1;
+        defer allocator.free(message);
+        writeFrame(client, .stderr, message) catch {};
+        return 1;
+    }
+
+    posix.chdir(request.cwd()) catch |err| {
+        const message = std.fmt.allocPrint(allocator, "Error: cannot enter {s}: {any}\n", .{ request.cwd(), err }) catch return 1;
+        defer allocator.free(message);
+        writeFrame(client, .stderr, message) catch {};
+        return 1;
+    };
+
+    // 上一个请求之后改动过的文件需要重新解析
+    resident.modules.?.evictChanged() catch {};
+
+    var capture = Capture.begin(client) catch |err| {
+        const message = std.fmt.allocPrint(allocator, "Error: cannot capture output: {any}\n", .{err}) catch return 1;
+        defer allocator.free(message);
+        writeFrame(client, .stderr, message) catch {};
+        return 1;
+    };
+
+    var exit_code: i32 = 0;
+    options.run(allocator, counting, request.argv(), resident) catch |err| {
+        std.debug.print("error: {s}\n", .{@errorName(err)});
+        exit_code = 1;
+    };
+
+    capture.end();
+    return exit_code;
+}
+
+/// 把 fd 1 / 2 临时重定向到管道，由转发线程把管道中的数据写成帧
+const Capture = struct {
+    saved_stdout: posix.fd_t,
+    saved_stderr: posix.fd_t,
+    stdout_pipe: [2]posix.fd_t,
+    stderr_pipe: [2]posix.fd_t,
+    thread: std.Thread,
+
+    fn begin(client: posix.fd_t) !Capture {
+        const stdout_pipe = try posix.pipe();
+        errdefer closePipe(stdout_pipe);
+        const stderr_pipe = try posix.pipe();
+        errdefer closePipe(stderr_pipe);
+
+        const saved_stdout = try posix.dup(posix.STDOUT_FILENO);
+        errdefer posix.close(saved_stdout);
+        const saved_stderr = try posix.dup(posix.STDERR_FILENO);
+        errdefer posix.close(saved_stderr);
+
+        const thread = try std.Thread.spawn(.{}, relayPipes, .{ client, stdout_pipe[0], stderr_pipe[0] });
+
+        // 重定向之后的输出（包括 --run 启动的子进程）都进入管道
+        posix.dup2(stdout_pipe[1], posix.STDOUT_FILENO) catch {};
+        posix.dup2(stderr_pipe[1], posix.STDERR_FILENO) catch {};
+        posix.close(stdout_pipe[1]);
+        posix.close(stderr_pipe[1]);
+
+        return .{
+            .saved_stdout = saved_stdout,
+            .saved_stderr = saved_stderr,
+            .stdout_pipe = stdout_pipe,
+            .stderr_pipe = stderr_pipe,
+            .thread = thread,
+        };
+    }
+
+    /// 恢复 fd 1 / 2；管道写端全部关闭后转发线程读到 EOF 并退出
+    fn end(self: *Capture) void {
+        posix.dup2(self.saved_stdout, posix.STDOUT_FILENO) catch {};
+        posix.dup2(self.saved_stderr, posix.STDERR_FILENO) catch {};
+        posix.close(self.saved_stdout);
+        posix.close(self.saved_stderr);
+        self.thread.join();
+        posix.close(self.stdout_pipe[0]);
+        posix.close(self.stderr_pipe[0]);
+    }
+
+    fn closePipe(pipe: [2]posix.fd_t) void {
+        posix.close(pipe[0]);
+        posix.close(pipe[1]);
+    }
+};
+
+/// 转发线程：轮询两个管道，直到两者都读到 EOF
+/// 客户端断开后继续读空管道，避免命令因管道写满而阻塞
+fn relayPipes(client: posix.fd_t, stdout_fd: posix.fd_t, stderr_fd: posix.fd_t) void {
+    var fds = [_]posix.pollfd{
+        .{ .fd = stdout_fd, .events = posix.POLL.IN, .revents = 0 },
+        .{ .fd = stderr_fd, .events = posix.POLL.IN, .revents = 0 },
+    };
+    const tags = [_]Tag{ .stdout, .stderr };
+    var open: usize = fds.len;
+    var client_alive = true;
+    var buf: [16 * 1024]u8 = undefined;
+
+    while (open > 0) {
+        _ = posix.poll(&fds, -1) catch return;
+        for (&fds, tags) |*pfd, tag| {
+            if (pfd.fd < 0 or pfd.revents == 0) continue;
+            const n = posix.read(pfd.fd, &buf) catch 0;
+            if (n == 0) {
+                // 管道已关闭：负数 fd 会被 poll 忽略
+                pfd.fd = -1;
+                open -= 1;
+                continue;
+            }
+            if (client_alive) {
+                writeFrame(client, tag, buf[0..n]) catch {
+                    client_alive = false;
+                };
+            }
+        }
+    }
+}
+
+/// pawc serve --stop
+fn stopServer(socket_path: []const u8) void {
+    const stream = std.net.connectUnixSocket(socket_path) catch {
+        std.debug.print("No compile server is listening on {s}\n", .{socket_path});
+        return;
+    };
+    defer stream.close();
+
+    const argv = [_][:0]const u8{ "pawc", shutdown_command };
+    writeRequest(stream.handle, "/", &argv) catch {};
+    var frame: [9]u8 = undefined;
+    readExact(stream.handle, &frame) catch {};
+    std.debug.print("🐾 Stopped compile server on {s}\n", .{socket_path});
+}
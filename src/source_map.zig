@@ -0,0 +1,161 @@
+//! 🆕 v0.2.0: Source Map - 源文件映射与行索引
+//!
+//! 每个源文件在一次编译中只打开一次：
+//! - 支持 mmap 的平台上直接把文件映射为只读内存（无大小上限，不复制）
+//! - 其他平台（Windows / WASI）回退为一次性读入堆内存
+//! - Lexer、ModuleLoader 和诊断输出共享同一份映射
+//! - 按需构建行首偏移索引，诊断定位某一行是 O(1)
+//!
+//! 源码切片（Token.lexeme、AST 中的名字）直接指向映射内存，
+//! 因此 SourceMap 必须比使用这些切片的所有阶段活得更久。
+
+const std = @import("std");
+const builtin = @import("builtin");
+
+/// 当前平台是否使用 mmap 读取源文件
+const use_mmap = switch (builtin.os.tag) {
+    .windows, .wasi => false,
+    else => true,
+};
+
+pub const SourceFile = struct {
+    allocator: std.mem.Allocator,  // 所属 SourceMap 的分配器（内容与行索引都由它分配和释放）
+    path: []const u8,
+    bytes: []const u8,
+    mapping: ?[]align(std.heap.page_size_min) const u8,  // mmap 的映射（null = 堆内存）
+    line_starts: ?[]usize,  // 每行第一个字节的偏移（延迟构建）
+    line_mutex: std.Thread.Mutex,
+
+    fn load(allocator: std.mem.Allocator, path: []const u8) !SourceFile {
+        var file = try std.fs.cwd().openFile(path, .{});
+        defer file.close();
+
+        const size = (try file.stat()).size;
+        var result = SourceFile{
+            .allocator = allocator,
+            .path = path,
+            .bytes = &[_]u8{},
+            .mapping = null,
+            .line_starts = null,
+            .line_mutex = .{},
+        };
+        if (size == 0) return result;
+
+        if (use_mmap) {
+            const len = std.math.cast(usize, size) orelse return error.FileTooBig;
+            if (std.posix.mmap(
+                null,
+                len,
+                std.posix.PROT.READ,
+                .{ .TYPE = .PRIVATE },
+                file.handle,
+                0,
+            )) |mapping| {
+                result.mapping = mapping;
+                result.bytes = mapping;
+                return result;
+            } else |_| {
+                // 映射失败（例如特殊文件系统）时回退为读取
+            }
+        }
+
+        result.bytes = try file.readToEndAlloc(allocator, std.math.maxInt(usize));
+        return result;
+    }
+
+    fn deinit(self: *SourceFile) void {
+        if (self.mapping) |mapping| {
+            std.posix.munmap(mapping);
+        } else if (self.bytes.len > 0) {
+            self.allocator.free(self.bytes);
+        }
+        if (self.line_starts) |starts| {
+            self.allocator.free(starts);
+        }
+    }
+
+    /// 取第 line_number 行（从 1 开始，不含换行符）；超出范围返回 null
+    pub fn line(self: *SourceFile, line_number: usize) !?[]const u8 {
+        if (line_number == 0) return null;
+        const starts = try self.lineStarts();
+        if (line_number > starts.len) return null;
+
+        const start = starts[line_number - 1];
+        var end = if (line_number < starts.len) starts[line_number] - 1 else self.bytes.len;
+        if (end > start and self.bytes[end - 1] == '\r') end -= 1;
+        return self.bytes[start..end];
+    }
+
+    /// 行首偏移索引（第一次调用时扫描一遍文件）
+    pub fn lineStarts(self: *SourceFile) ![]const usize {
+        const allocator = self.allocator;
+        self.line_mutex.lock();
+        defer self.line_mutex.unlock();
+
+        if (self.line_starts) |starts| return starts;
+
+        var starts = std.ArrayList(usize){};
+        errdefer starts.deinit(allocator);
+        try starts.append(allocator, 0);
+
+        var pos: usize = 0;
+        while (std.mem.indexOfScalarPos(u8, self.bytes, pos, '\n')) |newline| {
+            pos = newline + 1;
+            try starts.append(allocator, pos);
+        }
+
+        self.line_starts = try starts.toOwnedSlice(allocator);
+        return self.line_starts.?;
+    }
+};
+
+/// 一次编译中打开的所有源文件（线程安全，ModuleLoader 的工作线程会并发打开模块）
+pub const SourceMap = struct {
+    allocator: std.mem.Allocator,
+    files: std.StringHashMap(*SourceFile),
+    mutex: std.Thread.Mutex,
+
+    pub fn init(allocator: std.mem.Allocator) SourceMap {
+        return SourceMap{
+            .allocator = allocator,
+            .files = std.StringHashMap(*SourceFile).init(allocator),
+            .mutex = .{},
+        };
+    }
+
+    pub fn deinit(self: *SourceMap) void {
+        var it = self.files.iterator();
+        while (it.next()) |entry| {
+            entry.value_ptr.*.deinit();
+            self.allocator.destroy(entry.value_ptr.*);
+            self.allocator.free(entry.key_ptr.*);
+        }
+        self.files.deinit();
+    }
+
+    /// 打开源文件；同一路径只会映射一次
+    pub fn open(self: *SourceMap, path: []const u8) !*SourceFile {
+        self.mutex.lock();
+        defer self.mutex.unlock();
+
+        if (self.files.get(path)) |existing| return existing;
+
+        const key = try self.allocator.dupe(u8, path);
+        errdefer self.allocator.free(key);
+
+        const file = try self.allocator.create(SourceFile);
+        errdefer self.allocator.destroy(file);
+        file.* = try SourceFile.load(self.allocator, key);
+        errdefer file.deinit();
+
+        try self.files.put(key, file);
+        return file;
+    }
+
+    /// 查找已经打开的源文件（不会访问磁盘）
+    pub fn get(self: *SourceMap, path: []const u8) ?*SourceFile {
+        self.mutex.lock();
+        defer self.mutex.unlock();
+        return self.files.get(path);
+    }
+};
@@ -1,3 +1,7 @@
+const intern = @import("intern.zig");
+const Symbol = intern.Symbol;
+const no_symbol = intern.no_symbol;
+
 pub const TokenType = enum {
     // Paw 核心关键字 (19个) - 极简设计
     keyword_fn,       // 函数定义
@@ -109,6 +113,7 @@ pub const Token = struct {
     line: usize,
     column: usize,
     filename: []const u8,  // 🆕 v0.1.8: 文件名
+    symbol: Symbol = no_symbol,  // 🆕 v0.2.0: 标识符的驻留编号（见 intern.zig）
 
     pub fn init(token_type: TokenType, lexeme: []const u8, line: usize, column: usize, filename: []const u8) Token {
         return Token{
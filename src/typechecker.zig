@@ -24,6 +24,47 @@ pub const TypeMethods = struct {
 };
 
 const Token = @import("token.zig").Token;  // 🆕 v0.1.8
+const Interner = @import("intern.zig").Interner;  // 🆕 v0.2.0
+const SourceMap = @import("source_map.zig").SourceMap;  // 🆕 v0.2.0
+const prof = @import("profiler.zig");  // 🆕 v0.2.0
+const incremental = @import("incremental.zig");  // 🆕 v0.2.0
+
+/// 🆕 v0.2.0: 链式词法作用域
+/// 进入新的块只需在栈上创建一个指向父作用域的空帧（O(1)），
+/// 不再复制父作用域的所有变量；查找时沿作用域链向上
+pub const Scope = struct {
+    allocator: std.mem.Allocator,
+    parent: ?*const Scope,
+    vars: std.StringHashMapUnmanaged(ast.Type) = .{},
+    
+    /// 创建函数的根作用域
+    pub fn init(allocator: std.mem.Allocator) Scope {
+        return Scope{ .allocator = allocator, .parent = null };
+    }
+    
+    /// 创建子作用域（只有在子作用域中声明变量时才会分配内存）
+    pub fn child(parent: *const Scope) Scope {
+        return Scope{ .allocator = parent.allocator, .parent = parent };
+    }
+    
+    pub fn deinit(self: *Scope) void {
+        self.vars.deinit(self.allocator);
+    }
+    
+    /// 在当前帧中声明（或遮蔽）变量
+    pub fn put(self: *Scope, name: []const u8, var_type: ast.Type) !void {
+        try self.vars.put(self.allocator, name, var_type);
+    }
+    
+    /// 从当前帧开始沿作用域链查找变量
+    pub fn get(self: *const Scope, name: []const u8) ?ast.Type {
+        var frame: ?*const Scope = self;
+        while (frame) |f| : (frame = f.parent) {
+            if (f.vars.get(name)) |var_type| return var_type;
+        }
+        return null;
+    }
+};
 
 pub const TypeChecker = struct {
     allocator: std.mem.Allocator,
@@ -40,7 +81,17 @@ pub const TypeChecker = struct {
     mutable_vars: std.StringHashMap(bool),  // 🆕 v0.1.6: 跟踪可变变量 (变量名 -> 是否可变)
     source_file: []const u8,  // 🆕 v0.1.8: 当前处理的源文件名
     tokens: []Token,  // 🆕 v0.1.8: Token 数组用于位置查找
-    identifier_tokens: std.StringHashMap(Token),  // 🆕 v0.1.8: 标识符名 -> Token 映射
+    identifier_tokens: std.ArrayList(?Token),  // 🆕 v0.2.0: 标识符编号 (Symbol) -> 最后一次出现的 Token
+    interner: ?*const Interner,  // 🆕 v0.2.0: Lexer 的标识符驻留表（按名字查找 Token 时使用）
+    sources: ?*SourceMap,  // 🆕 v0.2.0: 已打开的源文件（诊断片段直接取行，不重读文件）
+    profiler: ?*prof.Profiler,  // 🆕 v0.2.0: --time-report 逐函数计时
+    clean_decls: ?*const std.StringHashMap(void),  // 🆕 v0.2.0: 增量编译中无需重新检查的声明
+    jobs: usize,  // 🆕 v0.2.0: 并行检查函数体的线程数（1 = 串行）
+    require_main: bool,  // 🆕 v0.2.0: 程序必须定义 main（REPL 输入不需要）
+    print_diagnostics: bool,  // 🆕 v0.2.0: check() 失败时是否打印诊断（语言服务器自己读取 diagnostics）
+
+    /// 🆕 v0.2.0: 函数数量少于该值时不启用线程池（线程开销大于收益）
+    const parallel_threshold = 16;
 
     pub fn init(allocator: std.mem.Allocator, source_file: []const u8, tokens: []Token) TypeChecker {
         return TypeChecker{
@@ -58,9 +109,58 @@ pub const TypeChecker = struct {
             .mutable_vars = std.StringHashMap(bool).init(allocator),  // 🆕 v0.1.6: 初始化可变变量表
             .source_file = source_file,  // 🆕 v0.1.8
             .tokens = tokens,  // 🆕 v0.1.8
-            .identifier_tokens = std.StringHashMap(Token).init(allocator),  // 🆕 v0.1.8
+            .identifier_tokens = std.ArrayList(?Token){},  // 🆕 v0.2.0
+            .interner = null,
+            .sources = null,
+            .profiler = null,
+            .clean_decls = null,
+            .jobs = 1,
+            .require_main = true,
+            .print_diagnostics = true,
         };
     }
+    
+    /// 🆕 v0.2.0: 提供 tokens 对应的驻留表，诊断时按 Symbol 定位标识符
+    pub fn setInterner(self: *TypeChecker, interner: *const Interner) void {
+        self.interner = interner;
+    }
+    
+    /// 🆕 v0.2.0: 诊断输出使用的源文件表
+    pub fn setSourceMap(self: *TypeChecker, sources: *SourceMap) void {
+        self.sources = sources;
+    }
+    
+    /// 🆕 v0.2.0: 记录每个函数的检查耗时
+    pub fn setProfiler(self: *TypeChecker, profiler: *prof.Profiler) void {
+        self.profiler = profiler;
+    }
+    
+    /// 🆕 v0.2.0: 增量编译：这些声明（及其依赖）自上次检查通过后没有变化，
+    /// 仍然登记到符号表，但跳过函数体检查
+    pub fn setCleanDecls(self: *TypeChecker, clean: *const std.StringHashMap(void)) void {
+        self.clean_decls = clean;
+    }
+    
+    fn isClean(self: *const TypeChecker, decl: ast.TopLevelDecl) bool {
+        const clean = self.clean_decls orelse return false;
+        const name = incremental.declName(decl) orelse return false;
+        return clean.contains(name);
+    }
+    
+    /// 🆕 v0.2.0: 设置并行检查函数体的线程数
+    pub fn setJobs(self: *TypeChecker, jobs: usize) void {
+        self.jobs = @max(jobs, 1);
+    }
+    
+    /// 🆕 v0.2.0: REPL 逐条输入检查，不要求 main 函数
+    pub fn setRequireMain(self: *TypeChecker, require_main: bool) void {
+        self.require_main = require_main;
+    }
+    
+    /// 🆕 v0.2.0: 语言服务器把 diagnostics / errors 转换为 LSP 诊断，不打印到 stderr
+    pub fn setPrintDiagnostics(self: *TypeChecker, print_diagnostics: bool) void {
+        self.print_diagnostics = print_diagnostics;
+    }
 
     pub fn deinit(self: *TypeChecker) void {
         // 🆕 v0.1.6: 释放错误消息内存
@@ -83,7 +183,7 @@ pub const TypeChecker = struct {
             }
         }
         self.diagnostics.deinit(self.allocator);
-        self.identifier_tokens.deinit();
+        self.identifier_tokens.deinit(self.allocator);
         
         self.symbol_table.deinit();
         self.function_table.deinit();
@@ -108,92 +208,228 @@ pub const TypeChecker = struct {
         self.arena.deinit();
     }
 
+    /// 🆕 v0.2.0: 查找标识符最后一次出现的 Token（仅在报错路径上调用）
+    fn identifierToken(self: *TypeChecker, name: []const u8) ?Token {
+        if (self.interner) |interner| {
+            const symbol = interner.lookup(name) orelse return null;
+            if (symbol >= self.identifier_tokens.items.len) return null;
+            return self.identifier_tokens.items[symbol];
+        }
+        // 没有驻留表（例如 REPL）：倒序线性扫描
+        var i = self.tokens.len;
+        while (i > 0) {
+            i -= 1;
+            const token = self.tokens[i];
+            if (token.type == .identifier and std.mem.eql(u8, token.lexeme, name)) return token;
+        }
+        return null;
+    }
+
     pub fn check(self: *TypeChecker, program: ast.Program) !void {
-        // 🆕 v0.1.8: 构建标识符 token 映射
-        for (self.tokens) |token| {
-            if (token.type == .identifier) {
-                try self.identifier_tokens.put(token.lexeme, token);
+        // 🆕 v0.2.0: 构建标识符 token 表（按 Symbol 下标，无需哈希字符串）
+        if (self.interner) |interner| {
+            try self.identifier_tokens.appendNTimes(self.allocator, null, interner.count());
+            for (self.tokens) |token| {
+                if (token.type == .identifier and token.symbol < self.identifier_tokens.items.len) {
+                    self.identifier_tokens.items[token.symbol] = token;
+                }
             }
         }
         
         // 第一遍：收集所有类型、函数和 trait 声明
         for (program.declarations) |decl| {
-            switch (decl) {
-                .function => |func| {
-                    try self.function_table.put(func.name, func);
-                },
-                .type_decl => |td| {
-                    try self.type_table.put(td.name, td);
-                    try self.symbol_table.put(td.name, ast.Type{ .named = td.name });
-                    
-                    // 收集 trait 定义
-                    if (td.kind == .trait_type) {
-                        const trait_def = TraitDef{
-                            .name = td.name,
-                            .methods = td.kind.trait_type.methods,
-                            .type_params = td.type_params,
-                        };
-                        try self.trait_table.put(td.name, trait_def);
-                    }
-                    
-                    // 收集类型的方法（struct 和 enum 有完整的方法实现）
-                    const methods: ?[]ast.FunctionDecl = switch (td.kind) {
-                        .struct_type => |st| st.methods,
-                        .enum_type => |et| et.methods,
-                        .trait_type => null,  // trait 只有签名，不收集到 type_methods
-                    };
-                    
-                    if (methods) |m| {
-                        if (m.len > 0) {
-                            var type_methods = TypeMethods{
-                                .type_name = td.name,
-                                .methods = std.StringHashMap(ast.FunctionDecl).init(self.allocator),
-                            };
-                            
-                            for (m) |method| {
-                                try type_methods.methods.put(method.name, method);
-                            }
-                            
-                            try self.type_methods.put(td.name, type_methods);
-                        }
-                    }
-                },
-                .struct_decl => |s| {
-                    try self.symbol_table.put(s.name, ast.Type{ .named = s.name });
-                },
-                .enum_decl => |e| {
-                    try self.symbol_table.put(e.name, ast.Type{ .named = e.name });
-                },
-                else => {},
-            }
+            try self.collectDecl(decl);
         }
 
         // 第二遍：类型检查
-        for (program.declarations) |decl| {
-            try self.checkDecl(decl);
+        // 🆕 v0.2.0: 第一遍完成后全局表冻结，函数体可以并行检查
+        if (self.jobs > 1) {
+            try self.checkBodiesParallel(program);
+        } else {
+            for (program.declarations) |decl| {
+                if (self.isClean(decl)) continue;
+                try self.checkDecl(decl);
+            }
         }
 
-        if (!self.function_table.contains("main")) {
+        if (self.require_main and !self.function_table.contains("main")) {
             try self.errors.append(self.allocator, "Error: missing main function");
         }
 
         // 🆕 v0.1.8: 打印增强的诊断消息
         if (self.diagnostics.items.len > 0) {
-            for (self.diagnostics.items) |diag| {
-                try diag.print(self.allocator);
+            if (self.print_diagnostics) {
+                for (self.diagnostics.items) |diag| {
+                    try diag.print(self.sources);
+                }
             }
             return error.TypeCheckFailed;
         }
         
         // 兼容：打印旧的简单错误
         if (self.errors.items.len > 0) {
-            for (self.errors.items) |err| {
-                std.debug.print("{s}\n", .{err});
+            if (self.print_diagnostics) {
+                for (self.errors.items) |err| {
+                    std.debug.print("{s}\n", .{err});
+                }
             }
             return error.TypeCheckFailed;
         }
     }
 
+    /// 🆕 v0.2.0: 登记预先解析的 prelude 声明
+    /// 只填充函数/类型/trait 表，prelude 的函数体不再重复检查
+    pub fn registerPrelude(self: *TypeChecker, declarations: []const ast.TopLevelDecl) !void {
+        for (declarations) |decl| {
+            try self.collectDecl(decl);
+        }
+    }
+
+    /// 把一个顶层声明登记到函数/类型/trait 表中
+    fn collectDecl(self: *TypeChecker, decl: ast.TopLevelDecl) !void {
+        switch (decl) {
+            .function => |func| {
+                try self.function_table.put(func.name, func);
+            },
+            .type_decl => |td| {
+                try self.type_table.put(td.name, td);
+                try self.symbol_table.put(td.name, ast.Type{ .named = td.name });
+            
+                // 收集 trait 定义
+                if (td.kind == .trait_type) {
+                    const trait_def = TraitDef{
+                        .name = td.name,
+                        .methods = td.kind.trait_type.methods,
+                        .type_params = td.type_params,
+                    };
+                    try self.trait_table.put(td.name, trait_def);
+                }
+            
+                // 收集类型的方法（struct 和 enum 有完整的方法实现）
+                const methods: ?[]ast.FunctionDecl = switch (td.kind) {
+                    .struct_type => |st| st.methods,
+                    .enum_type => |et| et.methods,
+                    .trait_type => null,  // trait 只有签名，不收集到 type_methods
+                };
+            
+                if (methods) |m| {
+                    if (m.len > 0) {
+                        var type_methods = TypeMethods{
+                            .type_name = td.name,
+                            .methods = std.StringHashMap(ast.FunctionDecl).init(self.allocator),
+                        };
+                    
+                        for (m) |method| {
+                            try type_methods.methods.put(method.name, method);
+                        }
+                    
+                        try self.type_methods.put(td.name, type_methods);
+                    }
+                }
+            },
+            .struct_decl => |s| {
+                try self.symbol_table.put(s.name, ast.Type{ .named = s.name });
+            },
+            .enum_decl => |e| {
+                try self.symbol_table.put(e.name, ast.Type{ .named = e.name });
+            },
+            else => {},
+        }
+    }
+
+    // ============================================================================
+    // 🆕 v0.2.0: Parallel Function Checking
+    // ============================================================================
+    
+    /// 一个函数体的检查任务，诊断信息按任务收集，最后按源码顺序合并
+    const FunctionJob = struct {
+        func: ast.FunctionDecl,
+        errors: std.ArrayList([]const u8) = .{},
+        diagnostics: std.ArrayList(Diagnostic) = .{},
+        failure: ?anyerror = null,
+    };
+    
+    /// 按 checkDecl 的遍历顺序收集所有函数体
+    fn collectFunctionJobs(self: *TypeChecker, program: ast.Program, jobs: *std.ArrayList(FunctionJob)) !void {
+        for (program.declarations) |decl| {
+            if (self.isClean(decl)) continue;
+            const methods: []const ast.FunctionDecl = switch (decl) {
+                .function => |func| {
+                    try jobs.append(self.allocator, .{ .func = func });
+                    continue;
+                },
+                .type_decl => |td| switch (td.kind) {
+                    .struct_type => |st| st.methods,
+                    .enum_type => |et| et.methods,
+                    .trait_type => continue,
+                },
+                .struct_decl => |sd| sd.methods,
+                .enum_decl => |ed| ed.methods,
+                else => continue,
+            };
+            for (methods) |method| {
+                try jobs.append(self.allocator, .{ .func = method });
+            }
+        }
+    }
+    
+    fn checkBodiesParallel(self: *TypeChecker, program: ast.Program) !void {
+        var jobs = std.ArrayList(FunctionJob){};
+        defer jobs.deinit(self.allocator);
+        try self.collectFunctionJobs(program, &jobs);
+        
+        const n_jobs = @min(self.jobs, jobs.items.len);
+        if (jobs.items.len < parallel_threshold or n_jobs <= 1) {
+            for (jobs.items) |job| {
+                try self.checkFunction(job.func);
+            }
+            return;
+        }
+        
+        {
+            var pool: std.Thread.Pool = undefined;
+            try pool.init(.{ .allocator = self.allocator, .n_jobs = n_jobs });
+            defer pool.deinit();
+            
+            var wait_group: std.Thread.WaitGroup = .{};
+            for (jobs.items) |*job| {
+                pool.spawnWg(&wait_group, runFunctionJob, .{ self, job });
+            }
+            pool.waitAndWork(&wait_group);
+        }
+        
+        // 按源码顺序合并，输出与串行检查完全一致
+        var first_failure: ?anyerror = null;
+        for (jobs.items) |*job| {
+            defer job.errors.deinit(self.allocator);
+            defer job.diagnostics.deinit(self.allocator);
+            try self.errors.appendSlice(self.allocator, job.errors.items);
+            try self.diagnostics.appendSlice(self.allocator, job.diagnostics.items);
+            if (first_failure == null) first_failure = job.failure;
+        }
+        if (first_failure) |err| return err;
+    }
+    
+    /// 在工作线程中检查一个函数体
+    /// 工作副本共享只读的全局表，可变状态（错误、可变变量表、arena）各自独立
+    fn runFunctionJob(self: *const TypeChecker, job: *FunctionJob) void {
+        var worker = self.*;
+        worker.errors = .{};
+        worker.diagnostics = .{};
+        worker.mutable_vars = std.StringHashMap(bool).init(self.allocator);
+        worker.arena = std.heap.ArenaAllocator.init(self.allocator);
+        worker.current_function_is_async = false;
+        defer worker.mutable_vars.deinit();
+        defer worker.arena.deinit();
+        
+        worker.checkFunction(job.func) catch |err| {
+            job.failure = err;
+        };
+        
+        job.errors = worker.errors;
+        job.diagnostics = worker.diagnostics;
+    }
+
     fn checkDecl(self: *TypeChecker, decl: ast.TopLevelDecl) !void {
         switch (decl) {
             .function => |func| {
@@ -255,6 +491,9 @@ pub const TypeChecker = struct {
     }
 
     fn checkFunction(self: *TypeChecker, func: ast.FunctionDecl) !void {
+        const zone = prof.zone(self.profiler, "typecheck", func.name);
+        defer zone.end();
+        
         // 保存之前的 async 状态
         const prev_async = self.current_function_is_async;
         self.current_function_is_async = func.is_async;
@@ -263,7 +502,7 @@ pub const TypeChecker = struct {
         // 🆕 v0.1.6: 清空可变变量表（每个函数有自己的作用域）
         self.mutable_vars.clearRetainingCapacity();
         
-        var local_scope = std.StringHashMap(ast.Type).init(self.allocator);
+        var local_scope = Scope.init(self.allocator);
         defer local_scope.deinit();
 
         // 🆕 如果是泛型函数，将类型参数添加到作用域
@@ -322,21 +561,11 @@ pub const TypeChecker = struct {
         }
     }
     
-    /// 创建子作用域（复制父作用域）
-    fn createChildScope(self: *TypeChecker, parent: *std.StringHashMap(ast.Type)) !std.StringHashMap(ast.Type) {
-        var child = std.StringHashMap(ast.Type).init(self.allocator);
-        var iter = parent.iterator();
-        while (iter.next()) |entry| {
-            try child.put(entry.key_ptr.*, entry.value_ptr.*);
-        }
-        return child;
-    }
-    
     // ============================================================================
     // Statement Checking
     // ============================================================================
     
-    fn checkStmt(self: *TypeChecker, stmt: ast.Stmt, scope: *std.StringHashMap(ast.Type)) (std.mem.Allocator.Error || error{TypeCheckFailed})!void {
+    fn checkStmt(self: *TypeChecker, stmt: ast.Stmt, scope: *Scope) (std.mem.Allocator.Error || error{TypeCheckFailed})!void {
         switch (stmt) {
             .expr => |expr| {
                 _ = try self.checkExpr(expr, scope);
@@ -406,7 +635,7 @@ pub const TypeChecker = struct {
                     _ = iter_type;
                     
                     // 为循环变量创建新的作用域
-                    var loop_scope = try self.createChildScope(scope);
+                    var loop_scope = Scope.child(scope);
                     defer loop_scope.deinit();
                     
                     // 添加循环变量（简化：假设为 i32）
@@ -492,7 +721,7 @@ pub const TypeChecker = struct {
         self: *TypeChecker,
         func: ast.FunctionDecl,
         call_args: []ast.Expr,
-        scope: *std.StringHashMap(ast.Type)
+        scope: *Scope
     ) ![]ast.Type {
         var type_map = std.StringHashMap(ast.Type).init(self.allocator);
         defer type_map.deinit();
@@ -561,7 +790,7 @@ pub const TypeChecker = struct {
     // Expression Checking
     // ============================================================================
     
-    fn checkExpr(self: *TypeChecker, expr: ast.Expr, scope: *std.StringHashMap(ast.Type)) (std.mem.Allocator.Error || error{TypeCheckFailed})!ast.Type {
+    fn checkExpr(self: *TypeChecker, expr: ast.Expr, scope: *Scope) (std.mem.Allocator.Error || error{TypeCheckFailed})!ast.Type {
         return switch (expr) {
             .int_literal => ast.Type.i32,      // 整数字面量默认 i32
             .float_literal => ast.Type.f64,    // 浮点字面量默认 f64
@@ -586,7 +815,7 @@ pub const TypeChecker = struct {
                     break :blk sym_type;
                 } else {
                     // 🆕 v0.1.8: Enhanced error message for undefined identifier
-                    if (self.identifier_tokens.get(name)) |token| {
+                    if (self.identifierToken(name)) |token| {
                         const error_msg = try std.fmt.allocPrint(
                             self.allocator,
                             "undefined variable '{s}'",
@@ -707,11 +936,14 @@ pub const TypeChecker = struct {
                             const inferred_types = try self.inferGenericTypes(func, call.args, scope);
                             defer self.allocator.free(inferred_types);
                             
+                            // 🆕 v0.2.0: 显式给出的类型实参优先（例如 size_of<T>()，T 不出现在参数中）
+                            const type_args = if (call.type_args.len == func.type_params.len) call.type_args else inferred_types;
+                            
                             // 返回替换后的返回类型
                             const return_type = try self.substituteType(
                                 func.return_type,
                                 func.type_params,
-                                inferred_types
+                                type_args
                             );
                             break :blk return_type;
                         } else {
@@ -779,16 +1011,10 @@ pub const TypeChecker = struct {
                 var result_type: ?ast.Type = null;
                 
                 for (is_match.arms) |arm| {
-                    // 🆕 为当前arm创建临时scope
-                    var arm_scope = std.StringHashMap(ast.Type).init(self.allocator);
+                    // 🆕 为当前arm创建临时scope（🆕 v0.2.0: 链接到父scope，不再复制）
+                    var arm_scope = Scope.child(scope);
                     defer arm_scope.deinit();
                     
-                    // 复制父scope
-                    var parent_iter = scope.iterator();
-                    while (parent_iter.next()) |entry| {
-                        try arm_scope.put(entry.key_ptr.*, entry.value_ptr.*);
-                    }
-                    
                     // 🆕 根据pattern添加绑定
                     switch (arm.pattern) {
                         .identifier => |id| {
@@ -842,8 +1068,23 @@ pub const TypeChecker = struct {
             },
             // 新增：as 表达式（类型转换）
             .as_expr => |as_cast| blk: {
-                const from_type = try self.checkExpr(as_cast.value.*, scope);
                 const to_type = as_cast.target_type;
+
+                // 🆕 v0.2.0: `f as i64` 取函数地址（传给 paw_task_spawn / paw_parallel_for 等运行时函数）
+                if (as_cast.value.* == .identifier) {
+                    const name = as_cast.value.identifier;
+                    const func = if (scope.get(name) == null) self.function_table.get(name) else null;
+                    if (func) |f| {
+                        if (to_type != .i64 and to_type != .u64) {
+                            try self.errors.append(self.allocator, try self.allocator.dupe(u8, "Type error: a function can only be converted to i64 or u64"));
+                        } else if (f.type_params.len > 0) {
+                            try self.errors.append(self.allocator, try self.allocator.dupe(u8, "Type error: cannot take the address of a generic function"));
+                        }
+                        break :blk to_type;
+                    }
+                }
+
+                const from_type = try self.checkExpr(as_cast.value.*, scope);
                 
                 // 🆕 v0.1.7: 改进的类型转换验证
                 const is_numeric_from = switch (from_type) {
@@ -1133,7 +1374,7 @@ pub const TypeChecker = struct {
         receiver_type: ast.Type,
         method_name: []const u8,
         args: []ast.Expr,
-        scope: *std.StringHashMap(ast.Type),
+        scope: *Scope,
     ) !ast.Type {
         // 获取接收者的类型名
         const type_name = switch (receiver_type) {
@@ -1353,18 +1594,21 @@ pub const TypeChecker = struct {
     }
     
     /// 🆕 v0.1.8: 查找相似的变量名建议
-    fn findSimilarVariable(self: *TypeChecker, name: []const u8, scope: *std.StringHashMap(ast.Type)) ?[]const u8 {
+    fn findSimilarVariable(self: *TypeChecker, name: []const u8, scope: *Scope) ?[]const u8 {
         var best_match: ?[]const u8 = null;
         var best_distance: usize = 999;
         
-        // 在局部作用域中查找
-        var scope_iter = scope.iterator();
-        while (scope_iter.next()) |entry| {
-            const candidate = entry.key_ptr.*;
-            const distance = self.levenshteinDistance(name, candidate);
-            if (distance < best_distance and distance <= 2) {  // 最多 2 个字符差异
-                best_distance = distance;
-                best_match = candidate;
+        // 在局部作用域链中查找（由内向外）
+        var frame: ?*const Scope = scope;
+        while (frame) |f| : (frame = f.parent) {
+            var scope_iter = f.vars.iterator();
+            while (scope_iter.next()) |entry| {
+                const candidate = entry.key_ptr.*;
+                const distance = self.levenshteinDistance(name, candidate);
+                if (distance < best_distance and distance <= 2) {  // 最多 2 个字符差异
+                    best_distance = distance;
+                    best_match = candidate;
+                }
             }
         }
         
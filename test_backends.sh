@@ -22,8 +22,8 @@ echo ""
 
 # LLVM 后端
 echo "【LLVM 后端】"
-./zig-out/bin/pawc tests/syntax/simple_comparison.paw --backend=llvm > /dev/null 2>&1
-/opt/homebrew/opt/llvm@19/bin/clang output.ll -o test_llvm 2>/dev/null
+# 直接从内存模块生成目标文件并链接（不再经过 output.ll）
+./zig-out/bin/pawc tests/syntax/simple_comparison.paw --backend=llvm --compile -o test_llvm > /dev/null 2>&1
 ./test_llvm
 LLVM_RESULT=$?
 echo "  编译: ✅"